@@ -0,0 +1,83 @@
+/**
+ * @file handler_scaling.cpp
+ * @brief Compile-time benchmark: a Handler of LIBCMD_BENCH_COMMANDS commands with every entry point instantiated
+ *
+ * Not linked into bench-all. The bench-compile target builds this file once per command count and reports
+ * the compile time and object size of each build, see scripts/compile_time.py.
+ */
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#ifndef LIBCMD_BENCH_COMMANDS
+#define LIBCMD_BENCH_COMMANDS 10
+#endif
+
+static_assert(LIBCMD_BENCH_COMMANDS <= 256, "One-byte IDs allow at most 256 commands");
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+/**
+ * @brief Three-byte format, one distinct ID per instantiation
+ * @tparam N The command ID
+ */
+template <std::size_t N> struct ScalingFormat
+{
+    static constexpr std::uint8_t ID = N; ///< Unique identifier for this message type
+    std::uint8_t id;                      ///< Command identifier
+    std::uint16_t arg;                    ///< Some argument associated with the command
+};
+
+/**
+ * @brief Command responding with its argument, so that every command has a distinct body
+ * @tparam N The command ID
+ */
+template <std::size_t N> class ScalingCommand final : public Command<ScalingFormat<N>>
+{
+  public:
+    explicit ScalingCommand(const serialized_message_view_t content) : Command<ScalingFormat<N>>(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        const std::uint16_t reply = this->content().arg + N;
+        communicator.respondView(std::span(reinterpret_cast<const std::uint8_t*>(&reply), sizeof(reply)));
+    }
+};
+
+/**
+ * @brief Builds a Handler registering the commands 0..N-1
+ */
+template <typename Sequence> struct ScalingHandler;
+template <std::size_t... I> struct ScalingHandler<std::index_sequence<I...>>
+{
+    using type = Handler<ScalingCommand<I>...>; ///< The Handler type
+};
+
+using scaling_handler_t = typename ScalingHandler<std::make_index_sequence<LIBCMD_BENCH_COMMANDS>>::type;
+
+/* ―――――――――――――――― Entry points ―――――――――――――――― */
+
+/**
+ * @brief Instantiates every dispatch path of the handler (external linkage keeps them in the object)
+ * @param frames The frames to execute
+ * @param communicator The Communicator responses go to
+ * @param mask Validation mask of frames
+ * @param out Statuses of frames
+ * @return std::size_t The number of successful executions
+ */
+std::size_t scalingHandlerExecute(
+    const std::span<const serialized_message_view_t> frames,
+    const Communicator& communicator,
+    const std::span<std::uint64_t> mask,
+    const std::span<HANDLER_EXECUTE_STATUS> out
+) {
+    std::size_t succeeded = scaling_handler_t::validateBatch(frames, mask);
+    for (const serialized_message_view_t frame : frames) {
+        succeeded += scaling_handler_t::execute<HANDLER_DISPATCH_MODE::JUMP_TABLE>(frame, communicator).ok() ? 1 : 0;
+        succeeded += scaling_handler_t::execute<HANDLER_DISPATCH_MODE::FOLD>(frame, communicator).ok() ? 1 : 0;
+    }
+    return succeeded + scaling_handler_t::executeBatch(frames, communicator, out);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "communication.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+/* ―――――――――――――――― Communicators ―――――――――――――――― */
+
+/**
+ * @brief Communicator discarding everything
+ */
+class NullCommunicator final : public Communicator
+{
+  public:
+    void respond(const std::vector<std::uint8_t>& /*response*/) const override {}
+    void respondView(const std::span<const std::uint8_t> response) const override {
+        std::span<const std::uint8_t> bytes = response; // DoNotOptimize() of a const lvalue is deprecated
+        benchmark::DoNotOptimize(bytes);
+    }
+
+    [[nodiscard]] REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& /*message*/,
+        std::function<void(std::vector<std::uint8_t>)> /*handle_response_callback*/
+    ) const override {
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+
+    [[nodiscard]] REQUEST_STATUS requestView(
+        const std::span<const std::uint8_t> /*message*/, const response_callback_t /*handle_response_callback*/
+    ) const override {
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+};
+
+/* ―――――――――――――――― Allocations ―――――――――――――――― */
+
+/**
+ * @brief Number of calls to the global operator new so far, on any thread
+ * @return std::size_t The allocation count
+ */
+std::size_t allocationCount() noexcept;
+
+/**
+ * @brief Reports the allocations made since start as an "allocs/iter" counter of state
+ *
+ * @param state The benchmark state, after its loop
+ * @param start allocationCount() before the loop
+ */
+inline void reportAllocations(benchmark::State& state, const std::size_t start) {
+    state.counters["allocs/iter"] = benchmark::Counter(
+        static_cast<double>(allocationCount() - start) / static_cast<double>(state.iterations())
+    );
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Compile-time benchmark of Handler: builds a source once per command count and reports time and code size.
+
+Code size is the text + data size reported by binutils `size` when it is available; the object size also counts
+the symbol names, which grow with the length of the Handler type and so quadratically with the command count.
+
+Usage: compile_time.py --compiler g++-14 --source handler_scaling.cpp --out compile.json [--flag=...] 10 100 250
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def code_size(obj):
+    """Returns text + data bytes of an object file, or None without binutils."""
+    tool = shutil.which("size")
+    if tool is None:
+        return None
+    output = subprocess.run([tool, obj], check=True, capture_output=True, text=True).stdout
+    text, data = output.splitlines()[-1].split()[:2]
+    return int(text) + int(data)
+
+
+def measure(compiler, flags, source, count, repetitions):
+    """Compiles source with LIBCMD_BENCH_COMMANDS=count, returns the best wall time, code and object sizes."""
+    with tempfile.TemporaryDirectory() as directory:
+        obj = os.path.join(directory, "scaling.o")
+        command = [compiler, *flags, f"-DLIBCMD_BENCH_COMMANDS={count}", "-c", source, "-o", obj]
+        best = float("inf")
+        for _ in range(repetitions):
+            start = time.perf_counter()
+            subprocess.run(command, check=True)
+            best = min(best, time.perf_counter() - start)
+        return best, code_size(obj), os.path.getsize(obj)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--compiler", required=True)
+    parser.add_argument("--source", required=True)
+    parser.add_argument("--out", help="JSON report path")
+    parser.add_argument("--flag", action="append", default=[], help="compiler flag, may be repeated")
+    parser.add_argument("--repetitions", type=int, default=1)
+    parser.add_argument("counts", type=int, nargs="+")
+    args = parser.parse_args()
+
+    results = []
+    print(f"{'commands':>10} {'seconds':>10} {'code bytes':>12} {'code/command':>14} {'object bytes':>14}")
+    for count in args.counts:
+        seconds, code, size = measure(args.compiler, args.flag, args.source, count, args.repetitions)
+        results.append({"commands": count, "seconds": seconds, "code_bytes": code, "object_bytes": size})
+        per_command = "-" if code is None else code // count
+        print(f"{count:>10} {seconds:>10.2f} {code if code is not None else '-':>12} {per_command:>14} {size:>14}")
+        sys.stdout.flush()
+
+    if args.out:
+        with open(args.out, "w", encoding="utf-8") as report:
+            json.dump({"compiler": args.compiler, "flags": args.flag, "results": results}, report, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,31 @@
+#include "bench_utils.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/* ―――――――――――――――― Counting allocator ―――――――――――――――― */
+
+namespace
+{
+std::atomic<std::size_t> allocations{0};
+} // anonymous namespace
+
+std::size_t allocationCount() noexcept { return allocations.load(std::memory_order_relaxed); }
+
+void* operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* const memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) { return operator new(size); }
+
+void operator delete(void* const memory) noexcept { std::free(memory); }
+
+void operator delete[](void* const memory) noexcept { std::free(memory); }
+
+void operator delete(void* const memory, std::size_t /*size*/) noexcept { std::free(memory); }
+
+void operator delete[](void* const memory, std::size_t /*size*/) noexcept { std::free(memory); }
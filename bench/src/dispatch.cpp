@@ -0,0 +1,162 @@
+#include "bench_utils.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "router.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <utility>
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+/**
+ * @brief Two-byte format, one distinct ID per instantiation
+ * @tparam N The command ID
+ */
+template <std::size_t N> struct BenchFormat
+{
+    static constexpr std::uint8_t ID = N; ///< Unique identifier for this message type
+    std::uint8_t id;                      ///< Command identifier
+    std::uint8_t arg;                     ///< Some argument associated with the command
+};
+
+/**
+ * @brief Command replying nothing, so that only the dispatch itself is measured
+ * @tparam N The command ID
+ */
+template <std::size_t N> class BenchCommand final : public Command<BenchFormat<N>>
+{
+  public:
+    explicit BenchCommand(const serialized_message_view_t content) : Command<BenchFormat<N>>(content) {}
+
+    void execute(const Communicator& /*communicator*/) const override {
+        std::uint8_t arg = this->content().arg;
+        benchmark::DoNotOptimize(arg);
+    }
+};
+
+/**
+ * @brief Builds a Handler registering the commands 0..N-1
+ */
+template <typename Sequence> struct BenchHandler;
+template <std::size_t... I> struct BenchHandler<std::index_sequence<I...>>
+{
+    using type = Handler<BenchCommand<I>...>; ///< The Handler type
+};
+
+template <std::size_t N> using bench_handler_t = typename BenchHandler<std::make_index_sequence<N>>::type;
+
+/* ―――――――――――――――― Benchmarks ―――――――――――――――― */
+
+/**
+ * @brief Dispatches a frame whose ID is given by the benchmark argument
+ * @tparam N Number of registered commands
+ * @tparam Mode Dispatch mode under test
+ */
+template <std::size_t N, HANDLER_DISPATCH_MODE Mode> static void bmDispatch(benchmark::State& state) {
+    std::array<std::uint8_t, 2> frame{static_cast<std::uint8_t>(state.range(0)), 0x01};
+    const NullCommunicator communicator;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frame); // keep the ID opaque to the optimizer
+        Result result = bench_handler_t<N>::template execute<Mode>(frame, communicator);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// Arguments: first, middle and last registered IDs
+BENCHMARK_TEMPLATE(bmDispatch, 3, HANDLER_DISPATCH_MODE::FOLD)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK_TEMPLATE(bmDispatch, 3, HANDLER_DISPATCH_MODE::JUMP_TABLE)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK_TEMPLATE(bmDispatch, 32, HANDLER_DISPATCH_MODE::FOLD)->Arg(0)->Arg(16)->Arg(31);
+BENCHMARK_TEMPLATE(bmDispatch, 32, HANDLER_DISPATCH_MODE::JUMP_TABLE)->Arg(0)->Arg(16)->Arg(31);
+BENCHMARK_TEMPLATE(bmDispatch, 200, HANDLER_DISPATCH_MODE::FOLD)->Arg(0)->Arg(100)->Arg(199);
+BENCHMARK_TEMPLATE(bmDispatch, 200, HANDLER_DISPATCH_MODE::JUMP_TABLE)->Arg(0)->Arg(100)->Arg(199);
+
+/** @brief Router of two shards of 32 commands each, to compare with bmDispatch of a single handler */
+using bench_router_t = Router<Route<0x01, bench_handler_t<32>>, Route<0x02, bench_handler_t<32>>>;
+
+/**
+ * @brief Dispatches a frame through a Router to the command of the benchmark argument
+ */
+static void bmRoutedDispatch(benchmark::State& state) {
+    std::array<std::uint8_t, 3> frame{0x02, static_cast<std::uint8_t>(state.range(0)), 0x01};
+    const NullCommunicator communicator;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frame); // keep the address and ID opaque to the optimizer
+        Result result = bench_router_t::execute(frame, communicator);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(bmRoutedDispatch)->Arg(0)->Arg(16)->Arg(31);
+
+/**
+ * @brief Builds a burst of frames with IDs spread over the N registered commands
+ * @tparam N Number of registered commands
+ * @param size Number of frames in the burst
+ * @return std::vector<std::array<std::uint8_t, 2>> The frames
+ */
+template <std::size_t N> static std::vector<std::array<std::uint8_t, 2>> makeBurst(const std::size_t size) {
+    std::vector<std::array<std::uint8_t, 2>> burst(size);
+    std::uint32_t state = 0x12345678U; // xorshift, deterministic across runs
+    for (std::array<std::uint8_t, 2>& frame : burst) {
+        state ^= state << 13U;
+        state ^= state >> 17U;
+        state ^= state << 5U;
+        frame = {static_cast<std::uint8_t>(state % N), 0x01};
+    }
+    return burst;
+}
+
+/**
+ * @brief Executes a burst of frames one execute() call at a time
+ * @tparam N Number of registered commands
+ */
+template <std::size_t N> static void bmBurstPerFrame(benchmark::State& state) {
+    const std::vector<std::array<std::uint8_t, 2>> burst = makeBurst<N>(static_cast<std::size_t>(state.range(0)));
+    const NullCommunicator communicator;
+    for (auto _ : state) {
+        for (const std::array<std::uint8_t, 2>& frame : burst) {
+            Result result = bench_handler_t<N>::execute(frame, communicator);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Executes a burst of frames with a single executeBatch() call, keeping one status per frame
+ * @tparam N Number of registered commands
+ */
+template <std::size_t N> static void bmBurstBatch(benchmark::State& state) {
+    const std::vector<std::array<std::uint8_t, 2>> burst = makeBurst<N>(static_cast<std::size_t>(state.range(0)));
+    const std::vector<serialized_message_view_t> frames(burst.begin(), burst.end());
+    std::vector<HANDLER_EXECUTE_STATUS> out(frames.size());
+    const NullCommunicator communicator;
+    for (auto _ : state) {
+        std::size_t succeeded = bench_handler_t<N>::executeBatch(frames, communicator, out);
+        benchmark::DoNotOptimize(succeeded);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(bmBurstPerFrame, 200)->Arg(64)->Arg(512);
+BENCHMARK_TEMPLATE(bmBurstBatch, 200)->Arg(64)->Arg(512);
+
+/**
+ * @brief Checks the IDs and sizes of a burst of frames with validateBatch(), without executing them
+ * @tparam N Number of registered commands
+ */
+template <std::size_t N> static void bmValidateBatch(benchmark::State& state) {
+    using handler_t = bench_handler_t<N>;
+    const std::vector<std::array<std::uint8_t, 2>> burst = makeBurst<N>(static_cast<std::size_t>(state.range(0)));
+    const std::vector<serialized_message_view_t> frames(burst.begin(), burst.end());
+    std::vector<std::uint64_t> mask(validationMaskWords(frames.size()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(handler_t::validateBatch(frames, mask));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(bmValidateBatch, 200)->Arg(64)->Arg(512);
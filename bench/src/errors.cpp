@@ -0,0 +1,132 @@
+#include "bench_utils.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+/**
+ * @brief Four-byte command format
+ */
+struct ErrorBenchFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t op;                         ///< Operation
+    std::uint16_t arg;                       ///< Argument
+};
+
+/**
+ * @brief Command succeeding, or throwing when op is non-zero
+ */
+class ErrorBenchCommand final : public Command<ErrorBenchFormat>
+{
+  public:
+    explicit ErrorBenchCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& /*communicator*/) const override {
+        if (content().op != 0) {
+            throw std::runtime_error("device rejected the operation");
+        }
+        std::uint16_t arg = content().arg;
+        benchmark::DoNotOptimize(arg);
+    }
+};
+
+using error_bench_handler_t = Handler<ErrorBenchCommand>;
+
+/**
+ * @brief Frames exercising each path of Handler::execute()
+ */
+enum class FRAME_KIND : std::uint8_t
+{
+    SUCCESS = 0,
+    UNKNOWN_ID = 1,
+    WRONG_LENGTH = 2,
+    EMPTY = 3,
+    EXCEPTION = 4,
+};
+
+/* ―――――――――――――――― Benchmarks ―――――――――――――――― */
+
+/**
+ * @brief Executes a frame taking the path given by the argument (see FRAME_KIND)
+ */
+static void bmExecutePath(benchmark::State& state) {
+    std::array<std::uint8_t, 5> storage{ErrorBenchFormat::ID, 0x00, 0x01, 0x00, 0x00};
+    serialized_message_view_t frame = serialized_message_view_t(storage).first(sizeof(ErrorBenchFormat));
+    switch (static_cast<FRAME_KIND>(state.range(0))) {
+    case FRAME_KIND::SUCCESS:
+        break;
+    case FRAME_KIND::UNKNOWN_ID:
+        storage[0] = 0x7F;
+        break;
+    case FRAME_KIND::WRONG_LENGTH:
+        frame = storage;
+        break;
+    case FRAME_KIND::EMPTY:
+        frame = {};
+        break;
+    case FRAME_KIND::EXCEPTION:
+        storage[1] = 0x01;
+        break;
+    }
+    const NullCommunicator communicator;
+    const std::size_t start = allocationCount();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage);
+        Result result = error_bench_handler_t::execute(frame, communicator);
+        benchmark::DoNotOptimize(result);
+    }
+    reportAllocations(state, start);
+}
+
+/**
+ * @brief Constructs a command from a frame that is too short, through the throwing constructor
+ */
+static void bmThrowingConstructor(benchmark::State& state) {
+    const std::array<std::uint8_t, 2> frame{ErrorBenchFormat::ID, 0x00};
+    const std::size_t start = allocationCount();
+    for (auto _ : state) {
+        try {
+            ErrorBenchCommand command(frame);
+            benchmark::DoNotOptimize(command);
+        }
+        catch (const MessageLengthError& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+    reportAllocations(state, start);
+}
+
+/**
+ * @brief Formats an error, into a std::string or into a stack buffer
+ */
+static void bmDescribeError(benchmark::State& state) {
+    const std::array<std::uint8_t, 2> frame{ErrorBenchFormat::ID, 0x00};
+    const NullCommunicator communicator;
+    const Result result = error_bench_handler_t::execute(frame, communicator);
+    const bool into_buffer = state.range(0) != 0;
+    const std::size_t start = allocationCount();
+    for (auto _ : state) {
+        if (into_buffer) {
+            std::array<char, 96> buffer{};
+            benchmark::DoNotOptimize(result.error().describeInto(buffer).size());
+        }
+        else {
+            const std::string text = result.error().describe();
+            benchmark::DoNotOptimize(text.data());
+        }
+    }
+    reportAllocations(state, start);
+}
+
+// Arguments: FRAME_KIND values
+BENCHMARK(bmExecutePath)->ArgName("kind")->DenseRange(0, 4);
+BENCHMARK(bmThrowingConstructor);
+BENCHMARK(bmDescribeError)->ArgName("into_buffer")->Arg(0)->Arg(1);
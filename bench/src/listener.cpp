@@ -0,0 +1,138 @@
+#include "command.h"
+#include "framer.h"
+#include "handler.h"
+#include "message.h"
+#include "socket_listener.h"
+#include "uring_listener.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+/**
+ * @brief Four-byte command answered with itself
+ */
+struct ListenerBenchFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t op;                         ///< Operation
+    std::uint16_t arg;                       ///< Argument
+};
+
+class ListenerBenchCommand final : public Command<ListenerBenchFormat>
+{
+  public:
+    explicit ListenerBenchCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::array<std::uint8_t, sizeof(ListenerBenchFormat)> buffer{};
+        communicator.respondView(SentMessage<ListenerBenchFormat>(content()).serializeInto(buffer));
+    }
+};
+
+using listener_bench_handler_t = Handler<ListenerBenchCommand>;
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+/**
+ * @brief Loopback server running a listener on its own thread, with connected clients
+ */
+template <typename ListenerT> class LoopbackBench
+{
+    int _listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    std::unique_ptr<ListenerT> _listener;
+    std::thread _loop;
+    std::vector<int> _clients;
+
+  public:
+    explicit LoopbackBench(const std::size_t clients) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        ::bind(_listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        ::listen(_listen_fd, 4096);
+        ::getsockname(_listen_fd, reinterpret_cast<sockaddr*>(&address), &length);
+        _listener = std::make_unique<ListenerT>(_listen_fd);
+        _loop = std::thread([this] { _listener->start(); });
+        for (std::size_t i = 0; i < clients; ++i) {
+            const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+            _clients.push_back(fd);
+        }
+    }
+
+    LoopbackBench(const LoopbackBench&) = delete;
+    LoopbackBench& operator=(const LoopbackBench&) = delete;
+
+    ~LoopbackBench() {
+        for (const int fd : _clients) {
+            ::close(fd);
+        }
+        _listener->stop();
+        _loop.join();
+        ::close(_listen_fd);
+    }
+
+    /**
+     * @brief Sends one frame on every connection, then waits for every response
+     * @param frame The encoded frame
+     */
+    void roundTrip(const serialized_message_view_t frame) const {
+        for (const int fd : _clients) {
+            ::send(fd, frame.data(), frame.size(), MSG_NOSIGNAL);
+        }
+        std::array<std::uint8_t, 64> response{};
+        for (const int fd : _clients) {
+            for (std::size_t got = 0; got < frame.size();) {
+                const ssize_t read = ::recv(fd, response.data(), response.size(), 0);
+                if (read > 0) {
+                    got += static_cast<std::size_t>(read);
+                }
+                else if (read == 0 || errno != EINTR) {
+                    return;
+                }
+            }
+        }
+    }
+};
+
+/* ―――――――――――――――― Benchmarks ―――――――――――――――― */
+
+/**
+ * @brief One request per connection per iteration, over as many connections as the argument
+ */
+template <typename ListenerT> static void bmListenerRoundTrip(benchmark::State& state) {
+#ifdef LIBCMD_HAS_IO_URING
+    if constexpr (std::is_same_v<ListenerT, UringListener<listener_bench_handler_t>>) {
+        if (!ListenerT::supported()) {
+            state.SkipWithError("io_uring is not available");
+            return;
+        }
+    }
+#endif
+    const LoopbackBench<ListenerT> bench(static_cast<std::size_t>(state.range(0)));
+    const serialized_message_t frame = SentMessage<ListenerBenchFormat>({.id = 0x01, .op = 1, .arg = 2}).serialize();
+    std::array<std::uint8_t, cobsEncodedSize(sizeof(ListenerBenchFormat))> encoded{};
+    const serialized_message_view_t bytes = cobsEncode(frame, encoded);
+    for (auto _ : state) {
+        bench.roundTrip(bytes);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(bmListenerRoundTrip<EpollListener<listener_bench_handler_t>>)->Arg(1)->Arg(64)->Arg(1024)->UseRealTime();
+#ifdef LIBCMD_HAS_IO_URING
+BENCHMARK(bmListenerRoundTrip<UringListener<listener_bench_handler_t>>)->Arg(1)->Arg(64)->Arg(1024)->UseRealTime();
+#endif
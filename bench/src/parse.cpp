@@ -0,0 +1,125 @@
+#include "bench_utils.h"
+#include "message.h"
+#include "wire.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+/**
+ * @brief Format laid out like those of main.cpp: packed, so value sits at offset 2
+ */
+struct PackedFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t status;                     ///< Status code
+    std::uint32_t value;                     ///< Some value associated with the command
+} __attribute__((packed));
+static_assert(sizeof(PackedFormat) == 6);
+
+/**
+ * @brief Same fields with natural alignment, padding bytes included in the frame
+ */
+struct AlignedFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t status;                     ///< Status code
+    std::uint16_t reserved;                  ///< Explicit padding
+    std::uint32_t value;                     ///< Some value associated with the command
+};
+static_assert(sizeof(AlignedFormat) == 8);
+
+/**
+ * @brief Same layout as PackedFormat through a little-endian wire field, without packing
+ */
+struct WireFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t status;                     ///< Status code
+    le_u32_t value;                          ///< Some value associated with the command
+};
+static_assert(sizeof(WireFormat) == 6);
+
+/**
+ * @brief Large configuration frame of which a command only reads a couple of fields
+ */
+struct ConfigFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t status;                     ///< Status code
+    le_u32_t value;                          ///< Some value associated with the command
+    std::array<std::uint8_t, 1018> table;    ///< Bulk configuration data
+};
+static_assert(sizeof(ConfigFormat) == 1024);
+
+/* ―――――――――――――――― Benchmarks ―――――――――――――――― */
+
+/**
+ * @brief Parses a frame into a ReceivedMessage and reads every field
+ *
+ * The argument is the offset of the frame in the receive buffer, 1 leaves it misaligned as it
+ * usually is after a transport header.
+ *
+ * @tparam Format The message format
+ */
+template <typename Format> static void bmParse(benchmark::State& state) {
+    alignas(8) std::array<std::uint8_t, 16 + sizeof(Format)> buffer{};
+    const auto offset = static_cast<std::size_t>(state.range(0));
+    buffer[offset] = Format::ID;
+    const serialized_message_view_t frame = serialized_message_view_t(buffer).subspan(offset, sizeof(Format));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buffer);
+        const ReceivedMessage<Format> message(frame);
+        const Format& content = message.content();
+        benchmark::DoNotOptimize(content.status + content.value);
+    }
+}
+
+/**
+ * @brief Parses through the exception-free tryParse(), with the same arguments as bmParse
+ * @tparam Format The message format
+ */
+template <typename Format> static void bmTryParse(benchmark::State& state) {
+    alignas(8) std::array<std::uint8_t, 16 + sizeof(Format)> buffer{};
+    const auto offset = static_cast<std::size_t>(state.range(0));
+    buffer[offset] = Format::ID;
+    const serialized_message_view_t frame = serialized_message_view_t(buffer).subspan(offset, sizeof(Format));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buffer);
+        const Result parsed = ReceivedMessage<Format>::tryParse(frame);
+        auto value = parsed.value().content().value;
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+/**
+ * @brief Reads two fields through a ReceivedMessageView, which copies nothing, with the same arguments as bmParse
+ * @tparam Format The message format
+ */
+template <typename Format> static void bmParseView(benchmark::State& state) {
+    alignas(8) std::array<std::uint8_t, 16 + sizeof(Format)> buffer{};
+    const auto offset = static_cast<std::size_t>(state.range(0));
+    buffer[offset] = Format::ID;
+    const serialized_message_view_t frame = serialized_message_view_t(buffer).subspan(offset, sizeof(Format));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buffer);
+        const ReceivedMessageView<Format> view(frame);
+        benchmark::DoNotOptimize(view.template get<&Format::status>() + view.template get<&Format::value>());
+    }
+}
+
+BENCHMARK_TEMPLATE(bmParse, PackedFormat)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(bmParse, AlignedFormat)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(bmParse, WireFormat)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(bmParse, ConfigFormat)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(bmParseView, WireFormat)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(bmParseView, ConfigFormat)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(bmTryParse, PackedFormat)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(bmTryParse, AlignedFormat)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(bmTryParse, WireFormat)->Arg(0)->Arg(1);
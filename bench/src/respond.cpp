@@ -0,0 +1,68 @@
+#include "bench_utils.h"
+#include "buffered_communicator.h"
+#include "communication.h"
+#include "posix_sink.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+/**
+ * @brief /dev/null opened for writing, the cost measured is the system call alone
+ */
+class DevNull
+{
+    int _fd;
+
+  public:
+    DevNull() : _fd(::open("/dev/null", O_WRONLY | O_CLOEXEC)) {}
+    DevNull(const DevNull&) = delete;
+    DevNull& operator=(const DevNull&) = delete;
+    ~DevNull() { ::close(_fd); }
+
+    [[nodiscard]] int fd() const noexcept { return _fd; }
+};
+
+/* ―――――――――――――――― Benchmarks ―――――――――――――――― */
+
+/**
+ * @brief Sends a batch of 16-byte responses with one write() each
+ */
+static void bmRespondPerFrame(benchmark::State& state) {
+    const DevNull null;
+    FdStreamSink sink(null.fd());
+    const std::array<std::uint8_t, 16> response{};
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            sink.send(response);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Sends the same batch through a BufferedCommunicator, one writev() per flush
+ */
+static void bmRespondBuffered(benchmark::State& state) {
+    const DevNull null;
+    FdStreamSink sink(null.fd());
+    const NullCommunicator upstream;
+    const BufferedCommunicator communicator(sink, upstream);
+    const std::array<std::uint8_t, 16> response{};
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            communicator.respondView(std::span<const std::uint8_t>(response));
+        }
+        communicator.flush();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(bmRespondPerFrame)->Arg(1)->Arg(16)->Arg(64);
+BENCHMARK(bmRespondBuffered)->Arg(1)->Arg(16)->Arg(64);
@@ -0,0 +1,70 @@
+#include "bench_utils.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "response_cache.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+/**
+ * @brief Four-byte read command and its response
+ */
+struct CacheBenchFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t op;                         ///< Operation
+    std::uint16_t arg;                       ///< Argument
+};
+
+/**
+ * @brief Pure read answering a value derived from arg, with a little work to stand for a real lookup
+ */
+class CacheBenchCommand final : public Command<CacheBenchFormat>
+{
+  public:
+    static constexpr bool IDEMPOTENT = true;
+
+    explicit CacheBenchCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::uint32_t value = content().arg;
+        for (int i = 0; i < 64; ++i) {
+            value = value * 1664525U + 1013904223U;
+        }
+        std::array<std::uint8_t, sizeof(CacheBenchFormat)> buffer{};
+        communicator.respondView(
+            SentMessage<CacheBenchFormat>({.id = 0x01, .op = 0, .arg = static_cast<std::uint16_t>(value)})
+                .serializeInto(buffer)
+        );
+    }
+};
+
+using cache_bench_handler_t = Handler<CacheBenchCommand>;
+
+static ResponseCache<> bench_cache({.ttl = std::chrono::seconds(0)});
+
+/* ―――――――――――――――― Benchmarks ―――――――――――――――― */
+
+/**
+ * @brief Executes the same frames again and again, through the handler or from the cache
+ * @tparam HandlerT The handler under test
+ */
+template <typename HandlerT> static void bmRepeatedReads(benchmark::State& state) {
+    std::array<serialized_message_t, 16> frames;
+    for (std::uint16_t i = 0; i < frames.size(); ++i) {
+        frames[i] = SentMessage<CacheBenchFormat>({.id = 0x01, .op = 0, .arg = i}).serialize();
+    }
+    const NullCommunicator communicator;
+    std::size_t next = 0;
+    for (auto _ : state) {
+        Result result = HandlerT::execute(frames[next++ % frames.size()], communicator);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(bmRepeatedReads<cache_bench_handler_t>);
+BENCHMARK(bmRepeatedReads<MemoizingHandler<cache_bench_handler_t, bench_cache>>);
@@ -0,0 +1,97 @@
+#include "bench_utils.h"
+#include "message.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+/**
+ * @brief Response format of main.cpp
+ */
+struct ResponseFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t status;                     ///< Status code
+    std::uint32_t value;                     ///< Some value associated with the command
+} __attribute__((packed));
+
+/**
+ * @brief Trailing-payload response, serialized header then payload
+ */
+struct ChunkResponseFormat
+{
+    static constexpr std::uint8_t ID = 0x02;             ///< Unique identifier for this message type
+    static constexpr std::size_t MAX_PAYLOAD_SIZE = 240; ///< Largest trailing payload
+    std::uint8_t id;                                     ///< Command identifier
+    std::uint8_t length;                                 ///< Payload length
+};
+
+/* ―――――――――――――――― Benchmarks ―――――――――――――――― */
+
+/**
+ * @brief Builds a response and serializes it into a fresh std::vector, as respond(vector) needs
+ */
+static void bmSerializeVector(benchmark::State& state) {
+    const std::size_t start = allocationCount();
+    std::uint32_t value = 0;
+    for (auto _ : state) {
+        const SentMessage<ResponseFormat> message({.id = ResponseFormat::ID, .status = 0, .value = ++value});
+        const serialized_message_t bytes = message.serialize();
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    reportAllocations(state, start);
+}
+
+/**
+ * @brief Builds a response and serializes it into a stack buffer, as respondView() allows
+ */
+static void bmSerializeInto(benchmark::State& state) {
+    const std::size_t start = allocationCount();
+    std::array<std::uint8_t, sizeof(ResponseFormat)> buffer{};
+    std::uint32_t value = 0;
+    for (auto _ : state) {
+        const SentMessage<ResponseFormat> message({.id = ResponseFormat::ID, .status = 0, .value = ++value});
+        benchmark::DoNotOptimize(message.serializeInto(buffer).data());
+    }
+    reportAllocations(state, start);
+}
+
+/**
+ * @brief Serializes a trailing-payload response of the argument's size into a stack buffer
+ */
+static void bmSerializePayloadInto(benchmark::State& state) {
+    const std::size_t start = allocationCount();
+    std::array<std::uint8_t, ChunkResponseFormat::MAX_PAYLOAD_SIZE> payload{};
+    std::array<std::uint8_t, sizeof(ChunkResponseFormat) + ChunkResponseFormat::MAX_PAYLOAD_SIZE> buffer{};
+    const auto size = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(payload);
+        const SentMessage<ChunkResponseFormat> message(
+            {.id = ChunkResponseFormat::ID, .length = static_cast<std::uint8_t>(size)},
+            serialized_message_view_t(payload).first(size)
+        );
+        benchmark::DoNotOptimize(message.serializeInto(buffer).data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    reportAllocations(state, start);
+}
+
+/**
+ * @brief Sends a response through respond(vector), the allocating path of a default Communicator
+ */
+static void bmRespondVector(benchmark::State& state) {
+    const NullCommunicator communicator;
+    const std::size_t start = allocationCount();
+    for (auto _ : state) {
+        const SentMessage<ResponseFormat> message({.id = ResponseFormat::ID, .status = 0, .value = 1});
+        communicator.respond(message.serialize());
+    }
+    reportAllocations(state, start);
+}
+
+BENCHMARK(bmSerializeVector);
+BENCHMARK(bmSerializeInto);
+BENCHMARK(bmSerializePayloadInto)->Arg(16)->Arg(240);
+BENCHMARK(bmRespondVector);
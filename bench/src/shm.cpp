@@ -0,0 +1,65 @@
+#include "bench_utils.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "shm_transport.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+/**
+ * @brief Four-byte command answered with itself
+ */
+struct ShmBenchFormat
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t op;                         ///< Operation
+    std::uint16_t arg;                       ///< Argument
+};
+
+class ShmBenchCommand final : public Command<ShmBenchFormat>
+{
+  public:
+    explicit ShmBenchCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::array<std::uint8_t, sizeof(ShmBenchFormat)> buffer{};
+        communicator.respondView(SentMessage<ShmBenchFormat>(content()).serializeInto(buffer));
+    }
+};
+
+/* ―――――――――――――――― Benchmarks ―――――――――――――――― */
+
+/**
+ * @brief One request and its response per iteration, against a listener on another thread
+ */
+static void bmShmRoundTrip(benchmark::State& state) {
+    auto segment = ShmSegment<>::create("/libcmd-bench-" + std::to_string(::getpid()));
+    ShmListener<Handler<ShmBenchCommand>> listener(segment.channel());
+    std::thread loop([&listener] { listener.start(); });
+    const NullCommunicator upstream;
+    const ShmClient client(segment.channel(), upstream);
+    const serialized_message_t request = SentMessage<ShmBenchFormat>({.id = 0x01, .op = 1, .arg = 2}).serialize();
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        auto status = client.requestView(request, [&bytes](const std::span<const std::uint8_t> response) {
+            bytes += response.size();
+        });
+        benchmark::DoNotOptimize(status);
+    }
+    benchmark::DoNotOptimize(bytes);
+    state.SetItemsProcessed(state.iterations());
+    listener.stop();
+    loop.join();
+}
+
+BENCHMARK(bmShmRoundTrip)->UseRealTime();
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/** @brief Cache line size used to keep independently written atomics apart */
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Lock-free bounded multi-producer multi-consumer queue (Vyukov's sequenced ring)
+ *
+ * Every slot carries a sequence number telling producers and consumers whose turn it is, so a push
+ * or pop is a single compare-exchange on the shared position plus one store on the slot. Elements
+ * are built and consumed in place (tryEmplace() / tryConsume()), which lets large elements such as
+ * frame buffers travel through the queue without being copied twice.
+ *
+ * All storage lives inside the object: nothing is allocated after construction. It is also a valid
+ * (if slightly heavier) SPSC queue.
+ *
+ * @tparam T The element type, default constructible; slots are reused, never destroyed
+ * @tparam Capacity The number of slots, a power of two
+ */
+template <typename T, std::size_t Capacity>
+    requires std::is_default_constructible_v<T>
+class BoundedQueue
+{
+    static_assert(Capacity >= 2 && std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    /** @brief A slot and the sequence number saying whether it is free or filled */
+    struct alignas(CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T value{};
+    };
+
+    std::array<Slot, Capacity> _slots;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _enqueue_position{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _dequeue_position{0};
+
+  public:
+    BoundedQueue() noexcept {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Claims a free slot and fills it in place
+     *
+     * @param fill Callable invoked with a reference to the claimed slot's element; must not throw
+     * @return true if an element was pushed, false if the queue was full
+     */
+    template <typename F>
+        requires std::invocable<F&, T&>
+    bool tryEmplace(F&& fill) noexcept {
+        std::size_t position = _enqueue_position.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = _slots[position & MASK];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+            if (difference == 0) {
+                if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    fill(slot.value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false; // full
+            }
+            else {
+                position = _enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Claims the oldest filled slot and consumes it in place
+     *
+     * @param consume Callable invoked with a reference to the claimed slot's element; must not throw
+     * @return true if an element was popped, false if the queue was empty
+     */
+    template <typename F>
+        requires std::invocable<F&, T&>
+    bool tryConsume(F&& consume) noexcept {
+        std::size_t position = _dequeue_position.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = _slots[position & MASK];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (difference == 0) {
+                if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    consume(slot.value);
+                    slot.sequence.store(position + Capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false; // empty
+            }
+            else {
+                position = _dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Consumes the oldest filled slot in place, only if a predicate accepts its element
+     *
+     * The predicate reads the element before the slot is claimed, which is only safe if no slot can be
+     * refilled meanwhile: call it from the single producer of the queue, other threads may still consume.
+     *
+     * @param accept Predicate invoked with the oldest element; must not throw
+     * @param consume Callable invoked with a reference to the claimed slot's element; must not throw
+     * @return true if an element was popped, false if the queue was empty or the oldest element refused
+     */
+    template <typename P, typename F>
+        requires std::predicate<P&, const T&> && std::invocable<F&, T&>
+    bool tryConsumeIf(P&& accept, F&& consume) noexcept {
+        std::size_t position = _dequeue_position.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = _slots[position & MASK];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (difference == 0) {
+                if (!accept(std::as_const(slot.value))) {
+                    return false;
+                }
+                if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    consume(slot.value);
+                    slot.sequence.store(position + Capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false; // empty
+            }
+            else {
+                position = _dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pushes a copy of value
+     * @return true if pushed, false if the queue was full
+     */
+    bool tryPush(const T& value) noexcept
+        requires std::is_nothrow_copy_assignable_v<T>
+    {
+        return tryEmplace([&value](T& slot) { slot = value; });
+    }
+
+    /**
+     * @brief Pops the oldest element into value
+     * @return true if popped, false if the queue was empty
+     */
+    bool tryPop(T& value) noexcept
+        requires std::is_nothrow_move_assignable_v<T>
+    {
+        return tryConsume([&value](T& slot) { value = std::move(slot); });
+    }
+
+    /**
+     * @brief Approximate number of queued elements, exact only when no push or pop is in progress
+     * @return std::size_t The number of elements
+     */
+    [[nodiscard]] std::size_t sizeApprox() const noexcept {
+        const std::size_t enqueued = _enqueue_position.load(std::memory_order_acquire);
+        const std::size_t dequeued = _dequeue_position.load(std::memory_order_acquire);
+        return enqueued >= dequeued ? enqueued - dequeued : 0;
+    }
+
+    /** @brief The number of slots */
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Capacity; }
+};
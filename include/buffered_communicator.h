@@ -0,0 +1,252 @@
+#pragma once
+
+#include "communication.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief When a BufferedCommunicator hands its buffered responses to the sink
+ *
+ * Whichever limit is reached first triggers the flush; flush() also sends everything at the end of a batch.
+ */
+struct BufferedFlushPolicy
+{
+    std::size_t max_bytes = 64 * 1024; ///< Flush once this many response bytes are buffered
+    std::size_t max_frames = 64;       ///< Flush once this many responses are buffered (one iovec each)
+    /** @brief Flush once the oldest buffered response is this old, checked by respond() and flushIfDue() */
+    std::chrono::steady_clock::duration max_delay = std::chrono::milliseconds(1);
+};
+
+/**
+ * @brief Counters of a BufferedCommunicator
+ */
+struct BufferedCommunicatorStats
+{
+    std::size_t responses = 0; ///< Responses sent, buffered or not
+    std::size_t flushes = 0;   ///< Calls to FrameSink::sendBatch(), i.e. scatter-gather writes
+    std::size_t bytes = 0;     ///< Response bytes sent
+};
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Communicator gathering responses and sending them to a FrameSink in scatter-gather batches
+ *
+ * Every respond() copies the response into a buffer; the buffer is handed to FrameSink::sendBatch()
+ * (one writev() or sendmmsg() with the POSIX sinks) when the flush policy says so, or when flush()
+ * is called at the end of a batch. A batch of N responses therefore costs one write instead of N.
+ * A response larger than max_bytes is sent on its own, after the buffered ones.
+ *
+ * Requests first flush the buffered responses, so the peer sees them in order, then go to the
+ * upstream communicator unchanged.
+ *
+ * The deadline is only checked when respond() or flushIfDue() runs: an idle transport loop should
+ * call flushIfDue() (or flush()) before blocking. Safe to call from several threads.
+ *
+ * Usage:
+ *     BufferedCommunicator communicator(socket_sink, upstream);
+ *     for (const serialized_message_view_t frame : frames) {
+ *         (void)MyHandler::execute(frame, communicator);
+ *     }
+ *     communicator.flush(); // end of batch
+ */
+class BufferedCommunicator final : public Communicator
+{
+    /** @brief A buffered response */
+    struct Pending
+    {
+        std::size_t offset; ///< Offset of the response in _bytes
+        std::size_t size;   ///< Size of the response
+    };
+
+    FrameSink& _sink;
+    const Communicator& _upstream;
+    const BufferedFlushPolicy _policy;
+    mutable std::mutex _mutex;
+    mutable std::vector<std::uint8_t> _bytes;
+    mutable std::vector<Pending> _pending;
+    mutable std::vector<std::span<const std::uint8_t>> _views;
+    mutable std::chrono::steady_clock::time_point _oldest{};
+    mutable BufferedCommunicatorStats _stats{};
+
+    /**
+     * @brief Hands every buffered response to the sink, with _mutex held
+     * The buffer is emptied even if the sink throws, the responses are then lost.
+     */
+    void flushLocked() const {
+        if (_pending.empty()) {
+            return;
+        }
+        _views.clear();
+        for (const Pending& pending : _pending) {
+            _views.emplace_back(_bytes.data() + pending.offset, pending.size);
+        }
+        _stats.flushes += 1;
+        _stats.bytes += _bytes.size();
+        const auto clear = [this] {
+            _bytes.clear();
+            _pending.clear();
+        };
+        try {
+            _sink.sendBatch(_views);
+        }
+        catch (...) {
+            clear();
+            throw;
+        }
+        clear();
+    }
+
+    /**
+     * @brief Whether the oldest buffered response reached the deadline, with _mutex held
+     * @param now The current time
+     * @return bool Whether the buffer should be flushed
+     */
+    [[nodiscard]] bool dueLocked(const std::chrono::steady_clock::time_point now) const noexcept {
+        return !_pending.empty() && now - _oldest >= _policy.max_delay;
+    }
+
+  public:
+    /**
+     * @brief Constructs the communicator
+     *
+     * @param sink Sink the responses are sent through
+     * @param upstream Communicator receiving request() calls
+     * @param policy When buffered responses are flushed
+     */
+    BufferedCommunicator(FrameSink& sink, const Communicator& upstream, const BufferedFlushPolicy policy = {})
+        : _sink(sink), _upstream(upstream), _policy(policy) {
+        _bytes.reserve(policy.max_bytes);
+        _pending.reserve(policy.max_frames);
+        _views.reserve(policy.max_frames);
+    }
+
+    BufferedCommunicator(const BufferedCommunicator&) = delete;
+    BufferedCommunicator& operator=(const BufferedCommunicator&) = delete;
+
+    /**
+     * @brief Flushes what is still buffered, errors of the sink are ignored
+     */
+    ~BufferedCommunicator() override {
+        try {
+            flush();
+        }
+        catch (...) { // NOLINT(bugprone-empty-catch) nowhere to report them from a destructor
+        }
+    }
+
+    void respond(const std::vector<std::uint8_t>& response) const override {
+        respondView(std::span<const std::uint8_t>(response));
+    }
+
+    /**
+     * @brief Buffers a response, flushing first or after according to the policy
+     * @param response The response message bytes, copied before returning
+     */
+    void respondView(const std::span<const std::uint8_t> response) const override {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const std::scoped_lock lock(_mutex);
+        _stats.responses += 1;
+        if (response.size() > _policy.max_bytes) {
+            flushLocked();
+            _stats.flushes += 1;
+            _stats.bytes += response.size();
+            const std::array<std::span<const std::uint8_t>, 1> single{response};
+            _sink.sendBatch(single);
+            return;
+        }
+        if (_bytes.size() + response.size() > _policy.max_bytes) {
+            flushLocked();
+        }
+        if (_pending.empty()) {
+            _oldest = now;
+        }
+        _pending.push_back({.offset = _bytes.size(), .size = response.size()});
+        _bytes.insert(_bytes.end(), response.begin(), response.end());
+        if (_pending.size() >= _policy.max_frames || dueLocked(now)) {
+            flushLocked();
+        }
+    }
+
+    /**
+     * @brief Flushes the buffered responses, then forwards the request upstream
+     *
+     * @param message The request message to send, only valid during the call
+     * @param handle_response_callback Callback invoked with each response
+     * @return REQUEST_STATUS The status of the upstream request
+     */
+    [[nodiscard]] REQUEST_STATUS requestView(
+        const std::span<const std::uint8_t> message, const response_callback_t handle_response_callback
+    ) const override {
+        flush();
+        return _upstream.requestView(message, handle_response_callback);
+    }
+
+    [[nodiscard]] REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& message, std::function<void(std::vector<uint8_t>)> handle_response_callback
+    ) const override {
+        flush();
+        return _upstream.request(message, std::move(handle_response_callback));
+    }
+
+    /**
+     * @brief Flushes the buffered responses, then starts the request upstream, see request()
+     *
+     * @param message The request message to send, only valid during the call
+     * @param completion Receives the responses and the final status
+     */
+    void startRequest(const std::span<const std::uint8_t> message, RequestCompletion& completion) const override {
+        flush();
+        _upstream.startRequest(message, completion);
+    }
+
+    /**
+     * @brief Sends every buffered response now, e.g. at the end of a batch
+     * @throws Whatever FrameSink::sendBatch() throws, the buffered responses are dropped then
+     */
+    void flush() const {
+        const std::scoped_lock lock(_mutex);
+        flushLocked();
+    }
+
+    /**
+     * @brief Flushes if the oldest buffered response reached the policy's deadline
+     * @return bool Whether a flush happened
+     */
+    bool flushIfDue() const {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const std::scoped_lock lock(_mutex);
+        if (!dueLocked(now)) {
+            return false;
+        }
+        flushLocked();
+        return true;
+    }
+
+    /**
+     * @brief Number of responses currently buffered
+     * @return std::size_t The number of responses
+     */
+    [[nodiscard]] std::size_t buffered() const {
+        const std::scoped_lock lock(_mutex);
+        return _pending.size();
+    }
+
+    /**
+     * @brief Copies the counters
+     * @return BufferedCommunicatorStats The counters
+     */
+    [[nodiscard]] BufferedCommunicatorStats stats() const {
+        const std::scoped_lock lock(_mutex);
+        return _stats;
+    }
+};
@@ -0,0 +1,525 @@
+#pragma once
+
+#include "communication.h"
+#include "handler.h"
+#include "message.h"
+#include "posix_helpers.h"
+#include "wire.h"
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace capture_helpers
+{
+/** @brief First bytes of a capture file */
+inline constexpr std::uint32_t MAGIC = 0x43444D43; // "CMDC" on the wire
+/** @brief Version of the record layout, bumped on incompatible changes */
+inline constexpr std::uint16_t VERSION = 1;
+
+/**
+ * @brief Header at the start of a capture file
+ */
+struct FileHeader
+{
+    le_u32_t magic;       ///< MAGIC
+    le_u16_t version;     ///< VERSION
+    le_u16_t record_size; ///< Size of a RecordHeader, so that readers can skip fields added later
+    le_u64_t origin_ns;   ///< Wall-clock time of the first possible record, in ns since the Unix epoch
+};
+static_assert(sizeof(FileHeader) == 16);
+
+/**
+ * @brief Header of each record, directly followed by the frame bytes
+ */
+struct RecordHeader
+{
+    le_u64_t at_ns; ///< Arrival time of the frame, in ns since FileHeader::origin_ns
+    le_u32_t size;  ///< Size of the frame, in bytes
+};
+static_assert(sizeof(RecordHeader) == 12);
+} // namespace capture_helpers
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief Counters of a CaptureWriter
+ */
+struct CaptureStats
+{
+    std::size_t records = 0; ///< Frames recorded, including those still buffered
+    std::size_t bytes = 0;   ///< Bytes recorded, headers included
+    std::size_t dropped = 0; ///< Frames lost: every buffered one when a write fails, see CaptureWriter::tryRecord()
+};
+
+/**
+ * @brief A frame read back from a capture
+ */
+struct CaptureRecord
+{
+    std::chrono::nanoseconds at;     ///< Arrival time of the frame, relative to CaptureReader::origin()
+    serialized_message_view_t frame; ///< The frame bytes, valid as long as the reader
+};
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Append-only log of the frames fed to a handler, with their arrival time
+ *
+ * The file holds a FileHeader, then one RecordHeader and the frame bytes per frame, back to back and
+ * with no padding: a capture is about 12 bytes bigger than the frames it holds. Records are buffered
+ * and written with one write() per buffer_bytes, so recording costs a memcpy on the hot path; a mutex
+ * serialises the threads recording into the same writer, and timestamps are taken under it so that
+ * records are always in time order. A process that dies loses its buffer, and at most a torn last
+ * record, which CaptureReader ignores.
+ *
+ * That one mutex also serialises the workers of a multi-threaded listener recording through a shared
+ * CapturingHandler: each frame holds it for a memcpy, and every buffer_bytes for a write(), during
+ * which the other workers wait. A smaller buffer bounds that stall, a writer per worker removes it.
+ *
+ * A default-constructed writer is closed and ignores frames until open(), so that a writer can be a
+ * global, referenced by CapturingHandler, and opened once the program knows where to write.
+ */
+class CaptureWriter final
+{
+    mutable std::mutex _mutex;
+    int _fd = -1;
+    std::size_t _buffer_bytes = 0;
+    std::vector<std::uint8_t> _buffer;
+    std::size_t _buffered = 0; ///< Records in _buffer, dropped if writing it fails
+    std::chrono::steady_clock::time_point _start;
+    CaptureStats _stats;
+
+    /**
+     * @brief Writes the buffer to the file, retrying short writes (mutex held)
+     * @throws std::system_error if the write fails, the buffer is then discarded and its records dropped
+     */
+    void flushLocked() {
+        std::size_t written = 0;
+        while (written < _buffer.size()) {
+            const ssize_t n = ::write(_fd, _buffer.data() + written, _buffer.size() - written);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                _buffer.clear();
+                _stats.dropped += std::exchange(_buffered, 0);
+                posix_helpers::throwErrno("write");
+            }
+            written += static_cast<std::size_t>(n);
+        }
+        _buffer.clear();
+        _buffered = 0;
+    }
+
+    /**
+     * @brief Appends a record to the buffer, flushing it once full (mutex held)
+     * @param frame The frame bytes
+     * @param at The arrival time, relative to the origin
+     */
+    void appendLocked(const serialized_message_view_t frame, const std::chrono::nanoseconds at) {
+        const capture_helpers::RecordHeader header{
+            .at_ns = static_cast<std::uint64_t>(at.count()),
+            .size = static_cast<std::uint32_t>(frame.size()),
+        };
+        const std::size_t offset = _buffer.size();
+        _buffer.resize(offset + sizeof(header) + frame.size());
+        std::memcpy(_buffer.data() + offset, &header, sizeof(header));
+        if (!frame.empty()) {
+            std::memcpy(_buffer.data() + offset + sizeof(header), frame.data(), frame.size());
+        }
+        ++_buffered;
+        ++_stats.records;
+        _stats.bytes += sizeof(header) + frame.size();
+        if (_buffer.size() >= _buffer_bytes) {
+            flushLocked();
+        }
+    }
+
+    /**
+     * @brief Closes the file after writing what is buffered (mutex held)
+     */
+    void closeLocked() noexcept {
+        if (_fd < 0) {
+            return;
+        }
+        try {
+            flushLocked();
+        }
+        catch (const std::system_error&) { // nothing to report it to, flushLocked() counted the lost tail
+        }
+        ::close(_fd);
+        _fd = -1;
+    }
+
+  public:
+    /** @brief Default buffer size, in bytes */
+    static constexpr std::size_t BUFFER_BYTES = 64 * 1024;
+
+    /**
+     * @brief Constructs a closed writer, see open()
+     */
+    CaptureWriter() = default;
+
+    /**
+     * @brief Constructs a writer and opens a capture, see open()
+     */
+    explicit CaptureWriter(const std::string& path, const std::size_t buffer_bytes = BUFFER_BYTES) {
+        open(path, buffer_bytes);
+    }
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    ~CaptureWriter() { close(); }
+
+    /**
+     * @brief Creates a capture file, replacing any file at path, and starts its clock
+     *
+     * @param path The file path
+     * @param buffer_bytes Bytes of records buffered before they are written
+     * @throws std::system_error if the file cannot be created or its header written
+     */
+    void open(const std::string& path, const std::size_t buffer_bytes = BUFFER_BYTES) {
+        const std::scoped_lock lock(_mutex);
+        closeLocked();
+        _fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+        if (_fd < 0) {
+            posix_helpers::throwErrno("open");
+        }
+        _buffer_bytes = buffer_bytes;
+        _buffer.reserve(buffer_bytes + sizeof(capture_helpers::RecordHeader));
+        _stats = {};
+        _start = std::chrono::steady_clock::now();
+        const auto origin = std::chrono::system_clock::now().time_since_epoch();
+        const capture_helpers::FileHeader header{
+            .magic = capture_helpers::MAGIC,
+            .version = capture_helpers::VERSION,
+            .record_size = sizeof(capture_helpers::RecordHeader),
+            .origin_ns = static_cast<std::uint64_t>(std::chrono::nanoseconds(origin).count()),
+        };
+        const auto* const bytes = reinterpret_cast<const std::uint8_t*>(&header);
+        _buffer.assign(bytes, bytes + sizeof(header));
+        try {
+            flushLocked();
+        }
+        catch (...) {
+            ::close(_fd);
+            _fd = -1;
+            throw;
+        }
+    }
+
+    /**
+     * @brief Writes what is buffered and closes the file, does nothing if closed
+     */
+    void close() noexcept {
+        const std::scoped_lock lock(_mutex);
+        closeLocked();
+    }
+
+    /**
+     * @brief Whether frames are being recorded
+     */
+    [[nodiscard]] bool isOpen() const noexcept {
+        const std::scoped_lock lock(_mutex);
+        return _fd >= 0;
+    }
+
+    /**
+     * @brief Records a frame, timestamped now; does nothing if closed
+     * @param frame The frame bytes (only read during the call)
+     * @throws std::system_error if writing a full buffer fails
+     */
+    void record(const serialized_message_view_t frame) {
+        const std::scoped_lock lock(_mutex);
+        if (_fd >= 0) {
+            appendLocked(frame, std::chrono::steady_clock::now() - _start);
+        }
+    }
+
+    /**
+     * @brief Records a frame with a given arrival time, e.g. a hardware timestamp; does nothing if closed
+     * @param frame The frame bytes (only read during the call)
+     * @param at The arrival time, relative to the open() call, not before that of the previous record
+     * @throws std::system_error if writing a full buffer fails
+     */
+    void record(const serialized_message_view_t frame, const std::chrono::nanoseconds at) {
+        const std::scoped_lock lock(_mutex);
+        if (_fd >= 0) {
+            appendLocked(frame, at);
+        }
+    }
+
+    /**
+     * @brief Records a frame, timestamped now, counting failures in CaptureStats::dropped instead of throwing
+     * @param frame The frame bytes (only read during the call)
+     * @return bool Whether the frame was recorded, or the writer is closed
+     */
+    bool tryRecord(const serialized_message_view_t frame) noexcept {
+        try {
+            record(frame);
+            return true;
+        }
+        catch (const std::system_error&) { // a failed write must not fail the execution, flushLocked() counted it
+            return false;
+        }
+        catch (...) { // nor a failed allocation, which loses this frame only
+            const std::scoped_lock lock(_mutex);
+            ++_stats.dropped;
+            return false;
+        }
+    }
+
+    /**
+     * @brief Writes what is buffered
+     * @throws std::system_error if the write fails
+     */
+    void flush() {
+        const std::scoped_lock lock(_mutex);
+        if (_fd >= 0) {
+            flushLocked();
+        }
+    }
+
+    /**
+     * @brief Counters since open()
+     * @return CaptureStats The counters
+     */
+    [[nodiscard]] CaptureStats stats() const {
+        const std::scoped_lock lock(_mutex);
+        return _stats;
+    }
+};
+
+/**
+ * @brief Read-only memory mapping of a capture written by CaptureWriter
+ *
+ * The file is validated and its complete records counted once at construction; iterating then reads
+ * the records in place, each frame being a view into the mapping, so replaying a capture copies and
+ * allocates nothing. A torn last record, left by a writer that died, is ignored (see truncatedBytes()).
+ *
+ * Usage:
+ *     const CaptureReader capture("frames.cap");
+ *     for (const CaptureRecord& record : capture) {
+ *         (void)Handler<Commands...>::execute(record.frame, communicator);
+ *     }
+ */
+class CaptureReader final
+{
+    const std::uint8_t* _data = nullptr;
+    std::size_t _size = 0;
+    std::size_t _end = 0;
+    std::size_t _count = 0;
+    std::size_t _record_size = 0;
+    std::uint64_t _origin_ns = 0;
+
+    [[noreturn]] static void invalid() {
+        errno = EPROTO;
+        posix_helpers::throwErrno("open: not a capture file");
+    }
+
+  public:
+    /**
+     * @brief Forward iterator over the records of a capture
+     */
+    class iterator
+    {
+        const CaptureReader* _reader = nullptr;
+        std::size_t _offset = 0;
+
+      public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag; // dereferences to a value, not a reference
+        using value_type = CaptureRecord;
+        using difference_type = std::ptrdiff_t;
+        using reference = CaptureRecord;
+        using pointer = void;
+
+        iterator() = default;
+        iterator(const CaptureReader* reader, const std::size_t offset) noexcept : _reader(reader), _offset(offset) {}
+
+        [[nodiscard]] reference operator*() const noexcept {
+            capture_helpers::RecordHeader header{};
+            std::memcpy(&header, _reader->_data + _offset, sizeof(header));
+            return {
+                .at = std::chrono::nanoseconds(header.at_ns.value()),
+                .frame = {_reader->_data + _offset + _reader->_record_size, header.size.value()},
+            };
+        }
+
+        iterator& operator++() noexcept {
+            capture_helpers::RecordHeader header{};
+            std::memcpy(&header, _reader->_data + _offset, sizeof(header));
+            _offset += _reader->_record_size + header.size.value();
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const iterator& other) const noexcept { return _offset == other._offset; }
+    };
+
+    /**
+     * @brief Maps a capture file
+     * @param path The file path
+     * @throws std::system_error if the file cannot be mapped, or is not a capture of this version (EPROTO)
+     */
+    explicit CaptureReader(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            posix_helpers::throwErrno("open");
+        }
+        struct stat status{};
+        if (::fstat(fd, &status) < 0) {
+            ::close(fd);
+            posix_helpers::throwErrno("fstat");
+        }
+        _size = static_cast<std::size_t>(status.st_size);
+        if (_size < sizeof(capture_helpers::FileHeader)) {
+            ::close(fd);
+            invalid();
+        }
+        void* const memory = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            posix_helpers::throwErrno("mmap");
+        }
+        _data = static_cast<const std::uint8_t*>(memory);
+        ::madvise(memory, _size, MADV_WILLNEED);
+
+        capture_helpers::FileHeader header{};
+        std::memcpy(&header, _data, sizeof(header));
+        if (header.magic != capture_helpers::MAGIC || header.version != capture_helpers::VERSION
+            || header.record_size < sizeof(capture_helpers::RecordHeader)) {
+            ::munmap(memory, _size);
+            invalid();
+        }
+        _record_size = header.record_size;
+        _origin_ns = header.origin_ns;
+
+        _end = sizeof(header);
+        while (_size - _end >= _record_size) {
+            capture_helpers::RecordHeader record{};
+            std::memcpy(&record, _data + _end, sizeof(record));
+            if (_size - _end - _record_size < record.size) {
+                break;
+            }
+            _end += _record_size + record.size;
+            ++_count;
+        }
+    }
+
+    CaptureReader(CaptureReader&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)), _end(other._end),
+          _count(other._count), _record_size(other._record_size), _origin_ns(other._origin_ns) {}
+    CaptureReader& operator=(CaptureReader&&) = delete;
+
+    ~CaptureReader() {
+        if (_data != nullptr) {
+            ::munmap(const_cast<std::uint8_t*>(_data), _size);
+        }
+    }
+
+    [[nodiscard]] iterator begin() const noexcept { return {this, sizeof(capture_helpers::FileHeader)}; }
+    [[nodiscard]] iterator end() const noexcept { return {this, _end}; }
+
+    /**
+     * @brief Number of complete records
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return _count; }
+
+    /**
+     * @brief Whether the capture holds no complete record
+     */
+    [[nodiscard]] bool empty() const noexcept { return _count == 0; }
+
+    /**
+     * @brief Bytes after the last complete record, left by a torn write
+     */
+    [[nodiscard]] std::size_t truncatedBytes() const noexcept { return _size - _end; }
+
+    /**
+     * @brief Wall-clock time the record timestamps are relative to
+     */
+    [[nodiscard]] std::chrono::system_clock::time_point origin() const noexcept {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(_origin_ns))
+        );
+    }
+};
+static_assert(std::forward_iterator<CaptureReader::iterator>);
+
+/**
+ * @brief Handler recording every frame into a CaptureWriter before executing it with HandlerT
+ *
+ * Frames are recorded as received, malformed ones included, so that replaying the capture feeds
+ * HandlerT exactly what it was fed. A failed write is counted in CaptureStats::dropped and never
+ * fails the execution.
+ *
+ * Usage:
+ *     inline CaptureWriter capture; // opened by main() when capturing is requested
+ *     using RecordedHandler = CapturingHandler<Handler<Commands...>, capture>;
+ *
+ * @tparam HandlerT The handler, e.g. Handler<Commands...>
+ * @tparam Writer The writer, shared by every thread executing frames
+ */
+template <typename HandlerT, CaptureWriter& Writer> class CapturingHandler final
+{
+  public:
+    /** @brief Type alias for the result of an execution */
+    using execute_result_t = typename HandlerT::execute_result_t;
+
+    /**
+     * @brief Records a frame, then executes it
+     * @tparam Mode How HandlerT looks up the command ID
+     * @param data Raw byte data containing the command ID and payload (only read during the call)
+     * @param communicator The Communicator instance to handle responses and requests
+     * @return execute_result_t The status of the execution
+     */
+    template <HANDLER_DISPATCH_MODE Mode = HANDLER_DISPATCH_MODE::JUMP_TABLE>
+    [[nodiscard]] static execute_result_t
+    execute(const serialized_message_view_t data, const Communicator& communicator) noexcept {
+        Writer.tryRecord(data);
+        return HandlerT::template execute<Mode>(data, communicator);
+    }
+
+    /**
+     * @brief Whether a frame is for an idempotent command, see BasicHandler::idempotent()
+     */
+    [[nodiscard]] static bool idempotent(const serialized_message_view_t data) noexcept
+        requires requires { HandlerT::idempotent(data); }
+    {
+        return HandlerT::idempotent(data);
+    }
+
+    /**
+     * @brief Route index of a frame, see Router::shardOf()
+     */
+    [[nodiscard]] static std::size_t shardOf(const serialized_message_view_t data) noexcept
+        requires requires { HandlerT::shardOf(data); }
+    {
+        return HandlerT::shardOf(data);
+    }
+};
+#endif
@@ -2,6 +2,7 @@
 
 #include "communication.h"
 #include "message.h"
+#include <cstring>
 
 /**
  * @brief Abstract base class representing a command that can be executed
@@ -21,10 +22,60 @@ template <MessageFormatT CommandMessageFormat> class Command : public ReceivedMe
     /**
      * @brief Constructs a Command from raw byte input
      *
-     * @param content Raw byte content of the command message
+     * @param content Raw byte content of the command message (a std::vector converts implicitly)
      * @throws std::runtime_error if content size is invalid
      */
-    explicit Command(const std::vector<std::uint8_t>& content) : ReceivedMessage<CommandMessageFormat>(content) {}
+    explicit Command(serialized_message_view_t content) : ReceivedMessage<CommandMessageFormat>(content) {}
+
+    /**
+     * @brief Executes the command associated with this message
+     * @param communicator The Communicator instance to handle responses and requests
+     */
+    virtual void execute(const Communicator& communicator) const = 0;
+};
+
+/**
+ * @brief Concept for commands marked idempotent: their responses only depend on the bytes of their frame
+ *
+ * Commands opt in by declaring `static constexpr bool IDEMPOTENT = true;`. The responses of such
+ * commands may be replayed from a cache instead of executing them again, see MemoizingHandler.
+ *
+ * @tparam C The command type to be checked
+ */
+template <typename C> concept IdempotentCommandT = requires { requires C::IDEMPOTENT; };
+
+/**
+ * @brief Abstract base class of commands reading their fields in place, see ReceivedMessageView
+ *
+ * Same interface as Command, but the frame is not copied at construction: fields are read from the
+ * receive buffer when the command accesses them, which saves the copy of large frames of which a
+ * command only reads a few fields.
+ *
+ * Usage:
+ *     class ConfigureCommand final : public ViewCommand<ConfigFormat> {
+ *       public:
+ *         explicit ConfigureCommand(serialized_message_view_t content) : ViewCommand(content) {}
+ *         void execute(const Communicator& communicator) const override { apply(get<&ConfigFormat::baudrate>()); }
+ *     };
+ *
+ * @tparam CommandMessageFormat The format of the command message (received)
+ */
+template <MessageFormatT CommandMessageFormat> class ViewCommand : public ReceivedMessageView<CommandMessageFormat>
+{
+  public:
+    /** @brief Type alias for the input message type */
+    using input_message_t = ReceivedMessageView<CommandMessageFormat>;
+
+    /**
+     * @brief Constructs a ViewCommand over raw byte input
+     *
+     * @param content Raw byte content of the command message, must outlive the command
+     * @throws MessageLengthError if content size is invalid
+     * @throws MessageWrongIdError if content ID is invalid
+     */
+    explicit ViewCommand(serialized_message_view_t content) : ReceivedMessageView<CommandMessageFormat>(content) {}
+
+    virtual ~ViewCommand() = default;
 
     /**
      * @brief Executes the command associated with this message
@@ -32,3 +83,130 @@ template <MessageFormatT CommandMessageFormat> class Command : public ReceivedMe
      */
     virtual void execute(const Communicator& communicator) const = 0;
 };
+
+/**
+ * @brief Base class for commands executed without virtual dispatch (CRTP)
+ *
+ * Unlike Command, this class has no virtual member at all (no vptr): the Handler
+ * knows the concrete type at compile-time, so execute() resolves statically and
+ * the derived run() can be inlined into the dispatcher. Derived classes implement
+ * `void run(const Communicator&) const` and a constructor forwarding the raw bytes.
+ *
+ * Usage:
+ *     class MyCommand final : public StaticCommand<MyCommand, MyFormat> {
+ *       public:
+ *         explicit MyCommand(serialized_message_view_t content) : StaticCommand(content) {}
+ *         void run(const Communicator& communicator) const { ... }
+ *     };
+ *
+ * Use Command instead when commands must be handled through a base pointer (e.g. plugins).
+ *
+ * @tparam Derived The derived command type
+ * @tparam CommandMessageFormat The format of the command message (received)
+ */
+template <typename Derived, MessageFormatT CommandMessageFormat> class StaticCommand
+{
+  protected:
+    CommandMessageFormat _content; ///< Structured content of the command message
+    [[no_unique_address]] message_helpers::payload_storage_t<CommandMessageFormat> _payload{}; ///< Trailing payload
+
+    /**
+     * @brief Constructs a StaticCommand from raw byte input
+     *
+     * @param content Raw byte content of the command message (only read during construction)
+     * @throws MessageLengthError if content size is invalid
+     * @throws MessageWrongIdError if content ID is invalid
+     */
+    explicit StaticCommand(serialized_message_view_t content)
+        requires std::is_trivially_copyable_v<CommandMessageFormat>
+    {
+        Message<CommandMessageFormat>::throwIfInvalid(content);
+        message_helpers::loadContent(content.data(), _content);
+        if constexpr (TrailingPayloadFormatT<CommandMessageFormat>) {
+            _payload = content.subspan(message_helpers::wireSize<CommandMessageFormat>());
+        }
+    }
+
+    /**
+     * @brief Constructs a StaticCommand with default content, see Message(std::in_place_t, serialized_message_view_t)
+     *
+     * @param content Raw byte content of the command message
+     * @throws MessageLengthError if content size is invalid
+     * @throws MessageWrongIdError if content ID is invalid
+     */
+    StaticCommand(std::in_place_t, serialized_message_view_t content) {
+        Message<CommandMessageFormat>::throwIfInvalid(content);
+        _content = CommandMessageFormat{}; // default-initialize all fields
+        _content.id = CommandMessageFormat::ID;
+        if constexpr (TrailingPayloadFormatT<CommandMessageFormat>) {
+            _payload = content.subspan(message_helpers::wireSize<CommandMessageFormat>());
+        }
+    }
+
+  public:
+    /** @brief Type alias for the message format */
+    using message_format_t = CommandMessageFormat;
+    /** @brief Type alias for the input message type (the command is its own input message) */
+    using input_message_t = StaticCommand;
+
+    /**
+     * @brief Checks that raw bytes have the size and ID of the command format, see Message::validate()
+     *
+     * @param content Raw byte content of the command message
+     * @return Result<void, ParseError> Success, or the reason the content is malformed
+     */
+    [[nodiscard]] static Result<void, ParseError> validate(const serialized_message_view_t content) noexcept {
+        return Message<CommandMessageFormat>::validate(content);
+    }
+
+    /**
+     * @brief Exception-free factory, see Message::tryParse()
+     *
+     * @param content Raw byte content of the command message
+     * @return Result<Derived, ParseError> The command, or the reason the content is malformed
+     */
+    [[nodiscard]] static Result<Derived, ParseError> tryParse(const serialized_message_view_t content) {
+        if (const Result checked = validate(content); !checked) {
+            return Result<Derived, ParseError>(UNEXPECT, checked.error());
+        }
+        return Result<Derived, ParseError>(EXPECT, Derived(content));
+    }
+
+    /**
+     * @brief Accessor for the structured content of the command message
+     *
+     * @return const CommandMessageFormat& Reference to the structured content
+     */
+    [[nodiscard]] const CommandMessageFormat& content() const { return _content; }
+
+    /**
+     * @brief Accessor for the trailing payload of variable-length formats, see Message::payload()
+     *
+     * @return serialized_message_view_t View over the bytes following the fixed header
+     */
+    [[nodiscard]] serialized_message_view_t payload() const
+        requires TrailingPayloadFormatT<CommandMessageFormat>
+    {
+        return _payload;
+    }
+
+    /**
+     * @brief Serializes the command content into a byte vector
+     *
+     * @return serialized_message_t Serialized byte vector of the command content
+     */
+    [[nodiscard]] serialized_message_t serialize() const {
+        serialized_message_t serialized(message_helpers::wireSize<CommandMessageFormat>());
+        message_helpers::storeContent(_content, serialized.data());
+        if constexpr (TrailingPayloadFormatT<CommandMessageFormat>) {
+            serialized.insert(serialized.end(), _payload.begin(), _payload.end());
+        }
+        return serialized;
+    }
+
+    /**
+     * @brief Executes the command associated with this message (statically bound to Derived::run())
+     * @param communicator The Communicator instance to handle responses and requests
+     */
+    void execute(const Communicator& communicator) const { static_cast<const Derived&>(*this).run(communicator); }
+};
@@ -1,8 +1,19 @@
 #pragma once
+#include "function_ref.h"
+#include <atomic>
+#include <concepts>
+#include <coroutine>
 #include <cstdint>
 #include <functional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+class RequestCompletion;
+template <typename F> class AsyncRequest;
+
 /**
  * @brief This class should be passed to Command::execute() to handle responding and requesting on its own.
  */
@@ -20,6 +31,7 @@ class Communicator
         ERROR_TIMEOUT = 1,
         ERROR_COMMUNICATION = 2,
         ERROR_UNKNOWN = 3,
+        ERROR_BUSY = 4, ///< Too many requests in flight, nothing was sent
     };
 
     /**
@@ -27,6 +39,18 @@ class Communicator
      */
     virtual void respond(const std::vector<std::uint8_t>&) const = 0;
 
+    /**
+     * @brief Sends a response message stored in a caller-owned buffer (e.g. Message::serializeInto())
+     *
+     * The default implementation copies the bytes into a std::vector and calls respond().
+     * Transports override it to write straight from the buffer, without allocating.
+     *
+     * @param response The response message bytes, only valid during the call
+     */
+    virtual void respondView(const std::span<const std::uint8_t> response) const {
+        respond(std::vector<std::uint8_t>(response.begin(), response.end()));
+    }
+
     /**
      * @brief Sends a request message and handles each response via a callback
      *
@@ -38,6 +62,31 @@ class Communicator
         const std::vector<std::uint8_t>& message, std::function<void(std::vector<uint8_t>)> handle_response_callback
     ) const = 0;
 
+    /** @brief Type alias for a non-owning callback receiving each response as a view */
+    using response_callback_t = FunctionRef<void(std::span<const std::uint8_t>)>;
+
+    /**
+     * @brief Sends a request message and handles each response via a non-owning callback, without allocating
+     *
+     * The default implementation copies the message and each response and forwards to request() above.
+     * Transports override it to hand out views over their receive buffers instead.
+     *
+     * @param message The request message to send, only valid during the call
+     * @param handle_response_callback Callback invoked with each response, each view only valid during its call
+     * @return EXECUTE_STATUS The status of the request execution
+     */
+    [[nodiscard]] virtual REQUEST_STATUS
+    requestView(const std::span<const std::uint8_t> message, const response_callback_t handle_response_callback) const {
+        return request(
+            std::vector<std::uint8_t>(message.begin(), message.end()),
+            std::function<void(std::vector<std::uint8_t>)>(
+                [handle_response_callback](const std::vector<std::uint8_t>& raw_response) {
+                    handle_response_callback(raw_response);
+                }
+            )
+        );
+    }
+
     /**
      * @brief Sends a request message and collects all responses into a vector
      *
@@ -47,13 +96,204 @@ class Communicator
      */
     [[nodiscard]] REQUEST_STATUS
     request(const std::vector<std::uint8_t>& message, std::vector<std::vector<std::uint8_t>>& responses) const {
-        const std::function<void(std::vector<std::uint8_t>)> callback(
-            [&responses](const std::vector<std::uint8_t>& raw_response) { responses.push_back(raw_response); }
+        return requestView(
+            std::span<const std::uint8_t>(message),
+            [&responses](const std::span<const std::uint8_t> raw_response) {
+                responses.emplace_back(raw_response.begin(), raw_response.end());
+            }
         );
-        return request(message, callback);
+    }
+
+    /**
+     * @brief Sends a request message and returns without waiting for its responses
+     *
+     * The transport calls completion.deliver() with each response, then completion.complete() exactly once,
+     * from any thread. The default implementation runs the blocking request() above and completes
+     * before returning; asynchronous transports override it to keep many requests in flight.
+     *
+     * @param message The request message to send, only valid during the call
+     * @param completion Receives the responses and the final status, outlives the request
+     */
+    virtual void startRequest(std::span<const std::uint8_t> message, RequestCompletion& completion) const;
+
+    /**
+     * @brief Sends a request message and returns an awaitable completing with the request status
+     *
+     * The request is sent immediately, so requests started one after the other are all in flight
+     * before the first co_await:
+     *     auto first = communicator.asyncRequest(message_a, on_response);
+     *     auto second = communicator.asyncRequest(message_b, on_response);
+     *     const REQUEST_STATUS status_a = co_await first; // both round trips overlap
+     *     const REQUEST_STATUS status_b = co_await second;
+     *
+     * @param message The request message to send, only valid during the call
+     * @param handle_response_callback Callable invoked with each response, each view only valid during its call
+     * @return AsyncRequest The awaitable, to be awaited (or destroyed, which waits) before its callable dies
+     */
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&, std::span<const std::uint8_t>>
+    [[nodiscard]] AsyncRequest<std::decay_t<F>>
+    asyncRequest(const std::span<const std::uint8_t> message, F&& handle_response_callback) const {
+        return AsyncRequest<std::decay_t<F>>(*this, message, std::forward<F>(handle_response_callback));
     }
 };
 
+/**
+ * @brief Receiving end of a request started with Communicator::startRequest()
+ *
+ * A completion is pending until complete() is called, and can be awaited once by a coroutine,
+ * which is resumed on the thread calling complete().
+ */
+class RequestCompletion
+{
+    enum class STATE : std::uint8_t
+    {
+        PENDING = 0,
+        AWAITING = 1,
+        DONE = 2,
+    };
+
+    std::atomic<STATE> _state{STATE::PENDING};
+    std::coroutine_handle<> _continuation;
+    Communicator::REQUEST_STATUS _status = Communicator::REQUEST_STATUS::ERROR_UNKNOWN;
+
+  protected:
+    /**
+     * @brief Handles one response of the request
+     * @param response The response message bytes, only valid during the call
+     */
+    virtual void onResponse(std::span<const std::uint8_t> response) = 0;
+
+    /**
+     * @brief Blocks until complete() was called, for destructors of completions that were never awaited
+     */
+    void waitUntilDone() const noexcept {
+        // Spins rather than waits on _state: complete() must not touch the object once it is DONE
+        while (_state.load(std::memory_order_acquire) != STATE::DONE) {
+            std::this_thread::yield();
+        }
+    }
+
+  public:
+    RequestCompletion() = default;
+    RequestCompletion(const RequestCompletion&) = delete;
+    RequestCompletion& operator=(const RequestCompletion&) = delete;
+    virtual ~RequestCompletion() = default;
+
+    /**
+     * @brief Delivers one response, called by the transport before complete(), never concurrently
+     * @param response The response message bytes, only valid during the call
+     */
+    void deliver(const std::span<const std::uint8_t> response) { onResponse(response); }
+
+    /**
+     * @brief Completes the request, resuming the awaiting coroutine if there is one
+     *
+     * Called exactly once by the transport; the completion may be destroyed as soon as it returns.
+     *
+     * @param status The status of the request
+     */
+    void complete(const Communicator::REQUEST_STATUS status) noexcept {
+        _status = status;
+        if (_state.exchange(STATE::DONE, std::memory_order_acq_rel) == STATE::AWAITING) {
+            _continuation.resume();
+        }
+    }
+
+    /**
+     * @brief Whether complete() was called
+     * @return bool True once the request completed
+     */
+    [[nodiscard]] bool done() const noexcept { return _state.load(std::memory_order_acquire) == STATE::DONE; }
+
+    /**
+     * @brief The status of the request, meaningful once done()
+     * @return REQUEST_STATUS The status passed to complete()
+     */
+    [[nodiscard]] Communicator::REQUEST_STATUS status() const noexcept { return _status; }
+
+    /**
+     * @brief Awaiter suspending the awaiting coroutine until the request completes
+     */
+    class Awaiter
+    {
+        RequestCompletion& _completion;
+
+      public:
+        explicit Awaiter(RequestCompletion& completion) noexcept : _completion(completion) {}
+
+        [[nodiscard]] bool await_ready() const noexcept { return _completion.done(); }
+
+        /**
+         * @brief Registers the awaiting coroutine, unless the request completed in the meantime
+         * @param awaiting The awaiting coroutine
+         * @return bool False if the request already completed and awaiting continues right away
+         */
+        [[nodiscard]] bool await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+            _completion._continuation = awaiting;
+            STATE expected = STATE::PENDING;
+            return _completion._state.compare_exchange_strong(
+                expected, STATE::AWAITING, std::memory_order_release, std::memory_order_acquire
+            );
+        }
+
+        /**
+         * @brief The status of the completed request
+         * @return REQUEST_STATUS The status passed to complete()
+         */
+        [[nodiscard]] Communicator::REQUEST_STATUS await_resume() const noexcept { return _completion.status(); }
+    };
+
+    /**
+     * @brief Awaits the completion, at most once
+     * @return Awaiter The awaiter
+     */
+    [[nodiscard]] Awaiter operator co_await() noexcept { return Awaiter(*this); }
+};
+
+/**
+ * @brief Awaitable request returned by Communicator::asyncRequest(), owning its response callable
+ *
+ * Neither copyable nor movable, since the transport holds a reference until the request completes.
+ * Destroying it before completion blocks until the transport completes it.
+ *
+ * @tparam F The response callable type
+ */
+template <typename F> class AsyncRequest final : public RequestCompletion
+{
+    F _handle_response_callback;
+
+    void onResponse(const std::span<const std::uint8_t> response) override { _handle_response_callback(response); }
+
+  public:
+    /**
+     * @brief Starts the request
+     *
+     * @param communicator The communicator sending the request
+     * @param message The request message to send, only valid during the call
+     * @param handle_response_callback Callable invoked with each response
+     */
+    template <typename G>
+    AsyncRequest(
+        const Communicator& communicator, const std::span<const std::uint8_t> message, G&& handle_response_callback
+    )
+        : _handle_response_callback(std::forward<G>(handle_response_callback)) {
+        communicator.startRequest(message, *this);
+    }
+
+    AsyncRequest(const AsyncRequest&) = delete;
+    AsyncRequest& operator=(const AsyncRequest&) = delete;
+
+    ~AsyncRequest() override { waitUntilDone(); }
+};
+
+inline void
+Communicator::startRequest(const std::span<const std::uint8_t> message, RequestCompletion& completion) const {
+    completion.complete(requestView(message, [&completion](const std::span<const std::uint8_t> response) {
+        completion.deliver(response);
+    }));
+}
+
 /**
  * @brief Abstract base class for communication interfaces
  *
@@ -69,3 +309,52 @@ class Listener
      */
     virtual void start() = 0;
 };
+
+/**
+ * @brief Interface for transports delivering already delimited frames (see CobsFramer) to a Listener
+ */
+class FrameSource
+{
+  public:
+    virtual ~FrameSource() = default;
+
+    /** @brief Type alias for a non-owning callback receiving each frame as a view */
+    using frame_callback_t = FunctionRef<void(std::span<const std::uint8_t>)>;
+
+    /**
+     * @brief Blocks until the transport has data, then delivers every complete frame it holds
+     *
+     * @param on_frame Callback invoked with each frame, each view only valid during its call
+     * @return true while the transport is open, false once it is closed and no frame is left
+     */
+    [[nodiscard]] virtual bool receive(frame_callback_t on_frame) = 0;
+};
+
+/**
+ * @brief Interface for transports sending whole frames, delimiting them as needed (see cobsEncode())
+ */
+class FrameSink
+{
+  public:
+    virtual ~FrameSink() = default;
+
+    /**
+     * @brief Sends one frame, safe to call from several threads
+     * @param frame The frame bytes, only valid during the call
+     */
+    virtual void send(std::span<const std::uint8_t> frame) = 0;
+
+    /**
+     * @brief Sends several frames in order, safe to call from several threads
+     *
+     * The default implementation calls send() for each frame. Transports override it to hand the
+     * whole batch to the kernel at once (see FdStreamSink and DatagramSocketSink).
+     *
+     * @param frames The frames, each only valid during the call
+     */
+    virtual void sendBatch(const std::span<const std::span<const std::uint8_t>> frames) {
+        for (const std::span<const std::uint8_t> frame : frames) {
+            send(frame);
+        }
+    }
+};
@@ -0,0 +1,469 @@
+#pragma once
+
+#include "bounded_queue.h"
+#include "communication.h"
+#include "handler.h"
+#include "message.h"
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief How ConcurrentListener picks the worker executing a frame
+ */
+enum class WORKER_AFFINITY : std::uint8_t
+{
+    ROUND_ROBIN = 0, ///< Spread frames evenly, no ordering guarantee between frames
+    COMMAND_ID = 1,  ///< Same frame key, same worker: frames of one command execute in arrival order
+    SHARD = 2,       ///< Same Router route, same worker (HandlerT::shardOf()), else as COMMAND_ID
+};
+
+/**
+ * @brief What ConcurrentListener does with a frame whose worker queue is at its admission limit
+ */
+enum class OVERLOAD_POLICY : std::uint8_t
+{
+    BLOCK = 0,       ///< Wait for the worker to catch up, pushing back on the transport
+    REJECT = 1,      ///< Shed the new frame
+    DROP_OLDEST = 2, ///< Shed the oldest queued frame for the new one, or the new one if the oldest has priority
+};
+
+/**
+ * @brief Key of the frames of ConcurrentListener, matched by WORKER_AFFINITY::COMMAND_ID and priority_ids
+ *
+ * The command ID read by HandlerT::frameId() where the handler exposes it (Handler does, one- and
+ * wide-ID alike), else the leading byte of the frame, e.g. the route address behind a Router: all the
+ * commands of one route then share a key. Frames shorter than the key have key 0.
+ */
+using frame_key_t = command_id_t;
+
+/**
+ * @brief Callback receiving each shed frame and its ERROR_OVERLOADED error, on the reader thread
+ *
+ * The error carries the command ID when the handler exposes frameId() (Handler does), else 0. An
+ * exception thrown by the callback is swallowed, so that it cannot stop the reader loop.
+ */
+using shed_callback_t = std::function<void(serialized_message_view_t frame, const HandlerExecuteError& error)>;
+
+/**
+ * @brief Configuration of a ConcurrentListener
+ */
+struct ConcurrentListenerConfig
+{
+    std::size_t workers = 1;                                 ///< Number of worker threads, at least 1
+    WORKER_AFFINITY affinity = WORKER_AFFINITY::ROUND_ROBIN; ///< Frame to worker assignment
+    std::vector<int> cores{}; ///< Core of worker i is cores[i % cores.size()], empty disables pinning
+    OVERLOAD_POLICY overload = OVERLOAD_POLICY::BLOCK; ///< Frames past the admission limit
+    std::size_t shed_depth = 0; ///< Admission limit of a worker queue, 0 (or above) for the queue capacity
+    std::vector<frame_key_t> priority_ids{}; ///< Keys of frames admitted up to the full queue, never shed
+    shed_callback_t on_shed{};                ///< Notified of every shed frame, e.g. to answer it with an error
+};
+
+/**
+ * @brief Counters of a ConcurrentListener, read with relaxed ordering
+ */
+struct ConcurrentListenerStats
+{
+    std::size_t received = 0;  ///< Frames read from the source
+    std::size_t executed = 0;  ///< Frames executed successfully
+    std::size_t failed = 0;    ///< Frames whose execution returned an error
+    std::size_t oversized = 0; ///< Frames dropped because they exceed the slot size
+    std::size_t rejected = 0;  ///< New frames shed, by REJECT or by DROP_OLDEST in front of a priority frame
+    std::size_t dropped = 0;   ///< Queued frames shed by OVERLOAD_POLICY::DROP_OLDEST
+    std::size_t queued = 0;    ///< Frames waiting in the worker queues now
+    std::size_t peak_depth = 0; ///< Deepest worker queue met by an incoming frame
+};
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Listener reading frames from a FrameSource and executing them on a pool of worker threads
+ *
+ * start() runs the reader loop on the calling thread: each frame is copied into a fixed slot of
+ * the chosen worker's lock-free queue, and the worker runs HandlerT::execute() on it. When the queue
+ * of a worker reaches its admission limit (ConcurrentListenerConfig::shed_depth) the reader waits
+ * for room, pushing back on the transport, or sheds frames according to the OVERLOAD_POLICY, so that
+ * a slow downstream bounds the queueing delay instead of stalling the transport.
+ * Idle workers sleep on an atomic wait and are only woken when they actually sleep, so a loaded
+ * pool does not pay a syscall per frame.
+ *
+ * The Communicator is shared by all workers and must be safe to call concurrently.
+ *
+ * @tparam HandlerT The handler, e.g. Handler<Commands...>
+ * @tparam MaxFrameSize The size of a queue slot, longer frames are dropped
+ * @tparam QueueCapacity The slots per worker queue, a power of two
+ */
+template <typename HandlerT, std::size_t MaxFrameSize = 256, std::size_t QueueCapacity = 1024>
+class ConcurrentListener final : public Listener
+{
+    /** @brief A queued frame */
+    struct FrameSlot
+    {
+        std::size_t size = 0;
+        std::array<std::uint8_t, MaxFrameSize> bytes{};
+    };
+
+    /** @brief A worker thread and its queue */
+    struct Worker
+    {
+        BoundedQueue<FrameSlot, QueueCapacity> queue;
+        alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> signal{0}; ///< Bumped to wake the worker
+        std::atomic<bool> sleeping{false};                               ///< Whether it waits on signal
+        std::thread thread;
+        FrameSlot current; ///< The frame being executed, copied out so that it does not hold a queue slot
+    };
+
+    FrameSource& _source;
+    const Communicator& _communicator;
+    const ConcurrentListenerConfig _config;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::size_t _next_worker = 0;
+    std::atomic<bool> _running{false}; ///< Whether the reader loop keeps reading
+    std::atomic<bool> _closing{false}; ///< Whether workers exit once their queue is empty
+    std::size_t _shed_depth = QueueCapacity;
+    std::bitset<std::size_t{std::numeric_limits<frame_key_t>::max()} + 1> _priority{}; ///< By frame key
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _received{0};
+    std::atomic<std::size_t> _oversized{0};
+    std::atomic<std::size_t> _rejected{0};
+    std::atomic<std::size_t> _dropped{0};
+    std::atomic<std::size_t> _peak_depth{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _executed{0};
+    std::atomic<std::size_t> _failed{0};
+
+    /**
+     * @brief Wakes a worker if it is sleeping
+     * @param worker The worker to wake
+     */
+    static void wake(Worker& worker) noexcept {
+        // Orders the queue push before reading sleeping, pairs with the fence in workerLoop()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (worker.sleeping.load(std::memory_order_relaxed)) {
+            worker.signal.fetch_add(1, std::memory_order_release);
+            worker.signal.notify_one();
+        }
+    }
+
+    /**
+     * @brief Pins the calling thread to a CPU core (no-op where unsupported)
+     * @param core The core index
+     */
+    static void pinToCore(const int core) noexcept {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        static_cast<void>(pthread_setaffinity_np(pthread_self(), sizeof(set), &set));
+#else
+        static_cast<void>(core);
+#endif
+    }
+
+    /**
+     * @brief Picks the worker for a frame according to the configured affinity
+     * @param frame The frame
+     * @return std::size_t The worker index
+     */
+    std::size_t pickWorker(const serialized_message_view_t frame) noexcept {
+        if constexpr (requires { HandlerT::shardOf(frame); }) {
+            if (_config.affinity == WORKER_AFFINITY::SHARD) {
+                return HandlerT::shardOf(frame) % _workers.size();
+            }
+        }
+        if (_config.affinity != WORKER_AFFINITY::ROUND_ROBIN) {
+            return keyOf(frame) % _workers.size();
+        }
+        const std::size_t worker = _next_worker;
+        _next_worker = (_next_worker + 1) % _workers.size();
+        return worker;
+    }
+
+    /**
+     * @brief Command ID of a frame, for the error of a shed frame
+     * @param frame The frame
+     * @return command_id_t The ID, 0 if the handler does not expose frameId() or the frame is too short
+     */
+    static command_id_t idOf(const serialized_message_view_t frame) noexcept {
+        if constexpr (requires { HandlerT::frameId(frame); }) {
+            if (frame.size() >= HandlerT::ID_SIZE) {
+                return HandlerT::frameId(frame);
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Key of a frame, see frame_key_t
+     * @param frame The frame
+     * @return frame_key_t The command ID, or the leading byte if the handler does not expose frameId()
+     */
+    static frame_key_t keyOf(const serialized_message_view_t frame) noexcept {
+        if constexpr (requires { HandlerT::frameId(frame); }) {
+            return idOf(frame);
+        }
+        else {
+            return frame.empty() ? 0 : frame.front();
+        }
+    }
+
+    /**
+     * @brief Whether a frame is of a priority key, never shed
+     * @param frame The frame
+     */
+    [[nodiscard]] bool isPriority(const serialized_message_view_t frame) const noexcept {
+        return _priority.test(keyOf(frame));
+    }
+
+    /**
+     * @brief Counts a shed frame and hands it to the configured callback
+     * @param frame The frame
+     * @param counter The counter of the policy that shed it
+     * @param msg The static description of the error
+     */
+    void
+    shed(const serialized_message_view_t frame, std::atomic<std::size_t>& counter, const char* const msg) noexcept {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        if (!_config.on_shed) {
+            return;
+        }
+        try {
+            _config.on_shed(
+                frame,
+                HandlerExecuteError{.code = HANDLER_EXECUTE_STATUS::ERROR_OVERLOADED, .id = idOf(frame), .msg = msg}
+            );
+        }
+        catch (...) { // NOLINT(bugprone-empty-catch) the frame is shed all the same, reading goes on
+        }
+    }
+
+    /**
+     * @brief Applies the overload policy to a frame meeting a worker queue at its admission limit
+     * @param frame The frame
+     * @param worker The worker of the frame
+     * @return bool Whether the frame is to be queued
+     */
+    bool admit(const serialized_message_view_t frame, Worker& worker) noexcept {
+        switch (_config.overload) {
+        case OVERLOAD_POLICY::REJECT:
+            shed(frame, _rejected, "Rejected by admission control");
+            return false;
+        case OVERLOAD_POLICY::DROP_OLDEST: {
+            bool kept = false; // whether the oldest frame has priority, and is kept
+            const auto sheddable = [this, &kept](const FrameSlot& slot) {
+                kept = isPriority(serialized_message_view_t(slot.bytes.data(), slot.size));
+                return !kept;
+            };
+            // The reader is the only producer of the queue, as tryConsumeIf() requires
+            worker.queue.tryConsumeIf(sheddable, [this](FrameSlot& slot) {
+                shed(serialized_message_view_t(slot.bytes.data(), slot.size), _dropped, "Dropped for a newer frame");
+            });
+            if (kept) {
+                shed(frame, _rejected, "Rejected by admission control, the oldest frame has priority");
+                return false;
+            }
+            return true;
+        }
+        case OVERLOAD_POLICY::BLOCK:
+            break;
+        }
+        while (worker.queue.sizeApprox() >= _shed_depth) {
+            wake(worker);
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Copies a frame into the queue of its worker, applying the admission limit of the configuration
+     *
+     * Frames of priority keys may fill the whole queue and wait for a free slot if needed; the others are
+     * admitted up to the shed depth, past which the overload policy decides.
+     *
+     * @param frame The frame, only valid during the call
+     */
+    void dispatch(const serialized_message_view_t frame) noexcept {
+        _received.fetch_add(1, std::memory_order_relaxed);
+        if (frame.size() > MaxFrameSize) {
+            _oversized.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Worker& worker = *_workers[pickWorker(frame)];
+        const std::size_t depth = worker.queue.sizeApprox();
+        if (depth > _peak_depth.load(std::memory_order_relaxed)) {
+            _peak_depth.store(depth, std::memory_order_relaxed); // only the reader thread writes it
+        }
+        if (!isPriority(frame) && depth >= _shed_depth && !admit(frame, worker)) {
+            return;
+        }
+        const auto fill = [frame](FrameSlot& slot) {
+            slot.size = frame.size();
+            std::memcpy(slot.bytes.data(), frame.data(), frame.size());
+        };
+        while (!worker.queue.tryEmplace(fill)) {
+            wake(worker);
+            std::this_thread::yield();
+        }
+        wake(worker);
+    }
+
+    /**
+     * @brief Executes every frame queued for a worker
+     * @param worker The worker
+     * @return bool Whether a frame was executed
+     */
+    bool drain(Worker& worker) noexcept {
+        bool any = false;
+        FrameSlot& current = worker.current;
+        while (worker.queue.tryConsume([&current](FrameSlot& slot) {
+            current.size = slot.size;
+            std::memcpy(current.bytes.data(), slot.bytes.data(), slot.size);
+        })) {
+            const auto result =
+                HandlerT::execute(serialized_message_view_t(current.bytes.data(), current.size), _communicator);
+            (result ? _executed : _failed).fetch_add(1, std::memory_order_relaxed);
+            any = true;
+        }
+        return any;
+    }
+
+    /**
+     * @brief Body of a worker thread: executes queued frames, sleeps while idle, exits once stopped and drained
+     * @param worker The worker
+     */
+    void workerLoop(Worker& worker) noexcept {
+        for (;;) {
+            const std::uint32_t seen = worker.signal.load(std::memory_order_acquire);
+            // Read before draining: once closing is seen, every frame ever pushed is visible to drain()
+            const bool closing = _closing.load(std::memory_order_acquire);
+            if (drain(worker)) {
+                continue;
+            }
+            worker.sleeping.store(true, std::memory_order_relaxed);
+            // Orders publishing sleeping before re-checking the queue, pairs with the fence in wake()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (drain(worker)) {
+                worker.sleeping.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            if (closing) {
+                return;
+            }
+            worker.signal.wait(seen, std::memory_order_acquire);
+            worker.sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+  public:
+    /**
+     * @brief Constructs the listener, its worker queues are allocated once here
+     *
+     * @param source The transport the frames are read from
+     * @param communicator The communicator passed to every command, shared by the workers
+     * @param config The worker pool configuration
+     */
+    ConcurrentListener(FrameSource& source, const Communicator& communicator, ConcurrentListenerConfig config = {})
+        : _source(source), _communicator(communicator), _config(std::move(config)) {
+        if (_config.shed_depth != 0 && _config.shed_depth < QueueCapacity) {
+            _shed_depth = _config.shed_depth;
+        }
+        for (const frame_key_t key : _config.priority_ids) {
+            _priority.set(key);
+        }
+        const std::size_t workers = _config.workers == 0 ? 1 : _config.workers;
+        _workers.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            _workers.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    ConcurrentListener(const ConcurrentListener&) = delete;
+    ConcurrentListener& operator=(const ConcurrentListener&) = delete;
+
+    /**
+     * @brief Starts the workers and reads frames until the source closes or stop() is called
+     *
+     * Blocks the calling thread. Before returning, every queued frame is executed and the workers are joined.
+     */
+    void start() override {
+        _running.store(true, std::memory_order_release);
+        _closing.store(false, std::memory_order_release);
+        for (std::size_t i = 0; i < _workers.size(); ++i) {
+            Worker& worker = *_workers[i];
+            const int core = _config.cores.empty() ? -1 : _config.cores[i % _config.cores.size()];
+            worker.thread = std::thread([this, &worker, core] {
+                if (core >= 0) {
+                    pinToCore(core);
+                }
+                workerLoop(worker);
+            });
+        }
+
+        const auto on_frame = [this](const serialized_message_view_t frame) { dispatch(frame); };
+        while (_running.load(std::memory_order_acquire) && _source.receive(on_frame)) {
+        }
+
+        _running.store(false, std::memory_order_release);
+        _closing.store(true, std::memory_order_release);
+        for (const std::unique_ptr<Worker>& worker : _workers) {
+            worker->signal.fetch_add(1, std::memory_order_release);
+            worker->signal.notify_one();
+            worker->thread.join();
+        }
+    }
+
+    /**
+     * @brief Asks start() to return once the current receive() returns; safe from any thread
+     *
+     * A source blocked in receive() must be closed separately to unblock the reader loop.
+     */
+    void stop() noexcept { _running.store(false, std::memory_order_release); }
+
+    /**
+     * @brief Snapshot of the listener counters
+     * @return ConcurrentListenerStats The counters
+     */
+    [[nodiscard]] ConcurrentListenerStats stats() const noexcept {
+        std::size_t queued = 0;
+        for (const std::unique_ptr<Worker>& worker : _workers) {
+            queued += worker->queue.sizeApprox();
+        }
+        return {
+            .received = _received.load(std::memory_order_relaxed),
+            .executed = _executed.load(std::memory_order_relaxed),
+            .failed = _failed.load(std::memory_order_relaxed),
+            .oversized = _oversized.load(std::memory_order_relaxed),
+            .rejected = _rejected.load(std::memory_order_relaxed),
+            .dropped = _dropped.load(std::memory_order_relaxed),
+            .queued = queued,
+            .peak_depth = _peak_depth.load(std::memory_order_relaxed),
+        };
+    }
+
+    /**
+     * @brief Approximate number of frames waiting in the queue of a worker
+     * @param worker The worker index, below workers()
+     * @return std::size_t The queue depth
+     */
+    [[nodiscard]] std::size_t queueDepth(const std::size_t worker) const noexcept {
+        return _workers[worker]->queue.sizeApprox();
+    }
+
+    /** @brief The number of worker threads */
+    [[nodiscard]] std::size_t workers() const noexcept { return _workers.size(); }
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "message.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+/**
+ * @brief Largest encoded size of a COBS frame, delimiter included
+ * @param size The size of the frame before encoding
+ * @return std::size_t The buffer size needed by cobsEncode()
+ */
+constexpr std::size_t cobsEncodedSize(const std::size_t size) { return size + size / 254 + 2; }
+
+/**
+ * @brief Encodes a frame with COBS (Consistent Overhead Byte Stuffing) and appends the 0x00 delimiter
+ *
+ * COBS removes every 0x00 from the frame, so that 0x00 can delimit frames on a byte stream
+ * (UART, TCP, ...) and a receiver can resynchronise on the next delimiter after any corruption.
+ *
+ * @param frame The frame to encode
+ * @param buffer Destination buffer, at least cobsEncodedSize(frame.size()) bytes
+ * @return serialized_message_view_t View over the encoded bytes, at the start of buffer
+ * @throws std::length_error if buffer is too small
+ */
+inline serialized_message_view_t
+cobsEncode(const serialized_message_view_t frame, const std::span<std::uint8_t> buffer) {
+    if (buffer.size() < cobsEncodedSize(frame.size())) {
+        throw std::length_error("Buffer too small to COBS-encode frame");
+    }
+    std::size_t code_index = 0; // where the code byte of the current block goes
+    std::size_t out = 1;
+    std::uint8_t code = 1;
+    for (const std::uint8_t byte : frame) {
+        if (byte != 0) {
+            buffer[out++] = byte;
+            ++code;
+        }
+        if (byte == 0 || code == 0xFF) {
+            buffer[code_index] = code;
+            code_index = out++;
+            code = 1;
+        }
+    }
+    buffer[code_index] = code;
+    buffer[out++] = 0x00; // delimiter
+    return buffer.first(out);
+}
+
+/**
+ * @brief Incremental COBS decoder carving frames out of a continuous byte stream
+ *
+ * Chunks of any size (a single byte, a whole DMA/read() buffer, ...) are fed as they arrive.
+ * Bytes are decoded in place into a fixed buffer holding only the frame in progress, so a partial
+ * frame survives across chunks and nothing is ever allocated. Each complete frame is handed to a
+ * callback as a view over that buffer, ready for Handler::execute().
+ *
+ * Frames longer than MaxFrameSize and malformed frames are dropped up to the next delimiter
+ * and counted in droppedFrames(). Empty frames (e.g. back-to-back delimiters) are skipped.
+ *
+ * Usage:
+ *     CobsFramer<256> framer;
+ *     framer.feed(chunk, [&](serialized_message_view_t frame) {
+ *         const Result result = MyHandler::execute(frame, communicator);
+ *     });
+ *
+ * @tparam MaxFrameSize The largest decoded frame accepted
+ */
+template <std::size_t MaxFrameSize> class CobsFramer
+{
+    std::array<std::uint8_t, MaxFrameSize> _frame{}; ///< Decoded bytes of the frame in progress
+    std::size_t _size = 0;                           ///< Number of decoded bytes in _frame
+    std::size_t _remaining = 0;                      ///< Data bytes left in the current COBS block
+    bool _pending_zero = false;                      ///< Whether a 0x00 is implied before the next block
+    bool _discarding = false;                        ///< Whether the frame in progress is dropped
+    std::size_t _dropped = 0;                        ///< Number of frames dropped so far
+
+    /**
+     * @brief Appends decoded bytes to the frame in progress
+     * @param bytes The decoded bytes
+     */
+    void append(const serialized_message_view_t bytes) noexcept {
+        if (bytes.size() > MaxFrameSize - _size) {
+            _discarding = true;
+            ++_dropped;
+            return;
+        }
+        std::memcpy(_frame.data() + _size, bytes.data(), bytes.size());
+        _size += bytes.size();
+    }
+
+    /**
+     * @brief Forgets the frame in progress
+     */
+    void restart() noexcept {
+        _size = 0;
+        _remaining = 0;
+        _pending_zero = false;
+        _discarding = false;
+    }
+
+  public:
+    /**
+     * @brief Feeds a chunk of the byte stream, emitting every frame it completes
+     *
+     * @param chunk The next bytes of the stream, only read during the call
+     * @param on_frame Callback invoked with each complete frame, each view only valid during its call
+     * @return std::size_t The number of frames emitted
+     */
+    template <typename F>
+        requires std::invocable<F&, serialized_message_view_t>
+    std::size_t feed(serialized_message_view_t chunk, F&& on_frame) {
+        std::size_t emitted = 0;
+        while (!chunk.empty()) {
+            if (chunk.front() == 0x00) { // delimiter
+                if (!_discarding && _remaining == 0 && _size > 0) {
+                    ++emitted;
+                    on_frame(serialized_message_view_t(_frame.data(), _size));
+                }
+                else if (!_discarding && _remaining != 0) {
+                    ++_dropped; // truncated block
+                }
+                restart();
+                chunk = chunk.subspan(1);
+            }
+            else if (_discarding) {
+                chunk = chunk.subspan(1);
+            }
+            else if (_remaining == 0) { // code byte starting a new block
+                if (_pending_zero) {
+                    constexpr std::array<std::uint8_t, 1> ZERO{0x00};
+                    append(ZERO);
+                }
+                _remaining = chunk.front() - 1U;
+                _pending_zero = chunk.front() != 0xFF;
+                chunk = chunk.subspan(1);
+            }
+            else { // block data: copy up to the end of the block, the chunk or the next delimiter
+                const serialized_message_view_t run = chunk.first(std::min(_remaining, chunk.size()));
+                const void* delimiter = std::memchr(run.data(), 0x00, run.size());
+                const std::size_t length =
+                    delimiter == nullptr ? run.size() : static_cast<const std::uint8_t*>(delimiter) - run.data();
+                append(run.first(length));
+                _remaining -= length;
+                chunk = chunk.subspan(length);
+            }
+        }
+        return emitted;
+    }
+
+    /**
+     * @brief Drops the frame in progress (e.g. after the link was reset)
+     */
+    void reset() noexcept { restart(); }
+
+    /**
+     * @brief Number of frames dropped because they were too long or malformed
+     * @return std::size_t The number of dropped frames
+     */
+    [[nodiscard]] std::size_t droppedFrames() const noexcept { return _dropped; }
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Non-owning reference to a callable, see the specialization below
+ * @tparam Signature The function signature, e.g. void(int)
+ */
+template <typename Signature> class FunctionRef;
+
+/**
+ * @brief Non-owning, non-allocating reference to a callable (same idea as C++26 std::function_ref)
+ *
+ * Unlike std::function, it never copies nor allocates the referenced callable: it only stores
+ * a pointer to it and a pointer to a trampoline. The referenced callable must outlive every call,
+ * which holds for the usual "pass a lambda to a synchronous function" pattern:
+ *     communicator.requestView(message, [&](std::span<const std::uint8_t> response) { ... });
+ *
+ * @tparam R The return type
+ * @tparam Args The argument types
+ */
+template <typename R, typename... Args> class FunctionRef<R(Args...)>
+{
+    /** @brief Type-erased pointer to the referenced callable */
+    union Target
+    {
+        void* object;           ///< Callable object (lambda, functor, ...)
+        R (*function)(Args...); ///< Free function
+    };
+
+    Target _target;                    ///< The referenced callable
+    R (*_trampoline)(Target, Args...); ///< Calls _target with its concrete type restored
+
+  public:
+    /**
+     * @brief Constructs a reference to a callable object
+     * Implicit, like std::function, so that lambdas can be passed directly.
+     * @param callable The callable, must outlive the FunctionRef
+     */
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, FunctionRef> && std::is_invocable_r_v<R, F&, Args...> &&
+                 !std::is_function_v<std::remove_reference_t<F>>)
+    FunctionRef(F&& callable) noexcept // NOLINT(google-explicit-constructor)
+        : _target{.object = const_cast<void*>(static_cast<const void*>(std::addressof(callable)))},
+          _trampoline([](const Target target, Args... args) -> R {
+              auto& referenced = *static_cast<std::remove_reference_t<F>*>(target.object);
+              return std::invoke(referenced, std::forward<Args>(args)...);
+          }) {}
+
+    /**
+     * @brief Constructs a reference to a free function
+     * @param function The function
+     */
+    FunctionRef(R (*function)(Args...)) noexcept // NOLINT(google-explicit-constructor)
+        : _target{.function = function},
+          _trampoline([](const Target target, Args... args) -> R {
+              return target.function(std::forward<Args>(args)...);
+          }) {}
+
+    /**
+     * @brief Calls the referenced callable
+     * @param args The arguments
+     * @return R The callable's result
+     */
+    R operator()(Args... args) const { return _trampoline(_target, std::forward<Args>(args)...); }
+};
@@ -1,19 +1,34 @@
 #pragma once
 
 #include "command.h"
+#include "perfect_hash.h"
 #include "result.h"
+#include "validation.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <limits>
 #include <memory>
+#include <span>
+#include <string>
+#include <string_view>
 
 /* ―――――――――――――――― Concepts ―――――――――――――――― */
 
 /**
  * @brief Concept to ensure a type behaves like a Command
+ * Accepts virtual commands (Command, ViewCommand) and statically dispatched ones (StaticCommand).
  * Usage: static_assert(CommandLike<T>);
  * @tparam C The type to be checked
  */
 template <typename C> concept CommandLike = requires(const std::vector<std::uint8_t>& raw, const C& c) {
     typename C::input_message_t;
-    requires std::derived_from<C, Command<typename C::input_message_t::message_format_t>>;
+    requires std::derived_from<C, Command<typename C::input_message_t::message_format_t>> ||
+                 std::derived_from<C, ViewCommand<typename C::input_message_t::message_format_t>> ||
+                 std::derived_from<C, StaticCommand<C, typename C::input_message_t::message_format_t>>;
 };
 
 /**
@@ -21,29 +36,96 @@ template <typename C> concept CommandLike = requires(const std::vector<std::uint
  */
 namespace command_helpers
 {
+/** @brief Type alias for the message format of a Command-like type */
+template <CommandLike C> using format_t = typename C::input_message_t::message_format_t;
+
+/**
+ * @brief Retrieves the numeric value of the command ID of a Command-like type at compile-time
+ * @tparam C The Command-like type
+ * @return command_id_t The command ID (see message_helpers::idKey())
+ */
+template <CommandLike C> consteval command_id_t cmdId() { return message_helpers::idKey<format_t<C>>(); }
+
+/**
+ * @brief First of a list of Command-like types
+ * @tparam C The first Command-like type
+ */
+template <CommandLike C, CommandLike...> struct First
+{
+    using type = C;
+};
+
 /**
- * @brief Retrieves the command ID from a Command-like type at compile-time
+ * @brief Size of the leading command ID of a list of Command-like types, see SameIdEncoding
+ * @tparam Commands The Command-like types
+ * @return std::size_t The size in bytes, 1 for an empty list
+ */
+template <CommandLike... Commands> consteval std::size_t idSize() {
+    if constexpr (sizeof...(Commands) == 0) {
+        return 1;
+    }
+    else {
+        return message_helpers::idSize<format_t<typename First<Commands...>::type>>();
+    }
+}
+
+/**
+ * @brief Constructs a Command-like type from a view over its raw bytes and executes it
+ * Commands exposing a serialized_message_view_t constructor are built straight from the view (no allocation).
+ * Commands that only accept a std::vector fall back to a copy of the bytes, kept alive until execute() returns
+ * so that the trailing payload of a command taking `const std::vector&` still refers to it.
  * @tparam C The Command-like type
- * @return std::uint8_t The command ID
+ * @param data Raw byte data of the command message
+ * @param communicator The Communicator instance to handle responses and requests
+ */
+template <CommandLike C> void executeCommand(const serialized_message_view_t data, const Communicator& communicator) {
+    if constexpr (std::is_constructible_v<C, serialized_message_view_t>) {
+        C{data}.execute(communicator);
+    }
+    else {
+        const serialized_message_t owned(data.begin(), data.end());
+        C{owned}.execute(communicator);
+    }
+}
+
+/**
+ * @brief Checks that a list of command IDs holds no duplicates
+ * Sorts a copy of the IDs and compares neighbours: O(N log N) constant evaluation steps and no template recursion.
+ * @tparam N The number of IDs
+ * @param ids The IDs
+ * @return bool Whether all IDs are distinct
+ */
+template <std::size_t N> consteval bool uniqueIds(std::array<command_id_t, N> ids) {
+    std::ranges::sort(ids);
+    return std::ranges::adjacent_find(ids) == ids.end();
+}
+
+/**
+ * @brief Compile-time check to ensure all command IDs are unique, see uniqueIds()
+ * A single instantiation whatever the number of commands, so large command sets neither hit the template
+ * depth limit nor instantiate one check per pair of commands.
+ * @tparam Commands The Command-like types
  */
-template <CommandLike C> consteval std::uint8_t cmdId() { return C::input_message_t::message_format_t::ID; }
+template <CommandLike... Commands> struct UniqueIds
+    : std::bool_constant<uniqueIds(std::array<command_id_t, sizeof...(Commands)>{cmdId<Commands>()...})>
+{};
 
 /**
- * @brief Base case for UniqueIds: no types means all IDs are unique
+ * @brief Base case for SameIdEncoding: no types share any encoding
  * @tparam ...
  */
-template <CommandLike...> struct UniqueIds : std::true_type
+template <CommandLike...> struct SameIdEncoding : std::true_type
 {};
 
 /**
- * @brief Compile-time check to ensure all command IDs are unique
- * Works by recursively checking that the ID of the first type
- * is different from all subsequent types, and then recursing on the rest.
+ * @brief Compile-time check that all commands encode their IDs with the same size and byte order,
+ * so that reading the leading bytes of a frame once finds its ID whatever the command
+ * (the values are compared by UniqueIds, e.g. an enum and an integer ID of the same value collide)
  * @tparam C The first Command-like type
  * @tparam Rest The remaining Command-like types
  */
-template <CommandLike C, CommandLike... Rest> struct UniqueIds<C, Rest...>
-    : std::bool_constant<((cmdId<C>() != cmdId<Rest>()) && ...) && UniqueIds<Rest...>::value>
+template <CommandLike C, CommandLike... Rest> struct SameIdEncoding<C, Rest...>
+    : std::bool_constant<(message_helpers::sameIdEncoding<format_t<C>, format_t<Rest>>() && ...)>
 {};
 } // namespace command_helpers
 
@@ -56,45 +138,373 @@ using serialized_message_array_t = std::vector<serialized_message_t>;
  */
 enum class HANDLER_EXECUTE_STATUS : std::uint8_t
 {
+    SUCCESS = 0, ///< Only written by executeBatch(), execute() reports success as an ok() result
     ERROR_ID_NOT_FOUND = 1,
     ERROR_MESSAGE_LENGTH_ERROR = 2,
     ERROR_EXCEPTION_DURING_EXECUTION = 3,
     ERROR_EMPTY_MESSAGE = 4,
+    ERROR_ROUTE_NOT_FOUND = 5, ///< No handler is routed the leading address byte, see Router
+    ERROR_OVERLOADED = 6,      ///< Shed by the admission control of a listener, see OVERLOAD_POLICY
 };
 /**
  * @brief Structure representing an error that occurred during command execution
+ *
+ * Errors are built without allocating: msg is a static string and the specifics are kept as fields,
+ * formatted on demand by describe() / describeInto(). An exception thrown by a command is kept by
+ * reference and only asked for its text when the error is formatted, so every error stays a few words
+ * large and returning one from execute() stays cheap.
  */
 struct HandlerExecuteError
 {
     /** @brief The status code of the error */
     HANDLER_EXECUTE_STATUS code;
-    /** @brief A descriptive message about the error */
-    std::string msg;
+    /** @brief The command ID of the frame, 0 for frames shorter than an ID */
+    command_id_t id = 0;
+    /** @brief A static description of the error, never freed */
+    const char* msg;
+    /** @brief The expected size or ID, 0 when not applicable */
+    std::size_t expected = 0;
+    /** @brief The actual size or ID, or the address of an unknown route */
+    std::size_t got = 0;
+    /** @brief The exception thrown during execution, null otherwise */
+    std::exception_ptr exception = nullptr;
+
+    /**
+     * @brief Text of the exception thrown during execution
+     * Rethrows the exception to read it, which may allocate: only meant for reporting errors.
+     * @return const char* Its what(), or nullptr if there is none or it is not a std::exception
+     */
+    [[nodiscard]] const char* exceptionText() const noexcept {
+        if (!exception) {
+            return nullptr;
+        }
+        try {
+            std::rethrow_exception(exception);
+        }
+        catch (const std::exception& e) {
+            return e.what(); // owned by the exception, which exception keeps alive
+        }
+        catch (...) {
+            return nullptr;
+        }
+    }
+
+    /**
+     * @brief Formats the error into a caller-owned buffer, without allocating except to read an exception
+     *
+     * Reads "<msg>: <what()>", "<msg>, expected <expected>, got <got>", for unknown IDs "<msg>: <id>" or,
+     * for unknown routes, "<msg>: <got>", truncated to the buffer size.
+     *
+     * @param buffer Destination buffer
+     * @return std::string_view View over the formatted text, at the start of buffer
+     */
+    std::string_view describeInto(const std::span<char> buffer) const noexcept {
+        char* out = buffer.data();
+        char* const end = buffer.data() + buffer.size();
+        const auto append = [&out, end](const std::string_view text) {
+            const std::size_t length = std::min(text.size(), static_cast<std::size_t>(end - out));
+            std::memcpy(out, text.data(), length);
+            out += length;
+        };
+        const auto appendNumber = [&out, end](const std::size_t value) {
+            const std::to_chars_result written = std::to_chars(out, end, value);
+            out = written.ec == std::errc{} ? written.ptr : end;
+        };
+
+        append(msg);
+        if (const char* const what = exceptionText()) {
+            append(": ");
+            append(what);
+        }
+        else if (expected != 0) {
+            append(", expected ");
+            appendNumber(expected);
+            append(", got ");
+            appendNumber(got);
+        }
+        else if (code == HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND) {
+            append(": ");
+            appendNumber(id);
+        }
+        else if (code == HANDLER_EXECUTE_STATUS::ERROR_ROUTE_NOT_FOUND) {
+            append(": ");
+            appendNumber(got);
+        }
+        return {buffer.data(), static_cast<std::size_t>(out - buffer.data())};
+    }
+
+    /**
+     * @brief Formats the error, for logging
+     * @return std::string A descriptive message about the error
+     */
+    [[nodiscard]] std::string describe() const {
+        std::string text(msg);
+        if (const char* const what = exceptionText()) {
+            return text.append(": ").append(what); // not truncated, unlike describeInto()
+        }
+        std::array<char, 160> buffer; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        return std::string(describeInto(buffer));
+    }
+};
+
+/**
+ * @brief Enumeration selecting how Handler maps a command ID to its command
+ */
+enum class HANDLER_DISPATCH_MODE : std::uint8_t
+{
+    JUMP_TABLE = 0, ///< Constant-time lookup in a compile-time table indexed by the ID byte
+    FOLD = 1,       ///< Compares the ID against each registered command in turn
+};
+
+/** @brief Type alias for the result of an execution */
+using handler_result_t = Result<void, HandlerExecuteError>;
+
+/**
+ * @brief Concept for the instrumentation policy of BasicHandler
+ *
+ * A policy declares `static constexpr bool ENABLED`. Enabled policies also provide
+ * `static void record(command_id_t id, const handler_result_t& result, std::uint64_t nanoseconds) noexcept`,
+ * called after every execution with the ID of the frame (0 if shorter than an ID), its result and its duration.
+ *
+ * @tparam I The type to be checked
+ */
+template <typename I> concept HandlerInstrumentationT = requires {
+    { I::ENABLED } -> std::convertible_to<bool>;
+} && (!I::ENABLED || requires(command_id_t id, const handler_result_t& result, std::uint64_t nanoseconds) {
+    { I::record(id, result, nanoseconds) } noexcept;
+});
+
+/**
+ * @brief Instrumentation policy recording nothing, compiled out entirely
+ */
+struct NoInstrumentation
+{
+    static constexpr bool ENABLED = false;
 };
 
+/**
+ * @brief Namespace containing the parts of BasicHandler that only depend on a single command
+ */
+namespace handler_helpers
+{
+/**
+ * @brief Runs a callable, turning any exception it throws into a HandlerExecuteError
+ * @param id The command ID of the frame being executed
+ * @param fn The callable to run
+ * @return handler_result_t The status of the call
+ */
+template <typename F> handler_result_t guarded(const command_id_t id, F&& fn) noexcept {
+    try {
+        std::forward<F>(fn)();
+    }
+    catch (const MessageLengthError&) {
+        return unexpected(
+            HandlerExecuteError{
+                .code = HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR,
+                .id = id,
+                .msg = "Invalid size",
+                .exception = std::current_exception(),
+            }
+        );
+    }
+    catch (const std::exception&) {
+        return unexpected(
+            HandlerExecuteError{
+                .code = HANDLER_EXECUTE_STATUS::ERROR_EXCEPTION_DURING_EXECUTION,
+                .id = id,
+                .msg = "Exception during execution",
+                .exception = std::current_exception(),
+            }
+        );
+    }
+    catch (...) {
+        return unexpected(
+            HandlerExecuteError{
+                .code = HANDLER_EXECUTE_STATUS::ERROR_EXCEPTION_DURING_EXECUTION,
+                .id = id,
+                .msg = "Unknown exception",
+            }
+        );
+    }
+    return {};
+}
+
+/**
+ * @brief Validates, constructs and executes a single command
+ * Malformed frames are rejected through Message::validate() before construction, so they never throw.
+ * Kept out of line so that both dispatch modes share one copy per command: code size stays linear in the
+ * number of commands instead of inlining every command body into the fold. Outside BasicHandler, its
+ * symbol names only the command, not every command of the handler, and handlers sharing a command share it.
+ * @tparam C The Command-like type matching the ID of data
+ * @param data Raw byte data of the command message
+ * @param communicator The Communicator instance to handle responses and requests
+ * @return handler_result_t The status of the command execution
+ */
+template <CommandLike C>
+[[gnu::noinline]] handler_result_t
+invoke(const serialized_message_view_t data, const Communicator& communicator) noexcept {
+    if (const Result checked = C::input_message_t::validate(data); !checked) {
+        const bool length = checked.error().code == MESSAGE_PARSE_STATUS::ERROR_LENGTH;
+        return unexpected(
+            HandlerExecuteError{
+                .code = length ? HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR
+                               : HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND,
+                .id = command_helpers::cmdId<C>(),
+                .msg = length ? "Invalid content size" : "Invalid ID",
+                .expected = checked.error().expected,
+                .got = checked.error().got,
+            }
+        );
+    }
+    return guarded(command_helpers::cmdId<C>(), [&] { command_helpers::executeCommand<C>(data, communicator); });
+}
+} // namespace handler_helpers
+
 /**
  * @brief Class that handles execution of commands based on incoming data
  *
  * This class takes a variadic list of Command-like types and provides a static
  * method to execute the appropriate command based on the ID found in the
  * incoming data. It ensures at compile-time that all command IDs are unique.
+ * Use it through the Handler alias, or through BasicHandler directly to add instrumentation (see metrics.h).
  *
+ * @tparam Instrumentation Policy notified of every execution, NoInstrumentation costs nothing
  * @tparam Commands Variadic list of Command-like types
  */
-template <CommandLike... Commands> class Handler final
+template <HandlerInstrumentationT Instrumentation, CommandLike... Commands> class BasicHandler final
 {
     static_assert(command_helpers::UniqueIds<Commands...>::value, "Duplicate command IDs registered in Handler");
+    static_assert(
+        command_helpers::SameIdEncoding<Commands...>::value, "Commands of a Handler must share their ID size and order"
+    );
+
+    /** @brief Type alias for the hash of the command IDs, only used for IDs wider than a byte */
+    using id_hash_t = PerfectHash<sizeof...(Commands)>;
 
   public:
+    /** @brief Type alias for the result of an execution */
+    using execute_result_t = handler_result_t;
+
+    /** @brief Size of the leading command ID of every frame, in bytes */
+    static constexpr std::size_t ID_SIZE = command_helpers::idSize<Commands...>();
+
     /**
-     * @brief Executes the appropriate command based on incoming data
+     * @brief Number of dispatch slots: one per ID byte for one-byte IDs, else the perfect hash slots plus
+     * a last slot for unknown IDs. The dispatch and frame size tables have one entry per slot.
+     */
+    static constexpr std::size_t SLOT_COUNT = ID_SIZE == 1 ? 256 : id_hash_t::SLOTS + 1;
+
+    /**
+     * @brief Reads the command ID of a frame
+     * @param data Raw byte data, at least ID_SIZE bytes
+     * @return command_id_t The command ID
+     */
+    [[nodiscard]] static command_id_t frameId(const serialized_message_view_t data) noexcept {
+        if constexpr (ID_SIZE == 1) {
+            return data.front();
+        }
+        else {
+            using format_t = command_helpers::format_t<typename command_helpers::First<Commands...>::type>;
+            return message_helpers::readId<format_t>(data); // every format reads it the same way
+        }
+    }
+
+  private:
+    /** @brief Type alias for a dispatch table entry */
+    using invoker_t = execute_result_t (*)(serialized_message_view_t, const Communicator&) noexcept;
+
+    /**
+     * @brief Perfect hash of the command IDs: O(1) dispatch without a 65536-entry table for 16-bit IDs
+     * A template so that one-byte handlers, which index their tables by the ID itself, never build it.
+     */
+    template <std::size_t IdSize = ID_SIZE>
+        requires(IdSize > 1)
+    static constexpr id_hash_t ID_HASH{
+        std::array<std::uint16_t, sizeof...(Commands)>{command_helpers::cmdId<Commands>()...}
+    };
+
+    /**
+     * @brief Dispatch slot of a command ID
+     * @param id The command ID, registered or not
+     * @return std::size_t The slot, SLOT_COUNT - 1 for unknown wide IDs
+     */
+    static constexpr std::size_t slotOfId(const command_id_t id) noexcept {
+        if constexpr (ID_SIZE == 1) {
+            return id;
+        }
+        else {
+            return ID_HASH<>.find(id);
+        }
+    }
+
+    /**
+     * @brief Dispatch slot of a frame
+     * @param data Raw byte data, at least ID_SIZE bytes
+     * @return std::size_t The slot
+     */
+    static std::size_t slotOf(const serialized_message_view_t data) noexcept { return slotOfId(frameId(data)); }
+
+    /**
+     * @brief Dispatch table entry for IDs that no command is registered for
+     * @param data Raw byte data of the message (at least ID_SIZE bytes)
+     * @return execute_result_t Always an ERROR_ID_NOT_FOUND error
+     */
+    static execute_result_t
+    unknownId(const serialized_message_view_t data, const Communicator& /*communicator*/) noexcept {
+        return unexpected(
+            HandlerExecuteError{
+                .code = HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND, .id = frameId(data), .msg = "Unknown command ID"
+            }
+        );
+    }
+
+    /**
+     * @brief Builds the table mapping every dispatch slot to its invoker
+     * @return std::array<invoker_t, SLOT_COUNT> The dispatch table
+     */
+    static consteval std::array<invoker_t, SLOT_COUNT> makeDispatchTable() {
+        std::array<invoker_t, SLOT_COUNT> table{};
+        table.fill(&unknownId);
+        ((table[slotOfId(command_helpers::cmdId<Commands>())] = &handler_helpers::invoke<Commands>), ...);
+        return table;
+    }
+
+    /**
+     * @brief Builds the valid frame sizes of every dispatch slot, see validateBatch()
+     * @return FrameSizeTable<SLOT_COUNT> The size table
+     */
+    static consteval FrameSizeTable<SLOT_COUNT> makeFrameSizeTable() {
+        FrameSizeTable<SLOT_COUNT> table{};
+        table.min.fill(std::numeric_limits<std::uint32_t>::max());
+        const auto add = [&table]<typename Format>() {
+            static_assert(message_helpers::maxSize<Format>() < std::numeric_limits<std::uint32_t>::max());
+            const std::size_t slot = slotOfId(message_helpers::idKey<Format>());
+            table.min[slot] = static_cast<std::uint32_t>(message_helpers::minSize<Format>());
+            table.max[slot] = static_cast<std::uint32_t>(message_helpers::maxSize<Format>());
+        };
+        (add.template operator()<command_helpers::format_t<Commands>>(), ...);
+        return table;
+    }
+
+    /**
+     * @brief Builds the table telling whether the command of every dispatch slot is idempotent
+     * @return std::array<bool, SLOT_COUNT> The table, false for unregistered IDs
+     */
+    static consteval std::array<bool, SLOT_COUNT> makeIdempotentTable() {
+        std::array<bool, SLOT_COUNT> table{};
+        ((table[slotOfId(command_helpers::cmdId<Commands>())] = IdempotentCommandT<Commands>), ...);
+        return table;
+    }
+
+    /**
+     * @brief Looks up and executes the command matching the ID of data, see execute()
+     * @tparam Mode How the ID is looked up
      * @param data Raw byte data containing the command ID and payload
      * @param communicator The Communicator instance to handle responses and requests
-     * @return EXECUTE_STATUS The status of the command execution
-     * @throws std::runtime_error if the data is empty or the command ID is unknown
+     * @return execute_result_t The status of the command execution
      */
-    [[nodiscard]] static Result<void, HandlerExecuteError>
-    execute(const serialized_message_t& data, const Communicator& communicator) noexcept {
+    template <HANDLER_DISPATCH_MODE Mode>
+    static execute_result_t dispatch(const serialized_message_view_t data, const Communicator& communicator) noexcept {
         if (data.empty()) {
             return unexpected(
                 HandlerExecuteError{
@@ -102,38 +512,143 @@ template <CommandLike... Commands> class Handler final
                 }
             );
         }
-        const std::uint8_t id = data.front();
-
-        // Short-circuit fold: constructs and execute only the matching command
-        try {
-            const bool matched =
-                ((id == command_helpers::cmdId<Commands>() && (Commands{data}.execute(communicator), true)) || ...);
-            if (!matched) {
+        if constexpr (ID_SIZE > 1) {
+            if (data.size() < ID_SIZE) {
                 return unexpected(
                     HandlerExecuteError{
-                        .code = HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND,
-                        .msg = "Unknown command ID: " + std::to_string(id)
+                        .code = HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR,
+                        .msg = "Frame shorter than a command ID",
+                        .expected = ID_SIZE,
+                        .got = data.size(),
                     }
                 );
             }
         }
-        catch (const MessageLengthError& e) {
-            return unexpected(
-                HandlerExecuteError{.code = HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR, .msg = e.what()}
-            );
+
+        if constexpr (Mode == HANDLER_DISPATCH_MODE::JUMP_TABLE) {
+            static constexpr std::array<invoker_t, SLOT_COUNT> DISPATCH_TABLE = makeDispatchTable();
+            return DISPATCH_TABLE[slotOf(data)](data, communicator);
         }
-        catch (const std::exception& e) {
-            return unexpected(
-                HandlerExecuteError{.code = HANDLER_EXECUTE_STATUS::ERROR_EXCEPTION_DURING_EXECUTION, .msg = e.what()}
-            );
+        else {
+            // Short-circuit fold picking the invoker of the matching command. Calling it once after the fold
+            // keeps a single result path: emplacing each command's result inside the fold grew the code
+            // faster than the number of commands.
+            const command_id_t id = frameId(data);
+            invoker_t invoker = &unknownId;
+            ((id == command_helpers::cmdId<Commands>() && (invoker = &handler_helpers::invoke<Commands>, true)) || ...);
+            return invoker(data, communicator);
         }
-        catch (...) {
-            return unexpected(
-                HandlerExecuteError{
-                    .code = HANDLER_EXECUTE_STATUS::ERROR_EXCEPTION_DURING_EXECUTION, .msg = "Unknown exception"
-                }
+    }
+
+  public:
+    /**
+     * @brief Executes the appropriate command based on incoming data
+     * @tparam Mode How the ID is looked up, the jump table is constant-time whatever the number of commands
+     * @param data Raw byte data containing the command ID and payload (only read during the call)
+     * @param communicator The Communicator instance to handle responses and requests
+     * @return EXECUTE_STATUS The status of the command execution
+     */
+    template <HANDLER_DISPATCH_MODE Mode = HANDLER_DISPATCH_MODE::JUMP_TABLE>
+    [[nodiscard]] static execute_result_t
+    execute(const serialized_message_view_t data, const Communicator& communicator) noexcept {
+        if constexpr (!Instrumentation::ENABLED) {
+            return dispatch<Mode>(data, communicator);
+        }
+        else {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            execute_result_t result = dispatch<Mode>(data, communicator);
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start
+            );
+            Instrumentation::record(
+                data.size() < ID_SIZE ? command_id_t{0} : frameId(data),
+                result,
+                static_cast<std::uint64_t>(elapsed.count())
             );
+            return result;
+        }
+    }
+
+    /**
+     * @brief Executes a burst of frames in arrival order, keeping only the status of each
+     *
+     * Same as calling execute() on every frame, with out[i] set to SUCCESS or the error code of
+     * frames[i]. A status is one byte where an execute_result_t carries the error message and exception,
+     * so storing one per frame stays cheap; callers needing those details call execute() instead.
+     * Only the first min(frames.size(), out.size()) frames are executed.
+     *
+     * @tparam Mode How the IDs are looked up
+     * @param frames The frames, each only read during its execution
+     * @param communicator The Communicator instance to handle responses and requests
+     * @param[out] out Receives the status of each executed frame
+     * @return std::size_t The number of frames executed successfully
+     */
+    template <HANDLER_DISPATCH_MODE Mode = HANDLER_DISPATCH_MODE::JUMP_TABLE>
+    static std::size_t executeBatch(
+        const std::span<const serialized_message_view_t> frames,
+        const Communicator& communicator,
+        const std::span<HANDLER_EXECUTE_STATUS> out
+    ) noexcept {
+        const std::size_t count = std::min(frames.size(), out.size());
+        std::size_t succeeded = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const execute_result_t result = execute<Mode>(frames[i], communicator);
+            out[i] = result ? HANDLER_EXECUTE_STATUS::SUCCESS : result.error().code;
+            succeeded += result ? 1 : 0;
+        }
+        return succeeded;
+    }
+
+    /**
+     * @brief Whether a frame is for an idempotent command, see IdempotentCommandT
+     * @param data Raw byte data of the frame
+     * @return bool Whether its ID is that of an idempotent command, false for frames shorter than an ID
+     */
+    [[nodiscard]] static bool idempotent(const serialized_message_view_t data) noexcept {
+        static constexpr std::array<bool, SLOT_COUNT> IDEMPOTENT = makeIdempotentTable();
+        return data.size() >= ID_SIZE && IDEMPOTENT[slotOf(data)];
+    }
+
+    /**
+     * @brief Size table of the registered commands, indexed by dispatch slot, see validateFrames()
+     * @return const FrameSizeTable& The table, built at compile time
+     */
+    [[nodiscard]] static const FrameSizeTable<SLOT_COUNT>& frameSizes() noexcept {
+        static constexpr FrameSizeTable<SLOT_COUNT> FRAME_SIZES = makeFrameSizeTable();
+        return FRAME_SIZES;
+    }
+
+    /**
+     * @brief Checks the ID and size of every frame of a batch against the registered commands
+     *
+     * Frames marked valid are those execute() would construct; the others would be rejected with
+     * ERROR_EMPTY_MESSAGE, ERROR_ID_NOT_FOUND or ERROR_MESSAGE_LENGTH_ERROR. See validateFrames().
+     * A standalone validator, for callers accepting or rejecting a burst as a whole before executing
+     * any of it. executeBatch() does not call it: execute() checks every frame anyway, and checking a
+     * burst up front costs about half as much again as executing it.
+     *
+     * @param frames The frames, only read during the call
+     * @param[out] mask Receives bit i for frames[i], must hold validationMaskWords(frames.size()) words
+     * @return std::size_t The number of valid frames
+     */
+    static std::size_t validateBatch(
+        const std::span<const serialized_message_view_t> frames, const std::span<std::uint64_t> mask
+    ) noexcept {
+        if constexpr (ID_SIZE == 1) {
+            return validateFrames(frames, frameSizes(), mask);
+        }
+        else {
+            // Frames shorter than an ID fall in the last slot, which accepts no size
+            const auto slot_of = [](const serialized_message_view_t frame) {
+                return frame.size() < ID_SIZE ? SLOT_COUNT - 1 : slotOf(frame);
+            };
+            return validateFrames(frames, frameSizes(), slot_of, mask);
         }
-        return {};
     }
 };
+
+/**
+ * @brief Handler without instrumentation, see BasicHandler
+ * @tparam Commands Variadic list of Command-like types
+ */
+template <CommandLike... Commands> using Handler = BasicHandler<NoInstrumentation, Commands...>;
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "message.h"
+#include "result.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace hex_helpers
+{
+/** @brief Entry of DECODE_TABLE for characters that are not hex digits */
+inline constexpr std::uint8_t INVALID = 0xFF;
+
+/**
+ * @brief Builds the table mapping every character to its hex digit value, INVALID if it is not one
+ * @return std::array<std::uint8_t, 256> The table, indexed by unsigned char
+ */
+consteval std::array<std::uint8_t, 256> makeDecodeTable() {
+    std::array<std::uint8_t, 256> table{};
+    table.fill(INVALID);
+    for (std::uint8_t digit = 0; digit < 10; ++digit) {
+        table['0' + digit] = digit;
+    }
+    for (std::uint8_t digit = 0; digit < 6; ++digit) {
+        table['a' + digit] = 10 + digit;
+        table['A' + digit] = 10 + digit;
+    }
+    return table;
+}
+
+/** @brief Hex digit value of every character, INVALID if it is not one */
+inline constexpr std::array<std::uint8_t, 256> DECODE_TABLE = makeDecodeTable();
+
+/** @brief Lowercase hex digits, indexed by value */
+inline constexpr std::array<char, 16> DIGITS = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+};
+} // namespace hex_helpers
+
+/* ―――――――――――――――― Errors ―――――――――――――――― */
+
+/**
+ * @brief Enumeration representing why a hex string could not be decoded
+ */
+enum class HEX_DECODE_STATUS : std::uint8_t
+{
+    ERROR_ODD_LENGTH = 1,      ///< The string has an odd number of digits
+    ERROR_INVALID_DIGIT = 2,   ///< The string holds a character that is not a hex digit
+    ERROR_BUFFER_TOO_SMALL = 3 ///< The decoded bytes do not fit the buffer
+};
+
+/* ―――――――――――――――― Functions ―――――――――――――――― */
+
+/**
+ * @brief Decodes contiguous hex digits (either case, no separators) into a caller-owned buffer
+ *
+ * Each pair of digits is decoded through a 256-entry table, with no allocation, locale or exception,
+ * so that text input can be decoded at the rate frames are executed.
+ *
+ * @param text The hex digits
+ * @param buffer Destination buffer, at least text.size() / 2 bytes
+ * @return Result<serialized_message_view_t, HEX_DECODE_STATUS> The decoded bytes, at the start of buffer
+ */
+[[nodiscard]] inline Result<serialized_message_view_t, HEX_DECODE_STATUS>
+hexDecode(const std::string_view text, const std::span<std::uint8_t> buffer) noexcept {
+    using result_t = Result<serialized_message_view_t, HEX_DECODE_STATUS>;
+    if (text.size() % 2 != 0) {
+        return result_t(UNEXPECT, HEX_DECODE_STATUS::ERROR_ODD_LENGTH);
+    }
+    const std::size_t size = text.size() / 2;
+    if (size > buffer.size()) {
+        return result_t(UNEXPECT, HEX_DECODE_STATUS::ERROR_BUFFER_TOO_SMALL);
+    }
+    std::uint8_t invalid = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::uint8_t high = hex_helpers::DECODE_TABLE[static_cast<unsigned char>(text[2 * i])];
+        const std::uint8_t low = hex_helpers::DECODE_TABLE[static_cast<unsigned char>(text[2 * i + 1])];
+        invalid |= high | low; // only INVALID has the high bits set, checked once at the end
+        buffer[i] = static_cast<std::uint8_t>(high << 4 | (low & 0x0F));
+    }
+    if ((invalid & 0xF0) != 0) {
+        return result_t(UNEXPECT, HEX_DECODE_STATUS::ERROR_INVALID_DIGIT);
+    }
+    return result_t(EXPECT, buffer.first(size));
+}
+
+/**
+ * @brief Encodes bytes as lowercase hex digits into a caller-owned buffer
+ * @param bytes The bytes
+ * @param buffer Destination buffer, at least 2 * bytes.size() characters
+ * @return std::string_view View over the digits, at the start of buffer, empty if buffer is too small
+ */
+[[nodiscard]] inline std::string_view
+hexEncode(const serialized_message_view_t bytes, const std::span<char> buffer) noexcept {
+    if (buffer.size() < 2 * bytes.size()) {
+        return {};
+    }
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        buffer[2 * i] = hex_helpers::DIGITS[bytes[i] >> 4];
+        buffer[2 * i + 1] = hex_helpers::DIGITS[bytes[i] & 0x0F];
+    }
+    return {buffer.data(), 2 * bytes.size()};
+}
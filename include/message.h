@@ -1,8 +1,20 @@
 #pragma once
 
+#include "result.h"
+#include "wire.h"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <new>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -13,8 +25,54 @@
  * Usage: static_assert(UnsignedByte<T>);
  * @tparam T The type to be checked
  */
-template <class T> concept UnsignedByte =
-    std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) == 1; // TODO: enum-friendly variant?
+template <class T> concept UnsignedByte = std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) == 1;
+
+namespace message_helpers
+{
+/**
+ * @brief Integer carried by a command ID type: the type itself, the underlying type of an enum,
+ * or the value type of a WireInt
+ * @tparam T The ID type
+ */
+template <typename T> struct IdInteger
+{
+    using type = T;
+};
+
+template <typename T>
+    requires std::is_enum_v<T>
+struct IdInteger<T>
+{
+    using type = std::underlying_type_t<T>;
+};
+
+template <std::integral T, std::endian Order> struct IdInteger<WireInt<T, Order>>
+{
+    using type = T;
+};
+
+/** @brief Type alias for the integer carried by a command ID type */
+template <typename T> using id_integer_t = typename IdInteger<std::remove_cv_t<T>>::type;
+} // namespace message_helpers
+
+/**
+ * @brief Concept for the type of a command ID: a 1 or 2-byte unsigned integral, or an enum over one
+ * Usage: static_assert(CommandIdT<T>);
+ * @tparam T The type to be checked
+ */
+template <class T> concept CommandIdT =
+    (std::is_integral_v<T> || std::is_enum_v<T>) && !std::is_same_v<std::remove_cv_t<T>, bool> &&
+    std::is_unsigned_v<message_helpers::id_integer_t<T>> && (sizeof(T) == 1 || sizeof(T) == 2);
+
+/**
+ * @brief Concept for the `id` member of a format whose ID has type I
+ * The member is a command ID type as wide as I, or a WireInt over such an integer to fix its byte order.
+ * @tparam M The type of the `id` member
+ * @tparam I The type of the format's ID
+ */
+template <class M, class I> concept IdFieldT =
+    (CommandIdT<M> || std::is_same_v<M, WireInt<message_helpers::id_integer_t<M>, M::ORDER>>) &&
+    std::is_unsigned_v<message_helpers::id_integer_t<M>> && sizeof(M) == sizeof(I);
 
 /**
  * @brief Concept to ensure a message format has a static ID and that `id` is
@@ -28,14 +86,22 @@ template <class T> concept UnsignedByte =
  *     std::array<std::uint8_t, 10> payload;    // etc...
  * }__attribute__((packed)); // packed to avoid padding issues (not strictly required)
  *
+ * Instead of packing, a format can list its wire fields in a fields() tuple, see FieldListFormatT.
+ *
+ * IDs may also be 16-bit or enums, e.g. to go past 256 commands:
+ * struct WideMessageFormat {
+ *     static constexpr std::uint16_t ID = 0x0102;
+ *     be_u16_t id;  // 0x01 then 0x02 on the wire
+ *     le_u32_t data;
+ * };
+ *
  * IMPORTANT:
  * If the type is not trivially copyable,
  * the user will need to use a custom Message constructor and a custom serialize()
  *
  * Requirements:
- *  - `T::ID` is a constant expression, representable in std::uint8_t.
- *  - The type of `T::ID` is a 1-byte unsigned integral (or use the enum-friendly variant below).
- *  - `T` has a non-static data member `id` that is an unsigned 1-byte integral.
+ *  - `T::ID` is a constant expression whose type satisfies CommandIdT (1 or 2-byte unsigned, or an enum over one).
+ *  - `T` has a non-static data member `id` as wide as `T::ID`: an unsigned integral, an enum, or a WireInt.
  *  - `id` is an lvalue (rules out bit-fields/proxies).
  *  - `T` is standard-layout and `offsetof(T, id) == 0`.
  *  - (Optional) `T` is trivially copyable for safe memcpy of the whole struct.
@@ -43,19 +109,321 @@ template <class T> concept UnsignedByte =
  * @tparam T The message format type to be checked.
  */
 template <typename T> concept MessageFormatT =
-    requires { // must expose a `static constexpr std::uint8_t ID`
-        requires UnsignedByte<decltype(T::ID)>;
-        std::integral_constant<std::uint8_t, T::ID>{};
+    requires { // must expose a `static constexpr` command ID
+        requires CommandIdT<std::remove_cv_t<decltype(T::ID)>>;
+        std::integral_constant<
+            message_helpers::id_integer_t<decltype(T::ID)>,
+            static_cast<message_helpers::id_integer_t<decltype(T::ID)>>(T::ID)>{};
     } &&
-    requires(T& x) { // must have a non-static member `std::uint8_t id`
-        requires UnsignedByte<std::remove_cvref_t<decltype(x.id)>>;
+    requires(T& x) { // must have a non-static member `id` matching the ID
+        requires IdFieldT<std::remove_cvref_t<decltype(x.id)>, std::remove_cv_t<decltype(T::ID)>>;
         requires std::is_lvalue_reference_v<decltype((x.id))>;
     } && std::is_standard_layout_v<T> && // layout precondition for using offsetof
     offsetof(T, id) == 0;                // id must be the very first member
 
+/** @brief Type alias for the numeric value of a command ID, wide enough for every CommandIdT */
+using command_id_t = std::uint16_t;
+
 /** @brief Type alias for the serialized message format */
 using serialized_message_t = std::vector<std::uint8_t>;
 
+/** @brief Type alias for a non-owning view over a serialized message */
+using serialized_message_view_t = std::span<const std::uint8_t>;
+
+/**
+ * @brief Concept for variable-length formats: a fixed header followed by a trailing payload
+ *
+ * The format struct itself only describes the fixed header, up to `T::MAX_PAYLOAD_SIZE`
+ * bytes may follow it in the same frame. The received payload is exposed as a view into
+ * the original buffer (no copy), see Message::payload().
+ *
+ * Example of a conforming type:
+ * struct FirmwareChunkFormat {
+ *     static constexpr std::uint8_t ID = 0x20;
+ *     static constexpr std::size_t MAX_PAYLOAD_SIZE = 4096; // bytes allowed after the header
+ *     std::uint8_t id;
+ *     std::uint32_t offset;
+ * }__attribute__((packed));
+ *
+ * @tparam T The message format type to be checked.
+ */
+template <typename T> concept TrailingPayloadFormatT = MessageFormatT<T> && requires {
+    requires std::same_as<std::remove_cv_t<decltype(T::MAX_PAYLOAD_SIZE)>, std::size_t>;
+    std::integral_constant<std::size_t, T::MAX_PAYLOAD_SIZE>{};
+};
+
+namespace message_helpers
+{
+/**
+ * @brief Type of the member a pointer to data member points to
+ * @tparam P The pointer to member type
+ */
+template <typename P> struct MemberPointer
+{};
+
+template <typename M, typename C> struct MemberPointer<M C::*>
+{
+    using class_t = C;  ///< The class of the member
+    using member_t = M; ///< The type of the member
+};
+
+/**
+ * @brief Whether a type is a tuple of pointers to trivially copyable data members of Format
+ * @tparam T The type to be checked
+ * @tparam Format The class the members must belong to
+ */
+template <typename T, typename Format> struct IsFieldList : std::false_type
+{};
+
+template <typename Format, typename... Members>
+struct IsFieldList<std::tuple<Members Format::*...>, Format>
+    : std::bool_constant<sizeof...(Members) != 0 && ((!std::is_function_v<Members>) && ...) &&
+                         (std::is_trivially_copyable_v<Members> && ...)>
+{};
+} // namespace message_helpers
+
+/**
+ * @brief Concept for formats listing their wire fields, so that their structs need no packing
+ *
+ * `T::fields()` returns a constexpr tuple of pointers to the members sent on the wire, `&T::id` first
+ * (a function rather than a constant, as the members of a class cannot be named before it is complete).
+ * The wire holds the listed members back to back in that order, each as its object representation
+ * (use WireInt members to fix a byte order), with none of the padding of the struct. Members are
+ * thus read and written naturally aligned in memory, while the frame stays compact. Listing every
+ * member of a packed struct in declaration order gives the same bytes as reading the struct whole.
+ *
+ * Example of a conforming type:
+ * struct StatusFormat {
+ *     static constexpr std::uint8_t ID = 0x05;
+ *     static constexpr auto fields() {
+ *         return std::tuple{&StatusFormat::id, &StatusFormat::flags, &StatusFormat::value};
+ *     }
+ *     std::uint8_t id;
+ *     std::uint8_t flags;
+ *     std::uint32_t value; // aligned in the struct (8 bytes), at offset 2 of the 6-byte frame
+ * };
+ *
+ * @tparam T The message format type to be checked.
+ */
+template <typename T> concept FieldListFormatT = MessageFormatT<T> && requires {
+    requires message_helpers::IsFieldList<decltype(T::fields()), T>::value;
+    requires std::is_same_v<std::tuple_element_t<0, decltype(T::fields())>, decltype(&T::id)>;
+    requires std::get<0>(T::fields()) == &T::id;
+};
+
+/**
+ * @brief Namespace containing internal helper types and functions for messages
+ */
+namespace message_helpers
+{
+/** @brief Type alias for the field list of a format */
+template <FieldListFormatT MessageFormat> using fields_t = decltype(MessageFormat::fields());
+
+/** @brief Type alias for the type of the field at an index of the field list of a format */
+template <FieldListFormatT MessageFormat, std::size_t I> using field_t =
+    typename MemberPointer<std::tuple_element_t<I, fields_t<MessageFormat>>>::member_t;
+
+/** @brief Index sequence over the field list of a format */
+template <FieldListFormatT MessageFormat> using field_indices_t =
+    std::make_index_sequence<std::tuple_size_v<fields_t<MessageFormat>>>;
+
+/**
+ * @brief Offset of a field on the wire, the sum of the sizes of the fields before it
+ * @tparam MessageFormat The message format
+ * @tparam I The index of the field in the field list
+ * @return std::size_t The offset in bytes
+ */
+template <FieldListFormatT MessageFormat, std::size_t I> consteval std::size_t fieldOffset() {
+    return []<std::size_t... Before>(std::index_sequence<Before...>) {
+        return (std::size_t{0} + ... + sizeof(field_t<MessageFormat, Before>));
+    }(std::make_index_sequence<I>());
+}
+
+/**
+ * @brief Size of the fixed part of a message format on the wire
+ * @tparam MessageFormat The message format
+ * @return std::size_t The size of its listed fields, or of the whole struct if it lists none
+ */
+template <MessageFormatT MessageFormat> consteval std::size_t wireSize() {
+    if constexpr (FieldListFormatT<MessageFormat>) {
+        return fieldOffset<MessageFormat, std::tuple_size_v<fields_t<MessageFormat>>>();
+    }
+    else {
+        return sizeof(MessageFormat);
+    }
+}
+
+/**
+ * @brief Offset on the wire of a member of a format
+ * @tparam MessageFormat The message format
+ * @tparam Member Pointer to the member
+ * @return std::size_t The offset in bytes, wireSize() if the member is not listed in the fields
+ */
+template <FieldListFormatT MessageFormat, auto Member> consteval std::size_t memberWireOffset() {
+    std::size_t offset = wireSize<MessageFormat>();
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        const auto match = [&]<std::size_t Index>() {
+            if constexpr (std::is_same_v<std::tuple_element_t<Index, fields_t<MessageFormat>>, decltype(Member)>) {
+                if (std::get<Index>(MessageFormat::fields()) == Member) {
+                    offset = fieldOffset<MessageFormat, Index>();
+                }
+            }
+        };
+        (match.template operator()<I>(), ...);
+    }(field_indices_t<MessageFormat>());
+    return offset;
+}
+
+/**
+ * @brief Writes the wire representation of the fixed part of a message
+ * @tparam MessageFormat The message format
+ * @param content The structured content
+ * @param out Destination, at least wireSize() bytes
+ */
+template <MessageFormatT MessageFormat>
+void storeContent(const MessageFormat& content, std::uint8_t* const out) noexcept {
+    if constexpr (FieldListFormatT<MessageFormat>) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (std::memcpy(
+                 out + fieldOffset<MessageFormat, I>(),
+                 &(content.*std::get<I>(MessageFormat::fields())),
+                 sizeof(field_t<MessageFormat, I>)
+             ),
+             ...);
+        }(field_indices_t<MessageFormat>());
+    }
+    else {
+        std::memcpy(out, &content, sizeof(MessageFormat));
+    }
+}
+
+/**
+ * @brief Reads the structured content of a message from its wire representation
+ * Members left out of the field list are value-initialized.
+ * @tparam MessageFormat The message format
+ * @param in Source, at least wireSize() bytes
+ * @param content The structured content to fill
+ */
+template <MessageFormatT MessageFormat>
+void loadContent(const std::uint8_t* const in, MessageFormat& content) noexcept {
+    if constexpr (FieldListFormatT<MessageFormat>) {
+        content = MessageFormat{};
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (std::memcpy(
+                 &(content.*std::get<I>(MessageFormat::fields())),
+                 in + fieldOffset<MessageFormat, I>(),
+                 sizeof(field_t<MessageFormat, I>)
+             ),
+             ...);
+        }(field_indices_t<MessageFormat>());
+    }
+    else {
+        std::memcpy(&content, in, sizeof(MessageFormat));
+    }
+}
+
+/**
+ * @brief Empty stand-in for the payload view of fixed-size formats
+ */
+struct NoPayload
+{};
+
+/**
+ * @brief Type of the payload member of a message: a view for trailing-payload formats, empty otherwise
+ * @tparam MessageFormat The message format
+ */
+template <MessageFormatT MessageFormat> using payload_storage_t =
+    std::conditional_t<TrailingPayloadFormatT<MessageFormat>, serialized_message_view_t, NoPayload>;
+
+/**
+ * @brief Smallest valid frame size for a message format
+ * @tparam MessageFormat The message format
+ * @return std::size_t The minimum size in bytes
+ */
+template <MessageFormatT MessageFormat> consteval std::size_t minSize() { return wireSize<MessageFormat>(); }
+
+/**
+ * @brief Largest valid frame size for a message format
+ * @tparam MessageFormat The message format
+ * @return std::size_t The maximum size in bytes
+ */
+template <MessageFormatT MessageFormat> consteval std::size_t maxSize() {
+    if constexpr (TrailingPayloadFormatT<MessageFormat>) {
+        return wireSize<MessageFormat>() + MessageFormat::MAX_PAYLOAD_SIZE;
+    }
+    else {
+        return wireSize<MessageFormat>();
+    }
+}
+
+/** @brief Type alias for the type of the `id` member of a message format */
+template <MessageFormatT MessageFormat> using id_field_t =
+    std::remove_cvref_t<decltype(std::declval<MessageFormat&>().id)>;
+
+/**
+ * @brief Numeric value of a command ID, or of an `id` member
+ * @param id The ID
+ * @return command_id_t The value
+ */
+template <typename T> constexpr command_id_t idValue(const T id) noexcept {
+    if constexpr (std::is_enum_v<T>) {
+        return static_cast<command_id_t>(std::to_underlying(id));
+    }
+    else if constexpr (std::is_integral_v<T>) {
+        return static_cast<command_id_t>(id);
+    }
+    else {
+        return static_cast<command_id_t>(id.value());
+    }
+}
+
+/**
+ * @brief Size of the leading ID of a message format on the wire
+ * @tparam MessageFormat The message format
+ * @return std::size_t The size in bytes, 1 or 2
+ */
+template <MessageFormatT MessageFormat> consteval std::size_t idSize() { return sizeof(id_field_t<MessageFormat>); }
+
+/**
+ * @brief Numeric value of the ID of a message format
+ * @tparam MessageFormat The message format
+ * @return command_id_t The value
+ */
+template <MessageFormatT MessageFormat> consteval command_id_t idKey() { return idValue(MessageFormat::ID); }
+
+/**
+ * @brief Reads the leading ID of raw bytes the way a message format encodes it
+ * @tparam MessageFormat The message format
+ * @param content Raw bytes, at least idSize() long
+ * @return command_id_t The numeric value of the ID
+ */
+template <MessageFormatT MessageFormat>
+command_id_t readId(const serialized_message_view_t content) noexcept {
+    id_field_t<MessageFormat> id;
+    std::memcpy(&id, content.data(), sizeof(id));
+    return idValue(id);
+}
+
+/**
+ * @brief Whether two message formats encode their IDs the same way (same size and byte order)
+ * @tparam A The first message format
+ * @tparam B The second message format
+ * @return bool Whether the same bytes hold the same ID in both formats
+ */
+template <MessageFormatT A, MessageFormatT B> consteval bool sameIdEncoding() {
+    const auto order = []<typename Field>() {
+        if constexpr (requires { Field::ORDER; }) {
+            return Field::ORDER;
+        }
+        else {
+            return std::endian::native;
+        }
+    };
+    const bool same_order = order.template operator()<id_field_t<A>>() == order.template operator()<id_field_t<B>>();
+    return idSize<A>() == idSize<B>() && (idSize<A>() == 1 || same_order);
+}
+} // namespace message_helpers
+
 /* ―――――――――――――――― Exceptions ―――――――――――――――― */
 /**
  * @brief Exception thrown when a message has an invalid length
@@ -100,6 +468,40 @@ class MessageWrongIdError final : public std::invalid_argument
     explicit MessageWrongIdError(const char* what_arg) : std::invalid_argument(what_arg) {}
 };
 
+/* ―――――――――――――――― Errors ―――――――――――――――― */
+/**
+ * @brief Enumeration representing why raw bytes could not be parsed into a message
+ */
+enum class MESSAGE_PARSE_STATUS : std::uint8_t
+{
+    ERROR_LENGTH = 1,   ///< The content size does not match the message format
+    ERROR_WRONG_ID = 2, ///< The leading ID does not match the message format
+};
+
+/**
+ * @brief Structure representing an error that occurred while parsing raw bytes (exception-free counterpart of
+ * MessageLengthError and MessageWrongIdError)
+ */
+struct ParseError
+{
+    /** @brief The status code of the error */
+    MESSAGE_PARSE_STATUS code;
+    /** @brief The expected size or ID */
+    std::size_t expected;
+    /** @brief The actual size or ID */
+    std::size_t got;
+
+    /**
+     * @brief Formats the error the same way the matching exception would
+     * @return std::string A descriptive message about the error
+     */
+    [[nodiscard]] std::string describe() const {
+        const char* prefix =
+            code == MESSAGE_PARSE_STATUS::ERROR_LENGTH ? "Invalid content size, expected " : "Invalid ID, expected ";
+        return prefix + std::to_string(expected) + ", got " + std::to_string(got);
+    }
+};
+
 /* ―――――――――――――――― Classes ―――――――――――――――― */
 
 /**
@@ -113,7 +515,8 @@ class MessageWrongIdError final : public std::invalid_argument
 template <MessageFormatT MessageFormat> class Message
 {
   protected:
-    MessageFormat _content; ///< Structured content of the message
+    MessageFormat _content; ///< Structured content of the message (the fixed header for trailing-payload formats)
+    [[no_unique_address]] message_helpers::payload_storage_t<MessageFormat> _payload{}; ///< Trailing payload view
 
     /**
      * @brief Constructs a Message from structured content
@@ -122,28 +525,36 @@ template <MessageFormatT MessageFormat> class Message
      */
     explicit Message(MessageFormat content) : _content(std::move(content)) {}
 
+    /**
+     * @brief Constructs a Message from a structured header and a trailing payload
+     *
+     * @param content Structured header of the message
+     * @param payload Trailing payload, not copied: it must outlive the message
+     * @throws MessageLengthError if the payload exceeds MessageFormat::MAX_PAYLOAD_SIZE
+     */
+    Message(MessageFormat content, const serialized_message_view_t payload)
+        requires TrailingPayloadFormatT<MessageFormat>
+        : _content(std::move(content)), _payload(payload) {
+        if (payload.size() > MessageFormat::MAX_PAYLOAD_SIZE) {
+            throw MessageLengthError("Payload too large for message format");
+        }
+    }
+
     /**
      * @brief Constructs a Message from raw byte input
      *
-     * @param content Raw byte content of the message
+     * @param content Raw byte content of the message (only read during construction)
      * @throws MessageLengthError if content size is invalid
      * @throws MessageWrongIdError if content size is invalid
      */
-    explicit Message(const std::vector<std::uint8_t>& content)
+    explicit Message(serialized_message_view_t content)
         requires std::is_trivially_copyable_v<MessageFormat>
     {
-        if (content.size() != sizeof(MessageFormat)) {
-            throw MessageLengthError(
-                "Invalid content size, expected " + std::to_string(sizeof(MessageFormat)) + ", got " +
-                std::to_string(content.size())
-            );
-        }
-        if (content.at(0) != MessageFormat::ID) {
-            throw MessageWrongIdError(
-                "Invalid ID, expected " + std::to_string(MessageFormat::ID) + ", got " + std::to_string(content.at(0))
-            );
+        throwIfInvalid(content);
+        message_helpers::loadContent(content.data(), _content);
+        if constexpr (TrailingPayloadFormatT<MessageFormat>) {
+            _payload = content.subspan(message_helpers::wireSize<MessageFormat>());
         }
-        std::memcpy(&_content, content.data(), sizeof(MessageFormat));
     }
 
     /**
@@ -155,7 +566,7 @@ template <MessageFormatT MessageFormat> class Message
      * Usage:
      *     class MyMessage : public Message<MyFormat> {
      *       public:
-     *         MyMessage(const std::vector<std::uint8_t>& content) : Message<MyFormat>(std::in_place, content)
+     *         MyMessage(serialized_message_view_t content) : Message<MyFormat>(std::in_place, content)
      *         { ... }
      *     };
      *
@@ -163,20 +574,13 @@ template <MessageFormatT MessageFormat> class Message
      * @throws MessageLengthError if content size is invalid
      * @throws MessageWrongIdError if content size is invalid
      */
-    explicit Message(std::in_place_t, const std::vector<std::uint8_t>& content) {
-        if (content.size() != sizeof(MessageFormat)) {
-            throw MessageLengthError(
-                "Invalid content size, expected " + std::to_string(sizeof(MessageFormat)) + ", got " +
-                std::to_string(content.size())
-            );
-        }
-        if (content.at(0) != MessageFormat::ID) {
-            throw MessageWrongIdError(
-                "Invalid ID, expected " + std::to_string(MessageFormat::ID) + ", got " + std::to_string(content.at(0))
-            );
-        }
+    explicit Message(std::in_place_t, serialized_message_view_t content) {
+        throwIfInvalid(content);
         _content = MessageFormat{}; // default-initialize all fields
         _content.id = MessageFormat::ID;
+        if constexpr (TrailingPayloadFormatT<MessageFormat>) {
+            _payload = content.subspan(message_helpers::wireSize<MessageFormat>());
+        }
     }
 
   public:
@@ -185,16 +589,127 @@ template <MessageFormatT MessageFormat> class Message
 
     virtual ~Message() = default;
 
+    /**
+     * @brief Checks that raw bytes have the size and ID of this message format, without throwing
+     * For trailing-payload formats, any size from the header size up to MAX_PAYLOAD_SIZE more bytes is valid.
+     *
+     * @param content Raw byte content of the message
+     * @return Result<void, ParseError> Success, or the reason the content is malformed
+     */
+    [[nodiscard]] static Result<void, ParseError> validate(const serialized_message_view_t content) noexcept {
+        constexpr std::size_t MIN_SIZE = message_helpers::minSize<MessageFormat>();
+        constexpr std::size_t MAX_SIZE = message_helpers::maxSize<MessageFormat>();
+        if (content.size() < MIN_SIZE || content.size() > MAX_SIZE) {
+            return unexpected(
+                ParseError{
+                    .code = MESSAGE_PARSE_STATUS::ERROR_LENGTH,
+                    .expected = content.size() < MIN_SIZE ? MIN_SIZE : MAX_SIZE,
+                    .got = content.size()
+                }
+            );
+        }
+        if (const command_id_t id = message_helpers::readId<MessageFormat>(content);
+            id != message_helpers::idKey<MessageFormat>()) {
+            return unexpected(
+                ParseError{
+                    .code = MESSAGE_PARSE_STATUS::ERROR_WRONG_ID,
+                    .expected = message_helpers::idKey<MessageFormat>(),
+                    .got = id,
+                }
+            );
+        }
+        return {};
+    }
+
+    /**
+     * @brief Throwing counterpart of validate(), used by the raw byte constructors
+     * (also usable by message-like types that do not derive from Message, e.g. StaticCommand)
+     *
+     * @param content Raw byte content of the message
+     * @throws MessageLengthError if content size is invalid
+     * @throws MessageWrongIdError if content ID is invalid
+     */
+    static void throwIfInvalid(const serialized_message_view_t content) {
+        const Result checked = validate(content);
+        if (checked) {
+            return;
+        }
+        if (checked.error().code == MESSAGE_PARSE_STATUS::ERROR_LENGTH) {
+            throw MessageLengthError(checked.error().describe());
+        }
+        throw MessageWrongIdError(checked.error().describe());
+    }
+
+    /**
+     * @brief Exception-free factory: validates raw bytes, then constructs the message from them
+     * Malformed content is reported through the Result instead of MessageLengthError/MessageWrongIdError.
+     * Exceptions thrown by the constructor of Self itself (e.g. custom checks) are not caught.
+     *
+     * Usage:
+     *     const Result parsed = ReceivedMessage<MyFormat>::tryParse(raw);
+     *     const Result parsed = MyCommand::tryParse<MyCommand>(raw);
+     *
+     * @tparam Self The concrete message type to construct, must be constructible from serialized_message_view_t
+     * @param content Raw byte content of the message
+     * @return Result<Self, ParseError> The message, or the reason the content is malformed
+     */
+    template <std::derived_from<Message> Self = Message>
+    [[nodiscard]] static Result<Self, ParseError> tryParse(const serialized_message_view_t content) {
+        if (const Result checked = validate(content); !checked) {
+            return Result<Self, ParseError>(UNEXPECT, checked.error());
+        }
+        return Result<Self, ParseError>(EXPECT, Self(content));
+    }
+
     /**
      * @brief Serializes the message content into a byte vector
      *
      * @return serialized_message_t Serialized byte vector of the message content
      */
     [[nodiscard]] virtual serialized_message_t serialize() const {
-        return {
-            reinterpret_cast<const std::uint8_t*>(&_content),
-            reinterpret_cast<const std::uint8_t*>(&_content) + sizeof(MessageFormat)
-        };
+        serialized_message_t serialized(message_helpers::wireSize<MessageFormat>());
+        message_helpers::storeContent(_content, serialized.data());
+        if constexpr (TrailingPayloadFormatT<MessageFormat>) {
+            serialized.insert(serialized.end(), _payload.begin(), _payload.end());
+        }
+        return serialized;
+    }
+
+    /**
+     * @brief Number of bytes serialize() and serializeInto() produce
+     *
+     * @return std::size_t The serialized size of the message
+     */
+    [[nodiscard]] virtual std::size_t serializedSize() const {
+        if constexpr (TrailingPayloadFormatT<MessageFormat>) {
+            return message_helpers::wireSize<MessageFormat>() + _payload.size();
+        }
+        else {
+            return message_helpers::wireSize<MessageFormat>();
+        }
+    }
+
+    /**
+     * @brief Serializes the message content into a caller-owned buffer, without allocating
+     *
+     * Usage:
+     *     std::array<std::uint8_t, sizeof(MyFormat)> buffer{};
+     *     communicator.respondView(SentMessage<MyFormat>(content).serializeInto(buffer));
+     *
+     * @param buffer Destination buffer (e.g. a stack array or a transport TX ring), at least serializedSize() bytes
+     * @return serialized_message_view_t View over the written bytes, at the start of buffer
+     * @throws MessageLengthError if buffer is too small
+     */
+    [[nodiscard]] virtual serialized_message_view_t serializeInto(const std::span<std::uint8_t> buffer) const {
+        const std::size_t size = serializedSize();
+        if (buffer.size() < size) {
+            throw MessageLengthError("Buffer too small to serialize message");
+        }
+        message_helpers::storeContent(_content, buffer.data());
+        if constexpr (TrailingPayloadFormatT<MessageFormat>) {
+            std::ranges::copy(_payload, buffer.begin() + message_helpers::wireSize<MessageFormat>());
+        }
+        return buffer.first(size);
     }
 
     /**
@@ -203,6 +718,19 @@ template <MessageFormatT MessageFormat> class Message
      * @return const MessageFormat& Reference to the structured content
      */
     [[nodiscard]] const MessageFormat& content() const { return _content; }
+
+    /**
+     * @brief Accessor for the trailing payload of variable-length formats
+     * For received messages this is a view into the buffer the message was parsed from (no copy),
+     * so it is only valid as long as that buffer is.
+     *
+     * @return serialized_message_view_t View over the bytes following the fixed header
+     */
+    [[nodiscard]] serialized_message_view_t payload() const
+        requires TrailingPayloadFormatT<MessageFormat>
+    {
+        return _payload;
+    }
 };
 
 /**
@@ -219,11 +747,12 @@ template <MessageFormatT ReceivedMessageFormat> class ReceivedMessage : public M
     /**
      * @brief Constructs a ReceivedMessage from raw byte input
      *
-     * @param content Raw byte content of the received message
+     * @param content Raw byte content of the received message (a std::vector converts implicitly),
+     *                for trailing-payload formats payload() keeps referring to it
      * @throws MessageLengthError if content size is invalid
      * @throws MessageWrongIdError if content size is invalid
      */
-    explicit ReceivedMessage(const serialized_message_t& content) : Message<ReceivedMessageFormat>(content) {}
+    explicit ReceivedMessage(serialized_message_view_t content) : Message<ReceivedMessageFormat>(content) {}
 
     /**
      * @brief Constructs a Message with default content
@@ -234,7 +763,7 @@ template <MessageFormatT ReceivedMessageFormat> class ReceivedMessage : public M
      * Usage:
      *     class MyMessage : public ReceivedMessage<MyFormat> {
      *       public:
-     *         MyMessage(const std::vector<std::uint8_t>& content) : ReceivedMessage<MyFormat>(std::in_place, content)
+     *         MyMessage(serialized_message_view_t content) : ReceivedMessage<MyFormat>(std::in_place, content)
      *         { ... }
      *     };
      *
@@ -242,8 +771,165 @@ template <MessageFormatT ReceivedMessageFormat> class ReceivedMessage : public M
      * @throws MessageLengthError if content size is invalid
      * @throws MessageWrongIdError if content size is invalid
      */
-    ReceivedMessage(std::in_place_t, const serialized_message_t& content)
+    ReceivedMessage(std::in_place_t, serialized_message_view_t content)
         : Message<ReceivedMessageFormat>(std::in_place, content) {}
+
+    /**
+     * @brief Exception-free factory, see Message::tryParse()
+     *
+     * @tparam Self The concrete received message type to construct
+     * @param content Raw byte content of the received message
+     * @return Result<Self, ParseError> The message, or the reason the content is malformed
+     */
+    template <std::derived_from<ReceivedMessage> Self = ReceivedMessage>
+    [[nodiscard]] static Result<Self, ParseError> tryParse(const serialized_message_view_t content) {
+        return Message<ReceivedMessageFormat>::template tryParse<Self>(content);
+    }
+};
+
+/**
+ * @brief Received message read in place: validated once, then every field is read from the source buffer
+ *
+ * Unlike ReceivedMessage, nothing is copied at construction, so a command reading a few fields of a large
+ * frame only touches those bytes. The view refers to the buffer it was constructed from, which must outlive
+ * it (a Handler only builds commands for the duration of execute()).
+ *
+ * Fields are read with get(), one memcpy of the field at its offset, whatever the alignment of the buffer.
+ * Formats with alignment 1 (WireInt fields or packed structs) can also be accessed as a whole through
+ * content(), a reference into the buffer, unless they list their fields (see FieldListFormatT).
+ *
+ * Usage:
+ *     const ReceivedMessageView<ConfigFormat> view(frame);
+ *     const std::uint32_t baudrate = view.get<&ConfigFormat::baudrate>();
+ *
+ * @tparam ReceivedMessageFormat The format of the received message, trivially copyable
+ */
+template <MessageFormatT ReceivedMessageFormat>
+    requires std::is_trivially_copyable_v<ReceivedMessageFormat>
+class ReceivedMessageView
+{
+    serialized_message_view_t _frame; ///< The validated frame, header then trailing payload
+
+    /**
+     * @brief Offset of a member in the frame
+     * Computed on a value-initialized instance, since offsetof() needs the name of the member;
+     * for formats with a field list, this is the offset of the member on the wire instead.
+     * @tparam Member Pointer to the member
+     * @return std::size_t The offset in bytes, folded to a constant by the optimizer
+     */
+    template <auto Member> static std::size_t offsetOfMember() noexcept {
+        if constexpr (FieldListFormatT<ReceivedMessageFormat>) {
+            constexpr std::size_t OFFSET = message_helpers::memberWireOffset<ReceivedMessageFormat, Member>();
+            static_assert(OFFSET < message_helpers::wireSize<ReceivedMessageFormat>(), "Member is not in fields()");
+            return OFFSET;
+        }
+        static const ReceivedMessageFormat probe{};
+        return static_cast<std::size_t>(
+            reinterpret_cast<const std::uint8_t*>(&(probe.*Member)) - reinterpret_cast<const std::uint8_t*>(&probe)
+        );
+    }
+
+  public:
+    /** @brief Type alias for the message format */
+    using message_format_t = ReceivedMessageFormat;
+
+    /**
+     * @brief Validates a frame and keeps a view over it, see Message::validate()
+     *
+     * @param content Raw byte content of the received message, referenced (not copied) by the view
+     * @throws MessageLengthError if content size is invalid
+     * @throws MessageWrongIdError if content ID is invalid
+     */
+    explicit ReceivedMessageView(const serialized_message_view_t content) : _frame(content) {
+        Message<ReceivedMessageFormat>::throwIfInvalid(content);
+    }
+
+    /**
+     * @brief Checks that raw bytes have the size and ID of the format, see Message::validate()
+     *
+     * @param content Raw byte content of the message
+     * @return Result<void, ParseError> Success, or the reason the content is malformed
+     */
+    [[nodiscard]] static Result<void, ParseError> validate(const serialized_message_view_t content) noexcept {
+        return Message<ReceivedMessageFormat>::validate(content);
+    }
+
+    /**
+     * @brief Exception-free factory, see Message::tryParse()
+     *
+     * @tparam Self The concrete view type to construct
+     * @param content Raw byte content of the message
+     * @return Result<Self, ParseError> The view, or the reason the content is malformed
+     */
+    template <std::derived_from<ReceivedMessageView> Self = ReceivedMessageView>
+    [[nodiscard]] static Result<Self, ParseError> tryParse(const serialized_message_view_t content) {
+        if (const Result checked = validate(content); !checked) {
+            return Result<Self, ParseError>(UNEXPECT, checked.error());
+        }
+        return Result<Self, ParseError>(EXPECT, Self(content));
+    }
+
+    /**
+     * @brief Reads one field of the message from the source buffer
+     *
+     * @tparam Member Pointer to the member, e.g. &MyFormat::value
+     * @return The value of the field (a WireInt field converts to its host value)
+     */
+    template <auto Member>
+        requires std::is_member_object_pointer_v<decltype(Member)>
+    [[nodiscard]] auto get() const noexcept {
+        using field_t = std::remove_cvref_t<decltype(std::declval<const ReceivedMessageFormat&>().*Member)>;
+        field_t field;
+        std::memcpy(&field, _frame.data() + offsetOfMember<Member>(), sizeof(field_t));
+        return field;
+    }
+
+    /**
+     * @brief The whole structured content, in place in the source buffer
+     * Only for formats of alignment 1, whose objects may start at any byte of a frame, and whose wire
+     * layout is the struct itself (no field list).
+     *
+     * @return const ReceivedMessageFormat& Reference into the source buffer
+     */
+    [[nodiscard]] const ReceivedMessageFormat& content() const noexcept
+        requires(alignof(ReceivedMessageFormat) == 1 && !FieldListFormatT<ReceivedMessageFormat>)
+    {
+#if defined(__cpp_lib_start_lifetime_as)
+        return *std::start_lifetime_as<const ReceivedMessageFormat>(_frame.data());
+#else
+        // The bytes already hold a valid object representation of the trivially copyable format
+        return *std::launder(reinterpret_cast<const ReceivedMessageFormat*>(_frame.data()));
+#endif
+    }
+
+    /**
+     * @brief Copies the structured content out of the source buffer, as ReceivedMessage does at construction
+     *
+     * @return ReceivedMessageFormat The content
+     */
+    [[nodiscard]] ReceivedMessageFormat load() const noexcept {
+        ReceivedMessageFormat content;
+        message_helpers::loadContent(_frame.data(), content);
+        return content;
+    }
+
+    /**
+     * @brief Accessor for the trailing payload of variable-length formats, see Message::payload()
+     *
+     * @return serialized_message_view_t View over the bytes following the fixed header
+     */
+    [[nodiscard]] serialized_message_view_t payload() const noexcept
+        requires TrailingPayloadFormatT<ReceivedMessageFormat>
+    {
+        return _frame.subspan(message_helpers::wireSize<ReceivedMessageFormat>());
+    }
+
+    /**
+     * @brief The validated frame the view reads from
+     *
+     * @return serialized_message_view_t The frame
+     */
+    [[nodiscard]] serialized_message_view_t frame() const noexcept { return _frame; }
 };
 
 /**
@@ -263,4 +949,15 @@ template <MessageFormatT SentMessageFormat> class SentMessage final : public Mes
      * @param content Structured content of the sent message
      */
     explicit SentMessage(SentMessageFormat content) : Message<SentMessageFormat>(std::move(content)) {}
+
+    /**
+     * @brief Constructs a SentMessage from a structured header and a trailing payload
+     *
+     * @param content Structured header of the sent message
+     * @param payload Trailing payload, not copied: it must outlive the message
+     * @throws MessageLengthError if the payload exceeds SentMessageFormat::MAX_PAYLOAD_SIZE
+     */
+    SentMessage(SentMessageFormat content, const serialized_message_view_t payload)
+        requires TrailingPayloadFormatT<SentMessageFormat>
+        : Message<SentMessageFormat>(std::move(content), payload) {}
 };
@@ -0,0 +1,351 @@
+#pragma once
+
+#include "bounded_queue.h"
+#include "handler.h"
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/** @brief Number of buckets of the execution time histogram, bucket i counts durations below 2^i ns */
+inline constexpr std::size_t METRICS_HISTOGRAM_BUCKETS = 32;
+
+/**
+ * @brief Number of error counters, indexed by HANDLER_EXECUTE_STATUS (index 0, SUCCESS, is unused)
+ *
+ * Follows the highest status, ERROR_OVERLOADED: a status added after it must be named here.
+ */
+inline constexpr std::size_t METRICS_ERROR_KINDS =
+    static_cast<std::size_t>(HANDLER_EXECUTE_STATUS::ERROR_OVERLOADED) + 1;
+
+/**
+ * @brief Counters of one command ID, copied out of CommandMetrics
+ */
+struct CommandSnapshot
+{
+    command_id_t id = 0;                                              ///< The command ID
+    std::uint64_t invocations = 0;                                    ///< Executions, successful or not
+    std::array<std::uint64_t, METRICS_ERROR_KINDS> errors{};          ///< Failed executions by HANDLER_EXECUTE_STATUS
+    std::array<std::uint64_t, METRICS_HISTOGRAM_BUCKETS> histogram{}; ///< Executions by log2 of their duration
+    std::uint64_t total_nanoseconds = 0;                              ///< Sum of the execution durations
+
+    /**
+     * @brief Number of failed executions with a given status
+     * @param status The status
+     * @return std::uint64_t The number of executions
+     */
+    [[nodiscard]] std::uint64_t errorCount(const HANDLER_EXECUTE_STATUS status) const noexcept {
+        return errors[static_cast<std::size_t>(status)];
+    }
+};
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Per command ID counters: invocations, errors by status and an execution time histogram
+ *
+ * Every ID has its own cache-line aligned cell updated with relaxed atomic increments, so recording
+ * costs a few uncontended atomic adds and commands executed on different threads do not share lines.
+ * Readers get a consistent view of each counter, not across counters.
+ *
+ * Cells are claimed by the first execution of an ID, probing linearly from the low byte of the ID,
+ * so one-byte IDs always get their own cell at once. At most CELLS distinct IDs are tracked; the
+ * executions of further IDs are only counted by droppedRecords(). Executions rejected with
+ * ERROR_ID_NOT_FOUND never claim a cell: they share the unknownIds() bucket whatever their ID, so
+ * frames with made-up wide IDs cannot use up the cells of the registered commands.
+ *
+ * Usage:
+ *     inline CommandMetrics metrics;
+ *     using MyHandler = BasicHandler<MetricsInstrumentation<metrics>, Commands...>;
+ *     exporter.serve(metrics.toPrometheus());
+ */
+class CommandMetrics
+{
+    /** @brief Counters of one command ID */
+    struct alignas(CACHE_LINE_SIZE) Cell
+    {
+        std::atomic<std::uint64_t> invocations{0};
+        std::atomic<std::uint64_t> total_nanoseconds{0};
+        std::array<std::atomic<std::uint64_t>, METRICS_ERROR_KINDS> errors{};
+        std::array<std::atomic<std::uint64_t>, METRICS_HISTOGRAM_BUCKETS> histogram{};
+    };
+
+  public:
+    /** @brief Number of distinct command IDs tracked */
+    static constexpr std::size_t CELLS = 256;
+
+  private:
+    std::array<Cell, CELLS> _cells{};
+    std::array<std::atomic<std::uint32_t>, CELLS> _ids{}; ///< ID + 1 of the owner of each cell, 0 if free
+    Cell _unknown{};                                      ///< Executions of IDs no command is registered for
+    std::atomic<std::uint64_t> _dropped{0};
+
+    /**
+     * @brief Finds the cell of an ID
+     * @param id The command ID
+     * @return std::size_t The cell, or CELLS if the ID has none
+     */
+    [[nodiscard]] std::size_t findCell(const command_id_t id) const noexcept {
+        const std::uint32_t owner = std::uint32_t{id} + 1;
+        for (std::size_t probe = 0; probe < CELLS; ++probe) {
+            const std::uint32_t current = _ids[(id + probe) % CELLS].load(std::memory_order_acquire);
+            if (current == owner) {
+                return (id + probe) % CELLS;
+            }
+            if (current == 0) {
+                break; // cells are never released, so the ID would own this one
+            }
+        }
+        return CELLS;
+    }
+
+    /**
+     * @brief Finds the cell of an ID, claiming the first free one if it has none
+     * @param id The command ID
+     * @return std::size_t The cell, or CELLS if every cell is owned by another ID
+     */
+    std::size_t claimCell(const command_id_t id) noexcept {
+        const std::uint32_t owner = std::uint32_t{id} + 1;
+        for (std::size_t probe = 0; probe < CELLS; ++probe) {
+            std::atomic<std::uint32_t>& cell = _ids[(id + probe) % CELLS];
+            std::uint32_t current = cell.load(std::memory_order_acquire);
+            // On failure current receives the owner that won the cell, possibly the same ID
+            if ((current == 0 && cell.compare_exchange_strong(current, owner)) || current == owner) {
+                return (id + probe) % CELLS;
+            }
+        }
+        return CELLS;
+    }
+
+    /**
+     * @brief Copies the counters of a cell
+     * @param cell The cell
+     * @param id The command ID reported in the snapshot
+     * @return CommandSnapshot The counters
+     */
+    [[nodiscard]] static CommandSnapshot copyCell(const Cell& cell, const command_id_t id) noexcept {
+        CommandSnapshot snapshot{
+            .id = id,
+            .invocations = cell.invocations.load(std::memory_order_relaxed),
+            .total_nanoseconds = cell.total_nanoseconds.load(std::memory_order_relaxed),
+        };
+        for (std::size_t i = 0; i < METRICS_ERROR_KINDS; ++i) {
+            snapshot.errors[i] = cell.errors[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < METRICS_HISTOGRAM_BUCKETS; ++i) {
+            snapshot.histogram[i] = cell.histogram[i].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    /**
+     * @brief Zeroes the counters of a cell
+     * @param cell The cell
+     */
+    static void clearCell(Cell& cell) noexcept {
+        cell.invocations.store(0, std::memory_order_relaxed);
+        cell.total_nanoseconds.store(0, std::memory_order_relaxed);
+        for (std::atomic<std::uint64_t>& counter : cell.errors) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (std::atomic<std::uint64_t>& counter : cell.histogram) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief Appends a metric line: name{labels} value */
+    static void appendLine(
+        std::string& out, const std::string_view name, const std::string_view labels, const std::uint64_t value
+    ) {
+        out.append(name);
+        out.push_back('{');
+        out.append(labels);
+        out.append("} ");
+        out.append(std::to_string(value));
+        out.push_back('\n');
+    }
+
+  public:
+    CommandMetrics() = default;
+    CommandMetrics(const CommandMetrics&) = delete;
+    CommandMetrics& operator=(const CommandMetrics&) = delete;
+
+    /**
+     * @brief Bucket of the histogram counting a duration
+     * @param nanoseconds The duration
+     * @return std::size_t The bucket, the last one also counts every longer duration
+     */
+    [[nodiscard]] static constexpr std::size_t bucketOf(const std::uint64_t nanoseconds) noexcept {
+        const auto bucket = static_cast<std::size_t>(std::bit_width(nanoseconds));
+        return bucket < METRICS_HISTOGRAM_BUCKETS ? bucket : METRICS_HISTOGRAM_BUCKETS - 1;
+    }
+
+    /**
+     * @brief Upper bound of a histogram bucket
+     * @param bucket The bucket
+     * @return std::uint64_t Durations counted by the bucket are below this bound (in nanoseconds)
+     */
+    [[nodiscard]] static constexpr std::uint64_t bucketBound(const std::size_t bucket) noexcept {
+        return std::uint64_t{1} << bucket;
+    }
+
+    /**
+     * @brief Records one execution
+     *
+     * @param id The command ID
+     * @param result The result of the execution, ERROR_ID_NOT_FOUND is recorded under unknownIds()
+     * @param nanoseconds The duration of the execution
+     */
+    void record(const command_id_t id, const handler_result_t& result, const std::uint64_t nanoseconds) noexcept {
+        const bool unknown = !result && result.error().code == HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND;
+        const std::size_t index = unknown ? CELLS : claimCell(id);
+        if (!unknown && index == CELLS) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Cell& cell = unknown ? _unknown : _cells[index];
+        cell.invocations.fetch_add(1, std::memory_order_relaxed);
+        cell.total_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        cell.histogram[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        if (!result) {
+            const auto kind = static_cast<std::size_t>(result.error().code);
+            if (kind < METRICS_ERROR_KINDS) {
+                cell.errors[kind].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Copies the counters of one command ID
+     * @param id The command ID
+     * @return CommandSnapshot The counters, all zero if the ID was never executed
+     */
+    [[nodiscard]] CommandSnapshot snapshot(const command_id_t id) const noexcept {
+        const std::size_t index = findCell(id);
+        if (index == CELLS) {
+            return CommandSnapshot{.id = id};
+        }
+        return copyCell(_cells[index], id);
+    }
+
+    /**
+     * @brief Copies the counters shared by every ID no command is registered for
+     * @return CommandSnapshot The counters, with id 0; every execution counts as ERROR_ID_NOT_FOUND
+     */
+    [[nodiscard]] CommandSnapshot unknownIds() const noexcept { return copyCell(_unknown, 0); }
+
+    /**
+     * @brief Copies the counters of every command ID executed at least once
+     * @return std::vector<CommandSnapshot> The counters, by increasing ID, without unknownIds()
+     */
+    [[nodiscard]] std::vector<CommandSnapshot> snapshot() const {
+        std::vector<CommandSnapshot> snapshots;
+        for (std::size_t cell = 0; cell < CELLS; ++cell) {
+            const std::uint32_t owner = _ids[cell].load(std::memory_order_acquire);
+            if (owner != 0 && _cells[cell].invocations.load(std::memory_order_relaxed) != 0) {
+                snapshots.push_back(snapshot(static_cast<command_id_t>(owner - 1)));
+            }
+        }
+        std::ranges::sort(snapshots, {}, &CommandSnapshot::id);
+        return snapshots;
+    }
+
+    /**
+     * @brief Number of executions not recorded because CELLS distinct IDs were already tracked
+     * @return std::uint64_t The number of executions
+     */
+    [[nodiscard]] std::uint64_t droppedRecords() const noexcept { return _dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Formats the counters in the Prometheus text exposition format
+     *
+     * Exports `<prefix>_command_invocations_total`, `<prefix>_command_errors_total` (labelled by status)
+     * and the `<prefix>_command_duration_nanoseconds` histogram, each labelled by command ID, the
+     * unknownIds() bucket as `id="unknown"` once it counted an execution.
+     *
+     * @param prefix The metric name prefix
+     * @return std::string The exposition text
+     */
+    [[nodiscard]] std::string toPrometheus(const std::string_view prefix = "libcmd") const {
+        const std::string prefix_string(prefix);
+        const std::string invocations = prefix_string + "_command_invocations_total";
+        const std::string errors = prefix_string + "_command_errors_total";
+        const std::string duration = prefix_string + "_command_duration_nanoseconds";
+
+        std::vector<std::pair<std::string, CommandSnapshot>> series; // id label and counters
+        for (const CommandSnapshot& command : snapshot()) {
+            series.emplace_back("id=\"" + std::to_string(command.id) + '"', command);
+        }
+        if (const CommandSnapshot unknown = unknownIds(); unknown.invocations != 0) {
+            series.emplace_back("id=\"unknown\"", unknown);
+        }
+
+        std::string out;
+        out.append("# TYPE ").append(invocations).append(" counter\n");
+        for (const auto& [id_label, command] : series) {
+            appendLine(out, invocations, id_label, command.invocations);
+        }
+        out.append("# TYPE ").append(errors).append(" counter\n");
+        for (const auto& [id_label, command] : series) {
+            for (std::size_t kind = 1; kind < METRICS_ERROR_KINDS; ++kind) {
+                appendLine(out, errors, id_label + ",status=\"" + std::to_string(kind) + '"', command.errors[kind]);
+            }
+        }
+        out.append("# TYPE ").append(duration).append(" histogram\n");
+        for (const auto& [id_label, command] : series) {
+            std::uint64_t cumulative = 0;
+            for (std::size_t bucket = 0; bucket + 1 < METRICS_HISTOGRAM_BUCKETS; ++bucket) {
+                cumulative += command.histogram[bucket];
+                appendLine(
+                    out,
+                    duration + "_bucket",
+                    id_label + ",le=\"" + std::to_string(bucketBound(bucket) - 1) + '"',
+                    cumulative
+                );
+            }
+            appendLine(out, duration + "_bucket", id_label + ",le=\"+Inf\"", command.invocations);
+            appendLine(out, duration + "_sum", id_label, command.total_nanoseconds);
+            appendLine(out, duration + "_count", id_label, command.invocations);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Zeroes every counter (not atomic with respect to concurrent record() calls)
+     */
+    void reset() noexcept {
+        for (std::atomic<std::uint32_t>& owner : _ids) {
+            owner.store(0, std::memory_order_relaxed);
+        }
+        _dropped.store(0, std::memory_order_relaxed);
+        for (Cell& cell : _cells) {
+            clearCell(cell);
+        }
+        clearCell(_unknown);
+    }
+};
+
+/**
+ * @brief Instrumentation policy of BasicHandler recording into a CommandMetrics with static storage duration
+ *
+ * Usage: BasicHandler<MetricsInstrumentation<metrics>, Commands...>
+ *
+ * @tparam Metrics The metrics recorded into
+ */
+template <CommandMetrics& Metrics> struct MetricsInstrumentation
+{
+    static constexpr bool ENABLED = true;
+
+    static void
+    record(const command_id_t id, const handler_result_t& result, const std::uint64_t nanoseconds) noexcept {
+        Metrics.record(id, result, nanoseconds);
+    }
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * @brief Perfect hash of N distinct 16-bit keys, built at compile time (hash and displace)
+ *
+ * Keys are first spread over BUCKETS buckets, then every bucket gets a seed chosen so that its keys
+ * land on free slots of a table of SLOTS = 2 * BUCKETS entries. A lookup therefore costs two hash
+ * evaluations, one seed load and one key comparison, whatever the number of keys, and the tables
+ * stay proportional to N (a 16-bit ID space would otherwise need 65536 entries).
+ *
+ * Usage:
+ *     static constexpr PerfectHash<3> HASH({0x0101, 0x0102, 0x0201});
+ *     const std::size_t slot = HASH.find(key); // HASH.SLOTS if key is not one of the keys
+ *
+ * @tparam N The number of keys
+ */
+template <std::size_t N> class PerfectHash
+{
+  public:
+    /** @brief Number of buckets, a power of two */
+    static constexpr std::size_t BUCKETS = std::bit_ceil(N == 0 ? std::size_t{1} : N);
+    /** @brief Number of slots, a power of two; find() returns SLOTS for unknown keys */
+    static constexpr std::size_t SLOTS = 2 * BUCKETS;
+
+  private:
+    static_assert(SLOTS <= 65536, "PerfectHash holds at most 32768 keys");
+
+    /** @brief Key of empty slots, outside the 16-bit range so that no key matches it */
+    static constexpr std::uint32_t EMPTY = 0x10000U;
+
+    std::array<std::uint16_t, BUCKETS> _seeds{};
+    std::array<std::uint32_t, SLOTS> _keys{};
+
+    /**
+     * @brief Mixes a key with a seed (lowbias32 finalizer)
+     * @param key The key
+     * @param seed The seed, 0 for the bucket hash
+     * @return std::uint32_t The hash
+     */
+    [[nodiscard]] static constexpr std::uint32_t mix(const std::uint32_t key, const std::uint32_t seed) noexcept {
+        std::uint32_t x = key ^ (seed * 0x9E3779B9U);
+        x ^= x >> 16U;
+        x *= 0x7FEB352DU;
+        x ^= x >> 15U;
+        x *= 0x846CA68BU;
+        x ^= x >> 16U;
+        return x;
+    }
+
+    [[nodiscard]] static constexpr std::size_t bucketOf(const std::uint32_t key) noexcept {
+        return mix(key, 0) & (BUCKETS - 1);
+    }
+
+    [[nodiscard]] static constexpr std::size_t slotOf(const std::uint32_t key, const std::uint32_t seed) noexcept {
+        return mix(key, seed) & (SLOTS - 1);
+    }
+
+  public:
+    /**
+     * @brief Builds the hash of a set of keys
+     * @param keys The keys
+     * @throws std::invalid_argument (at compile time) if two keys are equal
+     */
+    consteval explicit PerfectHash(const std::array<std::uint16_t, N>& keys) {
+        _keys.fill(EMPTY);
+
+        // Counting sort of the keys by bucket
+        std::array<std::size_t, BUCKETS + 1> offsets{};
+        for (const std::uint16_t key : keys) {
+            ++offsets[bucketOf(key) + 1];
+        }
+        std::size_t largest = 0;
+        for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            largest = offsets[bucket + 1] > largest ? offsets[bucket + 1] : largest;
+            offsets[bucket + 1] += offsets[bucket];
+        }
+        std::array<std::uint16_t, N> sorted{};
+        std::array<std::size_t, BUCKETS + 1> fill = offsets;
+        for (const std::uint16_t key : keys) {
+            sorted[fill[bucketOf(key)]++] = key;
+        }
+        for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) { // equal keys share a bucket
+            for (std::size_t i = offsets[bucket]; i < offsets[bucket + 1]; ++i) {
+                for (std::size_t j = offsets[bucket]; j < i; ++j) {
+                    if (sorted[i] == sorted[j]) {
+                        throw std::invalid_argument("Duplicate keys in PerfectHash");
+                    }
+                }
+            }
+        }
+
+        // Largest buckets first, while most slots are still free
+        for (std::size_t size = largest; size > 0; --size) {
+            for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                if (offsets[bucket + 1] - offsets[bucket] != size) {
+                    continue;
+                }
+                for (std::uint32_t seed = 1;; ++seed) {
+                    if (seed > 0xFFFFU) {
+                        throw std::logic_error("No PerfectHash seed places the bucket");
+                    }
+                    bool free = true;
+                    for (std::size_t i = offsets[bucket]; free && i < offsets[bucket + 1]; ++i) {
+                        const std::size_t slot = slotOf(sorted[i], seed);
+                        free = _keys[slot] == EMPTY;
+                        for (std::size_t j = offsets[bucket]; free && j < i; ++j) {
+                            free = slotOf(sorted[j], seed) != slot;
+                        }
+                    }
+                    if (free) {
+                        _seeds[bucket] = static_cast<std::uint16_t>(seed);
+                        for (std::size_t i = offsets[bucket]; i < offsets[bucket + 1]; ++i) {
+                            _keys[slotOf(sorted[i], seed)] = sorted[i];
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Slot of a key, only meaningful for one of the keys, see find()
+     * @param key The key
+     * @return std::size_t The slot, below SLOTS
+     */
+    [[nodiscard]] constexpr std::size_t slot(const std::uint16_t key) const noexcept {
+        return slotOf(key, _seeds[bucketOf(key)]);
+    }
+
+    /**
+     * @brief Slot of a key
+     * @param key The key
+     * @return std::size_t The slot of key, or SLOTS if key is not one of the keys
+     */
+    [[nodiscard]] constexpr std::size_t find(const std::uint16_t key) const noexcept {
+        const std::size_t candidate = slot(key);
+        return _keys[candidate] == key ? candidate : SLOTS;
+    }
+};
@@ -0,0 +1,396 @@
+#pragma once
+
+#include "communication.h"
+#include "message.h"
+#include "task.h"
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* ―――――――――――――――― Envelope ―――――――――――――――― */
+
+/**
+ * @brief Kind of a pipelined frame
+ */
+enum class PIPELINE_FRAME_KIND : std::uint8_t
+{
+    REQUEST = 0,  ///< Upstream to downstream, the body is the request message
+    RESPONSE = 1, ///< Downstream to upstream, the body is one response message
+    COMPLETE = 2, ///< Downstream to upstream, the body is the one-byte REQUEST_STATUS ending the request
+};
+
+/** @brief Size of the envelope header: little-endian 16-bit token, then the kind */
+inline constexpr std::size_t PIPELINE_HEADER_SIZE = 3;
+
+/**
+ * @brief A decoded pipelined frame
+ */
+struct PipelineEnvelope
+{
+    std::uint16_t token;            ///< Correlation token chosen by the requester, echoed by the device
+    PIPELINE_FRAME_KIND kind;       ///< What the body holds
+    serialized_message_view_t body; ///< View over the frame after the header
+};
+
+/**
+ * @brief Writes a pipelined frame: header then body
+ *
+ * @param envelope The token, kind and body
+ * @param buffer Destination buffer, at least PIPELINE_HEADER_SIZE + body size bytes
+ * @return serialized_message_view_t View over the frame, at the start of buffer
+ * @throws std::length_error if buffer is too small
+ */
+inline serialized_message_view_t
+encodeEnvelope(const PipelineEnvelope& envelope, const std::span<std::uint8_t> buffer) {
+    if (buffer.size() < PIPELINE_HEADER_SIZE + envelope.body.size()) {
+        throw std::length_error("Buffer too small for pipelined frame");
+    }
+    buffer[0] = static_cast<std::uint8_t>(envelope.token & 0xFFU);
+    buffer[1] = static_cast<std::uint8_t>(envelope.token >> 8U);
+    buffer[2] = static_cast<std::uint8_t>(envelope.kind);
+    if (!envelope.body.empty()) {
+        std::memcpy(buffer.data() + PIPELINE_HEADER_SIZE, envelope.body.data(), envelope.body.size());
+    }
+    return buffer.first(PIPELINE_HEADER_SIZE + envelope.body.size());
+}
+
+/**
+ * @brief Reads a pipelined frame
+ * @param frame The frame
+ * @return std::optional<PipelineEnvelope> The envelope, or nullopt if the frame is shorter than a header
+ */
+inline std::optional<PipelineEnvelope> decodeEnvelope(const serialized_message_view_t frame) noexcept {
+    if (frame.size() < PIPELINE_HEADER_SIZE) {
+        return std::nullopt;
+    }
+    return PipelineEnvelope{
+        .token = static_cast<std::uint16_t>(frame[0] | (frame[1] << 8U)),
+        .kind = static_cast<PIPELINE_FRAME_KIND>(frame[2]),
+        .body = frame.subspan(PIPELINE_HEADER_SIZE),
+    };
+}
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Communicator keeping up to MaxInFlight requests outstanding on one downstream link
+ *
+ * Each request is wrapped in an envelope carrying a correlation token and sent right away through
+ * the FrameSink; the downstream device answers with RESPONSE frames and one COMPLETE frame echoing
+ * the token, in any order across requests. Frames read from the link are fed to onDownstreamFrame(),
+ * which routes them to the right request. Requests are started with asyncRequest() (see Communicator),
+ * so one thread can fill the link's bandwidth-delay product; the blocking request() overloads still work.
+ *
+ * The token holds the in-flight table slot in its low bits and the slot's generation in its high bits,
+ * so a late frame for a request that already completed is never routed to the slot's next request.
+ * When the table is full, requests complete immediately with ERROR_BUSY. A request that gets no COMPLETE
+ * frame within the timeout is expired by a watchdog thread: its slot is freed and it completes with
+ * ERROR_TIMEOUT, on that thread, so that request(), syncWait() and ~AsyncRequest() never block for good.
+ *
+ * Responses to upstream (respond()) are forwarded to the upstream communicator unchanged.
+ *
+ * @tparam MaxInFlight The size of the in-flight table, a power of two up to 4096
+ * @tparam MaxRequestSize The largest request message, longer ones complete with ERROR_COMMUNICATION
+ */
+template <std::size_t MaxInFlight = 64, std::size_t MaxRequestSize = 256>
+class PipelinedCommunicator final : public Communicator
+{
+    static_assert(
+        std::has_single_bit(MaxInFlight) && MaxInFlight <= 4096, "MaxInFlight must be a power of two up to 4096"
+    );
+
+    static constexpr std::uint16_t SLOT_MASK = MaxInFlight - 1;
+    static constexpr std::uint16_t GENERATION_STEP = MaxInFlight;
+
+    /** @brief An in-flight table slot */
+    struct Slot
+    {
+        RequestCompletion* completion = nullptr;         ///< The request, nullptr when free
+        std::uint16_t token = 0;                         ///< Token of the request, slot index in the low bits
+        std::chrono::steady_clock::time_point deadline{}; ///< When the request expires
+    };
+
+    FrameSink& _downstream;
+    const Communicator& _upstream;
+    const std::chrono::steady_clock::duration _timeout;
+    mutable std::mutex _mutex;
+    mutable std::condition_variable_any _wake; ///< Wakes the watchdog when the table stops being empty
+    mutable std::array<Slot, MaxInFlight> _slots{};
+    mutable std::array<std::uint16_t, MaxInFlight> _free{}; ///< Stack of free slot indexes
+    mutable std::size_t _free_count = MaxInFlight;
+    std::jthread _watchdog; ///< Declared last, so that it stops before the table is destroyed
+
+    /**
+     * @brief Claims a free slot for a request
+     * @param completion The request
+     * @return std::optional<std::uint16_t> The token of the request, or nullopt if the table is full
+     */
+    std::optional<std::uint16_t> acquire(RequestCompletion& completion) const {
+        const std::scoped_lock lock(_mutex);
+        if (_free_count == 0) {
+            return std::nullopt;
+        }
+        Slot& slot = _slots[_free[--_free_count]];
+        slot.token = static_cast<std::uint16_t>(slot.token + GENERATION_STEP);
+        slot.completion = &completion;
+        slot.deadline = std::chrono::steady_clock::now() + _timeout;
+        if (_free_count == MaxInFlight - 1) {
+            _wake.notify_one(); // deadlines only grow, so the watchdog only waits for the first request
+        }
+        return slot.token;
+    }
+
+    /**
+     * @brief Frees the slot of a token, called with the lock held
+     * @param token The token
+     * @return RequestCompletion* The request, now owned by the caller who completes it, or nullptr if the
+     * token is unknown or stale
+     */
+    RequestCompletion* releaseLocked(const std::uint16_t token) const {
+        Slot& slot = _slots[token & SLOT_MASK];
+        if (slot.completion == nullptr || slot.token != token) {
+            return nullptr;
+        }
+        _free[_free_count++] = token & SLOT_MASK;
+        return std::exchange(slot.completion, nullptr);
+    }
+
+    /**
+     * @brief Frees the slot of a token, see releaseLocked()
+     * @param token The token
+     * @return RequestCompletion* The request, or nullptr if the token is unknown or stale
+     */
+    RequestCompletion* release(const std::uint16_t token) const {
+        const std::scoped_lock lock(_mutex);
+        return releaseLocked(token);
+    }
+
+    /**
+     * @brief Delivers a response to the request of a token
+     *
+     * The lock is held during the delivery, so that the request cannot be completed (and destroyed)
+     * by the watchdog, cancelAll() or a failed send meanwhile.
+     *
+     * @param token The token
+     * @param response The response
+     * @return bool Whether the token belongs to a request in flight
+     */
+    bool deliver(const std::uint16_t token, const serialized_message_view_t response) const {
+        const std::scoped_lock lock(_mutex);
+        const Slot& slot = _slots[token & SLOT_MASK];
+        if (slot.completion == nullptr || slot.token != token) {
+            return false;
+        }
+        slot.completion->deliver(response);
+        return true;
+    }
+
+    /**
+     * @brief Expires the requests past their deadline until stopped
+     * @param stop Stop token of the watchdog thread
+     */
+    void watch(const std::stop_token stop) const {
+        std::array<RequestCompletion*, MaxInFlight> expired{};
+        std::unique_lock lock(_mutex);
+        while (!stop.stop_requested()) {
+            if (_free_count == MaxInFlight) {
+                _wake.wait(lock, stop, [this] { return _free_count != MaxInFlight; });
+                continue;
+            }
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::time_point next = std::chrono::steady_clock::time_point::max();
+            std::size_t count = 0;
+            for (const Slot& slot : _slots) {
+                if (slot.completion == nullptr) {
+                    continue;
+                }
+                if (slot.deadline <= now) {
+                    expired[count++] = releaseLocked(slot.token);
+                }
+                else {
+                    next = std::min(next, slot.deadline);
+                }
+            }
+            if (count != 0) {
+                // Completed outside the lock: a resumed coroutine may start its next request right away
+                lock.unlock();
+                for (std::size_t i = 0; i < count; ++i) {
+                    expired[i]->complete(REQUEST_STATUS::ERROR_TIMEOUT);
+                }
+                lock.lock();
+                continue;
+            }
+            _wake.wait_until(lock, stop, next, [] { return false; });
+        }
+    }
+
+    /**
+     * @brief Whether a COMPLETE body holds a REQUEST_STATUS
+     * @param status The status byte
+     * @return bool Whether it is one of the REQUEST_STATUS values
+     */
+    static constexpr bool isRequestStatus(const std::uint8_t status) noexcept {
+        return status <= static_cast<std::uint8_t>(REQUEST_STATUS::ERROR_BUSY);
+    }
+
+  public:
+    /**
+     * @brief Constructs the communicator
+     *
+     * @param downstream Sink the enveloped requests are sent through
+     * @param upstream Communicator receiving respond() calls
+     * @param timeout How long a request waits for its COMPLETE frame
+     */
+    PipelinedCommunicator(
+        FrameSink& downstream,
+        const Communicator& upstream,
+        const std::chrono::steady_clock::duration timeout = std::chrono::seconds(1)
+    )
+        : _downstream(downstream), _upstream(upstream), _timeout(timeout) {
+        for (std::size_t i = 0; i < MaxInFlight; ++i) {
+            _slots[i].token = static_cast<std::uint16_t>(i);
+            _free[i] = static_cast<std::uint16_t>(MaxInFlight - 1 - i);
+        }
+        _watchdog = std::jthread([this](const std::stop_token stop) { watch(stop); });
+    }
+
+    void respond(const std::vector<std::uint8_t>& response) const override { _upstream.respond(response); }
+
+    void respondView(const std::span<const std::uint8_t> response) const override { _upstream.respondView(response); }
+
+    /**
+     * @brief Sends the enveloped request and registers it in the in-flight table
+     *
+     * @param message The request message to send, only valid during the call
+     * @param completion Receives the responses and the final status
+     */
+    void startRequest(const std::span<const std::uint8_t> message, RequestCompletion& completion) const override {
+        if (message.size() > MaxRequestSize) {
+            completion.complete(REQUEST_STATUS::ERROR_COMMUNICATION);
+            return;
+        }
+        const std::optional<std::uint16_t> token = acquire(completion);
+        if (!token) {
+            completion.complete(REQUEST_STATUS::ERROR_BUSY);
+            return;
+        }
+        std::array<std::uint8_t, PIPELINE_HEADER_SIZE + MaxRequestSize> buffer{};
+        const PipelineEnvelope envelope{.token = *token, .kind = PIPELINE_FRAME_KIND::REQUEST, .body = message};
+        try {
+            _downstream.send(encodeEnvelope(envelope, buffer));
+        }
+        catch (...) {
+            if (release(*token) != nullptr) { // unless the device already answered or it expired
+                completion.complete(REQUEST_STATUS::ERROR_COMMUNICATION);
+            }
+        }
+    }
+
+    /**
+     * @brief Blocks until every response was handled, other requests stay in flight meanwhile
+     *
+     * @param message The request message to send
+     * @param handle_response_callback Callback invoked with each response
+     * @return REQUEST_STATUS The status sent by the device, or ERROR_TIMEOUT
+     */
+    [[nodiscard]] REQUEST_STATUS requestView(
+        const std::span<const std::uint8_t> message, const response_callback_t handle_response_callback
+    ) const override {
+        return syncWait([](const PipelinedCommunicator& self,
+                           const std::span<const std::uint8_t> request_message,
+                           const response_callback_t callback) -> Task<REQUEST_STATUS> {
+            co_return co_await self.asyncRequest(request_message, callback);
+        }(*this, message, handle_response_callback));
+    }
+
+    [[nodiscard]] REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& message, std::function<void(std::vector<uint8_t>)> handle_response_callback
+    ) const override {
+        return requestView(
+            std::span<const std::uint8_t>(message),
+            [&handle_response_callback](const std::span<const std::uint8_t> response) {
+                handle_response_callback(std::vector<std::uint8_t>(response.begin(), response.end()));
+            }
+        );
+    }
+
+    /**
+     * @brief Routes a frame read from the downstream link to its request
+     *
+     * Called by the transport's reader, one frame at a time. Frames with an unknown or stale token
+     * (e.g. of an expired request), and malformed frames, are ignored. A COMPLETE frame whose status
+     * is not a REQUEST_STATUS completes its request with ERROR_COMMUNICATION. Response callbacks run
+     * with the in-flight table locked, so they must not start requests on this communicator.
+     *
+     * @param frame The frame, only valid during the call
+     * @return bool Whether the frame was routed to a request
+     */
+    bool onDownstreamFrame(const serialized_message_view_t frame) const {
+        const std::optional<PipelineEnvelope> envelope = decodeEnvelope(frame);
+        if (!envelope) {
+            return false;
+        }
+        switch (envelope->kind) {
+        case PIPELINE_FRAME_KIND::RESPONSE:
+            return deliver(envelope->token, envelope->body);
+        case PIPELINE_FRAME_KIND::COMPLETE:
+            if (envelope->body.size() != 1) {
+                return false;
+            }
+            if (RequestCompletion* const completion = release(envelope->token)) {
+                const std::uint8_t status = envelope->body[0];
+                completion->complete(
+                    isRequestStatus(status) ? static_cast<REQUEST_STATUS>(status) : REQUEST_STATUS::ERROR_COMMUNICATION
+                );
+                return true;
+            }
+            return false;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief Completes every request in flight, e.g. once the link is lost
+     * @param status The status every request completes with
+     */
+    void cancelAll(const REQUEST_STATUS status = REQUEST_STATUS::ERROR_COMMUNICATION) const {
+        std::array<RequestCompletion*, MaxInFlight> cancelled{};
+        std::size_t count = 0;
+        {
+            const std::scoped_lock lock(_mutex);
+            for (std::size_t i = 0; i < MaxInFlight; ++i) {
+                if (_slots[i].completion != nullptr) {
+                    cancelled[count++] = std::exchange(_slots[i].completion, nullptr);
+                    _free[_free_count++] = static_cast<std::uint16_t>(i);
+                }
+            }
+        }
+        // Completed outside the lock: a resumed coroutine may start its next request right away
+        for (std::size_t i = 0; i < count; ++i) {
+            cancelled[i]->complete(status);
+        }
+    }
+
+    /**
+     * @brief Number of requests in flight
+     * @return std::size_t The number of requests
+     */
+    [[nodiscard]] std::size_t inFlight() const {
+        const std::scoped_lock lock(_mutex);
+        return MaxInFlight - _free_count;
+    }
+};
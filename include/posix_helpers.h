@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cerrno>
+#include <system_error>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace posix_helpers
+{
+/**
+ * @brief Throws the error of the last failed system call
+ * @param what The failed call
+ * @throws std::system_error always
+ */
+[[noreturn]] inline void throwErrno(const char* what) { throw std::system_error(errno, std::generic_category(), what); }
+} // namespace posix_helpers
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "communication.h"
+#include "posix_helpers.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <system_error>
+
+#if __has_include(<sys/uio.h>) && __has_include(<unistd.h>)
+#include <limits.h> // IOV_MAX
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace posix_sink_helpers
+{
+/** @brief Number of frames handed to the kernel per writev() or sendmmsg() call */
+inline constexpr std::size_t BATCH_LIMIT = IOV_MAX < 64 ? IOV_MAX : 64;
+} // namespace posix_sink_helpers
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief FrameSink writing frames back to back on a stream file descriptor (TCP socket, pipe, serial port)
+ *
+ * A batch is written with one writev() per BATCH_LIMIT frames, retrying short writes. Frames are
+ * written as they are, so on a stream they must already be delimited (e.g. cobsEncode() output).
+ * A mutex keeps the frames of concurrent batches from interleaving. The descriptor is not owned.
+ */
+class FdStreamSink final : public FrameSink
+{
+    const int _fd;
+    std::mutex _mutex;
+
+    /**
+     * @brief Writes every byte of the iovecs, with _mutex held
+     * @param iov The iovecs, consumed by the call
+     * @throws std::system_error if writev() fails
+     */
+    void writeAll(std::span<iovec> iov) const {
+        while (!iov.empty()) {
+            const ssize_t written = ::writev(_fd, iov.data(), static_cast<int>(iov.size()));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                posix_helpers::throwErrno("writev");
+            }
+            // Skips the fully written iovecs, then the written prefix of the next one
+            auto left = static_cast<std::size_t>(written);
+            while (!iov.empty() && left >= iov.front().iov_len) {
+                left -= iov.front().iov_len;
+                iov = iov.subspan(1);
+            }
+            if (!iov.empty()) {
+                iov.front().iov_base = static_cast<std::uint8_t*>(iov.front().iov_base) + left;
+                iov.front().iov_len -= left;
+            }
+        }
+    }
+
+  public:
+    /**
+     * @brief Constructs the sink
+     * @param fd The stream descriptor, open for writing, outliving the sink
+     */
+    explicit FdStreamSink(const int fd) noexcept : _fd(fd) {}
+
+    void send(const std::span<const std::uint8_t> frame) override {
+        const std::array<std::span<const std::uint8_t>, 1> frames{frame};
+        sendBatch(frames);
+    }
+
+    /**
+     * @brief Writes the frames in order, with one writev() per BATCH_LIMIT frames
+     * @param frames The frames, each only valid during the call
+     * @throws std::system_error if writev() fails, part of the batch may have been written
+     */
+    void sendBatch(const std::span<const std::span<const std::uint8_t>> frames) override {
+        const std::scoped_lock lock(_mutex);
+        std::array<iovec, posix_sink_helpers::BATCH_LIMIT> iov{};
+        for (std::size_t first = 0; first < frames.size(); first += iov.size()) {
+            const std::size_t count = std::min(iov.size(), frames.size() - first);
+            for (std::size_t i = 0; i < count; ++i) {
+                // writev() does not write through iov_base, the const_cast only satisfies its signature
+                iov[i].iov_base = const_cast<std::uint8_t*>(frames[first + i].data()); // NOLINT
+                iov[i].iov_len = frames[first + i].size();
+            }
+            writeAll(std::span(iov).first(count));
+        }
+    }
+};
+
+#ifdef __linux__
+/**
+ * @brief FrameSink sending every frame as one datagram on a connected datagram socket (UDP, AF_UNIX)
+ *
+ * A batch is sent with one sendmmsg() per BATCH_LIMIT frames. Datagrams keep their boundaries, so
+ * frames need no delimiter, and concurrent sends need no lock. The socket is not owned.
+ */
+class DatagramSocketSink final : public FrameSink
+{
+    const int _fd;
+
+  public:
+    /**
+     * @brief Constructs the sink
+     * @param fd The connected datagram socket, outliving the sink
+     */
+    explicit DatagramSocketSink(const int fd) noexcept : _fd(fd) {}
+
+    void send(const std::span<const std::uint8_t> frame) override {
+        while (::send(_fd, frame.data(), frame.size(), 0) < 0) {
+            if (errno != EINTR) {
+                posix_helpers::throwErrno("send");
+            }
+        }
+    }
+
+    /**
+     * @brief Sends the frames in order, with one sendmmsg() per BATCH_LIMIT frames
+     * @param frames The frames, each only valid during the call
+     * @throws std::system_error if sendmmsg() fails, part of the batch may have been sent
+     */
+    void sendBatch(const std::span<const std::span<const std::uint8_t>> frames) override {
+        std::array<iovec, posix_sink_helpers::BATCH_LIMIT> iov{};
+        std::array<mmsghdr, posix_sink_helpers::BATCH_LIMIT> messages{};
+        for (std::size_t first = 0; first < frames.size();) {
+            const std::size_t count = std::min(iov.size(), frames.size() - first);
+            for (std::size_t i = 0; i < count; ++i) {
+                iov[i].iov_base = const_cast<std::uint8_t*>(frames[first + i].data()); // NOLINT
+                iov[i].iov_len = frames[first + i].size();
+                messages[i] = mmsghdr{};
+                messages[i].msg_hdr.msg_iov = &iov[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+            }
+            const int sent = ::sendmmsg(_fd, messages.data(), static_cast<unsigned int>(count), 0);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                posix_helpers::throwErrno("sendmmsg");
+            }
+            first += static_cast<std::size_t>(sent); // the kernel may send fewer datagrams than asked
+        }
+    }
+};
+#endif
+#endif
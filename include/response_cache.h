@@ -0,0 +1,433 @@
+#pragma once
+
+#include "bounded_queue.h"
+#include "communication.h"
+#include "handler.h"
+#include "message.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief Configuration of a ResponseCache
+ */
+struct ResponseCacheConfig
+{
+    std::chrono::steady_clock::duration ttl = std::chrono::seconds(1); ///< Lifetime of an entry, zero never expires
+};
+
+/**
+ * @brief Counters of a ResponseCache
+ */
+struct ResponseCacheStats
+{
+    std::size_t hits = 0;        ///< Frames answered from the cache
+    std::size_t misses = 0;      ///< Frames looked up and executed
+    std::size_t stores = 0;      ///< Entries written after an execution
+    std::size_t evictions = 0;   ///< Live entries overwritten to make room
+    std::size_t uncacheable = 0; ///< Executions not stored: frame or responses too large, or a request sent
+};
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace response_cache_helpers
+{
+/**
+ * @brief Hashes the bytes of a frame (64-bit FNV-1a with a final avalanche)
+ * @param bytes The bytes
+ * @return std::uint64_t The hash
+ */
+inline std::uint64_t hashBytes(const serialized_message_view_t bytes) noexcept {
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    for (const std::uint8_t byte : bytes) {
+        hash = (hash ^ byte) * 0x100000001B3ULL;
+    }
+    hash ^= hash >> 33U;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33U;
+    return hash;
+}
+
+/** @brief Size of the length prefix of every response stored in an entry */
+inline constexpr std::size_t LENGTH_SIZE = sizeof(std::uint16_t);
+} // namespace response_cache_helpers
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Bounded cache of the responses of idempotent commands, keyed by the raw bytes of their frame
+ *
+ * Entries have a fixed size and live in an open-addressing table split into Stripes stripes, each
+ * with its own mutex: the stripe and the home slot of a frame come from its hash, and a lookup
+ * probes at most PROBES slots of that stripe. Inserting into a full window overwrites its oldest
+ * entry. Nothing is allocated after construction, so the table is best kept in static storage.
+ *
+ * Entries expire after the configured TTL; invalidate(), invalidateIf() and clear() drop them
+ * earlier, e.g. when the state the commands read changes.
+ *
+ * @tparam Entries The number of entries, a power of two
+ * @tparam MaxKeySize The largest frame cached, in bytes
+ * @tparam MaxResponseBytes The room for the responses of a frame, each prefixed with a two-byte length
+ * @tparam Stripes The number of independently locked stripes, a power of two
+ */
+template <
+    std::size_t Entries = 1024,
+    std::size_t MaxKeySize = 32,
+    std::size_t MaxResponseBytes = 256,
+    std::size_t Stripes = 16>
+class ResponseCache
+{
+    static_assert(std::has_single_bit(Entries) && std::has_single_bit(Stripes) && Entries >= Stripes);
+    static_assert(MaxResponseBytes <= 0xFFFF, "Responses are prefixed with a 16-bit length");
+
+    using clock_t = std::chrono::steady_clock;
+
+  public:
+    /** @brief Slots probed from the home slot of a frame */
+    static constexpr std::size_t PROBES = std::min<std::size_t>(8, Entries / Stripes);
+
+    /**
+     * @brief Communicator forwarding responses to another one and keeping a copy of them for the cache
+     */
+    class Recorder final : public Communicator
+    {
+        const Communicator& _downstream;
+        mutable std::array<std::uint8_t, MaxResponseBytes> _bytes{};
+        mutable std::size_t _size = 0;
+        mutable bool _overflow = false;
+
+      public:
+        explicit Recorder(const Communicator& downstream) noexcept : _downstream(downstream) {}
+
+        void respond(const std::vector<std::uint8_t>& response) const override {
+            respondView(std::span<const std::uint8_t>(response));
+        }
+
+        void respondView(const std::span<const std::uint8_t> response) const override {
+            if (!_overflow && response.size() + response_cache_helpers::LENGTH_SIZE <= MaxResponseBytes - _size) {
+                const auto length = static_cast<std::uint16_t>(response.size());
+                std::memcpy(_bytes.data() + _size, &length, sizeof(length));
+                std::memcpy(_bytes.data() + _size + sizeof(length), response.data(), response.size());
+                _size += sizeof(length) + response.size();
+            }
+            else {
+                _overflow = true;
+            }
+            _downstream.respondView(response);
+        }
+
+        /** @brief Requests are forwarded, but make the execution uncacheable: its outcome is not pure */
+        REQUEST_STATUS request(
+            const std::vector<std::uint8_t>& message, std::function<void(std::vector<std::uint8_t>)> callback
+        ) const override {
+            _overflow = true;
+            return _downstream.request(message, std::move(callback));
+        }
+
+        REQUEST_STATUS requestView(
+            const std::span<const std::uint8_t> message, const response_callback_t handle_response_callback
+        ) const override {
+            _overflow = true;
+            return _downstream.requestView(message, handle_response_callback);
+        }
+
+        /** @brief Whether the responses recorded so far can be stored */
+        [[nodiscard]] bool cacheable() const noexcept { return !_overflow; }
+
+        /** @brief The recorded responses, each prefixed with its length */
+        [[nodiscard]] serialized_message_view_t recorded() const noexcept { return {_bytes.data(), _size}; }
+    };
+
+  private:
+    /** @brief A cached frame and its responses */
+    struct Entry
+    {
+        std::uint64_t hash = 0;
+        std::uint64_t stamp = 0; ///< Insertion order within the stripe, 0 if the entry is free
+        clock_t::time_point expires{};
+        std::uint16_t key_size = 0;
+        std::uint16_t response_size = 0;
+        std::array<std::uint8_t, MaxKeySize> key{};
+        std::array<std::uint8_t, MaxResponseBytes> responses{};
+
+        [[nodiscard]] bool matches(const std::uint64_t other, const serialized_message_view_t frame) const noexcept {
+            return stamp != 0 && hash == other && key_size == frame.size()
+                   && std::memcmp(key.data(), frame.data(), frame.size()) == 0;
+        }
+    };
+
+    /** @brief Entries sharing a mutex */
+    struct alignas(CACHE_LINE_SIZE) Stripe
+    {
+        std::mutex mutex;
+        std::uint64_t next_stamp = 1;
+        ResponseCacheStats stats{};
+        std::array<Entry, Entries / Stripes> entries{};
+    };
+
+    std::array<Stripe, Stripes> _stripes{};
+    const clock_t::duration _ttl;
+
+    [[nodiscard]] Stripe& stripeOf(const std::uint64_t hash) noexcept { return _stripes[hash & (Stripes - 1)]; }
+
+    [[nodiscard]] static std::size_t homeOf(const std::uint64_t hash) noexcept {
+        return static_cast<std::size_t>(hash >> 32U) & (Entries / Stripes - 1);
+    }
+
+    [[nodiscard]] bool live(const Entry& entry, const clock_t::time_point time) const noexcept {
+        return entry.stamp != 0 && (_ttl == clock_t::duration::zero() || time < entry.expires);
+    }
+
+    [[nodiscard]] clock_t::time_point now() const noexcept {
+        return _ttl == clock_t::duration::zero() ? clock_t::time_point{} : clock_t::now();
+    }
+
+  public:
+    /** @brief Largest frame cached, in bytes */
+    static constexpr std::size_t MAX_KEY_SIZE = MaxKeySize;
+
+    /**
+     * @brief Constructs an empty cache
+     * @param config The entry lifetime
+     */
+    explicit ResponseCache(const ResponseCacheConfig config = {}) noexcept : _ttl(config.ttl) {}
+
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /**
+     * @brief Sends the cached responses of a frame, if any
+     *
+     * The responses are copied out of the stripe and sent once its lock is released.
+     *
+     * @param frame The frame
+     * @param communicator The Communicator receiving the responses
+     * @return bool Whether the frame was cached (hit)
+     */
+    bool replay(const serialized_message_view_t frame, const Communicator& communicator) {
+        if (frame.size() > MaxKeySize) {
+            return false;
+        }
+        const std::uint64_t hash = response_cache_helpers::hashBytes(frame);
+        Stripe& stripe = stripeOf(hash);
+        std::array<std::uint8_t, MaxResponseBytes> responses; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        std::size_t size = 0;
+        {
+            const std::scoped_lock lock(stripe.mutex);
+            const clock_t::time_point time = now();
+            const std::size_t home = homeOf(hash);
+            const Entry* found = nullptr;
+            for (std::size_t probe = 0; probe < PROBES && found == nullptr; ++probe) {
+                const Entry& entry = stripe.entries[(home + probe) & (Entries / Stripes - 1)];
+                if (entry.matches(hash, frame) && live(entry, time)) {
+                    found = &entry;
+                }
+            }
+            if (found == nullptr) {
+                ++stripe.stats.misses;
+                return false;
+            }
+            ++stripe.stats.hits;
+            size = found->response_size;
+            std::memcpy(responses.data(), found->responses.data(), size);
+        }
+        for (std::size_t offset = 0; offset < size;) {
+            std::uint16_t length = 0;
+            std::memcpy(&length, responses.data() + offset, sizeof(length));
+            offset += sizeof(length);
+            communicator.respondView(std::span<const std::uint8_t>(responses.data() + offset, length));
+            offset += length;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stores the responses recorded while executing a frame
+     * @param frame The frame
+     * @param recorder The recorder the frame was executed with
+     */
+    void store(const serialized_message_view_t frame, const Recorder& recorder) {
+        const std::uint64_t hash = response_cache_helpers::hashBytes(frame);
+        Stripe& stripe = stripeOf(hash);
+        const std::scoped_lock lock(stripe.mutex);
+        if (frame.size() > MaxKeySize || !recorder.cacheable()) {
+            ++stripe.stats.uncacheable;
+            return;
+        }
+        const clock_t::time_point time = now();
+        const std::size_t home = homeOf(hash);
+        Entry* target = nullptr; // the entry of the frame if it has one, else a free one, else the oldest
+        Entry* free = nullptr;
+        Entry* oldest = nullptr;
+        for (std::size_t probe = 0; probe < PROBES && target == nullptr; ++probe) {
+            Entry& entry = stripe.entries[(home + probe) & (Entries / Stripes - 1)];
+            if (entry.matches(hash, frame)) {
+                target = &entry;
+            }
+            else if (!live(entry, time)) {
+                free = free == nullptr ? &entry : free;
+            }
+            else if (oldest == nullptr || entry.stamp < oldest->stamp) {
+                oldest = &entry;
+            }
+        }
+        if (target == nullptr) {
+            target = free != nullptr ? free : oldest;
+            stripe.stats.evictions += free == nullptr ? 1 : 0;
+        }
+        const serialized_message_view_t responses = recorder.recorded();
+        target->hash = hash;
+        target->stamp = stripe.next_stamp++;
+        target->expires = time + _ttl;
+        target->key_size = static_cast<std::uint16_t>(frame.size());
+        target->response_size = static_cast<std::uint16_t>(responses.size());
+        std::memcpy(target->key.data(), frame.data(), frame.size());
+        std::memcpy(target->responses.data(), responses.data(), responses.size());
+        ++stripe.stats.stores;
+    }
+
+    /**
+     * @brief Drops the entry of a frame
+     * @param frame The frame
+     */
+    void invalidate(const serialized_message_view_t frame) {
+        const std::uint64_t hash = response_cache_helpers::hashBytes(frame);
+        Stripe& stripe = stripeOf(hash);
+        const std::scoped_lock lock(stripe.mutex);
+        const std::size_t home = homeOf(hash);
+        for (std::size_t probe = 0; probe < PROBES; ++probe) {
+            Entry& entry = stripe.entries[(home + probe) & (Entries / Stripes - 1)];
+            if (entry.matches(hash, frame)) {
+                entry.stamp = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Drops the entries whose frame satisfies a predicate, e.g. every frame of a command ID
+     * @param predicate Called with the frame of every entry, under the lock of its stripe
+     * @return std::size_t The number of entries dropped
+     */
+    template <typename Predicate> std::size_t invalidateIf(Predicate&& predicate) {
+        std::size_t dropped = 0;
+        for (Stripe& stripe : _stripes) {
+            const std::scoped_lock lock(stripe.mutex);
+            for (Entry& entry : stripe.entries) {
+                if (entry.stamp != 0 && predicate(serialized_message_view_t(entry.key.data(), entry.key_size))) {
+                    entry.stamp = 0;
+                    ++dropped;
+                }
+            }
+        }
+        return dropped;
+    }
+
+    /**
+     * @brief Drops every entry
+     */
+    void clear() {
+        invalidateIf([](serialized_message_view_t) { return true; });
+    }
+
+    /**
+     * @brief Sum of the counters of every stripe
+     * @return ResponseCacheStats The counters
+     */
+    [[nodiscard]] ResponseCacheStats stats() {
+        ResponseCacheStats total{};
+        for (Stripe& stripe : _stripes) {
+            const std::scoped_lock lock(stripe.mutex);
+            total.hits += stripe.stats.hits;
+            total.misses += stripe.stats.misses;
+            total.stores += stripe.stats.stores;
+            total.evictions += stripe.stats.evictions;
+            total.uncacheable += stripe.stats.uncacheable;
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief Handler answering the frames of idempotent commands from a ResponseCache
+ *
+ * Frames of commands marked idempotent (see IdempotentCommandT) are first looked up in the cache:
+ * a hit sends the stored responses, skipping both the construction and the execution of the command.
+ * A miss executes the frame through HandlerT, recording its responses, and stores them if it
+ * succeeded. Other frames go straight to HandlerT.
+ *
+ * Usage:
+ *     inline ResponseCache<> cache;
+ *     using CachedHandler = MemoizingHandler<Handler<Commands...>, cache>;
+ *
+ * @tparam HandlerT The handler, e.g. Handler<Commands...>
+ * @tparam Cache The cache, shared by every thread executing frames
+ */
+template <typename HandlerT, auto& Cache> class MemoizingHandler final
+{
+  public:
+    /** @brief Type alias for the result of an execution */
+    using execute_result_t = typename HandlerT::execute_result_t;
+
+    /**
+     * @brief Executes a frame, or replays its cached responses
+     * @tparam Mode How HandlerT looks up the command ID
+     * @param data Raw byte data containing the command ID and payload (only read during the call)
+     * @param communicator The Communicator instance to handle responses and requests
+     * @return execute_result_t The status of the execution, success for cache hits
+     */
+    template <HANDLER_DISPATCH_MODE Mode = HANDLER_DISPATCH_MODE::JUMP_TABLE>
+    [[nodiscard]] static execute_result_t
+    execute(const serialized_message_view_t data, const Communicator& communicator) noexcept {
+        using cache_t = std::remove_reference_t<decltype(Cache)>;
+        if (!HandlerT::idempotent(data) || data.size() > cache_t::MAX_KEY_SIZE) {
+            return HandlerT::template execute<Mode>(data, communicator);
+        }
+        try {
+            if (Cache.replay(data, communicator)) {
+                return {};
+            }
+            const typename cache_t::Recorder recorder(communicator);
+            execute_result_t result = HandlerT::template execute<Mode>(data, recorder);
+            if (result) {
+                Cache.store(data, recorder);
+            }
+            return result;
+        }
+        catch (const std::exception&) { // thrown by the communicator while replaying, or by a mutex
+            return unexpected(
+                HandlerExecuteError{
+                    .code = HANDLER_EXECUTE_STATUS::ERROR_EXCEPTION_DURING_EXECUTION,
+                    .msg = "Exception during execution",
+                    .exception = std::current_exception(),
+                }
+            );
+        }
+        catch (...) {
+            return unexpected(
+                HandlerExecuteError{
+                    .code = HANDLER_EXECUTE_STATUS::ERROR_EXCEPTION_DURING_EXECUTION, .msg = "Unknown exception"
+                }
+            );
+        }
+    }
+
+    /**
+     * @brief Whether a frame is for an idempotent command, see BasicHandler::idempotent()
+     */
+    [[nodiscard]] static bool idempotent(const serialized_message_view_t data) noexcept {
+        return HandlerT::idempotent(data);
+    }
+};
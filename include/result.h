@@ -1,6 +1,9 @@
 #pragma once
 #include <cassert>
-#include <optional>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 /**
@@ -23,29 +26,198 @@ struct ExpectT
 
 inline constexpr ExpectT EXPECT{};
 
+template <typename T, typename E> class Result;
+
+/**
+ * @brief Namespace containing internal helper templates
+ */
+namespace result_helpers
+{
+/** @brief Whether a type is a Result */
+template <typename R> struct IsResult : std::false_type
+{};
+
+template <typename T, typename E> struct IsResult<Result<T, E>> : std::true_type
+{};
+
+/** @brief Whether a type is a Result, ignoring cv-qualifiers and references */
+template <typename R> concept ResultT = IsResult<std::remove_cvref_t<R>>::value;
+
+/** @brief Whether copying and destroying both alternatives is trivial, making the Result trivially copyable */
+template <typename... Ts> concept TriviallyCopyable = (std::is_trivially_copyable_v<Ts> && ...);
+} // namespace result_helpers
+
 /**
  * @brief A class representing the result of an operation that can succeed or fail
+ *
+ * The value and the error share a union behind a single discriminant, so a Result is never larger than
+ * its largest alternative plus one flag. It is copyable and movable, and trivially so when both
+ * alternatives are (e.g. the results of hexDecode() or Command::validate()). Assigning a Result holding
+ * the other alternative gives the strong guarantee: if constructing it throws, the old one is kept.
+ *
  * @tparam T The type of the successful value
  * @tparam E The type of the error value
  */
 template <typename T, typename E> class Result
 {
-    const bool _is_ok;
-    const std::optional<T> _value;
-    const std::optional<E> _error;
+    union
+    {
+        T _value;
+        E _error;
+    };
+    bool _is_ok;
+
+    /**
+     * @brief Constructs the alternative held by other into the (empty) storage
+     * @param other The Result to copy or move from
+     */
+    template <typename Other> void constructFrom(Other&& other) {
+        if (other._is_ok) {
+            std::construct_at(std::addressof(_value), std::forward<Other>(other)._value);
+        }
+        else {
+            std::construct_at(std::addressof(_error), std::forward<Other>(other)._error);
+        }
+        _is_ok = other._is_ok;
+    }
+
+    /**
+     * @brief Destroys the held alternative, leaving the storage empty
+     */
+    void destroy() noexcept {
+        if (_is_ok) {
+            std::destroy_at(std::addressof(_value));
+        }
+        else {
+            std::destroy_at(std::addressof(_error));
+        }
+    }
+
+    /**
+     * @brief Destroys one alternative and constructs the other in its storage, keeping the old one if that throws
+     * @param next The alternative to construct
+     * @param previous The alternative currently held
+     * @param args The arguments to construct next from
+     */
+    template <typename Next, typename Previous, typename... Args>
+    static void reinit(Next& next, Previous& previous, Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<Next, Args...>) {
+            std::destroy_at(std::addressof(previous));
+            std::construct_at(std::addressof(next), std::forward<Args>(args)...);
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<Next>) {
+            Next constructed(std::forward<Args>(args)...); // may throw while previous is still intact
+            std::destroy_at(std::addressof(previous));
+            std::construct_at(std::addressof(next), std::move(constructed));
+        }
+        else {
+            static_assert(
+                std::is_nothrow_move_constructible_v<Previous>,
+                "Assigning across alternatives needs one of them to be nothrow move constructible"
+            );
+            Previous saved(std::move(previous));
+            std::destroy_at(std::addressof(previous));
+            try {
+                std::construct_at(std::addressof(next), std::forward<Args>(args)...);
+            }
+            catch (...) {
+                std::construct_at(std::addressof(previous), std::move(saved));
+                throw;
+            }
+        }
+    }
+
+    /**
+     * @brief Replaces the held alternative with the one held by other
+     * @param other The Result to copy or move from
+     */
+    template <typename Other> void assignFrom(Other&& other) {
+        if (_is_ok && other._is_ok) {
+            _value = std::forward<Other>(other)._value;
+        }
+        else if (!_is_ok && !other._is_ok) {
+            _error = std::forward<Other>(other)._error;
+        }
+        else if (other._is_ok) {
+            reinit(_value, _error, std::forward<Other>(other)._value);
+            _is_ok = true;
+        }
+        else {
+            reinit(_error, _value, std::forward<Other>(other)._error);
+            _is_ok = false;
+        }
+    }
 
   public:
+    /** @brief Type alias for the successful value type */
+    using value_type = T;
+    /** @brief Type alias for the error type */
+    using error_type = E;
+
     /**
      * @brief Constructor for successful result
      * @param v The value
      */
-    Result(ExpectT, T v) noexcept : _is_ok(true), _value(std::move(v)), _error(std::nullopt) {}
+    Result(ExpectT, T v) noexcept(std::is_nothrow_move_constructible_v<T>) : _value(std::move(v)), _is_ok(true) {}
 
     /**
      * @brief Constructor for error result
      * @param e The error
      */
-    Result(UnexpectT, E e) noexcept : _is_ok(false), _value(std::nullopt), _error(std::move(e)) {}
+    Result(UnexpectT, E e) noexcept(std::is_nothrow_move_constructible_v<E>) : _error(std::move(e)), _is_ok(false) {}
+
+    Result(const Result&)
+        requires result_helpers::TriviallyCopyable<T, E>
+    = default;
+
+    Result(const Result& other)
+        requires(!result_helpers::TriviallyCopyable<T, E> && std::copy_constructible<T> && std::copy_constructible<E>)
+    {
+        constructFrom(other);
+    }
+
+    Result(Result&&) noexcept
+        requires result_helpers::TriviallyCopyable<T, E>
+    = default;
+
+    Result(Result&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>
+    ) {
+        constructFrom(std::move(other));
+    }
+
+    Result& operator=(const Result&)
+        requires result_helpers::TriviallyCopyable<T, E>
+    = default;
+
+    Result& operator=(const Result& other)
+        requires(!result_helpers::TriviallyCopyable<T, E> && std::copyable<T> && std::copyable<E>)
+    {
+        if (this != &other) {
+            assignFrom(other);
+        }
+        return *this;
+    }
+
+    Result& operator=(Result&&) noexcept
+        requires result_helpers::TriviallyCopyable<T, E>
+    = default;
+
+    Result& operator=(Result&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E> &&
+        std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_assignable_v<E>
+    ) {
+        if (this != &other) {
+            assignFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    ~Result()
+        requires result_helpers::TriviallyCopyable<T, E>
+    = default;
+
+    ~Result() { destroy(); }
 
     /**
      * @brief Observer
@@ -65,7 +237,25 @@ template <typename T, typename E> class Result
      */
     [[nodiscard]] const T& value() const& {
         assert(_is_ok && "Accessing value() on an error Result");
-        return _value.value();
+        return _value;
+    }
+
+    /**
+     * @brief Value access (precondition: ok())
+     * @return The successful value
+     */
+    [[nodiscard]] T& value() & {
+        assert(_is_ok && "Accessing value() on an error Result");
+        return _value;
+    }
+
+    /**
+     * @brief Value extraction (precondition: ok())
+     * @return The successful value, moved out
+     */
+    [[nodiscard]] T&& value() && {
+        assert(_is_ok && "Accessing value() on an error Result");
+        return std::move(_value);
     }
 
     /**
@@ -73,8 +263,79 @@ template <typename T, typename E> class Result
      * @return The error value
      */
     [[nodiscard]] const E& error() const& {
-        assert(!_is_ok && "Accessing value() on an error Result");
-        return _error.value();
+        assert(!_is_ok && "Accessing error() on a successful Result");
+        return _error;
+    }
+
+    /**
+     * @brief Error extraction (precondition: !ok())
+     * @return The error value, moved out
+     */
+    [[nodiscard]] E&& error() && {
+        assert(!_is_ok && "Accessing error() on a successful Result");
+        return std::move(_error);
+    }
+
+    /**
+     * @brief Chains an operation that can fail on the value
+     * @param fn Callable taking the value and returning a Result with the same error type
+     * @return The Result of fn, or this error
+     */
+    template <typename F> [[nodiscard]] auto and_then(F&& fn) const& {
+        using result_t = std::remove_cvref_t<std::invoke_result_t<F, const T&>>;
+        static_assert(result_helpers::ResultT<result_t>, "and_then() needs a callable returning a Result");
+        static_assert(std::is_same_v<typename result_t::error_type, E>, "and_then() cannot change the error type");
+        if (_is_ok) {
+            return std::invoke(std::forward<F>(fn), _value);
+        }
+        return result_t(UNEXPECT, _error);
+    }
+
+    /**
+     * @brief Chains an operation that can fail on the value, moving it
+     * @param fn Callable taking the value and returning a Result with the same error type
+     * @return The Result of fn, or this error
+     */
+    template <typename F> [[nodiscard]] auto and_then(F&& fn) && {
+        using result_t = std::remove_cvref_t<std::invoke_result_t<F, T&&>>;
+        static_assert(result_helpers::ResultT<result_t>, "and_then() needs a callable returning a Result");
+        static_assert(std::is_same_v<typename result_t::error_type, E>, "and_then() cannot change the error type");
+        if (_is_ok) {
+            return std::invoke(std::forward<F>(fn), std::move(_value));
+        }
+        return result_t(UNEXPECT, std::move(_error));
+    }
+
+    /**
+     * @brief Maps the value, keeping the error
+     * @param fn Callable taking the value
+     * @return Result<U, E> The mapped value (U may be void), or this error
+     */
+    template <typename F> [[nodiscard]] auto transform(F&& fn) const& {
+        using mapped_t = std::remove_cv_t<std::invoke_result_t<F, const T&>>;
+        if (!_is_ok) {
+            return Result<mapped_t, E>(UNEXPECT, _error);
+        }
+        if constexpr (std::is_void_v<mapped_t>) {
+            std::invoke(std::forward<F>(fn), _value);
+            return Result<void, E>(EXPECT);
+        }
+        else {
+            return Result<mapped_t, E>(EXPECT, std::invoke(std::forward<F>(fn), _value));
+        }
+    }
+
+    /**
+     * @brief Maps the error, keeping the value
+     * @param fn Callable taking the error
+     * @return Result<T, G> This value, or the mapped error
+     */
+    template <typename F> [[nodiscard]] auto transform_error(F&& fn) const& {
+        using mapped_t = std::remove_cv_t<std::invoke_result_t<F, const E&>>;
+        if (_is_ok) {
+            return Result<T, mapped_t>(EXPECT, _value);
+        }
+        return Result<T, mapped_t>(UNEXPECT, std::invoke(std::forward<F>(fn), _error));
     }
 };
 
@@ -84,25 +345,103 @@ template <typename T, typename E> class Result
  */
 template <typename E> class Result<void, E>
 {
-    const bool _is_ok;
-    const std::optional<E> _error;
+    union
+    {
+        E _error;
+    };
+    bool _is_ok;
 
   public:
+    /** @brief Type alias for the successful value type */
+    using value_type = void;
+    /** @brief Type alias for the error type */
+    using error_type = E;
+
     /**
      * @brief Constructor for successful result
      */
-    explicit Result(ExpectT) noexcept : _is_ok(true), _error(std::nullopt) {}
+    explicit Result(ExpectT) noexcept : _is_ok(true) {}
 
     /**
      * @brief Constructor for error result
      * @param e The error
      */
-    Result(UnexpectT, E e) noexcept : _is_ok(false), _error(std::move(e)) {}
+    Result(UnexpectT, E e) noexcept(std::is_nothrow_move_constructible_v<E>) : _error(std::move(e)), _is_ok(false) {}
 
     /**
      * @brief Default constructor for successful void result
      */
-    Result() : _is_ok(true), _error(std::nullopt) {}
+    Result() noexcept : _is_ok(true) {}
+
+    Result(const Result&)
+        requires result_helpers::TriviallyCopyable<E>
+    = default;
+
+    Result(const Result& other)
+        requires(!result_helpers::TriviallyCopyable<E> && std::copy_constructible<E>)
+        : _is_ok(other._is_ok) {
+        if (!_is_ok) {
+            std::construct_at(std::addressof(_error), other._error);
+        }
+    }
+
+    Result(Result&&) noexcept
+        requires result_helpers::TriviallyCopyable<E>
+    = default;
+
+    Result(Result&& other) noexcept(std::is_nothrow_move_constructible_v<E>) : _is_ok(other._is_ok) {
+        if (!_is_ok) {
+            std::construct_at(std::addressof(_error), std::move(other._error));
+        }
+    }
+
+    Result& operator=(const Result&)
+        requires result_helpers::TriviallyCopyable<E>
+    = default;
+
+    Result& operator=(const Result& other)
+        requires(!result_helpers::TriviallyCopyable<E> && std::copyable<E>)
+    {
+        if (this != &other) {
+            *this = Result(other);
+        }
+        return *this;
+    }
+
+    Result& operator=(Result&&) noexcept
+        requires result_helpers::TriviallyCopyable<E>
+    = default;
+
+    Result& operator=(Result&& other) noexcept(
+        std::is_nothrow_move_constructible_v<E> && std::is_nothrow_move_assignable_v<E>
+    ) {
+        if (this == &other) {
+            return *this;
+        }
+        if (!_is_ok && !other._is_ok) {
+            _error = std::move(other._error);
+        }
+        else {
+            if (!_is_ok) {
+                std::destroy_at(std::addressof(_error));
+            }
+            if (!other._is_ok) {
+                std::construct_at(std::addressof(_error), std::move(other._error));
+            }
+            _is_ok = other._is_ok;
+        }
+        return *this;
+    }
+
+    ~Result()
+        requires result_helpers::TriviallyCopyable<E>
+    = default;
+
+    ~Result() {
+        if (!_is_ok) {
+            std::destroy_at(std::addressof(_error));
+        }
+    }
 
     /**
      * @brief Observer
@@ -127,8 +466,64 @@ template <typename E> class Result<void, E>
      * @return The error value
      */
     [[nodiscard]] const E& error() const& {
-        assert(!_is_ok && "Accessing value() on an error Result");
-        return _error.value();
+        assert(!_is_ok && "Accessing error() on a successful Result");
+        return _error;
+    }
+
+    /**
+     * @brief Error extraction (precondition: !ok())
+     * @return The error value, moved out
+     */
+    [[nodiscard]] E&& error() && {
+        assert(!_is_ok && "Accessing error() on a successful Result");
+        return std::move(_error);
+    }
+
+    /**
+     * @brief Chains an operation that can fail
+     * @param fn Callable taking no argument and returning a Result with the same error type
+     * @return The Result of fn, or this error
+     */
+    template <typename F> [[nodiscard]] auto and_then(F&& fn) const& {
+        using result_t = std::remove_cvref_t<std::invoke_result_t<F>>;
+        static_assert(result_helpers::ResultT<result_t>, "and_then() needs a callable returning a Result");
+        static_assert(std::is_same_v<typename result_t::error_type, E>, "and_then() cannot change the error type");
+        if (_is_ok) {
+            return std::invoke(std::forward<F>(fn));
+        }
+        return result_t(UNEXPECT, _error);
+    }
+
+    /**
+     * @brief Produces a value on success, keeping the error
+     * @param fn Callable taking no argument
+     * @return Result<U, E> The produced value (U may be void), or this error
+     */
+    template <typename F> [[nodiscard]] auto transform(F&& fn) const& {
+        using mapped_t = std::remove_cv_t<std::invoke_result_t<F>>;
+        if (!_is_ok) {
+            return Result<mapped_t, E>(UNEXPECT, _error);
+        }
+        if constexpr (std::is_void_v<mapped_t>) {
+            std::invoke(std::forward<F>(fn));
+            return Result<void, E>(EXPECT);
+        }
+        else {
+            return Result<mapped_t, E>(EXPECT, std::invoke(std::forward<F>(fn)));
+        }
+    }
+
+    /**
+     * @brief Maps the error
+     * @param fn Callable taking the error
+     * @return Result<void, G> Success, or the mapped error
+     */
+    template <typename F> [[nodiscard]] auto transform_error(F&& fn) const& {
+        using mapped_t = std::remove_cv_t<std::invoke_result_t<F, const E&>>;
+        if (_is_ok) {
+            return Result<void, mapped_t>(EXPECT);
+        }
+        return Result<void, mapped_t>(UNEXPECT, std::invoke(std::forward<F>(fn), _error));
     }
 };
 
@@ -139,7 +534,7 @@ template <typename E> class Result<void, E>
  */
 template <typename T, typename E>
 [[nodiscard]] static Result<T, E> expected(T value) noexcept(std::is_nothrow_move_constructible_v<T>) {
-    return Result(EXPECT, std::move(value));
+    return Result<T, E>(EXPECT, std::move(value));
 }
 
 /**
@@ -165,5 +560,5 @@ template <typename E> [[nodiscard]] static Result<void, E> expected() noexcept {
  */
 template <typename E>
 [[nodiscard]] static Result<void, E> unexpected(E error) noexcept(std::is_nothrow_move_constructible_v<E>) {
-    return Result<void, E>(UNEXPECT, error);
+    return Result<void, E>(UNEXPECT, std::move(error));
 }
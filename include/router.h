@@ -0,0 +1,180 @@
+#pragma once
+
+#include "communication.h"
+#include "handler.h"
+#include "message.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+/* ―――――――――――――――― Concepts ―――――――――――――――― */
+
+/**
+ * @brief Concept for a handler a Router can forward to: Handler, BasicHandler or another Router
+ * @tparam H The type to be checked
+ */
+template <typename H> concept RoutableHandlerT = requires(serialized_message_view_t data, const Communicator& c) {
+    { H::template execute<HANDLER_DISPATCH_MODE::JUMP_TABLE>(data, c) } noexcept -> std::same_as<handler_result_t>;
+};
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief Binds a leading address byte to the handler of the frames carrying it
+ * @tparam Address The address (device, tenant or namespace) byte
+ * @tparam HandlerT The handler executing the rest of the frame
+ */
+template <std::uint8_t Address, RoutableHandlerT HandlerT> struct Route
+{
+    static constexpr std::uint8_t ADDRESS = Address; ///< The address byte
+    using handler_t = HandlerT;                      ///< The handler of the route
+};
+
+/**
+ * @brief Concept to ensure a type is a Route
+ * @tparam R The type to be checked
+ */
+template <typename R> concept RouteT = requires {
+    { R::ADDRESS } -> std::convertible_to<std::uint8_t>;
+    typename R::handler_t;
+} && RoutableHandlerT<typename R::handler_t>;
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace router_helpers
+{
+/**
+ * @brief Checks that a list of addresses holds no duplicates
+ * @tparam N The number of addresses
+ * @param addresses The addresses
+ * @return bool Whether all addresses are distinct
+ */
+template <std::size_t N> consteval bool uniqueAddresses(std::array<std::uint8_t, N> addresses) {
+    std::ranges::sort(addresses);
+    return std::ranges::adjacent_find(addresses) == addresses.end();
+}
+} // namespace router_helpers
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Dispatches frames to one of several handlers on a leading address byte
+ *
+ * A frame reads `<address> <command frame>`: the address selects the route through a 256-entry
+ * compile-time jump table, and the rest of the frame is handed as a view to the handler of that
+ * route, which validates and executes it as it would on its own. The router only checks the
+ * address byte, so a frame is validated once and nothing is copied or thrown on the way.
+ *
+ * Router has the static execute() of a handler, so it is used wherever a handler is expected,
+ * including as the handler of another route. With ConcurrentListener, WORKER_AFFINITY::SHARD
+ * gives each route its own worker (see shardOf()), which the listener can pin to its own core.
+ *
+ * Usage:
+ *     using Gateway = Router<Route<0x01, Handler<MotorCommands...>>, Route<0x02, Handler<SensorCommands...>>>;
+ *
+ * @tparam Routes The routes, with distinct addresses
+ */
+template <RouteT... Routes> class Router final
+{
+    static_assert(sizeof...(Routes) > 0, "A Router needs at least one route");
+    static_assert(
+        router_helpers::uniqueAddresses(std::array<std::uint8_t, sizeof...(Routes)>{Routes::ADDRESS...}),
+        "Duplicate addresses registered in Router"
+    );
+
+  public:
+    /** @brief Type alias for the result of an execution */
+    using execute_result_t = handler_result_t;
+
+    /** @brief Size of the leading address, in bytes */
+    static constexpr std::size_t PREFIX_SIZE = 1;
+
+    /** @brief Number of routes, also the shard of frames that no route matches */
+    static constexpr std::size_t SHARD_COUNT = sizeof...(Routes);
+
+  private:
+    /** @brief Type alias for a dispatch table entry */
+    using invoker_t = execute_result_t (*)(serialized_message_view_t, const Communicator&) noexcept;
+
+    /**
+     * @brief Dispatch table entry of a route: strips the address and executes the rest
+     * @tparam R The route
+     * @tparam Mode How the sub-handler looks up the command ID
+     */
+    template <RouteT R, HANDLER_DISPATCH_MODE Mode>
+    static execute_result_t forward(const serialized_message_view_t data, const Communicator& communicator) noexcept {
+        return R::handler_t::template execute<Mode>(data.subspan(PREFIX_SIZE), communicator);
+    }
+
+    /**
+     * @brief Dispatch table entry for addresses that no route is registered for
+     * @param data Raw byte data of the frame (at least PREFIX_SIZE bytes)
+     * @return execute_result_t Always an ERROR_ROUTE_NOT_FOUND error
+     */
+    static execute_result_t
+    unknownRoute(const serialized_message_view_t data, const Communicator& /*communicator*/) noexcept {
+        return unexpected(
+            HandlerExecuteError{
+                .code = HANDLER_EXECUTE_STATUS::ERROR_ROUTE_NOT_FOUND, .msg = "Unknown route", .got = data.front()
+            }
+        );
+    }
+
+    /**
+     * @brief Builds the table mapping every address to its invoker
+     * @tparam Mode How the sub-handlers look up the command ID
+     * @return std::array<invoker_t, 256> The dispatch table
+     */
+    template <HANDLER_DISPATCH_MODE Mode> static consteval std::array<invoker_t, 256> makeDispatchTable() {
+        std::array<invoker_t, 256> table{};
+        table.fill(&unknownRoute);
+        ((table[Routes::ADDRESS] = &forward<Routes, Mode>), ...);
+        return table;
+    }
+
+    /**
+     * @brief Builds the table mapping every address to the index of its route, SHARD_COUNT if unrouted
+     * @return std::array<std::uint16_t, 256> The shard table
+     */
+    static consteval std::array<std::uint16_t, 256> makeShardTable() {
+        std::array<std::uint16_t, 256> table{};
+        table.fill(static_cast<std::uint16_t>(SHARD_COUNT));
+        std::uint16_t shard = 0;
+        ((table[Routes::ADDRESS] = shard++), ...);
+        return table;
+    }
+
+  public:
+    /**
+     * @brief Executes a frame with the handler of its address
+     * @tparam Mode How the sub-handler looks up the command ID
+     * @param data Raw byte data: the address then the command frame (only read during the call)
+     * @param communicator The Communicator instance to handle responses and requests
+     * @return execute_result_t The status of the execution, ERROR_ROUTE_NOT_FOUND for unknown addresses
+     */
+    template <HANDLER_DISPATCH_MODE Mode = HANDLER_DISPATCH_MODE::JUMP_TABLE>
+    [[nodiscard]] static execute_result_t
+    execute(const serialized_message_view_t data, const Communicator& communicator) noexcept {
+        if (data.empty()) {
+            return unexpected(
+                HandlerExecuteError{
+                    .code = HANDLER_EXECUTE_STATUS::ERROR_EMPTY_MESSAGE, .msg = "Empty message received"
+                }
+            );
+        }
+        static constexpr std::array<invoker_t, 256> DISPATCH_TABLE = makeDispatchTable<Mode>();
+        return DISPATCH_TABLE[data.front()](data, communicator);
+    }
+
+    /**
+     * @brief Index of the route of a frame, in the order of Routes
+     * @param data Raw byte data of the frame
+     * @return std::size_t The route index, SHARD_COUNT for empty frames and unknown addresses
+     */
+    [[nodiscard]] static std::size_t shardOf(const serialized_message_view_t data) noexcept {
+        static constexpr std::array<std::uint16_t, 256> SHARD_TABLE = makeShardTable();
+        return data.empty() ? SHARD_COUNT : SHARD_TABLE[data.front()];
+    }
+};
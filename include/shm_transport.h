@@ -0,0 +1,651 @@
+#pragma once
+
+#include "bounded_queue.h"
+#include "communication.h"
+#include "message.h"
+#include "posix_helpers.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace shm_helpers
+{
+/** @brief Marks a channel as initialised, written last by its creator */
+inline constexpr std::uint32_t MAGIC = 0x434D4431; // "CMD1"
+/** @brief Polls of an empty ring before a waiter sleeps: a busy peer is seen without any system call */
+inline constexpr int SPINS = 4096;
+
+/**
+ * @brief Polls before sleeping on this machine: none on a single core, where spinning only delays the peer
+ */
+inline int spinLimit() noexcept {
+    static const int limit = std::thread::hardware_concurrency() > 1 ? SPINS : 0;
+    return limit;
+}
+
+/**
+ * @brief Kind of a ring record
+ */
+enum class RECORD_KIND : std::uint8_t
+{
+    WRAP = 0,     ///< Padding up to the end of the ring, the next record starts at offset 0
+    REQUEST = 1,  ///< Client to server, the body is the request message
+    RESPONSE = 2, ///< Server to client, the body is one response message
+    COMPLETE = 3, ///< Server to client, the body is the one-byte REQUEST_STATUS ending the request
+};
+
+/**
+ * @brief Header of a ring record, followed by the body padded to RECORD_ALIGN bytes
+ */
+struct RecordHeader
+{
+    std::uint32_t size;     ///< Size of the body
+    std::uint16_t sequence; ///< Sequence number of the request the record belongs to
+    RECORD_KIND kind;       ///< What the body holds
+    std::uint8_t reserved;
+};
+
+/** @brief Alignment of every record, so that a header never straddles the end of the ring */
+inline constexpr std::size_t RECORD_ALIGN = sizeof(RecordHeader);
+
+/**
+ * @brief Calls futex(2) on a word shared between processes (not FUTEX_PRIVATE_FLAG, unlike std::atomic::wait)
+ */
+inline void futex(std::atomic<std::uint32_t>& word, const int op, const std::uint32_t value, const timespec* timeout) {
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+    static_cast<void>(::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, value, timeout, nullptr, 0));
+}
+
+/** @brief Hint to the CPU that the thread is spinning */
+inline void spinPause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Wait point shared between processes: a futex word and whether anyone sleeps on it
+ *
+ * notify() only makes a system call when the waiter actually sleeps, so a busy pair of processes
+ * exchanges frames through memory alone.
+ */
+struct WaitPoint
+{
+    std::atomic<std::uint32_t> signal{0};   ///< Bumped by notify()
+    std::atomic<std::uint32_t> sleeping{0}; ///< Whether the waiter sleeps on signal
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+    /**
+     * @brief Spins, then sleeps, until ready() holds or the deadline passes
+     *
+     * @param ready Condition checked after every wake-up
+     * @param deadline When to give up, time_point::max() to wait forever
+     * @return bool Whether ready() holds
+     */
+    template <typename Ready>
+    bool await(Ready&& ready, const std::chrono::steady_clock::time_point deadline) noexcept {
+        for (int spin = 0, limit = spinLimit(); spin < limit; ++spin) {
+            if (ready()) {
+                return true;
+            }
+            spinPause();
+        }
+        for (;;) {
+            const std::uint32_t seen = signal.load(std::memory_order_acquire);
+            sleeping.store(1, std::memory_order_relaxed);
+            // Orders publishing sleeping before re-checking, pairs with the fence in notify()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ready()) {
+                sleeping.store(0, std::memory_order_relaxed);
+                return true;
+            }
+            if (deadline == std::chrono::steady_clock::time_point::max()) {
+                futex(signal, FUTEX_WAIT, seen, nullptr);
+            }
+            else {
+                const auto left = deadline - std::chrono::steady_clock::now();
+                if (left <= std::chrono::steady_clock::duration::zero()) {
+                    sleeping.store(0, std::memory_order_relaxed);
+                    return ready();
+                }
+                const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(left);
+                const timespec timeout{
+                    .tv_sec = static_cast<time_t>(seconds.count()),
+                    .tv_nsec = static_cast<long>(std::chrono::nanoseconds(left - seconds).count()),
+                };
+                futex(signal, FUTEX_WAIT, seen, &timeout);
+            }
+            sleeping.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Wakes the waiter if it sleeps
+     * @param force Whether to wake it even if it does not sleep yet, e.g. to stop it
+     */
+    void notify(const bool force = false) noexcept {
+        // Orders the ring update before reading sleeping, pairs with the fence in await()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (force || sleeping.load(std::memory_order_relaxed) != 0) {
+            signal.fetch_add(1, std::memory_order_release);
+            futex(signal, FUTEX_WAKE, 1, nullptr);
+        }
+    }
+};
+
+/**
+ * @brief Single-producer single-consumer ring of variable-size records, placed in shared memory
+ *
+ * Records are written and read in place: a record that would straddle the end of the ring is
+ * preceded by a WRAP record padding up to the end, so every body is contiguous and handed to the
+ * consumer as a view without copying. Positions are byte counts that only grow.
+ *
+ * @tparam Capacity The size of the ring in bytes, a power of two
+ */
+template <std::size_t Capacity> struct FrameRing
+{
+    static_assert(std::has_single_bit(Capacity) && Capacity >= 64, "Capacity must be a power of two, at least 64");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    /** @brief Largest body of a record: up to half the ring, a record fits an empty ring whatever the padding */
+    static constexpr std::size_t MAX_BODY = Capacity / 2 - sizeof(RecordHeader);
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> head{0}; ///< Consumer position
+    WaitPoint space;                                             ///< The producer waits here for space
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> tail{0}; ///< Producer position
+    WaitPoint data;                                              ///< The consumer waits here for records
+    alignas(CACHE_LINE_SIZE) std::array<std::uint8_t, Capacity> bytes{};
+
+    /**
+     * @brief Size of the record of a body, header and padding included
+     */
+    static constexpr std::size_t recordSize(const std::size_t body) noexcept {
+        return (sizeof(RecordHeader) + body + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+    }
+
+    void writeHeader(const std::uint64_t position, const RecordHeader& header) noexcept {
+        std::memcpy(bytes.data() + (position & (Capacity - 1)), &header, sizeof(header));
+    }
+
+    /**
+     * @brief Padding needed before the record of a body appended now, so that it does not straddle the end
+     */
+    [[nodiscard]] std::size_t padding(const std::size_t body) const noexcept {
+        const std::size_t left = Capacity - (tail.load(std::memory_order_relaxed) & (Capacity - 1));
+        return left < recordSize(body) ? left : 0;
+    }
+
+    /**
+     * @brief Whether the record of a body can be appended now (producer side)
+     */
+    [[nodiscard]] bool fits(const std::size_t body) const noexcept {
+        const std::uint64_t used = tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire);
+        return padding(body) + recordSize(body) <= Capacity - used;
+    }
+
+    /**
+     * @brief Appends a record if there is room for it (producer side)
+     *
+     * @param kind The kind of the record
+     * @param sequence The sequence number of the record
+     * @param body The body, at most MAX_BODY bytes
+     * @return bool Whether the record was appended
+     */
+    bool tryPush(const RECORD_KIND kind, const std::uint16_t sequence, const serialized_message_view_t body) noexcept {
+        if (!fits(body.size())) {
+            return false;
+        }
+        const std::uint64_t position = tail.load(std::memory_order_relaxed);
+        const std::size_t skip = padding(body.size());
+        const std::size_t size = recordSize(body.size());
+        std::uint64_t start = position;
+        if (skip != 0) {
+            writeHeader(start, {.size = 0, .sequence = 0, .kind = RECORD_KIND::WRAP, .reserved = 0});
+            start += skip;
+        }
+        const auto length = static_cast<std::uint32_t>(body.size());
+        writeHeader(start, {.size = length, .sequence = sequence, .kind = kind, .reserved = 0});
+        if (!body.empty()) {
+            std::memcpy(bytes.data() + (start & (Capacity - 1)) + sizeof(RecordHeader), body.data(), body.size());
+        }
+        tail.store(start + size, std::memory_order_release);
+        data.notify();
+        return true;
+    }
+
+    /**
+     * @brief Whether a record is available (consumer side)
+     */
+    [[nodiscard]] bool readable() const noexcept {
+        return head.load(std::memory_order_relaxed) != tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Drops everything written so far (consumer side), as nothing past a corrupt header can be trusted
+     * @param end The producer position
+     * @return bool false, no record was consumed
+     */
+    bool discard(const std::uint64_t end) noexcept {
+        head.store(end, std::memory_order_release);
+        space.notify();
+        return false;
+    }
+
+    /**
+     * @brief Hands the next record to a callback and frees it (consumer side)
+     *
+     * The ring is shared with another process, so its headers are not trusted: a record larger
+     * than MAX_BODY, one running past the producer position, or a WRAP not followed by a record
+     * discards everything written so far and the callback is not called.
+     *
+     * @param on_record Called with the header and a view over the body, only valid during the call
+     * @return bool Whether a record was consumed
+     */
+    template <typename F> bool tryPop(F&& on_record) {
+        std::uint64_t position = head.load(std::memory_order_relaxed);
+        const std::uint64_t end = tail.load(std::memory_order_acquire);
+        if (position == end) {
+            return false;
+        }
+        if (end - position > Capacity) {
+            return discard(end);
+        }
+        RecordHeader header{};
+        std::memcpy(&header, bytes.data() + (position & (Capacity - 1)), sizeof(header));
+        if (header.kind == RECORD_KIND::WRAP) { // always followed by the record it made room for
+            position += Capacity - (position & (Capacity - 1));
+            if (position >= end) {
+                return discard(end);
+            }
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            if (header.kind == RECORD_KIND::WRAP) {
+                return discard(end);
+            }
+        }
+        if (header.size > MAX_BODY || recordSize(header.size) > end - position) {
+            return discard(end);
+        }
+        const std::size_t offset = (position & (Capacity - 1)) + sizeof(RecordHeader);
+        const auto release = [this, position, &header] {
+            head.store(position + recordSize(header.size), std::memory_order_release);
+            space.notify();
+        };
+        try {
+            on_record(header, serialized_message_view_t(bytes.data() + offset, header.size));
+        }
+        catch (...) {
+            release();
+            throw;
+        }
+        release();
+        return true;
+    }
+};
+} // namespace shm_helpers
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief Memory shared by one client and the server: a ring in each direction
+ *
+ * @tparam Capacity The size of each ring in bytes, a power of two; frames are limited to about half of it
+ */
+template <std::size_t Capacity = 64 * 1024> struct ShmChannel
+{
+    /** @brief Largest request or response message */
+    static constexpr std::size_t MAX_FRAME = shm_helpers::FrameRing<Capacity>::MAX_BODY;
+
+    std::atomic<std::uint32_t> magic{0};          ///< MAGIC once the creator initialised the channel
+    std::uint32_t capacity = Capacity;            ///< Checked by ShmSegment::open()
+    shm_helpers::FrameRing<Capacity> requests{};  ///< Client to server
+    shm_helpers::FrameRing<Capacity> responses{}; ///< Server to client
+};
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief A ShmChannel mapped from a POSIX shared memory object (shm_open())
+ *
+ * One side creates the object, the other opens it by name; both then hand channel() to a
+ * ShmListener (server) or a ShmClient (client). The creator unlinks the name when destroyed.
+ *
+ * @tparam ChannelT The channel type, e.g. ShmChannel<>
+ */
+template <typename ChannelT = ShmChannel<>> class ShmSegment
+{
+    std::string _name;
+    ChannelT* _channel = nullptr;
+    bool _owner = false;
+
+    ShmSegment(std::string name, ChannelT* const channel, const bool owner) noexcept
+        : _name(std::move(name)), _channel(channel), _owner(owner) {}
+
+    static void* map(const int fd) {
+        void* const memory = ::mmap(nullptr, sizeof(ChannelT), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            posix_helpers::throwErrno("mmap");
+        }
+        return memory;
+    }
+
+  public:
+    /**
+     * @brief Creates the shared memory object and initialises the channel in it
+     * @param name The object name, e.g. "/libcmd-client-42"
+     * @return ShmSegment The mapping, unlinking the name when destroyed
+     * @throws std::system_error if the object exists already or cannot be created
+     */
+    static ShmSegment create(std::string name) {
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            posix_helpers::throwErrno("shm_open");
+        }
+        if (::ftruncate(fd, sizeof(ChannelT)) < 0) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            posix_helpers::throwErrno("ftruncate");
+        }
+        void* memory = nullptr;
+        try {
+            memory = map(fd);
+        }
+        catch (...) {
+            ::shm_unlink(name.c_str());
+            throw;
+        }
+        auto* const channel = ::new (memory) ChannelT();
+        channel->magic.store(shm_helpers::MAGIC, std::memory_order_release);
+        return ShmSegment(std::move(name), channel, true);
+    }
+
+    /**
+     * @brief Maps a channel created by another process
+     * @param name The object name given to create()
+     * @return ShmSegment The mapping
+     * @throws std::system_error if the object does not exist, or has another size or capacity (EPROTO)
+     */
+    static ShmSegment open(std::string name) {
+        const int fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+        if (fd < 0) {
+            posix_helpers::throwErrno("shm_open");
+        }
+        struct stat status{};
+        if (::fstat(fd, &status) < 0 || static_cast<std::size_t>(status.st_size) != sizeof(ChannelT)) {
+            ::close(fd);
+            errno = EPROTO;
+            posix_helpers::throwErrno("shm_open: not a channel of this type");
+        }
+        auto* const channel = std::launder(static_cast<ChannelT*>(map(fd)));
+        if (channel->magic.load(std::memory_order_acquire) != shm_helpers::MAGIC
+            || channel->capacity != sizeof(channel->requests.bytes)) {
+            ::munmap(channel, sizeof(ChannelT));
+            errno = EPROTO;
+            posix_helpers::throwErrno("shm_open: not a channel of this type");
+        }
+        return ShmSegment(std::move(name), channel, false);
+    }
+
+    ShmSegment(ShmSegment&& other) noexcept
+        : _name(std::move(other._name)), _channel(std::exchange(other._channel, nullptr)),
+          _owner(std::exchange(other._owner, false)) {}
+    ShmSegment& operator=(ShmSegment&&) = delete;
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+
+    ~ShmSegment() {
+        if (_channel != nullptr) {
+            ::munmap(_channel, sizeof(ChannelT));
+        }
+        if (_owner) {
+            ::shm_unlink(_name.c_str());
+        }
+    }
+
+    [[nodiscard]] ChannelT& channel() const noexcept { return *_channel; }
+};
+
+/**
+ * @brief Listener serving one client through a ShmChannel, on the thread calling start()
+ *
+ * Each request is executed straight from the request ring with HandlerT::execute(); the responses
+ * of the command are written to the response ring as they are sent, followed by a COMPLETE record
+ * with SUCCESS, or ERROR_UNKNOWN if the handler returned an error. While requests keep arriving
+ * the loop never makes a system call; once idle it sleeps on a futex until the client writes.
+ *
+ * @tparam HandlerT The handler, e.g. Handler<Commands...>
+ * @tparam Capacity The ring size of the channel
+ */
+template <typename HandlerT, std::size_t Capacity = 64 * 1024> class ShmListener final : public Listener
+{
+    /**
+     * @brief Communicator writing the responses of the request being executed
+     */
+    class Responder final : public Communicator
+    {
+        const ShmListener& _listener;
+
+      public:
+        std::uint16_t sequence = 0; ///< Sequence number of the request being executed
+
+        explicit Responder(const ShmListener& listener) noexcept : _listener(listener) {}
+
+        void respond(const std::vector<std::uint8_t>& response) const override {
+            respondView(std::span<const std::uint8_t>(response));
+        }
+
+        /**
+         * @brief Writes a response, waiting for room while the client reads
+         * @param response The response message bytes, only valid during the call
+         * @throws std::length_error if the response is larger than ShmChannel::MAX_FRAME
+         */
+        void respondView(const std::span<const std::uint8_t> response) const override {
+            _listener.push(shm_helpers::RECORD_KIND::RESPONSE, sequence, response);
+        }
+
+        REQUEST_STATUS request(const std::vector<std::uint8_t>&, std::function<void(std::vector<std::uint8_t>)>)
+            const override {
+            return REQUEST_STATUS::ERROR_COMMUNICATION;
+        }
+    };
+
+    ShmChannel<Capacity>& _channel;
+    std::atomic<bool> _stopped{false};
+
+    /**
+     * @brief Writes a record to the response ring, waiting for room unless stopped
+     */
+    void push(const shm_helpers::RECORD_KIND kind, const std::uint16_t sequence, const serialized_message_view_t body)
+        const {
+        if (body.size() > ShmChannel<Capacity>::MAX_FRAME) {
+            throw std::length_error("Response larger than the shared memory ring allows");
+        }
+        auto& ring = _channel.responses;
+        while (!ring.tryPush(kind, sequence, body)) {
+            const auto room = [&ring, &body, this] {
+                return _stopped.load(std::memory_order_relaxed) || ring.fits(body.size());
+            };
+            ring.space.await(room, std::chrono::steady_clock::time_point::max());
+            if (_stopped.load(std::memory_order_relaxed)) {
+                return; // stopped while the client does not read: the response is dropped
+            }
+        }
+    }
+
+  public:
+    /**
+     * @brief Constructs the listener
+     * @param channel The channel shared with the client, e.g. ShmSegment::channel()
+     */
+    explicit ShmListener(ShmChannel<Capacity>& channel) noexcept : _channel(channel) {}
+
+    ShmListener(const ShmListener&) = delete;
+    ShmListener& operator=(const ShmListener&) = delete;
+
+    /**
+     * @brief Executes the client's requests until stop() is called
+     */
+    void start() override {
+        Responder responder(*this);
+        auto& ring = _channel.requests;
+        const auto ready = [&ring, this] { return ring.readable() || _stopped.load(std::memory_order_relaxed); };
+        while (ring.data.await(ready, std::chrono::steady_clock::time_point::max())
+               && !_stopped.load(std::memory_order_relaxed)) {
+            while (ring.tryPop([this, &responder](const shm_helpers::RecordHeader& header,
+                                                  const serialized_message_view_t body) {
+                if (header.kind != shm_helpers::RECORD_KIND::REQUEST) {
+                    return;
+                }
+                responder.sequence = header.sequence;
+                const auto result = HandlerT::execute(body, responder);
+                const auto status = static_cast<std::uint8_t>(
+                    result ? Communicator::REQUEST_STATUS::SUCCESS : Communicator::REQUEST_STATUS::ERROR_UNKNOWN
+                );
+                push(shm_helpers::RECORD_KIND::COMPLETE, header.sequence, serialized_message_view_t(&status, 1));
+            })) {
+            }
+        }
+    }
+
+    /**
+     * @brief Makes start() return after the request being executed, or at once if not started yet
+     *
+     * Safe from any thread; a stopped listener cannot be started again.
+     */
+    void stop() noexcept {
+        _stopped.store(true, std::memory_order_release);
+        _channel.requests.data.notify(true);
+        _channel.responses.space.notify(true);
+    }
+};
+
+/**
+ * @brief Communicator sending requests to a ShmListener in another process through a ShmChannel
+ *
+ * request() writes the request to the request ring and reads the responses from the response
+ * ring in place, until the COMPLETE record. Against a busy server a round trip is two ring
+ * writes and no system call. One request is outstanding at a time, callers are serialised.
+ *
+ * A request that gets no COMPLETE record within the timeout returns ERROR_TIMEOUT; records of
+ * a timed-out request arriving later are recognised by their sequence number and skipped.
+ *
+ * Responses (respond()) are forwarded to the upstream communicator unchanged.
+ *
+ * @tparam Capacity The ring size of the channel
+ */
+template <std::size_t Capacity = 64 * 1024> class ShmClient final : public Communicator
+{
+    ShmChannel<Capacity>& _channel;
+    const Communicator& _upstream;
+    const std::chrono::steady_clock::duration _timeout;
+    mutable std::mutex _mutex;
+    mutable std::uint16_t _sequence = 0;
+
+  public:
+    /**
+     * @brief Constructs the client
+     *
+     * @param channel The channel shared with the server, e.g. ShmSegment::channel()
+     * @param upstream Communicator receiving respond() calls
+     * @param timeout How long a request waits for its COMPLETE record
+     */
+    ShmClient(
+        ShmChannel<Capacity>& channel,
+        const Communicator& upstream,
+        const std::chrono::steady_clock::duration timeout = std::chrono::seconds(1)
+    ) noexcept
+        : _channel(channel), _upstream(upstream), _timeout(timeout) {}
+
+    void respond(const std::vector<std::uint8_t>& response) const override { _upstream.respond(response); }
+
+    void respondView(const std::span<const std::uint8_t> response) const override { _upstream.respondView(response); }
+
+    /**
+     * @brief Sends a request and hands each response to the callback, as a view into the ring
+     *
+     * @param message The request message to send, only valid during the call
+     * @param handle_response_callback Callback invoked with each response, each view only valid during its call
+     * @return REQUEST_STATUS The status sent by the server, ERROR_TIMEOUT, or ERROR_COMMUNICATION
+     *         if the message is larger than ShmChannel::MAX_FRAME
+     */
+    [[nodiscard]] REQUEST_STATUS requestView(
+        const std::span<const std::uint8_t> message, const response_callback_t handle_response_callback
+    ) const override {
+        if (message.size() > ShmChannel<Capacity>::MAX_FRAME) {
+            return REQUEST_STATUS::ERROR_COMMUNICATION;
+        }
+        const std::scoped_lock lock(_mutex);
+        const std::uint16_t sequence = ++_sequence;
+        const auto deadline = std::chrono::steady_clock::now() + _timeout;
+
+        auto& requests = _channel.requests;
+        while (!requests.tryPush(shm_helpers::RECORD_KIND::REQUEST, sequence, message)) {
+            const auto room = [&requests, &message] { return requests.fits(message.size()); };
+            if (!requests.space.await(room, deadline)) {
+                return REQUEST_STATUS::ERROR_TIMEOUT;
+            }
+        }
+
+        auto& responses = _channel.responses;
+        std::optional<REQUEST_STATUS> status;
+        const auto on_record = [&](const shm_helpers::RecordHeader& header, const serialized_message_view_t body) {
+            if (header.sequence != sequence) {
+                return; // left over from a request that timed out
+            }
+            if (header.kind == shm_helpers::RECORD_KIND::RESPONSE) {
+                handle_response_callback(body);
+            }
+            else if (header.kind == shm_helpers::RECORD_KIND::COMPLETE) {
+                status = body.empty() ? REQUEST_STATUS::ERROR_COMMUNICATION : static_cast<REQUEST_STATUS>(body[0]);
+            }
+        };
+        const auto readable = [&responses] { return responses.readable(); };
+        while (!status) {
+            if (!responses.tryPop(on_record) && !responses.data.await(readable, deadline)) {
+                return REQUEST_STATUS::ERROR_TIMEOUT;
+            }
+        }
+        return *status;
+    }
+
+    [[nodiscard]] REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& message, std::function<void(std::vector<uint8_t>)> handle_response_callback
+    ) const override {
+        return requestView(
+            std::span<const std::uint8_t>(message),
+            [&handle_response_callback](const std::span<const std::uint8_t> response) {
+                handle_response_callback(std::vector<std::uint8_t>(response.begin(), response.end()));
+            }
+        );
+    }
+};
+#endif
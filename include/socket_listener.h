@@ -0,0 +1,535 @@
+#pragma once
+
+#include "communication.h"
+#include "framer.h"
+#include "message.h"
+#include "posix_helpers.h"
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief Configuration of a socket listener (EpollListener, UringListener)
+ */
+struct SocketListenerConfig
+{
+    std::size_t max_connections = 4096;     ///< Connections accepted beyond this are closed right away
+    std::size_t receive_buffer = 16 * 1024; ///< Bytes read at once from a connection
+    std::size_t receive_buffers = 256;      ///< UringListener: buffers shared by all connections, a power of two
+};
+
+/**
+ * @brief Counters of a socket listener, read with relaxed ordering
+ */
+struct SocketListenerStats
+{
+    std::size_t accepted = 0; ///< Connections accepted
+    std::size_t rejected = 0; ///< Connections closed on accept because max_connections was reached
+    std::size_t closed = 0;   ///< Connections closed, by the peer, an error or stop()
+    std::size_t received = 0; ///< Frames carved out of the byte streams
+    std::size_t executed = 0; ///< Frames executed successfully
+    std::size_t failed = 0;   ///< Frames whose execution returned an error
+    std::size_t dropped = 0;  ///< Frames dropped by the COBS framers (too long or malformed)
+};
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace socket_listener_helpers
+{
+/**
+ * @brief Owned file descriptor, closed on destruction
+ */
+class UniqueFd
+{
+    int _fd = -1;
+
+  public:
+    UniqueFd() noexcept = default;
+    explicit UniqueFd(const int fd) noexcept : _fd(fd) {}
+    UniqueFd(UniqueFd&& other) noexcept : _fd(std::exchange(other._fd, -1)) {}
+    UniqueFd& operator=(UniqueFd&& other) noexcept {
+        if (this != &other) {
+            reset();
+            _fd = std::exchange(other._fd, -1);
+        }
+        return *this;
+    }
+    UniqueFd(const UniqueFd&) = delete;
+    UniqueFd& operator=(const UniqueFd&) = delete;
+    ~UniqueFd() { reset(); }
+
+    /** @brief Closes the descriptor, if any */
+    void reset() noexcept {
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    [[nodiscard]] int get() const noexcept { return _fd; }
+};
+
+/**
+ * @brief Counters shared by the socket listeners, written by the loop thread only
+ */
+struct Counters
+{
+    std::atomic<std::size_t> accepted{0};
+    std::atomic<std::size_t> rejected{0};
+    std::atomic<std::size_t> closed{0};
+    std::atomic<std::size_t> received{0};
+    std::atomic<std::size_t> executed{0};
+    std::atomic<std::size_t> failed{0};
+    std::atomic<std::size_t> dropped{0};
+
+    /** @brief Increments a counter from the loop thread */
+    static void bump(std::atomic<std::size_t>& counter, const std::size_t by = 1) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] SocketListenerStats snapshot() const noexcept {
+        return {
+            .accepted = accepted.load(std::memory_order_relaxed),
+            .rejected = rejected.load(std::memory_order_relaxed),
+            .closed = closed.load(std::memory_order_relaxed),
+            .received = received.load(std::memory_order_relaxed),
+            .executed = executed.load(std::memory_order_relaxed),
+            .failed = failed.load(std::memory_order_relaxed),
+            .dropped = dropped.load(std::memory_order_relaxed),
+        };
+    }
+};
+
+/**
+ * @brief A client connection: COBS framer for its input, Communicator COBS-encoding its responses
+ *
+ * Responses are appended to an output buffer; pendingOutput() swaps it with the buffer being written,
+ * so responding while a write is in flight never touches the bytes the kernel reads.
+ * Commands can only respond: there is no request path back to a client, request() fails.
+ *
+ * @tparam MaxFrameSize The largest frame accepted from the client
+ */
+template <std::size_t MaxFrameSize> class Connection final : public Communicator
+{
+    const int _fd;
+    CobsFramer<MaxFrameSize> _framer;
+    mutable std::vector<std::uint8_t> _output;
+    std::vector<std::uint8_t> _sending;
+    std::size_t _sent = 0;
+
+  public:
+    std::uint32_t watched = 0; ///< Events watched in the epoll set (EpollListener)
+    bool receiving = false;    ///< Whether a receive is armed (UringListener)
+    bool writing = false;      ///< Whether a write is in flight (UringListener)
+    bool queued = false;       ///< Whether the connection waits to be serviced (UringListener)
+    bool closing = false;      ///< Whether the input ended: close once the output is written
+    bool broken = false;       ///< Whether writing failed: close without writing the rest
+
+    /**
+     * @brief Takes ownership of an accepted socket
+     * @param fd The socket
+     */
+    explicit Connection(const int fd) noexcept : _fd(fd) {}
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    ~Connection() override { ::close(_fd); }
+
+    [[nodiscard]] int fd() const noexcept { return _fd; }
+
+    /**
+     * @brief Executes every frame completed by a chunk of the byte stream
+     *
+     * @tparam HandlerT The handler executing the frames
+     * @param chunk The bytes received, only read during the call
+     * @param counters The counters to update
+     */
+    template <typename HandlerT> void consume(const serialized_message_view_t chunk, Counters& counters) {
+        const std::size_t dropped = _framer.droppedFrames();
+        const std::size_t frames = _framer.feed(chunk, [this, &counters](const serialized_message_view_t frame) {
+            Counters::bump(HandlerT::execute(frame, *this) ? counters.executed : counters.failed);
+        });
+        Counters::bump(counters.received, frames);
+        Counters::bump(counters.dropped, _framer.droppedFrames() - dropped);
+    }
+
+    /**
+     * @brief Bytes still to write, starting a new write from the buffered responses if the last one is done
+     * @return serialized_message_view_t The unwritten bytes, empty if nothing is left
+     */
+    [[nodiscard]] serialized_message_view_t pendingOutput() {
+        if (_sent == _sending.size()) {
+            _sending.clear();
+            _sent = 0;
+            std::swap(_sending, _output);
+        }
+        return serialized_message_view_t(_sending).subspan(_sent);
+    }
+
+    /**
+     * @brief Records that part of pendingOutput() was written
+     * @param bytes The number of bytes written
+     */
+    void wrote(const std::size_t bytes) noexcept { _sent += bytes; }
+
+    /**
+     * @brief Whether responses are waiting to be written
+     * @return bool Whether pendingOutput() is non-empty
+     */
+    [[nodiscard]] bool hasOutput() const noexcept { return _sent != _sending.size() || !_output.empty(); }
+
+    void respond(const std::vector<std::uint8_t>& response) const override {
+        respondView(std::span<const std::uint8_t>(response));
+    }
+
+    /**
+     * @brief Appends the COBS-encoded response to the output
+     * @param response The response message bytes, only valid during the call
+     */
+    void respondView(const std::span<const std::uint8_t> response) const override {
+        const std::size_t start = _output.size();
+        _output.resize(start + cobsEncodedSize(response.size()));
+        const serialized_message_view_t encoded = cobsEncode(response, std::span(_output).subspan(start));
+        _output.resize(start + encoded.size());
+    }
+
+    REQUEST_STATUS request(const std::vector<std::uint8_t>&, std::function<void(std::vector<std::uint8_t>)>)
+        const override {
+        return REQUEST_STATUS::ERROR_COMMUNICATION;
+    }
+};
+
+/**
+ * @brief Open connections, indexed by a slot that stays valid until the connection is released
+ *
+ * @tparam MaxFrameSize The largest frame accepted from a client
+ */
+template <std::size_t MaxFrameSize> class ConnectionTable
+{
+    std::vector<std::unique_ptr<Connection<MaxFrameSize>>> _slots;
+    std::vector<std::size_t> _free;
+    std::size_t _open = 0;
+
+  public:
+    /**
+     * @brief Adds a connection
+     * @param fd The accepted socket, owned by the connection from now on
+     * @return std::size_t The slot of the connection
+     */
+    std::size_t open(const int fd) {
+        std::size_t slot = _slots.size();
+        if (_free.empty()) {
+            _slots.emplace_back();
+        }
+        else {
+            slot = _free.back();
+            _free.pop_back();
+        }
+        _slots[slot] = std::make_unique<Connection<MaxFrameSize>>(fd);
+        ++_open;
+        return slot;
+    }
+
+    /**
+     * @brief Closes a connection and frees its slot
+     * @param slot The slot of the connection
+     */
+    void release(const std::size_t slot) {
+        _slots[slot].reset();
+        _free.push_back(slot);
+        --_open;
+    }
+
+    [[nodiscard]] Connection<MaxFrameSize>& operator[](const std::size_t slot) noexcept { return *_slots[slot]; }
+
+    /** @brief Number of open connections */
+    [[nodiscard]] std::size_t size() const noexcept { return _open; }
+
+    /**
+     * @brief Calls a function with the slot of every open connection
+     * @param f The function
+     */
+    template <typename F> void forEach(F&& f) {
+        for (std::size_t slot = 0; slot < _slots.size(); ++slot) {
+            if (_slots[slot] != nullptr) {
+                f(slot);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Creates the event file descriptor stop() writes to
+ * @return UniqueFd The descriptor
+ * @throws std::system_error if eventfd() fails
+ */
+inline UniqueFd makeStopEvent() {
+    const int fd = ::eventfd(0, EFD_CLOEXEC); // blocking: UringListener reads it through the ring
+    if (fd < 0) {
+        posix_helpers::throwErrno("eventfd");
+    }
+    return UniqueFd(fd);
+}
+
+/**
+ * @brief Wakes the loop waiting on a stop event
+ * @param event The stop event
+ */
+inline void signalStop(const UniqueFd& event) noexcept {
+    const std::uint64_t one = 1;
+    static_cast<void>(::write(event.get(), &one, sizeof(one)));
+}
+} // namespace socket_listener_helpers
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Listener serving the clients of a listening socket, see EpollListener and UringListener
+ */
+class SocketListener : public Listener
+{
+  public:
+    /**
+     * @brief Makes start() close every connection and return; safe from any thread
+     *
+     * Called before start(), the next start() returns right away.
+     */
+    virtual void stop() noexcept = 0;
+
+    /**
+     * @brief Snapshot of the listener counters
+     * @return SocketListenerStats The counters
+     */
+    [[nodiscard]] virtual SocketListenerStats stats() const noexcept = 0;
+};
+
+/**
+ * @brief Listener serving every client of a listening stream socket from one thread, with epoll
+ *
+ * start() accepts connections and reads COBS-delimited frames from all of them on the calling
+ * thread; each complete frame is executed with HandlerT::execute() straight from the connection's
+ * framer, and responses are COBS-encoded and written back on the same connection once the chunk
+ * is processed. Sockets are non-blocking: a client that does not read its responses only delays
+ * its own output. Commands execute on the loop thread, so a slow command stalls every client.
+ *
+ * The portable fallback of UringListener, see makeSocketListener().
+ *
+ * @tparam HandlerT The handler, e.g. Handler<Commands...>
+ * @tparam MaxFrameSize The largest frame accepted from a client
+ */
+template <typename HandlerT, std::size_t MaxFrameSize = 256> class EpollListener final : public SocketListener
+{
+    using connection_t = socket_listener_helpers::Connection<MaxFrameSize>;
+
+    /** @brief epoll tag of the listening socket, connections are tagged with their slot */
+    static constexpr std::uint64_t LISTEN_TAG = ~std::uint64_t{0};
+    /** @brief epoll tag of the stop event */
+    static constexpr std::uint64_t STOP_TAG = ~std::uint64_t{0} - 1;
+    /** @brief Events handled per epoll_wait() */
+    static constexpr int EVENTS = 64;
+
+    const int _listen_fd;
+    const SocketListenerConfig _config;
+    socket_listener_helpers::UniqueFd _stop;
+    socket_listener_helpers::UniqueFd _epoll;
+    socket_listener_helpers::ConnectionTable<MaxFrameSize> _connections;
+    std::vector<std::uint8_t> _buffer;
+    socket_listener_helpers::Counters _counters;
+
+    /**
+     * @brief Registers or updates a descriptor in the epoll set
+     * @throws std::system_error if epoll_ctl() fails
+     */
+    void control(const int op, const int fd, const std::uint32_t events, const std::uint64_t tag) const {
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = tag;
+        if (::epoll_ctl(_epoll.get(), op, fd, &event) < 0) {
+            posix_helpers::throwErrno("epoll_ctl");
+        }
+    }
+
+    void release(const std::size_t slot) {
+        _connections.release(slot); // closing the socket also removes it from the epoll set
+        socket_listener_helpers::Counters::bump(_counters.closed);
+    }
+
+    /**
+     * @brief Accepts every pending connection
+     */
+    void acceptAll() {
+        for (;;) {
+            const int fd = ::accept4(_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                return; // EAGAIN once drained; ECONNABORTED, EMFILE, ... are retried on the next event
+            }
+            if (_connections.size() >= _config.max_connections) {
+                ::close(fd);
+                socket_listener_helpers::Counters::bump(_counters.rejected);
+                continue;
+            }
+            const std::size_t slot = _connections.open(fd);
+            _connections[slot].watched = EPOLLIN | EPOLLRDHUP;
+            control(EPOLL_CTL_ADD, fd, _connections[slot].watched, slot);
+            socket_listener_helpers::Counters::bump(_counters.accepted);
+        }
+    }
+
+    /**
+     * @brief Writes as much pending output as the socket takes
+     * @param connection The connection, marked broken if the write fails
+     * @return bool Whether output is left, to write once the socket is writable again
+     */
+    static bool writeOutput(connection_t& connection) noexcept {
+        for (serialized_message_view_t output = connection.pendingOutput(); !output.empty();
+             output = connection.pendingOutput()) {
+            const ssize_t written = ::send(connection.fd(), output.data(), output.size(), MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                connection.broken = errno != EAGAIN && errno != EWOULDBLOCK;
+                return !connection.broken;
+            }
+            connection.wrote(static_cast<std::size_t>(written));
+        }
+        return false;
+    }
+
+    /**
+     * @brief Services a connection: reads one chunk, executes its frames, writes the responses
+     * @param slot The slot of the connection
+     * @param events The epoll events of the connection
+     */
+    void service(const std::size_t slot, const std::uint32_t events) {
+        connection_t& connection = _connections[slot];
+        if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0 && !connection.closing) {
+            const ssize_t received = ::recv(connection.fd(), _buffer.data(), _buffer.size(), 0);
+            if (received > 0) {
+                connection.template consume<HandlerT>(
+                    serialized_message_view_t(_buffer.data(), static_cast<std::size_t>(received)), _counters
+                );
+            }
+            else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                connection.closing = true;
+            }
+        }
+        const bool blocked = writeOutput(connection);
+        // A half-closed client still gets its responses: the connection closes once they are written
+        if (connection.broken || (connection.closing && !blocked)) {
+            release(slot);
+            return;
+        }
+        // Input is only watched while open, output only while some is left
+        const std::uint32_t watched = (connection.closing ? 0U : EPOLLIN | EPOLLRDHUP) | (blocked ? EPOLLOUT : 0U);
+        if (watched != connection.watched) {
+            connection.watched = watched;
+            control(EPOLL_CTL_MOD, connection.fd(), watched, slot);
+        }
+    }
+
+    /**
+     * @brief Runs the event loop until the stop event fires
+     * @throws std::system_error if epoll_wait() or epoll_ctl() fail
+     */
+    void run() {
+        std::array<epoll_event, EVENTS> events{};
+        bool running = true;
+        while (running) {
+            const int ready = ::epoll_wait(_epoll.get(), events.data(), EVENTS, -1);
+            if (ready < 0 && errno != EINTR) {
+                posix_helpers::throwErrno("epoll_wait");
+            }
+            for (int i = 0; i < ready; ++i) {
+                const epoll_event& event = events[static_cast<std::size_t>(i)];
+                if (event.data.u64 == LISTEN_TAG) {
+                    acceptAll();
+                }
+                else if (event.data.u64 == STOP_TAG) {
+                    std::uint64_t count = 0;
+                    static_cast<void>(::read(_stop.get(), &count, sizeof(count)));
+                    running = false;
+                }
+                else {
+                    service(static_cast<std::size_t>(event.data.u64), event.events);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Closes every connection, writing what their sockets take of the pending output
+     */
+    void closeAll() {
+        _connections.forEach([this](const std::size_t slot) {
+            static_cast<void>(writeOutput(_connections[slot])); // best effort, no waiting for writability
+            release(slot);
+        });
+        _epoll.reset();
+    }
+
+  public:
+    /**
+     * @brief Constructs the listener
+     *
+     * @param listen_fd A listening stream socket (TCP, AF_UNIX), made non-blocking, not owned
+     * @param config Connection limits and buffer sizes
+     * @throws std::system_error if the stop event cannot be created
+     */
+    explicit EpollListener(const int listen_fd, const SocketListenerConfig config = {})
+        : _listen_fd(listen_fd), _config(config), _stop(socket_listener_helpers::makeStopEvent()),
+          _buffer(config.receive_buffer == 0 ? 1 : config.receive_buffer) {
+        ::fcntl(_listen_fd, F_SETFL, ::fcntl(_listen_fd, F_GETFL) | O_NONBLOCK);
+    }
+
+    EpollListener(const EpollListener&) = delete;
+    EpollListener& operator=(const EpollListener&) = delete;
+
+    /**
+     * @brief Serves the clients until stop() is called
+     *
+     * Blocks the calling thread. Before returning, every connection is closed.
+     *
+     * @throws std::system_error if the epoll set cannot be created or updated
+     */
+    void start() override {
+        const int epoll = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epoll < 0) {
+            posix_helpers::throwErrno("epoll_create1");
+        }
+        _epoll = socket_listener_helpers::UniqueFd(epoll);
+        try {
+            control(EPOLL_CTL_ADD, _listen_fd, EPOLLIN, LISTEN_TAG);
+            control(EPOLL_CTL_ADD, _stop.get(), EPOLLIN, STOP_TAG);
+            run();
+        }
+        catch (...) {
+            closeAll();
+            throw;
+        }
+        closeAll();
+    }
+
+    void stop() noexcept override { socket_listener_helpers::signalStop(_stop); }
+
+    [[nodiscard]] SocketListenerStats stats() const noexcept override { return _counters.snapshot(); }
+};
+#endif
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+template <typename T = void> class Task;
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace task_helpers
+{
+/**
+ * @brief Promise parts shared by every Task: continuation and exception
+ */
+class PromiseBase
+{
+    std::coroutine_handle<> _continuation = std::noop_coroutine();
+    std::exception_ptr _exception;
+
+    /** @brief Final awaiter, transfers control to the awaiting coroutine without growing the stack */
+    struct FinalAwaiter
+    {
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        [[nodiscard]] std::coroutine_handle<> await_suspend(const std::coroutine_handle<Promise> handle) noexcept {
+            return handle.promise()._continuation;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+  public:
+    [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+    [[nodiscard]] FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { _exception = std::current_exception(); }
+
+    /**
+     * @brief Sets the coroutine resumed once this task completes
+     * @param continuation The awaiting coroutine
+     */
+    void setContinuation(const std::coroutine_handle<> continuation) noexcept { _continuation = continuation; }
+
+    /**
+     * @brief Rethrows the exception escaping the coroutine body, if any
+     */
+    void rethrowIfFailed() const {
+        if (_exception) {
+            std::rethrow_exception(_exception);
+        }
+    }
+};
+
+/**
+ * @brief Promise of a Task producing a value
+ * @tparam T The value type
+ */
+template <typename T> class Promise final : public PromiseBase
+{
+    std::optional<T> _value;
+
+  public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+        requires std::is_convertible_v<U&&, T>
+    void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
+        _value.emplace(std::forward<U>(value));
+    }
+
+    /**
+     * @brief Moves the value out, or rethrows the exception escaping the coroutine body
+     * @return T The value
+     */
+    T result() {
+        rethrowIfFailed();
+        return std::move(*_value);
+    }
+};
+
+/**
+ * @brief Promise of a Task producing nothing
+ */
+template <> class Promise<void> final : public PromiseBase
+{
+  public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    /**
+     * @brief Rethrows the exception escaping the coroutine body, if any
+     */
+    void result() const { rethrowIfFailed(); }
+};
+} // namespace task_helpers
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Lazily started coroutine task, the body runs when the task is first awaited
+ *
+ * Awaiting a task resumes the awaiting coroutine by symmetric transfer when the task completes, so
+ * long chains of tasks completing synchronously do not grow the stack once optimised (-O2 turns the
+ * transfer into a tail call). A task is awaited at most once; from a plain function, use syncWait().
+ *
+ * Usage:
+ *     Task<int> answer() { co_return 42; }
+ *     Task<int> twice() { co_return 2 * co_await answer(); }
+ *
+ * @tparam T The type of the value produced by the coroutine
+ */
+template <typename T> class [[nodiscard]] Task
+{
+  public:
+    using promise_type = task_helpers::Promise<T>;
+
+  private:
+    std::coroutine_handle<promise_type> _handle;
+
+  public:
+    /**
+     * @brief Takes ownership of a coroutine frame, used by the promise
+     * @param handle The coroutine
+     */
+    explicit Task(const std::coroutine_handle<promise_type> handle) noexcept : _handle(handle) {}
+
+    Task(Task&& other) noexcept : _handle(std::exchange(other._handle, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (_handle) {
+                _handle.destroy();
+            }
+            _handle = std::exchange(other._handle, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    /**
+     * @brief Starts the task, which resumes awaiting when it completes
+     * @param awaiting The awaiting coroutine
+     * @return std::coroutine_handle<> The task coroutine, resumed next
+     */
+    [[nodiscard]] std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+        _handle.promise().setContinuation(awaiting);
+        return _handle;
+    }
+
+    /**
+     * @brief Produces the value of the completed task
+     * @return T The value
+     * @throws Whatever escaped the coroutine body
+     */
+    T await_resume() { return _handle.promise().result(); }
+};
+
+template <typename T> Task<T> task_helpers::Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise>::from_promise(*this));
+}
+
+inline Task<void> task_helpers::Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise>::from_promise(*this));
+}
+
+/* ―――――――――――――――― Functions ―――――――――――――――― */
+
+namespace task_helpers
+{
+/**
+ * @brief Completion signal of syncWait(), notified while holding its lock so the waiter outlives the notifier
+ */
+struct SyncWaitEvent
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool done = false;
+
+    void set() {
+        const std::scoped_lock lock(mutex);
+        done = true;
+        condition.notify_one();
+    }
+
+    void wait() {
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [this] { return done; });
+    }
+};
+
+/**
+ * @brief Eagerly destroyed driver coroutine of syncWait(), signals its event on completion
+ */
+struct SyncWaitDriver
+{
+    struct promise_type
+    {
+        SyncWaitEvent* event = nullptr;
+
+        SyncWaitDriver get_return_object() noexcept {
+            return SyncWaitDriver{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        [[nodiscard]] auto final_suspend() const noexcept {
+            struct Signal
+            {
+                [[nodiscard]] bool await_ready() const noexcept { return false; }
+                void await_suspend(const std::coroutine_handle<promise_type> handle) const noexcept {
+                    handle.promise().event->set();
+                }
+                void await_resume() const noexcept {}
+            };
+            return Signal{};
+        }
+
+        void return_void() const noexcept {}
+        [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); } // the body catches everything
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/** @brief Type alias for the value slot of syncWait(), a flag for Task<void> */
+template <typename T> using sync_wait_value_t = std::optional<std::conditional_t<std::is_void_v<T>, bool, T>>;
+
+/**
+ * @brief Awaits task, storing its value or exception
+ * @param task The task
+ * @param[out] value Slot receiving the value
+ * @param[out] error Slot receiving the exception
+ * @return SyncWaitDriver The suspended driver coroutine
+ */
+template <typename T> SyncWaitDriver drive(Task<T>& task, sync_wait_value_t<T>& value, std::exception_ptr& error) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+            value.emplace(true);
+        }
+        else {
+            value.emplace(co_await task);
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+}
+} // namespace task_helpers
+
+/**
+ * @brief Runs a task to completion, blocking the calling thread until it completes
+ *
+ * The task may complete on another thread (e.g. the transport thread completing an AsyncRequest).
+ *
+ * @param task The task
+ * @return T The value produced by the task
+ * @throws Whatever escaped the coroutine body
+ */
+template <typename T> T syncWait(Task<T> task) {
+    task_helpers::sync_wait_value_t<T> value;
+    std::exception_ptr error;
+    task_helpers::SyncWaitEvent event;
+    const task_helpers::SyncWaitDriver driver = task_helpers::drive(task, value, error);
+    driver.handle.promise().event = &event;
+    driver.handle.resume();
+    event.wait();
+    driver.handle.destroy();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*value);
+    }
+}
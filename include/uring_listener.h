@@ -0,0 +1,596 @@
+#pragma once
+
+#include "posix_helpers.h"
+#include "socket_listener.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(IORING_RECV_MULTISHOT) && defined(IORING_SETUP_DEFER_TASKRUN)
+#define LIBCMD_HAS_IO_URING 1
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace uring_helpers
+{
+/** @brief Submission queue entries, the completion queue holds four times as many */
+inline constexpr unsigned RING_ENTRIES = 1024;
+/** @brief Ring flags; SINGLE_ISSUER and DEFER_TASKRUN need Linux 6.1, as do multishot recv and buffer rings */
+inline constexpr unsigned RING_FLAGS =
+    IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_CQSIZE;
+/** @brief Identifier of the provided buffer group receives take their buffers from */
+inline constexpr std::uint16_t BUFFER_GROUP = 0;
+
+/**
+ * @brief Minimal io_uring: the two mapped rings and the submission entries, without liburing
+ *
+ * Entries are filled with next() and handed to the kernel together by submit(); completions are
+ * consumed with reap(). Only the thread that created the ring may use it (SINGLE_ISSUER).
+ */
+class Ring
+{
+    socket_listener_helpers::UniqueFd _fd;
+    void* _rings = MAP_FAILED; ///< Submission and completion rings, one mapping (IORING_FEAT_SINGLE_MMAP)
+    std::size_t _rings_size = 0;
+    io_uring_sqe* _sqes = nullptr;
+    std::size_t _sqes_size = 0;
+    unsigned* _sq_head = nullptr;
+    unsigned* _sq_tail = nullptr;
+    unsigned _sq_mask = 0;
+    unsigned _sq_entries = 0;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned _cq_mask = 0;
+    io_uring_cqe* _cqes = nullptr;
+    unsigned _tail = 0;    ///< Local submission tail, published by submit()
+    unsigned _pending = 0; ///< Entries filled since the last submit()
+
+    template <typename T> T* at(const std::size_t offset) const noexcept {
+        return reinterpret_cast<T*>(static_cast<std::uint8_t*>(_rings) + offset);
+    }
+
+    void unmap() noexcept {
+        if (_sqes != nullptr) {
+            ::munmap(_sqes, _sqes_size);
+        }
+        if (_rings != MAP_FAILED) {
+            ::munmap(_rings, _rings_size);
+        }
+    }
+
+  public:
+    /**
+     * @brief Creates and maps a ring
+     * @param entries The number of submission entries
+     * @throws std::system_error if the kernel refuses the ring (too old, io_uring disabled, ...)
+     */
+    explicit Ring(const unsigned entries) {
+        io_uring_params params{};
+        params.flags = RING_FLAGS;
+        params.cq_entries = entries * 4;
+        const auto fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            posix_helpers::throwErrno("io_uring_setup");
+        }
+        _fd = socket_listener_helpers::UniqueFd(fd);
+        if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0) {
+            throw std::system_error(ENOSYS, std::generic_category(), "io_uring without IORING_FEAT_SINGLE_MMAP");
+        }
+        _rings_size = std::max<std::size_t>(
+            params.sq_off.array + params.sq_entries * sizeof(unsigned),
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe)
+        );
+        constexpr int PROTECTION = PROT_READ | PROT_WRITE;
+        constexpr int MAPPING = MAP_SHARED | MAP_POPULATE;
+        _rings = ::mmap(nullptr, _rings_size, PROTECTION, MAPPING, fd, IORING_OFF_SQ_RING);
+        if (_rings == MAP_FAILED) {
+            posix_helpers::throwErrno("mmap");
+        }
+        _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* const sqes = ::mmap(nullptr, _sqes_size, PROTECTION, MAPPING, fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            unmap();
+            posix_helpers::throwErrno("mmap");
+        }
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+        _sq_head = at<unsigned>(params.sq_off.head);
+        _sq_tail = at<unsigned>(params.sq_off.tail);
+        _sq_mask = *at<unsigned>(params.sq_off.ring_mask);
+        _sq_entries = params.sq_entries;
+        _cq_head = at<unsigned>(params.cq_off.head);
+        _cq_tail = at<unsigned>(params.cq_off.tail);
+        _cq_mask = *at<unsigned>(params.cq_off.ring_mask);
+        _cqes = at<io_uring_cqe>(params.cq_off.cqes);
+        _tail = *_sq_tail;
+        unsigned* const array = at<unsigned>(params.sq_off.array);
+        for (unsigned i = 0; i < params.sq_entries; ++i) { // entry i always sits in slot i
+            array[i] = i;
+        }
+    }
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    ~Ring() { unmap(); }
+
+    [[nodiscard]] int fd() const noexcept { return _fd.get(); }
+
+    /**
+     * @brief Next free submission entry, zeroed; the queue is submitted first if it is full
+     * @return io_uring_sqe& The entry, submitted by the next submit()
+     */
+    io_uring_sqe& next() {
+        while (_tail - std::atomic_ref(*_sq_head).load(std::memory_order_acquire) == _sq_entries) {
+            submit(0);
+        }
+        io_uring_sqe& sqe = _sqes[_tail & _sq_mask];
+        sqe = io_uring_sqe{};
+        ++_tail;
+        ++_pending;
+        return sqe;
+    }
+
+    /**
+     * @brief Submits the filled entries and waits for completions
+     * @param wait The number of completions to wait for, 0 to return right away
+     * @throws std::system_error if io_uring_enter() fails
+     */
+    void submit(const unsigned wait) {
+        std::atomic_ref(*_sq_tail).store(_tail, std::memory_order_release);
+        const unsigned flags = wait > 0 ? IORING_ENTER_GETEVENTS : 0U;
+        const auto submitted =
+            static_cast<int>(::syscall(__NR_io_uring_enter, fd(), _pending, wait, flags, nullptr, 0));
+        if (submitted < 0) {
+            if (errno == EINTR || errno == EBUSY) { // EBUSY: completions must be reaped first
+                return;
+            }
+            posix_helpers::throwErrno("io_uring_enter");
+        }
+        _pending -= static_cast<unsigned>(submitted);
+    }
+
+    /**
+     * @brief Consumes every available completion
+     * @param f Called with a copy of each completion, may fill new entries
+     */
+    template <typename F> void reap(F&& f) {
+        unsigned head = *_cq_head;
+        while (head != std::atomic_ref(*_cq_tail).load(std::memory_order_acquire)) {
+            const io_uring_cqe cqe = _cqes[head & _cq_mask];
+            std::atomic_ref(*_cq_head).store(++head, std::memory_order_release);
+            f(cqe);
+        }
+    }
+
+    /**
+     * @brief Calls io_uring_register()
+     * @throws std::system_error if the call fails
+     */
+    void registerResource(const unsigned opcode, void* const argument, const unsigned count) const {
+        if (::syscall(__NR_io_uring_register, fd(), opcode, argument, count) < 0) {
+            posix_helpers::throwErrno("io_uring_register");
+        }
+    }
+};
+
+/**
+ * @brief Receive buffers registered with a ring as a provided buffer ring
+ *
+ * The kernel picks a free buffer for each completed multishot receive and reports its ID; the
+ * buffer goes back to the kernel with recycle() once its bytes are consumed. All connections share
+ * the buffers, so memory stays proportional to the receives in flight, not to the connections.
+ */
+class BufferRing
+{
+    const Ring& _ring;
+    io_uring_buf* _bufs = nullptr; ///< The ring entries; the tail overlays the resv field of the first one
+    std::size_t _bufs_size = 0;
+    std::vector<std::uint8_t> _storage;
+    const std::size_t _buffer_size;
+    const std::uint16_t _mask;
+    std::uint16_t _tail = 0;
+
+  public:
+    /**
+     * @brief Allocates the buffers and registers them with the ring
+     *
+     * @param ring The ring
+     * @param count The number of buffers, a power of two up to 32768
+     * @param buffer_size The size of each buffer
+     * @throws std::system_error if the registration fails
+     */
+    BufferRing(const Ring& ring, const std::size_t count, const std::size_t buffer_size)
+        : _ring(ring), _bufs_size(count * sizeof(io_uring_buf)), _storage(count * buffer_size),
+          _buffer_size(buffer_size), _mask(static_cast<std::uint16_t>(count - 1)) {
+        void* const bufs = ::mmap(nullptr, _bufs_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (bufs == MAP_FAILED) {
+            posix_helpers::throwErrno("mmap");
+        }
+        // Not io_uring_buf_ring::bufs: in C++ the empty struct of __DECLARE_FLEX_ARRAY moves it 8 bytes
+        _bufs = static_cast<io_uring_buf*>(bufs);
+        io_uring_buf_reg registration{};
+        registration.ring_addr = reinterpret_cast<std::uintptr_t>(_bufs);
+        registration.ring_entries = static_cast<std::uint32_t>(count);
+        registration.bgid = BUFFER_GROUP;
+        try {
+            ring.registerResource(IORING_REGISTER_PBUF_RING, &registration, 1);
+        }
+        catch (...) {
+            ::munmap(_bufs, _bufs_size);
+            throw;
+        }
+        for (std::size_t id = 0; id < count; ++id) {
+            recycle(static_cast<std::uint16_t>(id));
+        }
+    }
+
+    BufferRing(const BufferRing&) = delete;
+    BufferRing& operator=(const BufferRing&) = delete;
+
+    ~BufferRing() {
+        io_uring_buf_reg registration{};
+        registration.bgid = BUFFER_GROUP;
+        try {
+            _ring.registerResource(IORING_UNREGISTER_PBUF_RING, &registration, 1);
+        }
+        catch (...) { // NOLINT(bugprone-empty-catch) closing the ring unregisters the buffers anyway
+        }
+        ::munmap(_bufs, _bufs_size);
+    }
+
+    /**
+     * @brief Bytes received into a buffer
+     * @param id The buffer ID of the completion
+     * @param size The number of bytes received
+     * @return serialized_message_view_t The bytes
+     */
+    [[nodiscard]] serialized_message_view_t buffer(const std::uint16_t id, const std::size_t size) const noexcept {
+        return serialized_message_view_t(_storage).subspan(id * _buffer_size, size);
+    }
+
+    /**
+     * @brief Hands a buffer back to the kernel
+     * @param id The buffer ID
+     */
+    void recycle(const std::uint16_t id) noexcept {
+        io_uring_buf& buf = _bufs[_tail & _mask];
+        buf.addr = reinterpret_cast<std::uintptr_t>(_storage.data() + id * _buffer_size);
+        buf.len = static_cast<std::uint32_t>(_buffer_size);
+        buf.bid = id;
+        std::atomic_ref(_bufs[0].resv).store(++_tail, std::memory_order_release);
+    }
+};
+} // namespace uring_helpers
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Listener serving every client of a listening stream socket from one thread, with io_uring
+ *
+ * Same behaviour as EpollListener, with fewer system calls: connections are accepted by one
+ * multishot accept, each connection has one multishot receive drawing from a buffer ring
+ * registered with the kernel, and the responses of all connections are sent through the same
+ * ring. Each loop iteration is a single io_uring_enter() submitting the sends and waiting for the
+ * next completions, whatever the number of connections.
+ *
+ * Needs Linux 6.1 (see supported()); makeSocketListener() falls back to EpollListener otherwise.
+ *
+ * @tparam HandlerT The handler, e.g. Handler<Commands...>
+ * @tparam MaxFrameSize The largest frame accepted from a client
+ */
+template <typename HandlerT, std::size_t MaxFrameSize = 256> class UringListener final : public SocketListener
+{
+    using connection_t = socket_listener_helpers::Connection<MaxFrameSize>;
+
+    /** @brief Operation of a submission, in the top byte of its user data; the rest is the connection slot */
+    enum class OPERATION : std::uint8_t
+    {
+        ACCEPT = 1,
+        STOP = 2,
+        RECEIVE = 3,
+        SEND = 4,
+        CANCEL = 5,
+    };
+
+    static constexpr std::uint64_t userData(const OPERATION operation, const std::size_t slot = 0) noexcept {
+        return (static_cast<std::uint64_t>(operation) << 56U) | slot;
+    }
+
+    const int _listen_fd;
+    const SocketListenerConfig _config;
+    socket_listener_helpers::UniqueFd _stop;
+    socket_listener_helpers::ConnectionTable<MaxFrameSize> _connections;
+    socket_listener_helpers::Counters _counters;
+    std::vector<std::size_t> _queue; ///< Connections to service once the completions are reaped
+    std::uint64_t _stop_count = 0;   ///< Read from the stop event by the ring
+    bool _stopping = false;
+
+    /**
+     * @brief Everything start() creates, on the calling thread
+     */
+    struct Loop
+    {
+        uring_helpers::Ring ring;
+        uring_helpers::BufferRing buffers;
+
+        explicit Loop(const SocketListenerConfig& config)
+            : ring(uring_helpers::RING_ENTRIES),
+              buffers(ring, std::bit_ceil(std::clamp<std::size_t>(config.receive_buffers, 1, 32768)),
+                      config.receive_buffer == 0 ? 1 : config.receive_buffer) {}
+    };
+
+    void armAccept(uring_helpers::Ring& ring) const {
+        io_uring_sqe& sqe = ring.next();
+        sqe.opcode = IORING_OP_ACCEPT;
+        sqe.fd = _listen_fd;
+        sqe.ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe.accept_flags = SOCK_CLOEXEC;
+        sqe.user_data = userData(OPERATION::ACCEPT);
+    }
+
+    void armStop(uring_helpers::Ring& ring) {
+        io_uring_sqe& sqe = ring.next();
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = _stop.get();
+        sqe.addr = reinterpret_cast<std::uintptr_t>(&_stop_count);
+        sqe.len = sizeof(_stop_count);
+        sqe.user_data = userData(OPERATION::STOP);
+    }
+
+    void armReceive(uring_helpers::Ring& ring, const std::size_t slot) {
+        connection_t& connection = _connections[slot];
+        io_uring_sqe& sqe = ring.next();
+        sqe.opcode = IORING_OP_RECV;
+        sqe.fd = connection.fd();
+        sqe.ioprio = IORING_RECV_MULTISHOT;
+        sqe.flags = IOSQE_BUFFER_SELECT;
+        sqe.buf_group = uring_helpers::BUFFER_GROUP;
+        sqe.user_data = userData(OPERATION::RECEIVE, slot);
+        connection.receiving = true;
+    }
+
+    void armSend(uring_helpers::Ring& ring, const std::size_t slot, const serialized_message_view_t output) {
+        io_uring_sqe& sqe = ring.next();
+        sqe.opcode = IORING_OP_SEND;
+        sqe.fd = _connections[slot].fd();
+        sqe.addr = reinterpret_cast<std::uintptr_t>(output.data());
+        sqe.len = static_cast<std::uint32_t>(output.size());
+        sqe.msg_flags = MSG_NOSIGNAL;
+        sqe.user_data = userData(OPERATION::SEND, slot);
+        _connections[slot].writing = true;
+    }
+
+    void enqueue(const std::size_t slot) {
+        connection_t& connection = _connections[slot];
+        if (!connection.queued) {
+            connection.queued = true;
+            _queue.push_back(slot);
+        }
+    }
+
+    /**
+     * @brief Handles one completion
+     */
+    void complete(Loop& loop, const io_uring_cqe& cqe) {
+        const auto operation = static_cast<OPERATION>(cqe.user_data >> 56U);
+        const std::size_t slot = cqe.user_data & ((std::uint64_t{1} << 56U) - 1);
+        const bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+        switch (operation) {
+        case OPERATION::ACCEPT:
+            if (cqe.res >= 0) {
+                if (_stopping || _connections.size() >= _config.max_connections) {
+                    ::close(cqe.res);
+                    socket_listener_helpers::Counters::bump(_counters.rejected);
+                }
+                else {
+                    armReceive(loop.ring, _connections.open(cqe.res));
+                    socket_listener_helpers::Counters::bump(_counters.accepted);
+                }
+            }
+            else if (cqe.res == -EBADF || cqe.res == -EINVAL || cqe.res == -ENOTSOCK) {
+                throw std::system_error(-cqe.res, std::generic_category(), "accept");
+            }
+            if (!more && !_stopping) {
+                armAccept(loop.ring);
+            }
+            break;
+        case OPERATION::STOP: {
+            _stopping = true;
+            io_uring_sqe& cancel = loop.ring.next();
+            cancel.opcode = IORING_OP_ASYNC_CANCEL;
+            cancel.addr = userData(OPERATION::ACCEPT);
+            cancel.user_data = userData(OPERATION::CANCEL);
+            // Ends the receives and sends in flight, each connection then closes on its last completion
+            _connections.forEach([this](const std::size_t open) {
+                ::shutdown(_connections[open].fd(), SHUT_RDWR);
+                enqueue(open);
+            });
+            break;
+        }
+        case OPERATION::RECEIVE: {
+            connection_t& connection = _connections[slot];
+            if (cqe.res > 0) {
+                const auto id = static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                connection.template consume<HandlerT>(
+                    loop.buffers.buffer(id, static_cast<std::size_t>(cqe.res)), _counters
+                );
+                loop.buffers.recycle(id);
+            }
+            if (!more) {
+                connection.receiving = false;
+                // A multishot receive also ends when the buffers run out; 0 or an error end the input
+                if ((cqe.res > 0 || cqe.res == -ENOBUFS) && !_stopping && !connection.closing) {
+                    armReceive(loop.ring, slot);
+                }
+                else {
+                    connection.closing = true;
+                }
+            }
+            enqueue(slot);
+            break;
+        }
+        case OPERATION::SEND: {
+            connection_t& connection = _connections[slot];
+            connection.writing = false;
+            if (cqe.res < 0) {
+                connection.broken = true;
+            }
+            else {
+                connection.wrote(static_cast<std::size_t>(cqe.res));
+            }
+            enqueue(slot);
+            break;
+        }
+        case OPERATION::CANCEL:
+            break;
+        }
+    }
+
+    /**
+     * @brief Sends the pending output of a connection, or closes it once it has no operation in flight
+     */
+    void service(Loop& loop, const std::size_t slot) {
+        connection_t& connection = _connections[slot];
+        connection.queued = false;
+        if (!connection.writing && !connection.broken) {
+            const serialized_message_view_t output = connection.pendingOutput();
+            if (!output.empty()) {
+                armSend(loop.ring, slot, output);
+            }
+        }
+        if (connection.broken && connection.receiving) {
+            ::shutdown(connection.fd(), SHUT_RDWR); // ends the receive, its completion services the connection again
+        }
+        const bool done = connection.broken || (connection.closing && !connection.hasOutput());
+        if (done && !connection.receiving && !connection.writing) {
+            _connections.release(slot);
+            socket_listener_helpers::Counters::bump(_counters.closed);
+        }
+    }
+
+    /**
+     * @brief Runs the event loop until stop() is called and every connection is closed
+     */
+    void run(Loop& loop) {
+        _stopping = false;
+        armAccept(loop.ring);
+        armStop(loop.ring);
+        while (!_stopping || _connections.size() > 0) {
+            loop.ring.submit(1);
+            loop.ring.reap([this, &loop](const io_uring_cqe& cqe) { complete(loop, cqe); });
+            for (std::size_t i = 0; i < _queue.size(); ++i) { // servicing never enqueues
+                service(loop, _queue[i]);
+            }
+            _queue.clear();
+        }
+    }
+
+    /**
+     * @brief Closes every connection, without waiting for their operations (the ring is going away)
+     */
+    void closeAll() {
+        _connections.forEach([this](const std::size_t slot) {
+            _connections.release(slot);
+            socket_listener_helpers::Counters::bump(_counters.closed);
+        });
+        _queue.clear();
+    }
+
+  public:
+    /**
+     * @brief Constructs the listener, the ring itself is created by start()
+     *
+     * @param listen_fd A listening stream socket (TCP, AF_UNIX), not owned
+     * @param config Connection limits and buffer sizes
+     * @throws std::system_error if the stop event cannot be created
+     */
+    explicit UringListener(const int listen_fd, const SocketListenerConfig config = {})
+        : _listen_fd(listen_fd), _config(config), _stop(socket_listener_helpers::makeStopEvent()) {}
+
+    UringListener(const UringListener&) = delete;
+    UringListener& operator=(const UringListener&) = delete;
+
+    /**
+     * @brief Whether the kernel supports the io_uring features used, by creating a small ring
+     * @return bool Whether start() can create its ring
+     */
+    [[nodiscard]] static bool supported() noexcept {
+        try {
+            const uring_helpers::Ring ring(2);
+            const uring_helpers::BufferRing buffers(ring, 1, 64);
+            return true;
+        }
+        catch (...) {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Serves the clients until stop() is called
+     *
+     * Blocks the calling thread, which is the only one submitting to the ring. Before returning,
+     * every connection is closed.
+     *
+     * @throws std::system_error if the ring cannot be created or an operation fails unexpectedly
+     */
+    void start() override {
+        const std::unique_ptr<Loop> loop = std::make_unique<Loop>(_config);
+        try {
+            run(*loop);
+        }
+        catch (...) {
+            closeAll();
+            throw;
+        }
+    }
+
+    void stop() noexcept override { socket_listener_helpers::signalStop(_stop); }
+
+    [[nodiscard]] SocketListenerStats stats() const noexcept override { return _counters.snapshot(); }
+};
+#endif
+
+/* ―――――――――――――――― Functions ―――――――――――――――― */
+
+#ifdef __linux__
+/**
+ * @brief Creates the fastest socket listener the running kernel supports
+ *
+ * Usage:
+ *     const std::unique_ptr<SocketListener> listener = makeSocketListener<MyHandler>(listen_fd);
+ *     std::thread loop([&] { listener->start(); });
+ *     ...
+ *     listener->stop();
+ *
+ * @tparam HandlerT The handler, e.g. Handler<Commands...>
+ * @tparam MaxFrameSize The largest frame accepted from a client
+ * @param listen_fd A listening stream socket (TCP, AF_UNIX), not owned
+ * @param config Connection limits and buffer sizes
+ * @return std::unique_ptr<SocketListener> A UringListener where supported, an EpollListener otherwise
+ */
+template <typename HandlerT, std::size_t MaxFrameSize = 256>
+std::unique_ptr<SocketListener> makeSocketListener(const int listen_fd, const SocketListenerConfig config = {}) {
+#ifdef LIBCMD_HAS_IO_URING
+    if (UringListener<HandlerT, MaxFrameSize>::supported()) {
+        return std::make_unique<UringListener<HandlerT, MaxFrameSize>>(listen_fd, config);
+    }
+#endif
+    return std::make_unique<EpollListener<HandlerT, MaxFrameSize>>(listen_fd, config);
+}
+#endif
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "message.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define LIBCMD_HAS_AVX2_KERNEL 1
+#endif
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief Valid frame sizes of every dispatch slot, built at compile time by the handler (see BasicHandler)
+ *
+ * With one-byte IDs the slot is the ID byte; with wider IDs it is the slot of the ID in the handler's
+ * perfect hash. A frame is valid when min[slot] <= size <= max[slot]. Slots without a command have
+ * min above max, so no size is valid for them. The arrays are aligned for the vector gathers of
+ * validateFrames().
+ *
+ * @tparam Slots The number of slots
+ */
+template <std::size_t Slots = 256> struct FrameSizeTable
+{
+    alignas(32) std::array<std::uint32_t, Slots> min{}; ///< Smallest valid frame size of each slot
+    alignas(32) std::array<std::uint32_t, Slots> max{}; ///< Largest valid frame size of each slot
+};
+
+/**
+ * @brief Enumeration selecting the implementation of validateFrames()
+ */
+enum class VALIDATION_KERNEL : std::uint8_t
+{
+    AUTO = 0,   ///< AVX2 where the CPU running the program supports it, scalar elsewhere
+    SCALAR = 1, ///< One frame at a time, the reference the vector kernel is tested against
+    AVX2 = 2,   ///< Eight frames at a time, falls back to scalar where the CPU lacks AVX2
+};
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+namespace validation_helpers
+{
+/** @brief Largest frame size the tables can express, longer frames are clamped to it */
+inline constexpr std::size_t SIZE_LIMIT = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Size of a frame as compared against a FrameSizeTable
+ * @param frame The frame
+ * @return std::uint32_t The size, clamped to SIZE_LIMIT
+ */
+constexpr std::uint32_t frameSize(const serialized_message_view_t frame) noexcept {
+    return static_cast<std::uint32_t>(std::min(frame.size(), SIZE_LIMIT));
+}
+
+/**
+ * @brief Table index of a frame as compared against a FrameSizeTable<256>
+ * @param frame The frame
+ * @return std::uint32_t Its ID byte, 0 for an empty frame (whose size 0 is below every minimum)
+ */
+constexpr std::uint32_t frameId(const serialized_message_view_t frame) noexcept {
+    return frame.empty() ? 0U : frame.front();
+}
+
+/**
+ * @brief Checks the frames from begin on one at a time, setting their bits of a cleared mask
+ * @param frames The frames of the batch
+ * @param table The valid sizes of every ID byte
+ * @param[out] mask The cleared mask
+ * @param begin The first frame to check
+ */
+inline void validateScalar(
+    const std::span<const serialized_message_view_t> frames,
+    const FrameSizeTable<>& table,
+    const std::span<std::uint64_t> mask,
+    const std::size_t begin
+) noexcept {
+    for (std::size_t i = begin; i < frames.size(); ++i) {
+        const std::uint32_t id = frameId(frames[i]);
+        const std::uint32_t size = frameSize(frames[i]);
+        const bool accepted = (size >= table.min[id]) & (size <= table.max[id]);
+        mask[i / 64] |= static_cast<std::uint64_t>(accepted) << (i % 64);
+    }
+}
+
+#ifdef LIBCMD_HAS_AVX2_KERNEL
+/**
+ * @brief Checks the frames eight at a time with a gather from the table, setting their bits of a cleared mask
+ *
+ * Compiled for AVX2 whatever the -m flags of the build, so it must only run where cpuSupportsAvx2().
+ *
+ * @param frames The frames of the batch
+ * @param table The valid sizes of every ID byte
+ * @param[out] mask The cleared mask
+ * @return std::size_t The number of frames checked, the rest are left to validateScalar()
+ */
+[[gnu::target("avx2")]] inline std::size_t validateAvx2(
+    const std::span<const serialized_message_view_t> frames,
+    const FrameSizeTable<>& table,
+    const std::span<std::uint64_t> mask
+) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= frames.size(); i += 8) {
+        // Lanes are built in registers: storing them to memory first would stall on store forwarding
+        const auto id = [&frames, i](const std::size_t j) { return static_cast<int>(frameId(frames[i + j])); };
+        const auto size = [&frames, i](const std::size_t j) { return static_cast<int>(frameSize(frames[i + j])); };
+        const __m256i ids = _mm256_setr_epi32(id(0), id(1), id(2), id(3), id(4), id(5), id(6), id(7));
+        const __m256i sizes =
+            _mm256_setr_epi32(size(0), size(1), size(2), size(3), size(4), size(5), size(6), size(7));
+        const __m256i min = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table.min.data()), ids, 4);
+        const __m256i max = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table.max.data()), ids, 4);
+        // Unsigned min <= size <= max, as max(size, min) == size and min(size, max) == size
+        const __m256i above_min = _mm256_cmpeq_epi32(_mm256_max_epu32(sizes, min), sizes);
+        const __m256i below_max = _mm256_cmpeq_epi32(_mm256_min_epu32(sizes, max), sizes);
+        const auto bits = static_cast<std::uint32_t>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(above_min, below_max)))
+        );
+        mask[i / 64] |= static_cast<std::uint64_t>(bits) << (i % 64); // i % 64 is a multiple of 8
+    }
+    return i;
+}
+
+/**
+ * @brief Whether the CPU running the program supports AVX2, checked once
+ * @return bool Whether validateAvx2() may run
+ */
+inline bool cpuSupportsAvx2() noexcept {
+    static const bool SUPPORTED = __builtin_cpu_supports("avx2") != 0;
+    return SUPPORTED;
+}
+#endif
+
+/**
+ * @brief Counts the valid frames of a mask
+ * @param mask The mask
+ * @param frames The number of frames it covers
+ * @return std::size_t The number of set bits
+ */
+inline std::size_t countValid(const std::span<const std::uint64_t> mask, const std::size_t frames) noexcept {
+    std::size_t valid = 0;
+    for (std::size_t word = 0; word < (frames + 63) / 64; ++word) {
+        valid += static_cast<std::size_t>(std::popcount(mask[word]));
+    }
+    return valid;
+}
+} // namespace validation_helpers
+
+/* ―――――――――――――――― Functions ―――――――――――――――― */
+
+/**
+ * @brief Number of 64-bit words of a validation mask covering a batch
+ * @param frames The number of frames in the batch
+ * @return std::size_t The number of words
+ */
+constexpr std::size_t validationMaskWords(const std::size_t frames) noexcept { return (frames + 63) / 64; }
+
+/**
+ * @brief Checks the ID and size of every frame of a batch at once, without branching per frame
+ *
+ * Bit i % 64 of mask[i / 64] is set when frames[i] is non-empty, starts with an ID of the table
+ * and has a size that ID accepts; these are exactly the frames Message::validate() accepts.
+ * On x86-64 the AVX2 kernel is compiled in whatever the -m flags and picked at run time when the
+ * CPU supports it, checking eight frames at a time with a gather from the table; elsewhere the
+ * same branch-free check runs one frame at a time.
+ *
+ * @param frames The frames of the batch, only read during the call
+ * @param table The valid sizes of every ID byte
+ * @param[out] mask Receives the validity bits, must hold validationMaskWords(frames.size()) words
+ * @param kernel The implementation to use, AUTO outside of tests
+ * @return std::size_t The number of valid frames
+ */
+inline std::size_t validateFrames(
+    const std::span<const serialized_message_view_t> frames,
+    const FrameSizeTable<>& table,
+    const std::span<std::uint64_t> mask,
+    const VALIDATION_KERNEL kernel = VALIDATION_KERNEL::AUTO
+) noexcept {
+    std::fill_n(mask.begin(), validationMaskWords(frames.size()), std::uint64_t{0});
+    std::size_t checked = 0;
+#ifdef LIBCMD_HAS_AVX2_KERNEL
+    if (kernel != VALIDATION_KERNEL::SCALAR && validation_helpers::cpuSupportsAvx2()) {
+        checked = validation_helpers::validateAvx2(frames, table, mask);
+    }
+#else
+    (void)kernel;
+#endif
+    validation_helpers::validateScalar(frames, table, mask, checked);
+    return validation_helpers::countValid(mask, frames.size());
+}
+
+/**
+ * @brief Same check as validateFrames() for any slot mapping, one frame at a time
+ *
+ * @param frames The frames of the batch, only read during the call
+ * @param table The valid sizes of every slot
+ * @param slot_of Callable mapping a frame to its slot, e.g. the perfect hash of wide IDs
+ * @param[out] mask Receives the validity bits, must hold validationMaskWords(frames.size()) words
+ * @return std::size_t The number of valid frames
+ */
+template <std::size_t Slots, typename SlotOf>
+std::size_t validateFrames(
+    const std::span<const serialized_message_view_t> frames,
+    const FrameSizeTable<Slots>& table,
+    SlotOf&& slot_of,
+    const std::span<std::uint64_t> mask
+) noexcept {
+    std::fill_n(mask.begin(), validationMaskWords(frames.size()), std::uint64_t{0});
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const std::size_t slot = slot_of(frames[i]);
+        const std::uint32_t size = validation_helpers::frameSize(frames[i]);
+        const bool accepted = (size >= table.min[slot]) & (size <= table.max[slot]);
+        mask[i / 64] |= static_cast<std::uint64_t>(accepted) << (i % 64);
+    }
+    return validation_helpers::countValid(mask, frames.size());
+}
+
+/**
+ * @brief Whether a frame is marked valid in a validation mask
+ * @param mask The mask filled by validateFrames()
+ * @param index The index of the frame in its batch
+ * @return bool Whether the frame is valid
+ */
+constexpr bool isValidFrame(const std::span<const std::uint64_t> mask, const std::size_t index) noexcept {
+    return ((mask[index / 64] >> (index % 64)) & 1U) != 0;
+}
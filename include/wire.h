@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+/* ―――――――――――――――― Classes ―――――――――――――――― */
+
+/**
+ * @brief Integer field stored in a fixed byte order, usable as a member of a message format
+ *
+ * The value is kept as raw bytes, so the field has alignment 1: formats made of wire fields need
+ * no `__attribute__((packed))` and reading a field is never an unaligned load of a wider type.
+ * Conversions compile down to one (byte-wise safe) load or store, plus a byte swap when Order is
+ * not the host order. The type is trivially copyable and standard-layout, so formats using it
+ * still satisfy MessageFormatT and are serialized with a plain memcpy.
+ *
+ * Example:
+ * struct StatusFormat {
+ *     static constexpr std::uint8_t ID = 0x01;
+ *     std::uint8_t id;
+ *     le_u32_t value; // little-endian on the wire whatever the host
+ * };
+ *
+ * @tparam T The integer type of the value
+ * @tparam Order The byte order on the wire
+ */
+template <std::integral T, std::endian Order> class WireInt
+{
+    static_assert(
+        Order == std::endian::little || Order == std::endian::big, "Order must be std::endian::little or big"
+    );
+
+    std::array<std::uint8_t, sizeof(T)> _bytes{};
+
+    /**
+     * @brief Converts between host and wire order (the conversion is its own inverse)
+     * @param value The value in one order
+     * @return T The value in the other order
+     */
+    [[nodiscard]] static constexpr T convert(const T value) noexcept {
+        if constexpr (Order == std::endian::native || sizeof(T) == 1) {
+            return value;
+        }
+        else {
+            return std::byteswap(value);
+        }
+    }
+
+  public:
+    /** @brief Type alias for the value type */
+    using value_type = T;
+
+    /** @brief Byte order of the field on the wire */
+    static constexpr std::endian ORDER = Order;
+
+    constexpr WireInt() noexcept = default;
+
+    /**
+     * @brief Constructs the field from a host value
+     * @param value The value
+     */
+    constexpr WireInt(const T value) noexcept // NOLINT(google-explicit-constructor)
+        : _bytes(std::bit_cast<std::array<std::uint8_t, sizeof(T)>>(convert(value))) {}
+
+    /**
+     * @brief Stores a host value
+     * @param value The value
+     * @return WireInt& This field
+     */
+    constexpr WireInt& operator=(const T value) noexcept {
+        _bytes = std::bit_cast<std::array<std::uint8_t, sizeof(T)>>(convert(value));
+        return *this;
+    }
+
+    /**
+     * @brief Loads the value in host order
+     * @return T The value
+     */
+    [[nodiscard]] constexpr T value() const noexcept { return convert(std::bit_cast<T>(_bytes)); }
+
+    /** @brief Loads the value in host order, see value() */
+    constexpr operator T() const noexcept { return value(); } // NOLINT(google-explicit-constructor)
+
+    /**
+     * @brief The bytes of the field, as they are on the wire
+     * @return const std::array<std::uint8_t, sizeof(T)>& The bytes
+     */
+    [[nodiscard]] constexpr const std::array<std::uint8_t, sizeof(T)>& bytes() const noexcept { return _bytes; }
+};
+
+/* ―――――――――――――――― Aliases ―――――――――――――――― */
+
+/** @brief Type alias for little-endian wire fields */
+template <std::integral T> using le_t = WireInt<T, std::endian::little>;
+
+/** @brief Type alias for big-endian (network order) wire fields */
+template <std::integral T> using be_t = WireInt<T, std::endian::big>;
+
+using le_u16_t = le_t<std::uint16_t>;
+using le_u32_t = le_t<std::uint32_t>;
+using le_u64_t = le_t<std::uint64_t>;
+using le_i16_t = le_t<std::int16_t>;
+using le_i32_t = le_t<std::int32_t>;
+using le_i64_t = le_t<std::int64_t>;
+using be_u16_t = be_t<std::uint16_t>;
+using be_u32_t = be_t<std::uint32_t>;
+using be_u64_t = be_t<std::uint64_t>;
+using be_i16_t = be_t<std::int16_t>;
+using be_i32_t = be_t<std::int32_t>;
+using be_i64_t = be_t<std::int64_t>;
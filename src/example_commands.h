@@ -0,0 +1,176 @@
+#pragma once
+
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "wire.h"
+#include <array>
+#include <cstdint>
+
+/* ―――――――――――――――― Messages format ―――――――――――――――― */
+
+/**
+ * @brief Structure representing the format of a specific received message
+ */
+struct ReceivedMessageFormat1
+{
+    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t arg;                        ///< Some argument associated with the command
+} __attribute__((packed));
+
+/**
+ * @brief Structure representing the format of a specific received message
+ */
+struct ReceivedMessageFormat2
+{
+    static constexpr std::uint8_t ID = 0x02; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t arg;                        ///< Some argument associated with the command
+} __attribute__((packed));
+
+/**
+ * @brief Structure representing the format of a specific received message
+ */
+struct ReceivedMessageFormat3
+{
+    static constexpr std::uint8_t ID = 0x03; ///< Unique identifier for this message type
+    std::uint8_t id;                         ///< Command identifier
+    std::uint8_t arg;                        ///< Some argument associated with the command
+} __attribute__((packed));
+
+/**
+ * @brief Structure representing the format of a specific sent message
+ *
+ * Wire fields have alignment 1, so the layout has no padding without being packed.
+ */
+struct SentMessageFormat1
+{
+    static constexpr std::uint8_t ID = ReceivedMessageFormat1::ID; ///< Unique identifier for this message type
+    std::uint8_t id;                                               ///< Command identifier
+    std::uint8_t status;                                           ///< Status code
+    le_u32_t value;                                                ///< Some value, little-endian on the wire
+};
+
+/**
+ * @brief Structure representing the format of a specific sent message
+ *
+ * Wire fields have alignment 1, so the layout has no padding without being packed.
+ */
+struct SentMessageFormat2
+{
+    static constexpr std::uint8_t ID = ReceivedMessageFormat2::ID; ///< Unique identifier for this message type
+    std::uint8_t id;                                               ///< Command identifier
+    std::uint8_t status;                                           ///< Status code
+    le_u32_t value;                                                ///< Some value, little-endian on the wire
+};
+
+/**
+ * @brief Structure representing the format of a specific sent message
+ *
+ * Wire fields have alignment 1, so the layout has no padding without being packed.
+ */
+struct SentMessageFormat3
+{
+    static constexpr std::uint8_t ID = ReceivedMessageFormat3::ID; ///< Unique identifier for this message type
+    std::uint8_t id;                                               ///< Command identifier
+    std::uint8_t status;                                           ///< Status code
+    le_u32_t value;                                                ///< Some value, little-endian on the wire
+};
+
+/* ―――――――――――――――― Messages format ―――――――――――――――― */
+using ReceivedMessage1 = ReceivedMessage<ReceivedMessageFormat1>;
+using ReceivedMessage2 = ReceivedMessage<ReceivedMessageFormat2>;
+using ReceivedMessage3 = ReceivedMessage<ReceivedMessageFormat3>;
+using SentMessage1 = SentMessage<SentMessageFormat1>;
+using SentMessage2 = SentMessage<SentMessageFormat2>;
+using SentMessage3 = SentMessage<SentMessageFormat3>;
+
+/**
+ * @brief Class representing a specific command that can be executed
+ */
+struct Command1 final : Command<ReceivedMessageFormat1>
+{
+    /**
+     * @brief Constructs a SpecificCommand from raw byte input
+     *
+     * @param content Raw byte content of the command message
+     * @throws std::runtime_error if content size is invalid
+     */
+    explicit Command1(const serialized_message_view_t content) : Command(content) {}
+
+    /**
+     * @brief Executes the command associated with this message
+     * @param communicator The Communicator instance to handle responses and requests
+     */
+    void execute(const Communicator& communicator) const override {
+        // Dummy implementation
+        std::array<std::uint8_t, sizeof(SentMessageFormat1)> buffer{};
+        communicator.respondView(SentMessage1({
+                                                  .id = this->content().id,
+                                                  .status = 0x00,
+                                                  .value = _content.arg * 1U,
+                                              })
+                                     .serializeInto(buffer));
+    }
+};
+
+/**
+ * @brief Class representing a specific command that can be executed
+ */
+struct Command2 final : Command<ReceivedMessageFormat2>
+{
+    /**
+     * @brief Constructs a SpecificCommand from raw byte input
+     *
+     * @param content Raw byte content of the command message
+     * @throws std::runtime_error if content size is invalid
+     */
+    explicit Command2(const serialized_message_view_t content) : Command(content) {}
+
+    /**
+     * @brief Executes the command associated with this message
+     * @param communicator The Communicator instance to handle responses and requests
+     */
+    void execute(const Communicator& communicator) const override {
+        // Dummy implementation
+        std::array<std::uint8_t, sizeof(SentMessageFormat2)> buffer{};
+        communicator.respondView(SentMessage2({
+                                                  .id = this->content().id,
+                                                  .status = 0x00,
+                                                  .value = _content.arg * 2U,
+                                              })
+                                     .serializeInto(buffer));
+    }
+};
+
+/**
+ * @brief Class representing a specific command that can be executed
+ */
+struct Command3 final : Command<ReceivedMessageFormat3>
+{
+    /**
+     * @brief Constructs a SpecificCommand from raw byte input
+     *
+     * @param content Raw byte content of the command message
+     * @throws std::runtime_error if content size is invalid
+     */
+    explicit Command3(const serialized_message_view_t content) : Command(content) {}
+
+    /**
+     * @brief Executes the command associated with this message
+     * @param communicator The Communicator instance to handle responses and requests
+     */
+    void execute(const Communicator& communicator) const override {
+        // Dummy implementation
+        std::array<std::uint8_t, sizeof(SentMessageFormat3)> buffer{};
+        communicator.respondView(SentMessage3({
+                                                  .id = this->content().id,
+                                                  .status = 0x00,
+                                                  .value = _content.arg * 3U,
+                                              })
+                                     .serializeInto(buffer));
+    }
+};
+
+using Handler123 = Handler<Command1, Command2, Command3>;
@@ -1,207 +1,230 @@
-#include "command.h"
+#include "capture.h"
+#include "example_commands.h"
+#include "framer.h"
 #include "handler.h"
-#include "message.h"
+#include "hex.h"
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
 #include <generator>
 #include <iomanip>
 #include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
 
-/* ―――――――――――――――― Messages format ―――――――――――――――― */
-
-/**
- * @brief Structure representing the format of a specific received message
- */
-struct ReceivedMessageFormat1
-{
-    static constexpr std::uint8_t ID = 0x01; ///< Unique identifier for this message type
-    std::uint8_t id;                         ///< Command identifier
-    std::uint8_t arg;                        ///< Some argument associated with the command
-} __attribute__((packed));
-
-/**
- * @brief Structure representing the format of a specific received message
- */
-struct ReceivedMessageFormat2
-{
-    static constexpr std::uint8_t ID = 0x02; ///< Unique identifier for this message type
-    std::uint8_t id;                         ///< Command identifier
-    std::uint8_t arg;                        ///< Some argument associated with the command
-} __attribute__((packed));
-
-/**
- * @brief Structure representing the format of a specific received message
- */
-struct ReceivedMessageFormat3
-{
-    static constexpr std::uint8_t ID = 0x03; ///< Unique identifier for this message type
-    std::uint8_t id;                         ///< Command identifier
-    std::uint8_t arg;                        ///< Some argument associated with the command
-} __attribute__((packed));
-
-/**
- * @brief Structure representing the format of a specific sent message
- */
-struct SentMessageFormat1
-{
-    static constexpr std::uint8_t ID = ReceivedMessageFormat1::ID; ///< Unique identifier for this message type
-    std::uint8_t id;                                               ///< Command identifier
-    std::uint8_t status;                                           ///< Status code
-    std::uint32_t value;                                           ///< Some value associated with the command
-} __attribute__((packed));
-
-/**
- * @brief Structure representing the format of a specific sent message
- */
-struct SentMessageFormat2
-{
-    static constexpr std::uint8_t ID = ReceivedMessageFormat2::ID; ///< Unique identifier for this message type
-    std::uint8_t id;                                               ///< Command identifier
-    std::uint8_t status;                                           ///< Status code
-    std::uint32_t value;                                           ///< Some value associated with the command
-} __attribute__((packed));
-
-/**
- * @brief Structure representing the format of a specific sent message
- */
-struct SentMessageFormat3
-{
-    static constexpr std::uint8_t ID = ReceivedMessageFormat3::ID; ///< Unique identifier for this message type
-    std::uint8_t id;                                               ///< Command identifier
-    std::uint8_t status;                                           ///< Status code
-    std::uint32_t value;                                           ///< Some value associated with the command
-} __attribute__((packed));
-
-/* ―――――――――――――――― Messages format ―――――――――――――――― */
-using ReceivedMessage1 = ReceivedMessage<ReceivedMessageFormat1>;
-using ReceivedMessage2 = ReceivedMessage<ReceivedMessageFormat2>;
-using ReceivedMessage3 = ReceivedMessage<ReceivedMessageFormat3>;
-using SentMessage1 = SentMessage<SentMessageFormat1>;
-using SentMessage2 = SentMessage<SentMessageFormat2>;
-using SentMessage3 = SentMessage<SentMessageFormat3>;
-
+/* ―――――――――――――――― Communicator ―――――――――――――――― */
 /**
- * @brief Class representing a specific command that can be executed
+ * @brief Simple Communicator implementation that prints responses to console
  */
-struct Command1 final : Command<ReceivedMessageFormat1>
+class SimpleCommunicator final : public Communicator
 {
+  public:
     /**
-     * @brief Constructs a SpecificCommand from raw byte input
-     *
-     * @param content Raw byte content of the command message
-     * @throws std::runtime_error if content size is invalid
+     * @brief Callback function to send a response message for the current request
+     * Forwards to respondView().
+     * @param response The response message to print
      */
-    explicit Command1(const std::vector<std::uint8_t>& content) : Command(content) {}
+    void respond(const std::vector<uint8_t>& response) const override {
+        respondView(std::span<const std::uint8_t>(response));
+    }
 
     /**
-     * @brief Executes the command associated with this message
-     * @param communicator The Communicator instance to handle responses and requests
+     * @brief Callback function to send a response message for the current request
+     * @param response The response message to print
      */
-    void execute(const Communicator& communicator) const override {
-        // Dummy implementation
-        communicator.respond(SentMessage1({
-                                              .id = this->content().id,
-                                              .status = 0x00,
-                                              .value = _content.arg * 1U,
-                                          })
-                                 .serialize());
+    void respondView(const std::span<const std::uint8_t> response) const override {
+        std::cout << "Response: 0x";
+        for (const std::uint8_t b : response) {
+            std::cout << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(b);
+        }
+        std::cout << std::dec << std::endl; // reset to decimal
     }
-};
 
-/**
- * @brief Class representing a specific command that can be executed
- */
-struct Command2 final : Command<ReceivedMessageFormat2>
-{
     /**
-     * @brief Constructs a SpecificCommand from raw byte input
-     *
-     * @param content Raw byte content of the command message
-     * @throws std::runtime_error if content size is invalid
+     * @brief Sends a request message and handles each response via a callback
+     * Forwards to requestView().
+     * @return EXECUTE_STATUS The status of the request execution
      */
-    explicit Command2(const std::vector<std::uint8_t>& content) : Command(content) {}
+    [[nodiscard]] REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& message,
+        std::function<void(std::vector<std::uint8_t>)> handle_response_callback
+    ) const override {
+        return requestView(
+            std::span<const std::uint8_t>(message),
+            [&handle_response_callback](const std::span<const std::uint8_t> response) {
+                handle_response_callback({response.begin(), response.end()});
+            }
+        );
+    }
 
     /**
-     * @brief Executes the command associated with this message
-     * @param communicator The Communicator instance to handle responses and requests
+     * @brief Sends a request message and handles each response via a callback
+     * @return EXECUTE_STATUS The status of the request execution
      */
-    void execute(const Communicator& communicator) const override {
-        // Dummy implementation
-        communicator.respond(SentMessage2({
-                                              .id = this->content().id,
-                                              .status = 0x00,
-                                              .value = _content.arg * 2U,
-                                          })
-                                 .serialize());
+    [[nodiscard]] REQUEST_STATUS requestView(
+        const std::span<const std::uint8_t> /*message*/, const response_callback_t /*handle_response_callback*/
+    ) const override {
+        // Dummy implementation: no actual request handling
+        return REQUEST_STATUS::ERROR_UNKNOWN;
     }
 };
 
 /**
- * @brief Class representing a specific command that can be executed
+ * @brief Communicator writing responses to stdout through a reused buffer, for batch mode
+ *
+ * Responses are written as hex lines, or COBS-framed in binary mode, into a buffer flushed with one
+ * write() per BUFFER_BYTES, so that output costs neither a flush nor an allocation per response.
  */
-struct Command3 final : Command<ReceivedMessageFormat3>
+class BatchCommunicator final : public Communicator
 {
+    bool _binary;
+    bool _quiet;
+    mutable std::vector<std::uint8_t> _buffer;
+    mutable std::size_t _size = 0;
+    mutable std::size_t _responses = 0;
+
+  public:
+    /** @brief Bytes of output buffered before they are written */
+    static constexpr std::size_t BUFFER_BYTES = 64 * 1024;
+
     /**
-     * @brief Constructs a SpecificCommand from raw byte input
-     *
-     * @param content Raw byte content of the command message
-     * @throws std::runtime_error if content size is invalid
+     * @brief Constructs the communicator
+     * @param binary Whether to COBS-frame responses instead of writing hex lines
+     * @param quiet Whether to count responses without writing them
      */
-    explicit Command3(const std::vector<std::uint8_t>& content) : Command(content) {}
+    BatchCommunicator(const bool binary, const bool quiet) : _binary(binary), _quiet(quiet), _buffer(BUFFER_BYTES) {}
+
+    BatchCommunicator(const BatchCommunicator&) = delete;
+    BatchCommunicator& operator=(const BatchCommunicator&) = delete;
+
+    ~BatchCommunicator() override { flush(); }
 
     /**
-     * @brief Executes the command associated with this message
-     * @param communicator The Communicator instance to handle responses and requests
+     * @brief Writes the buffered responses to stdout
      */
-    void execute(const Communicator& communicator) const override {
-        // Dummy implementation
-        communicator.respond(SentMessage3({
-                                              .id = this->content().id,
-                                              .status = 0x00,
-                                              .value = _content.arg * 3U,
-                                          })
-                                 .serialize());
+    void flush() const {
+        std::size_t written = 0;
+        while (written < _size) {
+            const ssize_t n = ::write(STDOUT_FILENO, _buffer.data() + written, _size - written);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break; // stdout is gone, e.g. a closed pipe: drop the output like a quiet run would
+            }
+            written += static_cast<std::size_t>(n);
+        }
+        _size = 0;
     }
-};
 
-using Handler123 = Handler<Command1, Command2, Command3>;
+    /**
+     * @brief Number of responses sent so far
+     */
+    [[nodiscard]] std::size_t responses() const noexcept { return _responses; }
 
-/* ―――――――――――――――― Communicator ―――――――――――――――― */
-/**
- * @brief Simple Communicator implementation that prints responses to console
- */
-class SimpleCommunicator final : public Communicator
-{
-  public:
     /**
-     * @brief Callback function to send a response message for the current request
-     * @param response The response message to print
+     * @brief Appends a response to the output buffer
+     * Forwards to respondView().
+     * @param response The response message
      */
     void respond(const std::vector<uint8_t>& response) const override {
-        std::cout << "Response: 0x";
-        for (const std::uint8_t b : response) {
-            std::cout << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(b);
+        respondView(std::span<const std::uint8_t>(response));
+    }
+
+    /**
+     * @brief Appends a response to the output buffer, flushing it first if the response does not fit
+     * @param response The response message
+     */
+    void respondView(const std::span<const std::uint8_t> response) const override {
+        ++_responses;
+        if (_quiet) {
+            return;
+        }
+        const std::size_t needed = _binary ? cobsEncodedSize(response.size()) : 2 * response.size() + 1;
+        if (_buffer.size() - _size < needed) {
+            flush();
+            if (_buffer.size() < needed) {
+                _buffer.resize(needed);
+            }
+        }
+        const std::span<std::uint8_t> tail = std::span(_buffer).subspan(_size);
+        if (_binary) {
+            _size += cobsEncode(response, tail).size();
+        }
+        else {
+            _size += hexEncode(response, {reinterpret_cast<char*>(tail.data()), tail.size()}).size();
+            _buffer[_size++] = '\n';
         }
-        std::cout << std::dec << std::endl; // reset to decimal
     }
 
     /**
-     * @brief Sends a request message and handles each response via a callback
-     * @return EXECUTE_STATUS The status of the request execution
+     * @brief Requests are not supported in batch mode
+     * @return REQUEST_STATUS Always ERROR_UNKNOWN
+     */
+    [[nodiscard]] REQUEST_STATUS requestView(
+        const std::span<const std::uint8_t> /*message*/, const response_callback_t /*handle_response_callback*/
+    ) const override {
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+
+    /**
+     * @brief Requests are not supported in batch mode
+     * @return REQUEST_STATUS Always ERROR_UNKNOWN
      */
     [[nodiscard]] REQUEST_STATUS request(
         const std::vector<std::uint8_t>& /*message*/,
         std::function<void(std::vector<std::uint8_t>)> /*handle_response_callback*/
     ) const override {
-        // Dummy implementation: no actual request handling
         return REQUEST_STATUS::ERROR_UNKNOWN;
     }
 };
 
+/* ―――――――――――――――― Capture ―――――――――――――――― */
+
+/** @brief Capture of the executed frames, opened by --record and replayed with the replay tool */
+static CaptureWriter capture;
+
+using RecordedHandler123 = CapturingHandler<Handler123, capture>;
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/**
+ * @brief Command line options
+ */
+struct ExampleOptions
+{
+    std::string record;  ///< Capture file, empty not to record
+    bool batch = false;  ///< Execute frames read in bulk instead of prompting for them
+    bool binary = false; ///< Batch frames are COBS-framed bytes instead of hex lines
+    bool quiet = false;  ///< Count batch responses without writing them
+    std::string input;   ///< Batch input file, empty or "-" for stdin
+};
+
+/**
+ * @brief Counters of a batch run
+ */
+struct BatchStats
+{
+    std::size_t executed = 0;  ///< Frames executed
+    std::size_t failed = 0;    ///< Frames the handler failed
+    std::size_t malformed = 0; ///< Lines that are not hex, or COBS frames dropped by the framer
+};
+
 /* ―――――――――――――――― Helpers ―――――――――――――――― */
 
-static std::generator<std::vector<std::uint8_t>> inputMessage() {
+/** @brief Largest frame accepted, in bytes */
+static constexpr std::size_t MAX_FRAME_SIZE = 4096;
+
+static std::generator<serialized_message_view_t> inputMessage() {
     std::cout << "Enter 'q' to quit." << std::endl;
+    std::string line;
+    std::array<std::uint8_t, MAX_FRAME_SIZE> frame{};
     while (true) {
-        std::string line;
         std::cout << "Enter hex bytes (contiguous, e.g., 0105): ";
         if (!std::getline(std::cin, line)) {
             exit(1);
@@ -212,50 +235,211 @@ static std::generator<std::vector<std::uint8_t>> inputMessage() {
             break;
         }
 
-        // Validate: only hex digits and even length
-        bool all_hex = true;
-        for (const char i : line) {
-            if (!std::isxdigit(static_cast<unsigned char>(i))) {
-                all_hex = false;
+        // Convert contiguous hex string to bytes
+        const auto data = hexDecode(line, frame);
+        if (!data) {
+            switch (data.error()) {
+            case HEX_DECODE_STATUS::ERROR_ODD_LENGTH:
+                std::cerr << "Error: odd number of hex digits; pad with a leading 0." << std::endl;
+                break;
+            case HEX_DECODE_STATUS::ERROR_INVALID_DIGIT:
+                std::cerr << "Error: input must be contiguous hex digits only (0-9, a-f, A-F)." << std::endl;
+                break;
+            case HEX_DECODE_STATUS::ERROR_BUFFER_TOO_SMALL:
+                std::cerr << "Error: frames are limited to " << MAX_FRAME_SIZE << " bytes." << std::endl;
                 break;
             }
+            continue;
+        }
+        co_yield data.value();
+    }
+    std::cout << "Exiting." << std::endl;
+    co_return;
+}
+
+static bool parseOptions(const int argc, char** argv, ExampleOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            options.record = argv[++i];
+        }
+        else if (arg == "--batch") {
+            options.batch = true;
+        }
+        else if (arg == "--binary") {
+            options.binary = true;
+        }
+        else if (arg == "--quiet") {
+            options.quiet = true;
+        }
+        else if (options.input.empty() && (arg == "-" || !arg.starts_with("--"))) {
+            options.input = arg;
+        }
+        else {
+            return false;
+        }
+    }
+    // --binary, --quiet and the input only apply to batch mode
+    return options.batch || (!options.binary && !options.quiet && options.input.empty());
+}
+
+/**
+ * @brief Executes every hex line of a chunk, leaving the last, unterminated line in it
+ *
+ * @param chunk The input read so far
+ * @param frame Buffer the frames are decoded into, reused for every line
+ * @param communicator Where the responses go
+ * @param stats The counters to update
+ * @return std::size_t Bytes of chunk consumed, up to and including the last newline
+ */
+static std::size_t executeHexLines(
+    const std::string_view chunk,
+    const std::span<std::uint8_t> frame,
+    const BatchCommunicator& communicator,
+    BatchStats& stats
+) {
+    std::size_t begin = 0;
+    while (true) {
+        const std::size_t end = chunk.find('\n', begin);
+        if (end == std::string_view::npos) {
+            return begin;
         }
-        if (!all_hex) {
-            std::cerr << "Error: input must be contiguous hex digits only (0-9, a-f, A-F)." << std::endl;
+        std::string_view line = chunk.substr(begin, end - begin);
+        begin = end + 1;
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        if (line.empty()) {
             continue;
         }
-        if (line.size() % 2 != 0) {
-            std::cerr << "Error: odd number of hex digits; pad with a leading 0." << std::endl;
+        const auto data = hexDecode(line, frame);
+        if (!data) {
+            ++stats.malformed;
             continue;
         }
+        ++stats.executed;
+        stats.failed += RecordedHandler123::execute(data.value(), communicator) ? 0 : 1;
+    }
+}
 
-        // Convert contiguous hex string to bytes
-        std::vector<std::uint8_t> data;
-        data.reserve(line.size() / 2);
-        for (std::size_t i = 0; i < line.size(); i += 2) {
-            const std::string byte_str = line.substr(i, 2);
-            data.push_back(static_cast<std::uint8_t>(std::stoul(byte_str, nullptr, 16)));
+/**
+ * @brief Executes the frames of a file or stdin, read in chunks of CHUNK_BYTES
+ *
+ * Hex mode reads one frame per line, blank lines skipped; binary mode reads COBS frames, as sent
+ * on a byte stream. Either way, frames are decoded into buffers reused for the whole run and
+ * responses go through BatchCommunicator, so the loop allocates nothing per frame.
+ *
+ * @param options The options
+ * @return int The exit code
+ */
+static int runBatch(const ExampleOptions& options) {
+    constexpr std::size_t CHUNK_BYTES = 1024 * 1024;
+    const bool from_stdin = options.input.empty() || options.input == "-";
+    const int fd = from_stdin ? STDIN_FILENO : ::open(options.input.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: cannot open " << options.input << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    BatchStats stats;
+    std::vector<char> chunk(CHUNK_BYTES);
+    std::array<std::uint8_t, MAX_FRAME_SIZE> frame{};
+    CobsFramer<MAX_FRAME_SIZE> framer;
+    const auto start = std::chrono::steady_clock::now();
+    {
+        const BatchCommunicator communicator(options.binary, options.quiet);
+        std::size_t pending = 0; // bytes of an unterminated hex line kept at the start of chunk
+        bool skipping = false;   // inside a line longer than a chunk, dropped up to its newline
+        while (true) {
+            const ssize_t n = ::read(fd, chunk.data() + pending, chunk.size() - pending);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0) {
+                std::cerr << "Error: cannot read input: " << std::strerror(errno) << std::endl;
+                break;
+            }
+            if (options.binary) {
+                const serialized_message_view_t bytes(
+                    reinterpret_cast<const std::uint8_t*>(chunk.data()), static_cast<std::size_t>(n)
+                );
+                framer.feed(bytes, [&](const serialized_message_view_t data) {
+                    ++stats.executed;
+                    stats.failed += RecordedHandler123::execute(data, communicator) ? 0 : 1;
+                });
+                if (n == 0) {
+                    break;
+                }
+                continue;
+            }
+
+            std::size_t size = pending + static_cast<std::size_t>(n);
+            if (skipping && n != 0) { // nothing is pending while skipping
+                const std::size_t newline = std::string_view(chunk.data(), size).find('\n');
+                if (newline == std::string_view::npos) {
+                    continue;
+                }
+                skipping = false;
+                size -= newline + 1;
+                std::memmove(chunk.data(), chunk.data() + newline + 1, size);
+            }
+            if (n == 0) { // end of input: the last line may lack its newline
+                if (pending != 0) {
+                    chunk[size] = '\n';
+                    executeHexLines({chunk.data(), size + 1}, frame, communicator, stats);
+                }
+                break;
+            }
+            const std::size_t consumed = executeHexLines({chunk.data(), size}, frame, communicator, stats);
+            pending = size - consumed;
+            if (pending == chunk.size()) { // no newline in a whole chunk, far too long for a frame
+                ++stats.malformed;
+                pending = 0;
+                skipping = true;
+            }
+            std::memmove(chunk.data(), chunk.data() + consumed, pending);
         }
-        co_yield data;
     }
-    std::cout << "Exiting." << std::endl;
-    co_return;
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (!from_stdin) {
+        ::close(fd);
+    }
+
+    stats.malformed += framer.droppedFrames();
+    std::cerr << "Executed " << stats.executed << " frames (" << stats.failed << " failed, " << stats.malformed
+              << " malformed) in " << elapsed.count() << " s: "
+              << static_cast<std::size_t>(static_cast<double>(stats.executed) / elapsed.count()) << " frames/s"
+              << std::endl;
+    return stats.failed == 0 && stats.malformed == 0 ? 0 : 1;
 }
 
 /* ―――――――――――――――― Main ―――――――――――――――― */
 
-int main() {
+int main(const int argc, char** argv) {
+    ExampleOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--record <capture file>] [--batch [--binary] [--quiet] [<input>|-]]"
+                  << std::endl;
+        return 2;
+    }
+    if (!options.record.empty()) {
+        capture.open(options.record);
+    }
+    if (options.batch) {
+        return runBatch(options);
+    }
+
     std::cout << "Command Handler Test Program" << std::endl;
-    for (const std::vector<std::uint8_t>& data : inputMessage()) {
+    for (const serialized_message_view_t data : inputMessage()) {
         const SimpleCommunicator communicator;
         // Execute handler
-        const Result result = Handler123::execute(data, communicator);
+        const Result result = RecordedHandler123::execute(data, communicator);
 
         // Report status
         if (!result) {
             std::cerr << "Error: command execution failed:\n"
-                      << "\t- code:\t" << static_cast<int>(result.error().code) << "\t- msg:\t" << result.error().msg
-                      << std::endl;
+                      << "\t- code:\t" << static_cast<int>(result.error().code) << "\t- msg:\t"
+                      << result.error().describe() << std::endl;
         }
         else {
             std::cout << "Command executed successfully." << std::endl;
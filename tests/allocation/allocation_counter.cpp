@@ -0,0 +1,61 @@
+#include "allocation_counter.h"
+#include <cstdlib>
+#include <new>
+
+/* ―――――――――――――――― Counting allocator ―――――――――――――――― */
+
+namespace
+{
+thread_local std::size_t allocations = 0;
+
+void* allocate(const std::size_t size) {
+    ++allocations;
+    if (void* const memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* allocateAligned(const std::size_t size, const std::align_val_t alignment) {
+    ++allocations;
+    const auto align = static_cast<std::size_t>(alignment);
+    if (void* const memory = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+} // anonymous namespace
+
+std::size_t allocationCount() noexcept { return allocations; }
+
+void* operator new(const std::size_t size) { return allocate(size); }
+
+void* operator new[](const std::size_t size) { return allocate(size); }
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* const memory) noexcept { std::free(memory); }
+
+void operator delete[](void* const memory) noexcept { std::free(memory); }
+
+void operator delete(void* const memory, std::size_t /*size*/) noexcept { std::free(memory); }
+
+void operator delete[](void* const memory, std::size_t /*size*/) noexcept { std::free(memory); }
+
+void operator delete(void* const memory, std::align_val_t /*alignment*/) noexcept { std::free(memory); }
+
+void operator delete[](void* const memory, std::align_val_t /*alignment*/) noexcept { std::free(memory); }
+
+void operator delete(void* const memory, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* const memory, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    std::free(memory);
+}
@@ -0,0 +1,109 @@
+#include "allocation_counter.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+#include <new>
+#include <span>
+#include <vector>
+
+/* ───────────────────────── Commands ───────────────────────── */
+
+struct AllocFormatA
+{
+    static constexpr std::uint8_t ID = 0x01;
+    std::uint8_t id;
+    std::uint8_t op;
+    std::uint16_t val;
+};
+
+struct AllocFormatB
+{
+    static constexpr std::uint8_t ID = 0x02;
+    std::uint8_t id;
+    std::uint8_t code;
+};
+
+/** Responds with its own frame from a stack buffer */
+class AllocCommandA final : public Command<AllocFormatA>
+{
+  public:
+    explicit AllocCommandA(const serialized_message_view_t raw) : Command(raw) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::array<std::uint8_t, sizeof(AllocFormatA)> buffer{};
+        communicator.respondView(SentMessage(content()).serializeInto(buffer));
+    }
+};
+
+class AllocCommandB final : public StaticCommand<AllocCommandB, AllocFormatB>
+{
+  public:
+    explicit AllocCommandB(const serialized_message_view_t raw) : StaticCommand(raw) {}
+
+    void run(const Communicator& /*communicator*/) const {}
+};
+
+using alloc_handler_t = Handler<AllocCommandA, AllocCommandB>;
+
+/**
+ * @brief Communicator counting the responses, without allocating
+ */
+class CountingCommunicator final : public Communicator
+{
+  public:
+    mutable std::size_t responses = 0;
+
+    void respond(const std::vector<std::uint8_t>& /*response*/) const override { ++responses; }
+    void respondView(const std::span<const std::uint8_t> /*response*/) const override { ++responses; }
+
+    REQUEST_STATUS request(const std::vector<std::uint8_t>&, std::function<void(std::vector<std::uint8_t>)>)
+        const override {
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+};
+
+/* ───────────────────────── Tests ───────────────────────── */
+
+TEST(HandlerAllocations, CounterSeesAllocations) {
+    const std::size_t before = allocationCount();
+    const std::vector<std::uint8_t> bytes(16);
+    // Called directly rather than through new-expressions, which the compiler may elide
+    ::operator delete[](::operator new[](4));
+    ::operator delete(::operator new(64, std::align_val_t{64}), std::align_val_t{64});
+    EXPECT_EQ(allocationCount() - before, 3);
+}
+
+TEST(HandlerAllocations, RejectingFramesDoesNotAllocate) {
+    const CountingCommunicator communicator;
+    const std::vector<std::uint8_t> wrong_size{AllocFormatA::ID, 0x00};
+    const std::vector<std::uint8_t> unknown{0x7F, 0x00};
+    const std::vector<std::uint8_t> empty;
+
+    const std::size_t before = allocationCount();
+    for (int i = 0; i < 100; ++i) {
+        static_cast<void>(alloc_handler_t::execute(wrong_size, communicator));
+        static_cast<void>(alloc_handler_t::execute(unknown, communicator));
+        static_cast<void>(alloc_handler_t::execute(empty, communicator));
+        static_cast<void>(alloc_handler_t::execute<HANDLER_DISPATCH_MODE::FOLD>(unknown, communicator));
+    }
+    EXPECT_EQ(allocationCount() - before, 0);
+}
+
+TEST(HandlerAllocations, ExecutingViewCommandsDoesNotAllocate) {
+    const CountingCommunicator communicator;
+    const std::vector<std::uint8_t> frame_a{AllocFormatA::ID, 0x01, 0x02, 0x03};
+    const std::vector<std::uint8_t> frame_b{AllocFormatB::ID, 0x04};
+
+    const std::size_t before = allocationCount();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(alloc_handler_t::execute(frame_a, communicator));
+        EXPECT_TRUE(alloc_handler_t::execute(frame_b, communicator));
+    }
+    EXPECT_EQ(allocationCount() - before, 0);
+    EXPECT_EQ(communicator.responses, 100);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+/* ―――――――――――――――― Allocations ―――――――――――――――― */
+
+/**
+ * @brief Number of calls to the global operator new (any form) made by the calling thread so far
+ *
+ * Only defined in the test-allocations executable, which replaces the global allocation functions;
+ * the other tests run with the default ones.
+ *
+ * @return std::size_t The allocation count
+ */
+std::size_t allocationCount() noexcept;
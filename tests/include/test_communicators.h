@@ -0,0 +1,97 @@
+#pragma once
+
+#include "communication.h"
+#include "message.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <span>
+#include <thread>
+#include <vector>
+
+/* ―――――――――――――――― Communicators ―――――――――――――――― */
+
+/**
+ * @brief Communicator dropping the responses, only counting them, and failing every request
+ *
+ * Thread-safe, for handlers run by the listeners' workers as well as by the test thread.
+ */
+class DiscardingCommunicator final : public Communicator
+{
+    mutable std::atomic<std::size_t> _responses{0};
+
+  public:
+    void respondView(const std::span<const std::uint8_t> /*response*/) const override {
+        _responses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void respond(const std::vector<std::uint8_t>& /*response*/) const override {
+        _responses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    REQUEST_STATUS
+    request(const std::vector<std::uint8_t>&, std::function<void(std::vector<std::uint8_t>)>) const override {
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+
+    /**
+     * @brief Number of responses sent so far
+     */
+    [[nodiscard]] std::size_t responses() const noexcept { return _responses.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Thread-safe communicator recording the responses, and the thread sending each, and failing every request
+ *
+ * Responses are parsed as Response, so a malformed one throws MessageLengthError or MessageWrongIdError
+ * out of the command that sent it.
+ *
+ * @tparam Response The format of every response
+ */
+template <MessageFormatT Response> class RecordingCommunicator final : public Communicator
+{
+    mutable std::mutex _mutex;
+
+  public:
+    mutable std::vector<Response> responses;        ///< In the order they were sent
+    mutable std::vector<std::thread::id> threads;   ///< The thread sending each response
+
+    void respondView(const std::span<const std::uint8_t> response) const override {
+        const Response content = ReceivedMessage<Response>(response).content();
+        const std::scoped_lock lock(_mutex);
+        responses.push_back(content);
+        threads.push_back(std::this_thread::get_id());
+    }
+
+    void respond(const std::vector<std::uint8_t>& response) const override {
+        respondView(std::span<const std::uint8_t>(response));
+    }
+
+    REQUEST_STATUS
+    request(const std::vector<std::uint8_t>&, std::function<void(std::vector<std::uint8_t>)>) const override {
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+
+    /**
+     * @brief The threads that sent the responses, grouped by a field of the response
+     *
+     * Usage:
+     *     EXPECT_EQ(communicator.threadsBy(&DeviceResponse::device)[1].size(), 1U);
+     *
+     * @param field The field grouping the responses, e.g. the command or device they answer
+     * @return std::map The distinct threads per field value
+     */
+    template <typename Field>
+    [[nodiscard]] std::map<Field, std::set<std::thread::id>> threadsBy(Field Response::* const field) const {
+        const std::scoped_lock lock(_mutex);
+        std::map<Field, std::set<std::thread::id>> grouped;
+        for (std::size_t i = 0; i < responses.size(); ++i) {
+            grouped[responses[i].*field].insert(threads[i]);
+        }
+        return grouped;
+    }
+};
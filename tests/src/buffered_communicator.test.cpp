@@ -0,0 +1,275 @@
+#include "buffered_communicator.h"
+#include "communication.h"
+#include "posix_sink.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Transports ―――――――――――――――― */
+
+/**
+ * @brief Sink recording every batch it receives
+ */
+class BatchRecordingSink final : public FrameSink
+{
+  public:
+    std::vector<std::vector<std::vector<std::uint8_t>>> batches;
+    bool fail = false;
+
+    void send(const std::span<const std::uint8_t> frame) override {
+        const std::array<std::span<const std::uint8_t>, 1> frames{frame};
+        sendBatch(frames);
+    }
+
+    void sendBatch(const std::span<const std::span<const std::uint8_t>> frames) override {
+        if (fail) {
+            throw std::runtime_error("sink failure");
+        }
+        auto& batch = batches.emplace_back();
+        for (const auto frame : frames) {
+            batch.emplace_back(frame.begin(), frame.end());
+        }
+    }
+};
+
+/**
+ * @brief Upstream communicator recording how many requests it received
+ */
+class RequestCountingUpstream final : public Communicator
+{
+  public:
+    mutable std::size_t requests = 0;
+
+    void respond(const std::vector<std::uint8_t>&) const override {}
+
+    REQUEST_STATUS request(const std::vector<std::uint8_t>&, std::function<void(std::vector<std::uint8_t>)>)
+        const override {
+        ++requests;
+        return REQUEST_STATUS::SUCCESS;
+    }
+};
+
+/**
+ * @brief Connected pair of AF_UNIX sockets, closed on destruction
+ */
+struct SocketPair
+{
+    std::array<int, 2> fds{-1, -1};
+
+    explicit SocketPair(const int type) { EXPECT_EQ(::socketpair(AF_UNIX, type, 0, fds.data()), 0); }
+    SocketPair(const SocketPair&) = delete;
+    SocketPair& operator=(const SocketPair&) = delete;
+    ~SocketPair() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+};
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+/** @brief Policy that only flushes on max_frames, for deterministic tests */
+static constexpr BufferedFlushPolicy FRAMES_ONLY{
+    .max_bytes = 1024, .max_frames = 3, .max_delay = std::chrono::hours(1)
+};
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(BufferedCommunicator, FlushesWhenMaxFramesIsReached) {
+    BatchRecordingSink sink;
+    const RequestCountingUpstream upstream;
+    const BufferedCommunicator communicator(sink, upstream, FRAMES_ONLY);
+
+    communicator.respond(std::vector<std::uint8_t>{1});
+    communicator.respond(std::vector<std::uint8_t>{2, 2});
+    EXPECT_TRUE(sink.batches.empty());
+    EXPECT_EQ(communicator.buffered(), 2);
+
+    communicator.respond(std::vector<std::uint8_t>{3});
+    ASSERT_EQ(sink.batches.size(), 1);
+    EXPECT_EQ(sink.batches[0], (std::vector<std::vector<std::uint8_t>>{{1}, {2, 2}, {3}}));
+    EXPECT_EQ(communicator.buffered(), 0);
+
+    const BufferedCommunicatorStats stats = communicator.stats();
+    EXPECT_EQ(stats.responses, 3);
+    EXPECT_EQ(stats.flushes, 1);
+    EXPECT_EQ(stats.bytes, 4);
+}
+
+TEST(BufferedCommunicator, FlushesBeforeExceedingMaxBytes) {
+    BatchRecordingSink sink;
+    const RequestCountingUpstream upstream;
+    const BufferedCommunicator communicator(
+        sink, upstream, {.max_bytes = 4, .max_frames = 16, .max_delay = std::chrono::hours(1)}
+    );
+
+    communicator.respond(std::vector<std::uint8_t>{1, 1, 1});
+    communicator.respond(std::vector<std::uint8_t>{2, 2}); // 5 bytes would not fit, {1, 1, 1} goes first
+    ASSERT_EQ(sink.batches.size(), 1);
+    EXPECT_EQ(sink.batches[0], (std::vector<std::vector<std::uint8_t>>{{1, 1, 1}}));
+    EXPECT_EQ(communicator.buffered(), 1);
+}
+
+TEST(BufferedCommunicator, SendsOversizedResponsesAloneAndInOrder) {
+    BatchRecordingSink sink;
+    const RequestCountingUpstream upstream;
+    const BufferedCommunicator communicator(
+        sink, upstream, {.max_bytes = 4, .max_frames = 16, .max_delay = std::chrono::hours(1)}
+    );
+
+    communicator.respond(std::vector<std::uint8_t>{1});
+    communicator.respond(std::vector<std::uint8_t>(8, 9));
+    ASSERT_EQ(sink.batches.size(), 2);
+    EXPECT_EQ(sink.batches[0], (std::vector<std::vector<std::uint8_t>>{{1}}));
+    EXPECT_EQ(sink.batches[1], (std::vector<std::vector<std::uint8_t>>{std::vector<std::uint8_t>(8, 9)}));
+    EXPECT_EQ(communicator.stats().bytes, 9);
+}
+
+TEST(BufferedCommunicator, FlushSendsTheRemainderOfABatch) {
+    BatchRecordingSink sink;
+    const RequestCountingUpstream upstream;
+    const BufferedCommunicator communicator(sink, upstream, FRAMES_ONLY);
+
+    communicator.flush(); // nothing buffered, no empty batch
+    EXPECT_TRUE(sink.batches.empty());
+
+    communicator.respond(std::vector<std::uint8_t>{1});
+    communicator.flush();
+    ASSERT_EQ(sink.batches.size(), 1);
+    EXPECT_EQ(sink.batches[0].size(), 1);
+}
+
+TEST(BufferedCommunicator, FlushesOnceTheDeadlinePassed) {
+    BatchRecordingSink sink;
+    const RequestCountingUpstream upstream;
+    const BufferedCommunicator communicator(
+        sink, upstream, {.max_bytes = 1024, .max_frames = 16, .max_delay = std::chrono::milliseconds(5)}
+    );
+
+    communicator.respond(std::vector<std::uint8_t>{1});
+    EXPECT_FALSE(communicator.flushIfDue());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(communicator.flushIfDue());
+    ASSERT_EQ(sink.batches.size(), 1);
+
+    communicator.respond(std::vector<std::uint8_t>{2});
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    communicator.respond(std::vector<std::uint8_t>{3}); // the first one is overdue
+    ASSERT_EQ(sink.batches.size(), 2);
+    EXPECT_EQ(sink.batches[1], (std::vector<std::vector<std::uint8_t>>{{2}, {3}}));
+}
+
+TEST(BufferedCommunicator, RequestsFlushBeforeGoingUpstream) {
+    BatchRecordingSink sink;
+    const RequestCountingUpstream upstream;
+    const BufferedCommunicator communicator(sink, upstream, FRAMES_ONLY);
+
+    communicator.respond(std::vector<std::uint8_t>{1});
+    const auto status = communicator.request(std::vector<std::uint8_t>{0x10}, [](std::vector<std::uint8_t>) {});
+    EXPECT_EQ(status, Communicator::REQUEST_STATUS::SUCCESS);
+    EXPECT_EQ(upstream.requests, 1);
+    EXPECT_EQ(sink.batches.size(), 1);
+}
+
+TEST(BufferedCommunicator, DropsTheBufferWhenTheSinkThrows) {
+    BatchRecordingSink sink;
+    const RequestCountingUpstream upstream;
+    const BufferedCommunicator communicator(sink, upstream, FRAMES_ONLY);
+
+    communicator.respond(std::vector<std::uint8_t>{1});
+    sink.fail = true;
+    EXPECT_THROW(communicator.flush(), std::runtime_error);
+    EXPECT_EQ(communicator.buffered(), 0);
+    sink.fail = false;
+}
+
+TEST(BufferedCommunicator, DestructorFlushes) {
+    BatchRecordingSink sink;
+    const RequestCountingUpstream upstream;
+    {
+        const BufferedCommunicator communicator(sink, upstream, FRAMES_ONLY);
+        communicator.respond(std::vector<std::uint8_t>{1});
+    }
+    EXPECT_EQ(sink.batches.size(), 1);
+}
+
+TEST(PosixSink, StreamSinkWritesTheBatchBackToBack) {
+    const SocketPair pair(SOCK_STREAM);
+    FdStreamSink sink(pair.fds[0]);
+    const std::vector<std::uint8_t> a{1, 2, 3};
+    const std::vector<std::uint8_t> b{4};
+    const std::vector<std::uint8_t> c{5, 6};
+    const std::array<std::span<const std::uint8_t>, 3> frames{a, b, c};
+    sink.sendBatch(frames);
+    sink.send(a);
+
+    std::array<std::uint8_t, 16> received{};
+    std::size_t total = 0;
+    while (total < 9) {
+        const ssize_t got = ::read(pair.fds[1], received.data() + total, received.size() - total);
+        ASSERT_GT(got, 0);
+        total += static_cast<std::size_t>(got);
+    }
+    EXPECT_EQ(std::vector<std::uint8_t>(received.begin(), received.begin() + 9),
+              (std::vector<std::uint8_t>{1, 2, 3, 4, 5, 6, 1, 2, 3}));
+}
+
+TEST(PosixSink, StreamSinkSplitsLargeBatches) {
+    const SocketPair pair(SOCK_STREAM);
+    FdStreamSink sink(pair.fds[0]);
+    std::vector<std::uint8_t> byte{7};
+    const std::vector<std::span<const std::uint8_t>> frames(posix_sink_helpers::BATCH_LIMIT * 2 + 1, byte);
+    sink.sendBatch(frames);
+
+    std::vector<std::uint8_t> received(frames.size() + 1);
+    std::size_t total = 0;
+    while (total < frames.size()) {
+        const ssize_t got = ::read(pair.fds[1], received.data() + total, received.size() - total);
+        ASSERT_GT(got, 0);
+        total += static_cast<std::size_t>(got);
+    }
+    EXPECT_EQ(total, frames.size());
+}
+
+#ifdef __linux__
+TEST(PosixSink, DatagramSinkSendsOneDatagramPerFrame) {
+    const SocketPair pair(SOCK_DGRAM);
+    DatagramSocketSink sink(pair.fds[0]);
+    const std::vector<std::uint8_t> a{1, 2, 3};
+    const std::vector<std::uint8_t> b{4};
+    const std::array<std::span<const std::uint8_t>, 2> frames{a, b};
+    sink.sendBatch(frames);
+    sink.send(b);
+
+    std::array<std::uint8_t, 16> received{};
+    EXPECT_EQ(::recv(pair.fds[1], received.data(), received.size(), 0), 3);
+    EXPECT_EQ(received[2], 3);
+    EXPECT_EQ(::recv(pair.fds[1], received.data(), received.size(), 0), 1);
+    EXPECT_EQ(::recv(pair.fds[1], received.data(), received.size(), 0), 1);
+    EXPECT_EQ(received[0], 4);
+}
+
+TEST(PosixSink, BufferedCommunicatorOverDatagrams) {
+    const SocketPair pair(SOCK_DGRAM);
+    DatagramSocketSink sink(pair.fds[0]);
+    const RequestCountingUpstream upstream;
+    const BufferedCommunicator communicator(sink, upstream, FRAMES_ONLY);
+    for (std::uint8_t i = 0; i < 3; ++i) {
+        communicator.respond(std::vector<std::uint8_t>(i + 1U, i));
+    }
+
+    std::array<std::uint8_t, 16> received{};
+    for (std::uint8_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(::recv(pair.fds[1], received.data(), received.size(), 0), i + 1);
+        EXPECT_EQ(received[0], i);
+    }
+    EXPECT_EQ(communicator.stats().flushes, 1);
+}
+#endif
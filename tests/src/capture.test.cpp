@@ -0,0 +1,242 @@
+#include "capture.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "test_communicators.h"
+#include <array>
+#include <csignal>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+struct CapturedFormat
+{
+    static constexpr std::uint8_t ID = 0x71;
+    std::uint8_t id;
+    std::uint8_t arg;
+};
+static_assert(MessageFormatT<CapturedFormat>);
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+class CapturedCommand final : public Command<CapturedFormat>
+{
+  public:
+    explicit CapturedCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::array<std::uint8_t, sizeof(CapturedFormat)> buffer{};
+        communicator.respondView(
+            SentMessage<CapturedFormat>({.id = CapturedFormat::ID, .arg = content().arg}).serializeInto(buffer)
+        );
+    }
+};
+
+static CaptureWriter handler_capture;
+
+using CapturedHandler = CapturingHandler<Handler<CapturedCommand>, handler_capture>;
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+/**
+ * @brief Gives each test its own capture file, removed afterwards
+ */
+class CaptureTest : public testing::Test
+{
+  protected:
+    std::string path;
+
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path()
+                / ("libcmd-capture-" + std::to_string(::getpid()) + "-"
+                   + testing::UnitTest::GetInstance()->current_test_info()->name() + ".cap"))
+                   .string();
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+};
+
+static std::vector<std::vector<std::uint8_t>> readFrames(const CaptureReader& reader) {
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (const CaptureRecord& record : reader) {
+        frames.emplace_back(record.frame.begin(), record.frame.end());
+    }
+    return frames;
+}
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST_F(CaptureTest, ReadsBackTheRecordedFramesAndTimes) {
+    const std::vector<std::vector<std::uint8_t>> frames = {{0x71, 0x01}, {}, {0x7F, 0x00, 0x01, 0x02}};
+    {
+        CaptureWriter writer(path);
+        writer.record(frames[0], std::chrono::nanoseconds(10));
+        writer.record(frames[1], std::chrono::nanoseconds(20));
+        writer.record(frames[2], std::chrono::milliseconds(30));
+        EXPECT_EQ(writer.stats().records, 3U);
+        EXPECT_EQ(writer.stats().bytes, 3 * 12 + 6U);
+    }
+
+    const CaptureReader reader(path);
+    EXPECT_EQ(reader.size(), 3U);
+    EXPECT_EQ(reader.truncatedBytes(), 0U);
+    EXPECT_EQ(std::filesystem::file_size(path), 16 + 3 * 12 + 6U);
+    EXPECT_EQ(readFrames(reader), frames);
+    const std::vector<CaptureRecord> records(reader.begin(), reader.end());
+    EXPECT_EQ(records[0].at, std::chrono::nanoseconds(10));
+    EXPECT_EQ(records[1].at, std::chrono::nanoseconds(20));
+    EXPECT_EQ(records[2].at, std::chrono::milliseconds(30));
+    EXPECT_LE(reader.origin(), std::chrono::system_clock::now());
+    EXPECT_GT(reader.origin(), std::chrono::system_clock::now() - std::chrono::minutes(1));
+}
+
+TEST_F(CaptureTest, TimestampsFramesInOrder) {
+    {
+        CaptureWriter writer(path, 64); // flushes every few records
+        for (std::uint8_t i = 0; i < 100; ++i) {
+            writer.record(std::vector<std::uint8_t>{0x71, i});
+        }
+    }
+    const CaptureReader reader(path);
+    ASSERT_EQ(reader.size(), 100U);
+    std::chrono::nanoseconds previous{0};
+    std::uint8_t next = 0;
+    for (const CaptureRecord& record : reader) {
+        EXPECT_GE(record.at, previous);
+        EXPECT_EQ(record.frame[1], next++);
+        previous = record.at;
+    }
+}
+
+TEST_F(CaptureTest, IgnoresATornLastRecord) {
+    {
+        CaptureWriter writer(path);
+        writer.record(std::vector<std::uint8_t>{0x71, 0x01});
+        writer.record(std::vector<std::uint8_t>{0x71, 0x02, 0x03, 0x04});
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    const CaptureReader reader(path);
+    EXPECT_EQ(reader.size(), 1U);
+    EXPECT_EQ(reader.truncatedBytes(), 12 + 3U);
+    EXPECT_EQ(readFrames(reader), (std::vector<std::vector<std::uint8_t>>{{0x71, 0x01}}));
+}
+
+TEST_F(CaptureTest, RejectsOtherFiles) {
+    std::ofstream(path) << "not a capture, but long enough for a header";
+    try {
+        const CaptureReader reader(path);
+        FAIL() << "opened a file that is not a capture";
+    }
+    catch (const std::system_error& e) {
+        EXPECT_EQ(e.code(), std::errc::protocol_error);
+    }
+
+    std::ofstream(path, std::ios::trunc) << "short";
+    EXPECT_THROW(CaptureReader{path}, std::system_error);
+    EXPECT_THROW(CaptureReader{path + ".missing"}, std::system_error);
+}
+
+TEST_F(CaptureTest, ClosedWriterIgnoresFrames) {
+    CaptureWriter writer;
+    EXPECT_FALSE(writer.isOpen());
+    writer.record(std::vector<std::uint8_t>{0x71, 0x01});
+    EXPECT_TRUE(writer.tryRecord(std::vector<std::uint8_t>{0x71, 0x01}));
+    EXPECT_EQ(writer.stats().records, 0U);
+    EXPECT_FALSE(std::filesystem::exists(path));
+
+    writer.open(path);
+    EXPECT_TRUE(writer.isOpen());
+    writer.record(std::vector<std::uint8_t>{0x71, 0x01});
+    writer.close();
+    EXPECT_FALSE(writer.isOpen());
+    EXPECT_EQ(CaptureReader(path).size(), 1U);
+}
+
+TEST_F(CaptureTest, CountsEveryBufferedFrameOfAFailedWriteAsDropped) {
+    CaptureWriter writer(path, 64); // the 5th record of 14 bytes fills the buffer
+
+    // Past the file header, writes fail with EFBIG instead of raising SIGXFSZ
+    rlimit saved{};
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &saved), 0);
+    rlimit limited = saved;
+    limited.rlim_cur = 16;
+    const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limited), 0);
+    std::size_t recorded = 0;
+    for (std::uint8_t i = 0; i < 5; ++i) {
+        recorded += writer.tryRecord(std::vector<std::uint8_t>{0x71, i}) ? 1 : 0;
+    }
+    ::setrlimit(RLIMIT_FSIZE, &saved);
+    std::signal(SIGXFSZ, previous_handler);
+
+    EXPECT_EQ(recorded, 4U);
+    EXPECT_EQ(writer.stats().dropped, 5U);
+    writer.record(std::vector<std::uint8_t>{0x71, 0x05});
+    writer.close();
+    EXPECT_EQ(writer.stats().dropped, 5U);
+    EXPECT_EQ(readFrames(CaptureReader(path)), (std::vector<std::vector<std::uint8_t>>{{0x71, 0x05}}));
+}
+
+TEST_F(CaptureTest, CapturingHandlerRecordsEveryFrameFedToIt) {
+    handler_capture.open(path);
+    const DiscardingCommunicator communicator;
+    const std::vector<std::vector<std::uint8_t>> frames = {{0x71, 0x05}, {0x71}, {0x02, 0x00}, {0x71, 0x06}};
+    std::size_t failures = 0;
+    for (const std::vector<std::uint8_t>& frame : frames) {
+        failures += CapturedHandler::execute(frame, communicator) ? 0 : 1;
+    }
+    handler_capture.close();
+
+    EXPECT_EQ(failures, 2U);
+    EXPECT_EQ(communicator.responses(), 2U);
+    const CaptureReader reader(path);
+    EXPECT_EQ(readFrames(reader), frames);
+
+    // Replaying the capture gives the same outcome
+    const DiscardingCommunicator replayed;
+    std::size_t replay_failures = 0;
+    for (const CaptureRecord& record : reader) {
+        replay_failures += Handler<CapturedCommand>::execute(record.frame, replayed) ? 0 : 1;
+    }
+    EXPECT_EQ(replay_failures, failures);
+    EXPECT_EQ(replayed.responses(), communicator.responses());
+}
+
+TEST_F(CaptureTest, RecordsFromConcurrentThreads) {
+    {
+        CaptureWriter writer(path, 256);
+        std::vector<std::thread> threads;
+        for (std::uint8_t thread = 0; thread < 4; ++thread) {
+            threads.emplace_back([&writer, thread] {
+                for (std::uint8_t i = 0; i < 250; ++i) {
+                    writer.record(std::vector<std::uint8_t>{0x71, thread, i});
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+    const CaptureReader reader(path);
+    ASSERT_EQ(reader.size(), 1000U);
+    std::array<std::uint8_t, 4> next{};
+    std::chrono::nanoseconds previous{0};
+    for (const CaptureRecord& record : reader) {
+        ASSERT_EQ(record.frame.size(), 3U);
+        EXPECT_EQ(record.frame[2], next[record.frame[1]]++);
+        EXPECT_GE(record.at, previous);
+        previous = record.at;
+    }
+}
@@ -1,5 +1,6 @@
 #include "command.h"
 #include "message.h"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -69,6 +70,36 @@ class EchoPlusOneCommand final : public TestCommandBase
     }
 };
 
+/* Same behaviour as EchoPlusOneCommand, without virtual dispatch */
+class StaticEchoPlusOneCommand final : public StaticCommand<StaticEchoPlusOneCommand, CmdFormat>
+{
+  public:
+    explicit StaticEchoPlusOneCommand(const serialized_message_view_t raw) : StaticCommand(raw) {}
+
+    void run(const Communicator& communicator) const {
+        RspFormat rsp{};
+        rsp.id = RspFormat::ID;
+        rsp.status = this->content().opcode;
+        rsp.value = static_cast<std::uint16_t>(this->content().param + 1);
+        communicator.respond(ResponseMessage(rsp).serialize());
+    }
+};
+
+/* Same behaviour again, reading its fields in place instead of copying the frame */
+class ViewEchoPlusOneCommand final : public ViewCommand<CmdFormat>
+{
+  public:
+    explicit ViewEchoPlusOneCommand(const serialized_message_view_t raw) : ViewCommand(raw) {}
+
+    void execute(const Communicator& communicator) const override {
+        RspFormat rsp{};
+        rsp.id = RspFormat::ID;
+        rsp.status = get<&CmdFormat::opcode>();
+        rsp.value = static_cast<std::uint16_t>(get<&CmdFormat::param>() + 1);
+        communicator.respond(ResponseMessage(rsp).serialize());
+    }
+};
+
 class TestCommunicator final : public Communicator
 {
   public:
@@ -193,3 +224,134 @@ TEST(CommandExecute, MultipleInstancesIndependentState) {
     EXPECT_EQ(comm.responses[0], e1);
     EXPECT_EQ(comm.responses[1], e2);
 }
+
+TEST(StaticCommandBasics, HasNoVirtualDispatch) {
+    static_assert(!std::is_polymorphic_v<StaticEchoPlusOneCommand>, "StaticCommand must not carry a vptr");
+    static_assert(sizeof(StaticEchoPlusOneCommand) == sizeof(CmdFormat));
+    static_assert(std::is_same_v<StaticEchoPlusOneCommand::message_format_t, CmdFormat>);
+    SUCCEED();
+}
+
+TEST(StaticCommandExecute, MatchesVirtualCommand) {
+    CmdFormat cmd{};
+    cmd.id = CmdFormat::ID;
+    cmd.opcode = 0x7A;
+    cmd.param = 0x00FF;
+    const std::vector<std::uint8_t> raw = toBytes(cmd);
+
+    const EchoPlusOneCommand dynamic_command{raw};
+    const StaticEchoPlusOneCommand static_command{raw};
+    EXPECT_EQ(static_command.serialize(), dynamic_command.serialize());
+
+    TestCommunicator const dynamic_comm{};
+    TestCommunicator const static_comm{};
+    dynamic_command.execute(dynamic_comm);
+    static_command.execute(static_comm);
+    ASSERT_EQ(static_comm.responses.size(), 1);
+    EXPECT_EQ(static_comm.responses, dynamic_comm.responses);
+}
+
+TEST(StaticCommandConstruction, ValidatesLikeCommand) {
+    const std::vector<std::uint8_t> bad_small(sizeof(CmdFormat) - 1, CmdFormat::ID);
+    EXPECT_THROW(StaticEchoPlusOneCommand{bad_small}, MessageLengthError);
+
+    const std::vector<std::uint8_t> bad_id(sizeof(CmdFormat), 0x00);
+    EXPECT_THROW(StaticEchoPlusOneCommand{bad_id}, MessageWrongIdError);
+
+    const Result parsed = StaticEchoPlusOneCommand::tryParse(bad_small);
+    ASSERT_FALSE(parsed);
+    EXPECT_EQ(parsed.error().code, MESSAGE_PARSE_STATUS::ERROR_LENGTH);
+}
+
+TEST(ViewCommandExecute, MatchesCopyingCommand) {
+    const std::vector<std::uint8_t> raw = toBytes(CmdFormat{.id = CmdFormat::ID, .opcode = 0x7A, .param = 0x00FF});
+
+    const EchoPlusOneCommand copying_command{raw};
+    const ViewEchoPlusOneCommand view_command{raw};
+    static_assert(std::is_same_v<ViewEchoPlusOneCommand::input_message_t, ReceivedMessageView<CmdFormat>>);
+    EXPECT_EQ(view_command.frame().data(), raw.data());
+
+    TestCommunicator const copying_comm{};
+    TestCommunicator const view_comm{};
+    copying_command.execute(copying_comm);
+    view_command.execute(view_comm);
+    ASSERT_EQ(view_comm.responses.size(), 1);
+    EXPECT_EQ(view_comm.responses, copying_comm.responses);
+
+    const std::vector<std::uint8_t> bad_id(sizeof(CmdFormat), 0x00);
+    EXPECT_THROW(ViewEchoPlusOneCommand{bad_id}, MessageWrongIdError);
+}
+
+TEST(CommunicatorRespond, RespondViewForwardsToRespondByDefault) {
+    TestCommunicator const comm{};
+    const std::array<std::uint8_t, 3> frame{0x01, 0x02, 0x03};
+    comm.respondView(std::span<const std::uint8_t>(frame));
+    ASSERT_EQ(comm.responses.size(), 1);
+    EXPECT_EQ(comm.responses[0], (std::vector<std::uint8_t>{0x01, 0x02, 0x03}));
+}
+
+/* Communicator answering every request with two responses, through the std::function overload only */
+class EchoTwiceCommunicator final : public Communicator
+{
+  public:
+    void respond(const std::vector<std::uint8_t>& /*response*/) const override {}
+
+    [[nodiscard]] REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& message, std::function<void(std::vector<uint8_t>)> handle_response_callback
+    ) const override {
+        handle_response_callback(message);
+        handle_response_callback(message);
+        return REQUEST_STATUS::SUCCESS;
+    }
+};
+
+/* Communicator handing out views over its own buffer, through requestView() */
+class ViewCommunicator final : public Communicator
+{
+  public:
+    mutable int function_overload_calls = 0;
+
+    void respond(const std::vector<std::uint8_t>& /*response*/) const override {}
+
+    [[nodiscard]] REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& /*message*/, std::function<void(std::vector<uint8_t>)> /*callback*/
+    ) const override {
+        ++function_overload_calls;
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+
+    [[nodiscard]] REQUEST_STATUS
+    requestView(const std::span<const std::uint8_t> message, const response_callback_t handle_response_callback)
+        const override {
+        const std::array<std::uint8_t, 2> rx_buffer{message.front(), 0xAC};
+        handle_response_callback(rx_buffer);
+        return REQUEST_STATUS::SUCCESS;
+    }
+};
+
+TEST(CommunicatorRequest, RequestViewForwardsToRequestByDefault) {
+    const EchoTwiceCommunicator comm;
+    const std::array<std::uint8_t, 2> message{0x10, 0x20};
+
+    int received = 0;
+    const Communicator::REQUEST_STATUS status =
+        comm.requestView(std::span<const std::uint8_t>(message), [&](const std::span<const std::uint8_t> response) {
+            const std::vector<std::uint8_t> copy(response.begin(), response.end());
+            EXPECT_EQ(copy, (std::vector<std::uint8_t>{0x10, 0x20}));
+            ++received;
+        });
+    EXPECT_EQ(status, Communicator::REQUEST_STATUS::SUCCESS);
+    EXPECT_EQ(received, 2);
+}
+
+TEST(CommunicatorRequest, CollectingOverloadUsesRequestView) {
+    const ViewCommunicator comm;
+    const Communicator& base = comm; // the collecting overload is hidden by the overrides
+    std::vector<std::vector<std::uint8_t>> responses;
+    const Communicator::REQUEST_STATUS status = base.request(std::vector<std::uint8_t>{0x33}, responses);
+
+    EXPECT_EQ(status, Communicator::REQUEST_STATUS::SUCCESS);
+    EXPECT_EQ(comm.function_overload_calls, 0);
+    ASSERT_EQ(responses.size(), 1);
+    EXPECT_EQ(responses[0], (std::vector<std::uint8_t>{0x33, 0xAC}));
+}
@@ -0,0 +1,446 @@
+#include "concurrent_listener.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "test_communicators.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+struct SequencedFormat
+{
+    static constexpr std::uint8_t ID = 0x21;
+    std::uint8_t id;
+    std::uint8_t key; // copied into the response
+    std::uint16_t sequence;
+};
+static_assert(MessageFormatT<SequencedFormat>);
+
+struct OtherSequencedFormat
+{
+    static constexpr std::uint8_t ID = 0x22;
+    std::uint8_t id;
+    std::uint8_t key;
+    std::uint16_t sequence;
+};
+static_assert(MessageFormatT<OtherSequencedFormat>);
+
+struct SequencedResponse
+{
+    static constexpr std::uint8_t ID = 0xA1;
+    std::uint8_t id;
+    std::uint8_t command;
+    std::uint16_t sequence;
+};
+static_assert(MessageFormatT<SequencedResponse>);
+
+struct StallFormat
+{
+    static constexpr std::uint8_t ID = 0x23;
+    std::uint8_t id;
+};
+static_assert(MessageFormatT<StallFormat>);
+
+struct WideStallFormat
+{
+    static constexpr std::uint16_t ID = 0x2300;
+    be_u16_t id;
+};
+static_assert(MessageFormatT<WideStallFormat>);
+
+struct WideFormat
+{
+    static constexpr std::uint16_t ID = 0x2142;
+    be_u16_t id;
+};
+static_assert(MessageFormatT<WideFormat>);
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+static std::atomic<bool> stall_entered{false};
+static std::atomic<bool> stall_released{false};
+
+/**
+ * @brief Holds its worker until released, so that the frames behind it pile up in the queue
+ */
+template <typename Format = StallFormat> class StallCommand final : public Command<Format>
+{
+  public:
+    explicit StallCommand(const serialized_message_view_t content) : Command<Format>(content) {}
+
+    void execute(const Communicator& /*communicator*/) const override {
+        stall_entered = true;
+        while (!stall_released) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+class WideCommand final : public Command<WideFormat>
+{
+  public:
+    explicit WideCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& /*communicator*/) const override {}
+};
+
+template <typename Format> class SequencedCommand final : public Command<Format>
+{
+  public:
+    explicit SequencedCommand(const serialized_message_view_t content) : Command<Format>(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::array<std::uint8_t, sizeof(SequencedResponse)> buffer{};
+        communicator.respondView(SentMessage<SequencedResponse>({.id = SequencedResponse::ID,
+                                                             .command = Format::ID,
+                                                             .sequence = this->content().sequence})
+                                 .serializeInto(buffer));
+    }
+};
+
+using SequencedHandler = Handler<SequencedCommand<SequencedFormat>, SequencedCommand<OtherSequencedFormat>>;
+using StallingHandler =
+    Handler<SequencedCommand<SequencedFormat>, SequencedCommand<OtherSequencedFormat>, StallCommand<>>;
+using WideStallingHandler = Handler<WideCommand, StallCommand<WideStallFormat>>;
+
+/* ―――――――――――――――― Transports ―――――――――――――――― */
+
+/**
+ * @brief Source delivering pre-built frames a few at a time, then closing
+ */
+class VectorFrameSource final : public FrameSource
+{
+    std::vector<std::vector<std::uint8_t>> _frames;
+    std::size_t _next = 0;
+
+  public:
+    explicit VectorFrameSource(std::vector<std::vector<std::uint8_t>> frames) : _frames(std::move(frames)) {}
+
+    bool receive(const frame_callback_t on_frame) override {
+        for (std::size_t i = 0; i < 7 && _next < _frames.size(); ++i) {
+            on_frame(_frames[_next++]);
+        }
+        return _next < _frames.size();
+    }
+};
+
+/**
+ * @brief Source stalling the worker first, then delivering every frame at once and releasing the worker
+ */
+class StallingFrameSource final : public FrameSource
+{
+    std::vector<std::vector<std::uint8_t>> _frames;
+    std::vector<std::uint8_t> _stall;
+    bool _stalled = false;
+
+  public:
+    explicit StallingFrameSource(
+        std::vector<std::vector<std::uint8_t>> frames, std::vector<std::uint8_t> stall = {StallFormat::ID}
+    )
+        : _frames(std::move(frames)), _stall(std::move(stall)) {
+        stall_entered = false;
+        stall_released = false;
+    }
+
+    bool receive(const frame_callback_t on_frame) override {
+        if (!_stalled) {
+            on_frame(_stall);
+            while (!stall_entered) {
+                std::this_thread::yield();
+            }
+            _stalled = true;
+            return true;
+        }
+        for (const std::vector<std::uint8_t>& frame : _frames) {
+            on_frame(frame);
+        }
+        stall_released = true;
+        return false;
+    }
+};
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+template <typename Format> static std::vector<std::uint8_t> frameOf(const std::uint16_t sequence) {
+    return SentMessage<Format>({.id = Format::ID, .key = 0, .sequence = sequence}).serialize();
+}
+
+static std::vector<std::vector<std::uint8_t>> interleavedFrames(const std::uint16_t per_command) {
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (std::uint16_t sequence = 0; sequence < per_command; ++sequence) {
+        frames.push_back(frameOf<SequencedFormat>(sequence));
+        frames.push_back(frameOf<OtherSequencedFormat>(sequence));
+    }
+    return frames;
+}
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(BoundedQueue, PushesAndPopsInOrderUntilFull) {
+    BoundedQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_EQ(queue.sizeApprox(), 4);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(BoundedQueue, ConsumesOnlyAcceptedElements) {
+    BoundedQueue<int, 4> queue;
+    ASSERT_TRUE(queue.tryPush(1));
+    ASSERT_TRUE(queue.tryPush(2));
+    int value = -1;
+    const auto store = [&value](const int element) { value = element; };
+    EXPECT_FALSE(queue.tryConsumeIf([](const int element) { return element != 1; }, store));
+    EXPECT_EQ(value, -1);
+    EXPECT_TRUE(queue.tryConsumeIf([](const int element) { return element == 1; }, store));
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(queue.sizeApprox(), 1);
+}
+
+TEST(BoundedQueue, TransfersEveryElementBetweenThreads) {
+    constexpr int COUNT = 20000;
+    BoundedQueue<int, 64> queue;
+    long long sum = 0;
+    std::thread consumer([&] {
+        int value = 0;
+        for (int received = 0; received < COUNT;) {
+            if (queue.tryPop(value)) {
+                sum += value;
+                ++received;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (int i = 1; i <= COUNT;) {
+        if (queue.tryPush(i)) {
+            ++i;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    EXPECT_EQ(sum, static_cast<long long>(COUNT) * (COUNT + 1) / 2);
+}
+
+TEST(ConcurrentListener, ExecutesEveryFrameOnTheWorkers) {
+    VectorFrameSource source(interleavedFrames(500));
+    RecordingCommunicator<SequencedResponse> communicator;
+    ConcurrentListener<SequencedHandler, 16, 8> listener(source, communicator, {.workers = 4});
+    listener.start();
+
+    EXPECT_EQ(communicator.responses.size(), 1000);
+    const ConcurrentListenerStats stats = listener.stats();
+    EXPECT_EQ(stats.received, 1000);
+    EXPECT_EQ(stats.executed, 1000);
+    EXPECT_EQ(stats.failed, 0);
+    for (const std::thread::id thread : communicator.threads) {
+        EXPECT_NE(thread, std::this_thread::get_id()) << "commands run on the workers, not the reader";
+    }
+}
+
+TEST(ConcurrentListener, CommandIdAffinityPreservesPerCommandOrder) {
+    VectorFrameSource source(interleavedFrames(2000));
+    RecordingCommunicator<SequencedResponse> communicator;
+    ConcurrentListener<SequencedHandler, 16, 8> listener(
+        source, communicator, {.workers = 3, .affinity = WORKER_AFFINITY::COMMAND_ID}
+    );
+    listener.start();
+
+    ASSERT_EQ(communicator.responses.size(), 4000);
+    std::map<std::uint8_t, std::uint16_t> next_sequence;
+    for (const SequencedResponse& response : communicator.responses) {
+        EXPECT_EQ(response.sequence, next_sequence[response.command]++) << "command " << int(response.command);
+    }
+    for (const auto& [command, threads] : communicator.threadsBy(&SequencedResponse::command)) {
+        EXPECT_EQ(threads.size(), 1U) << "command " << int(command) << " moved between workers";
+    }
+}
+
+TEST(ConcurrentListener, CountsFailedAndOversizedFrames) {
+    std::vector<std::vector<std::uint8_t>> frames = interleavedFrames(1);
+    frames.push_back({0x7F});                        // unknown ID
+    frames.push_back({});                            // empty
+    frames.push_back(std::vector<std::uint8_t>(17)); // larger than a slot
+    VectorFrameSource source(std::move(frames));
+    RecordingCommunicator<SequencedResponse> communicator;
+    ConcurrentListener<SequencedHandler, 16, 8> listener(source, communicator, {.workers = 2, .cores = {0}});
+    listener.start();
+
+    const ConcurrentListenerStats stats = listener.stats();
+    EXPECT_EQ(stats.received, 5);
+    EXPECT_EQ(stats.executed, 2);
+    EXPECT_EQ(stats.failed, 2);
+    EXPECT_EQ(stats.oversized, 1);
+}
+
+TEST(ConcurrentListener, RejectsFramesPastTheQueueWhenOverloaded) {
+    StallingFrameSource source(interleavedFrames(10)); // 20 frames behind the stalled one, 8 slots
+    RecordingCommunicator<SequencedResponse> communicator;
+    std::vector<HandlerExecuteError> shed;
+    std::size_t queued_when_shed = 0;
+    ConcurrentListener<StallingHandler, 16, 8>* running = nullptr;
+    ConcurrentListener<StallingHandler, 16, 8> listener(
+        source,
+        communicator,
+        {.overload = OVERLOAD_POLICY::REJECT,
+         .on_shed =
+             [&](serialized_message_view_t, const HandlerExecuteError& error) {
+                 shed.push_back(error);
+                 queued_when_shed = running->stats().queued;
+             }}
+    );
+    running = &listener;
+    listener.start();
+
+    const ConcurrentListenerStats stats = listener.stats();
+    EXPECT_EQ(stats.received, 21U);
+    EXPECT_EQ(stats.executed, 9U);
+    EXPECT_EQ(stats.rejected, 12U);
+    EXPECT_EQ(stats.peak_depth, 8U);
+    EXPECT_EQ(stats.queued, 0U);
+    EXPECT_EQ(queued_when_shed, 8U);
+    ASSERT_EQ(shed.size(), 12U);
+    EXPECT_EQ(shed.front().code, HANDLER_EXECUTE_STATUS::ERROR_OVERLOADED);
+    EXPECT_EQ(shed.front().id, SequencedFormat::ID);
+    ASSERT_EQ(communicator.responses.size(), 8U);
+    EXPECT_EQ(communicator.responses.back().sequence, 3); // the first 8 frames: sequences 0..3 of both commands
+}
+
+TEST(ConcurrentListener, DropsTheOldestFramesWhenOverloaded) {
+    StallingFrameSource source(interleavedFrames(10));
+    RecordingCommunicator<SequencedResponse> communicator;
+    ConcurrentListener<StallingHandler, 16, 8> listener(
+        source, communicator, {.overload = OVERLOAD_POLICY::DROP_OLDEST}
+    );
+    listener.start();
+
+    const ConcurrentListenerStats stats = listener.stats();
+    EXPECT_EQ(stats.executed, 9U);
+    EXPECT_EQ(stats.dropped, 12U);
+    ASSERT_EQ(communicator.responses.size(), 8U);
+    EXPECT_EQ(communicator.responses.front().sequence, 6); // the newest 8 frames: sequences 6..9 of both
+    EXPECT_EQ(communicator.responses.back().sequence, 9);
+}
+
+TEST(ConcurrentListener, AdmitsPriorityIdsPastTheShedDepth) {
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (std::uint16_t sequence = 0; sequence < 10; ++sequence) {
+        frames.push_back(frameOf<SequencedFormat>(sequence));
+    }
+    for (std::uint16_t sequence = 0; sequence < 3; ++sequence) {
+        frames.push_back(frameOf<OtherSequencedFormat>(sequence));
+    }
+    StallingFrameSource source(std::move(frames));
+    RecordingCommunicator<SequencedResponse> communicator;
+    ConcurrentListener<StallingHandler, 16, 8> listener(
+        source,
+        communicator,
+        {.overload = OVERLOAD_POLICY::REJECT, .shed_depth = 4, .priority_ids = {OtherSequencedFormat::ID}}
+    );
+    listener.start();
+
+    const ConcurrentListenerStats stats = listener.stats();
+    EXPECT_EQ(stats.rejected, 6U);
+    EXPECT_EQ(stats.executed, 8U);
+    EXPECT_EQ(std::ranges::count(communicator.responses, SequencedFormat::ID, &SequencedResponse::command), 4);
+    EXPECT_EQ(std::ranges::count(communicator.responses, OtherSequencedFormat::ID, &SequencedResponse::command), 3);
+}
+
+TEST(ConcurrentListener, DropOldestNeverShedsPriorityFrames) {
+    StallingFrameSource source({
+        frameOf<SequencedFormat>(0),
+        frameOf<OtherSequencedFormat>(0),
+        frameOf<SequencedFormat>(1),
+        frameOf<SequencedFormat>(2), // drops sequence 0
+        frameOf<SequencedFormat>(3), // rejected: the oldest frame is the priority one
+        frameOf<OtherSequencedFormat>(1),
+    });
+    RecordingCommunicator<SequencedResponse> communicator;
+    std::vector<HandlerExecuteError> shed;
+    ConcurrentListener<StallingHandler, 16, 8> listener(
+        source,
+        communicator,
+        {.overload = OVERLOAD_POLICY::DROP_OLDEST,
+         .shed_depth = 3,
+         .priority_ids = {OtherSequencedFormat::ID},
+         .on_shed =
+             [&shed](serialized_message_view_t, const HandlerExecuteError& error) {
+                 shed.push_back(error);
+                 throw std::runtime_error("callback failure"); // swallowed, the listener goes on
+             }}
+    );
+    listener.start();
+
+    const ConcurrentListenerStats stats = listener.stats();
+    EXPECT_EQ(stats.dropped, 1U);
+    EXPECT_EQ(stats.rejected, 1U);
+    EXPECT_EQ(stats.executed, 5U);
+    EXPECT_EQ(shed.size(), 2U);
+    std::map<std::uint8_t, std::vector<std::uint16_t>> sequences;
+    for (const SequencedResponse& response : communicator.responses) {
+        sequences[response.command].push_back(response.sequence);
+    }
+    EXPECT_EQ(sequences[SequencedFormat::ID], (std::vector<std::uint16_t>{1, 2}));
+    EXPECT_EQ(sequences[OtherSequencedFormat::ID], (std::vector<std::uint16_t>{0, 1}));
+}
+
+TEST(ConcurrentListener, ReportsTheWideIdOfShedFrames) {
+    const std::vector<std::uint8_t> frame{0x21, 0x42}; // WideFormat::ID in network order
+    StallingFrameSource source({frame, frame}, {0x23, 0x00});
+    RecordingCommunicator<SequencedResponse> communicator;
+    std::vector<HandlerExecuteError> shed;
+    ConcurrentListener<WideStallingHandler, 16, 8> listener(
+        source,
+        communicator,
+        {.overload = OVERLOAD_POLICY::REJECT,
+         .shed_depth = 1,
+         .on_shed = [&shed](serialized_message_view_t, const HandlerExecuteError& error) { shed.push_back(error); }}
+    );
+    listener.start();
+
+    EXPECT_EQ(listener.stats().executed, 2U);
+    ASSERT_EQ(shed.size(), 1U);
+    EXPECT_EQ(shed.front().id, WideFormat::ID);
+}
+
+TEST(ConcurrentListener, MatchesPriorityIdsOnTheWholeWideId) {
+    const std::vector<std::uint8_t> priority{0x21, 0x42}; // WideFormat::ID in network order
+    const std::vector<std::uint8_t> other{0x21, 0x43};    // same leading byte, unknown ID
+    StallingFrameSource source({priority, priority, other, other}, {0x23, 0x00});
+    RecordingCommunicator<SequencedResponse> communicator;
+    std::vector<HandlerExecuteError> shed;
+    ConcurrentListener<WideStallingHandler, 16, 8> listener(
+        source,
+        communicator,
+        {.overload = OVERLOAD_POLICY::REJECT,
+         .shed_depth = 1,
+         .priority_ids = {WideFormat::ID},
+         .on_shed = [&shed](serialized_message_view_t, const HandlerExecuteError& error) { shed.push_back(error); }}
+    );
+    listener.start();
+
+    EXPECT_EQ(listener.stats().rejected, 2U);
+    EXPECT_EQ(listener.stats().executed, 3U); // the stall frame and both priority frames
+    ASSERT_EQ(shed.size(), 2U);
+    EXPECT_EQ(shed.front().id, 0x2143);
+}
@@ -0,0 +1,127 @@
+#include "framer.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+static std::vector<std::uint8_t> encode(const std::vector<std::uint8_t>& frame) {
+    std::vector<std::uint8_t> buffer(cobsEncodedSize(frame.size()));
+    const serialized_message_view_t encoded = cobsEncode(frame, buffer);
+    return {encoded.begin(), encoded.end()};
+}
+
+/**
+ * @brief Frame with every byte value, zeros included, long enough to need several COBS blocks
+ */
+static std::vector<std::uint8_t> patternFrame(const std::size_t size) {
+    std::vector<std::uint8_t> frame(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        frame[i] = static_cast<std::uint8_t>(i * 7);
+    }
+    return frame;
+}
+
+/* ―――――――――――――――― Encoder ―――――――――――――――― */
+
+TEST(CobsEncode, KnownVectors) {
+    EXPECT_EQ(encode({0x00}), (std::vector<std::uint8_t>{0x01, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x00, 0x00}), (std::vector<std::uint8_t>{0x01, 0x01, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x22, 0x00, 0x33}), (std::vector<std::uint8_t>{0x03, 0x11, 0x22, 0x02, 0x33, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x00, 0x00, 0x00}), (std::vector<std::uint8_t>{0x02, 0x11, 0x01, 0x01, 0x01, 0x00}));
+}
+
+TEST(CobsEncode, LongRunsSplitIntoFullBlocks) {
+    const std::vector<std::uint8_t> frame(300, 0x42);
+    const std::vector<std::uint8_t> encoded = encode(frame);
+    EXPECT_EQ(encoded.front(), 0xFF);
+    EXPECT_EQ(encoded.back(), 0x00);
+    EXPECT_LE(encoded.size(), cobsEncodedSize(frame.size()));
+    for (std::size_t i = 0; i + 1 < encoded.size(); ++i) {
+        EXPECT_NE(encoded[i], 0x00) << "only the delimiter may be zero, at " << i;
+    }
+}
+
+TEST(CobsEncode, ThrowsOnSmallBuffer) {
+    const std::vector<std::uint8_t> frame{0x01, 0x02};
+    std::vector<std::uint8_t> buffer(cobsEncodedSize(frame.size()) - 1);
+    EXPECT_THROW(static_cast<void>(cobsEncode(frame, buffer)), std::length_error);
+}
+
+/* ―――――――――――――――― Framer ―――――――――――――――― */
+
+TEST(CobsFramer, RoundTripsFramesOfAnySize) {
+    CobsFramer<1024> framer;
+    for (const std::size_t size : {1U, 2U, 253U, 254U, 255U, 508U, 1024U}) {
+        const std::vector<std::uint8_t> frame = patternFrame(size);
+        std::vector<std::vector<std::uint8_t>> frames;
+        const std::size_t emitted = framer.feed(encode(frame), [&](const serialized_message_view_t decoded) {
+            frames.emplace_back(decoded.begin(), decoded.end());
+        });
+        ASSERT_EQ(emitted, 1) << "size " << size;
+        EXPECT_EQ(frames.at(0), frame) << "size " << size;
+    }
+    EXPECT_EQ(framer.droppedFrames(), 0);
+}
+
+TEST(CobsFramer, ReassemblesFramesSplitAcrossChunks) {
+    std::vector<std::uint8_t> stream;
+    std::vector<std::vector<std::uint8_t>> sent;
+    for (std::size_t size = 1; size < 40; size += 3) {
+        sent.push_back(patternFrame(size));
+        const std::vector<std::uint8_t> encoded = encode(sent.back());
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+
+    for (std::size_t chunk_size = 1; chunk_size <= 17; ++chunk_size) {
+        CobsFramer<64> framer;
+        std::vector<std::vector<std::uint8_t>> received;
+        for (std::size_t offset = 0; offset < stream.size(); offset += chunk_size) {
+            const serialized_message_view_t chunk =
+                serialized_message_view_t(stream).subspan(offset, std::min(chunk_size, stream.size() - offset));
+            framer.feed(chunk, [&](const serialized_message_view_t decoded) {
+                received.emplace_back(decoded.begin(), decoded.end());
+            });
+        }
+        EXPECT_EQ(received, sent) << "chunk size " << chunk_size;
+    }
+}
+
+TEST(CobsFramer, DropsOversizedFrameAndResynchronises) {
+    CobsFramer<8> framer;
+    std::vector<std::uint8_t> stream = encode(patternFrame(9));
+    const std::vector<std::uint8_t> next = encode({0x01, 0x00, 0x02});
+    stream.insert(stream.end(), next.begin(), next.end());
+
+    std::vector<std::vector<std::uint8_t>> received;
+    framer.feed(stream, [&](const serialized_message_view_t decoded) {
+        received.emplace_back(decoded.begin(), decoded.end());
+    });
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0], (std::vector<std::uint8_t>{0x01, 0x00, 0x02}));
+    EXPECT_EQ(framer.droppedFrames(), 1);
+}
+
+TEST(CobsFramer, DropsTruncatedFrameAndSkipsEmptyOnes) {
+    CobsFramer<16> framer;
+    // 0x05 announces 4 data bytes but the delimiter comes after 2, then idle delimiters
+    const std::vector<std::uint8_t> stream{0x05, 0x11, 0x22, 0x00, 0x00, 0x00, 0x02, 0x33, 0x00};
+
+    std::vector<std::vector<std::uint8_t>> received;
+    framer.feed(stream, [&](const serialized_message_view_t decoded) {
+        received.emplace_back(decoded.begin(), decoded.end());
+    });
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0], (std::vector<std::uint8_t>{0x33}));
+    EXPECT_EQ(framer.droppedFrames(), 1);
+}
+
+TEST(CobsFramer, ResetDropsPartialFrame) {
+    CobsFramer<16> framer;
+    const std::vector<std::uint8_t> encoded = encode({0x01, 0x02, 0x03});
+    int frames = 0;
+    framer.feed(serialized_message_view_t(encoded).first(2), [&](serialized_message_view_t) { ++frames; });
+    framer.reset();
+    framer.feed(encoded, [&](serialized_message_view_t) { ++frames; });
+    EXPECT_EQ(frames, 1);
+}
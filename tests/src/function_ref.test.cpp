@@ -0,0 +1,52 @@
+#include "function_ref.h"
+#include <gtest/gtest.h>
+#include <string>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+static int twice(const int x) { return 2 * x; }
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(FunctionRef, CallsLambdaWithoutCopyingIt) {
+    int calls = 0;
+    auto counter = [&calls](const int step) { calls += step; };
+    const FunctionRef<void(int)> ref(counter);
+
+    ref(1);
+    ref(2);
+    EXPECT_EQ(calls, 3);
+}
+
+TEST(FunctionRef, ReferencesStatefulFunctor) {
+    struct Accumulator
+    {
+        int total = 0;
+        int operator()(const int x) { return total += x; }
+    } accumulator;
+
+    const FunctionRef<int(int)> ref(accumulator);
+    EXPECT_EQ(ref(5), 5);
+    EXPECT_EQ(ref(5), 10);
+    EXPECT_EQ(accumulator.total, 10) << "The referenced object itself must be mutated, not a copy";
+}
+
+TEST(FunctionRef, CallsFreeFunction) {
+    const FunctionRef<int(int)> ref(&twice);
+    EXPECT_EQ(ref(21), 42);
+
+    const FunctionRef<int(int)> decayed(twice);
+    EXPECT_EQ(decayed(4), 8);
+}
+
+TEST(FunctionRef, ConvertsReturnType) {
+    const auto make = [] { return "abc"; };
+    const FunctionRef<std::string()> ref(make);
+    EXPECT_EQ(ref(), "abc");
+}
+
+TEST(FunctionRef, IsSmallAndTriviallyCopyable) {
+    static_assert(std::is_trivially_copyable_v<FunctionRef<void(int)>>);
+    static_assert(sizeof(FunctionRef<void(int)>) == 2 * sizeof(void*));
+    SUCCEED();
+}
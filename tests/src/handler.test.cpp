@@ -1,11 +1,16 @@
 #include "handler.h"
 #include "command.h"
 #include "message.h"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 /* ───────────────────────── Helpers ───────────────────────── */
@@ -121,6 +126,58 @@ class CommandC final : public Command<FormatC>
     }
 };
 
+/* A command built straight from a view: no std::vector involved on the dispatch path. */
+struct FormatD
+{
+    static constexpr std::uint8_t ID = 0x04;
+    std::uint8_t id;
+    std::uint8_t arg;
+};
+static_assert(MessageFormatT<FormatD>);
+
+static int constructed_d = 0;
+
+class CommandD final : public Command<FormatD>
+{
+  public:
+    explicit CommandD(const serialized_message_view_t raw) : Command(raw) { ++constructed_d; } // increment counter
+
+    void execute(const Communicator& communicator) const override {
+        // Response: status = arg, result = arg * 2
+        ResponseFormat r{};
+        r.id = ResponseFormat::ID;
+        r.status = this->content().arg;
+        r.result = static_cast<std::uint16_t>(this->content().arg * 2U);
+        communicator.respond(SentMessage(r).serialize());
+    }
+};
+
+/* Statically dispatched command, registered alongside the virtual ones. */
+struct FormatE
+{
+    static constexpr std::uint8_t ID = 0x05;
+    std::uint8_t id;
+    std::uint8_t arg;
+};
+static_assert(MessageFormatT<FormatE>);
+
+static int constructed_e = 0;
+
+class CommandE final : public StaticCommand<CommandE, FormatE>
+{
+  public:
+    explicit CommandE(const serialized_message_view_t raw) : StaticCommand(raw) { ++constructed_e; }
+
+    void run(const Communicator& communicator) const {
+        // Response: status = arg, result = arg + 5
+        ResponseFormat r{};
+        r.id = ResponseFormat::ID;
+        r.status = this->content().arg;
+        r.result = static_cast<std::uint16_t>(this->content().arg + 5U);
+        communicator.respond(SentMessage(r).serialize());
+    }
+};
+
 /* ─────────────────── Duplicate-ID Commands ─────────────────── */
 namespace
 {
@@ -156,6 +213,7 @@ TEST(HandlerConcepts, CommandLike) {
     static_assert(CommandLike<CommandA>, "CommandA should satisfy CommandLike");
     static_assert(CommandLike<CommandB>, "CommandB should satisfy CommandLike");
     static_assert(CommandLike<CommandC>, "CommandC should satisfy CommandLike");
+    static_assert(CommandLike<CommandE>, "StaticCommand-based CommandE should satisfy CommandLike");
 
     // A type with the right typedefs but not deriving from Command should fail.
     struct Fake
@@ -185,6 +243,11 @@ TEST(Helpers, UniqueIdsDetection) {
 
     // Duplicate IDs => UniqueIds should be false (detected) unordered
     EXPECT_FALSE((command_helpers::UniqueIds<CommandA, CommandB, CommandC, CommandADuplicate>::value));
+
+    // Sorted check, independent of registration order
+    static_assert(command_helpers::uniqueIds(std::array<command_id_t, 0>{}));
+    static_assert(command_helpers::uniqueIds(std::array<command_id_t, 4>{0x0300, 0x02, 0x01, 0x0301}));
+    static_assert(!command_helpers::uniqueIds(std::array<command_id_t, 4>{0x09, 0x02, 0x01, 0x09}));
 }
 
 /* ───────────────────────── Handler::execute ───────────────────────── */
@@ -211,6 +274,8 @@ static void resetCounters() {
     constructed_a = 0;
     constructed_b = 0;
     constructed_c = 0;
+    constructed_d = 0;
+    constructed_e = 0;
 }
 
 TEST(HandlerExecute, ThrowsOnEmpty) {
@@ -388,3 +453,593 @@ TEST(HandlerExecute, DispatchesMultipleCommands) {
     EXPECT_EQ(communicator.responses.size(), 1);
     EXPECT_EQ(communicator.responses[0], expected_bytes_a);
 }
+
+/* ───────────────────────── Handler::execute (span path) ───────────────────────── */
+
+using TestHandlerABCD = Handler<CommandA, CommandB, CommandC, CommandD>;
+
+TEST(HandlerExecuteSpan, DispatchesFromViewIntoLargerBuffer) {
+    resetCounters();
+
+    // Frame sits in the middle of a transport buffer, e.g. a DMA/ring buffer
+    const std::array<std::uint8_t, 6> ring{0xEE, FormatD::ID, 0x21, 0xEE, 0xEE, 0xEE};
+    const serialized_message_view_t frame = serialized_message_view_t(ring).subspan(1, sizeof(FormatD));
+
+    const TestCommunicator communicator;
+    const Result result = TestHandlerABCD::execute(frame, communicator);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(constructed_d, 1);
+
+    ResponseFormat expected{};
+    expected.id = ResponseFormat::ID;
+    expected.status = 0x21;
+    expected.result = 0x42;
+    ASSERT_EQ(communicator.responses.size(), 1);
+    EXPECT_EQ(communicator.responses[0], SentMessage{expected}.serialize());
+}
+
+TEST(HandlerExecuteSpan, VectorOnlyCommandsStillDispatchFromView) {
+    resetCounters();
+
+    constexpr FormatA A{.id = FormatA::ID, .op = 0x10, .val = 0x0011};
+    const std::vector<std::uint8_t> raw_a = toBytes(A);
+
+    const TestCommunicator communicator;
+    const Result result = TestHandlerABCD::execute(serialized_message_view_t(raw_a), communicator);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(constructed_a, 1);
+    EXPECT_EQ(communicator.responses.size(), 1);
+}
+
+TEST(HandlerExecuteSpan, KeepsLengthCheckOnView) {
+    resetCounters();
+
+    const std::array<std::uint8_t, 3> too_long{FormatD::ID, 0x00, 0x00};
+    const TestCommunicator communicator;
+    const Result result = TestHandlerABCD::execute(serialized_message_view_t(too_long), communicator);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+    EXPECT_EQ(constructed_d, 0);
+    EXPECT_EQ(communicator.responses.size(), 0);
+}
+
+/* ───────────────────────── Handler::execute (dispatch modes) ───────────────────────── */
+
+TEST(HandlerDispatchMode, FoldAndJumpTableAgree) {
+    constexpr FormatA A{.id = FormatA::ID, .op = 0x01, .val = 0x0002};
+    constexpr FormatC C{.id = FormatC::ID, .flag = 0x03, .y = 0x0004};
+    const std::vector<std::vector<std::uint8_t>> frames{
+        toBytes(A), toBytes(C), {0x7F, 0x00, 0x00, 0x00}, {FormatB::ID, 0x00}, {},
+    };
+
+    for (const std::vector<std::uint8_t>& frame : frames) {
+        resetCounters();
+        const TestCommunicator fold_communicator;
+        const Result fold = TestHandlerCBA::execute<HANDLER_DISPATCH_MODE::FOLD>(frame, fold_communicator);
+
+        const TestCommunicator table_communicator;
+        const Result table = TestHandlerCBA::execute<HANDLER_DISPATCH_MODE::JUMP_TABLE>(frame, table_communicator);
+
+        ASSERT_EQ(fold.ok(), table.ok());
+        if (!fold) {
+            EXPECT_EQ(fold.error().code, table.error().code);
+        }
+        EXPECT_EQ(fold_communicator.responses, table_communicator.responses);
+    }
+}
+
+TEST(HandlerDispatchMode, JumpTableDispatchesKnownId) {
+    resetCounters();
+
+    constexpr FormatB B{.id = FormatB::ID, .code = 0x01, .x = 0x0002};
+    const TestCommunicator communicator;
+    const Result result = TestHandlerABC::execute<HANDLER_DISPATCH_MODE::JUMP_TABLE>(toBytes(B), communicator);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(constructed_b, 1);
+    EXPECT_EQ(communicator.responses.size(), 1);
+}
+
+/* ───────────────────────── Handler::execute (static commands) ───────────────────────── */
+
+using TestHandlerMixed = Handler<CommandA, CommandE>;
+
+TEST(HandlerStaticCommand, DispatchesAlongsideVirtualCommands) {
+    resetCounters();
+
+    const std::vector<std::uint8_t> raw_e{FormatE::ID, 0x10};
+    const TestCommunicator communicator;
+    const Result result = TestHandlerMixed::execute(raw_e, communicator);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(constructed_e, 1);
+    EXPECT_EQ(constructed_a, 0);
+
+    ResponseFormat expected{};
+    expected.id = ResponseFormat::ID;
+    expected.status = 0x10;
+    expected.result = 0x15;
+    ASSERT_EQ(communicator.responses.size(), 1);
+    EXPECT_EQ(communicator.responses[0], SentMessage{expected}.serialize());
+
+    constexpr FormatA A{.id = FormatA::ID, .op = 0x01, .val = 0x0001};
+    ASSERT_TRUE(TestHandlerMixed::execute(toBytes(A), communicator));
+    EXPECT_EQ(constructed_a, 1);
+}
+
+TEST(HandlerStaticCommand, RejectsWrongSizeWithoutConstructing) {
+    resetCounters();
+
+    const std::vector<std::uint8_t> raw_e{FormatE::ID, 0x10, 0x00};
+    const TestCommunicator communicator;
+    const Result result = TestHandlerMixed::execute(raw_e, communicator);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+    EXPECT_EQ(constructed_e, 0);
+}
+
+/* ───────────────────────── Handler::execute (trailing payload) ───────────────────────── */
+
+struct FormatChunk
+{
+    static constexpr std::uint8_t ID = 0x06;
+    static constexpr std::size_t MAX_PAYLOAD_SIZE = 64;
+    std::uint8_t id;
+};
+static_assert(TrailingPayloadFormatT<FormatChunk>);
+
+class CommandChunk final : public Command<FormatChunk>
+{
+  public:
+    explicit CommandChunk(const serialized_message_view_t raw) : Command(raw) {}
+
+    void execute(const Communicator& communicator) const override {
+        // Response: status = payload size, result = sum of payload bytes
+        ResponseFormat r{};
+        r.id = ResponseFormat::ID;
+        r.status = static_cast<std::uint8_t>(this->payload().size());
+        for (const std::uint8_t b : this->payload()) {
+            r.result = static_cast<std::uint16_t>(r.result + b);
+        }
+        communicator.respond(SentMessage(r).serialize());
+    }
+};
+
+/** Same as CommandChunk, built from a copy of the frame */
+class CommandChunkCopied final : public Command<FormatChunk>
+{
+  public:
+    explicit CommandChunkCopied(const std::vector<std::uint8_t>& raw) : Command(raw) {}
+
+    void execute(const Communicator& communicator) const override {
+        ResponseFormat r{};
+        r.id = ResponseFormat::ID;
+        r.status = static_cast<std::uint8_t>(this->payload().size());
+        for (const std::uint8_t b : this->payload()) {
+            r.result = static_cast<std::uint16_t>(r.result + b);
+        }
+        communicator.respond(SentMessage(r).serialize());
+    }
+};
+static_assert(!std::is_constructible_v<CommandChunkCopied, serialized_message_view_t>);
+
+TEST(HandlerTrailingPayload, DispatchesVariableLengthFrames) {
+    using handler_t = Handler<CommandA, CommandChunk>;
+    const TestCommunicator communicator;
+
+    const std::vector<std::uint8_t> small{FormatChunk::ID, 0x01, 0x02};
+    ASSERT_TRUE(handler_t::execute(small, communicator));
+
+    std::vector<std::uint8_t> large(1 + FormatChunk::MAX_PAYLOAD_SIZE, 0x01);
+    large[0] = FormatChunk::ID;
+    ASSERT_TRUE(handler_t::execute(large, communicator));
+
+    ASSERT_EQ(communicator.responses.size(), 2);
+    EXPECT_EQ(communicator.responses[0][offsetof(ResponseFormat, status)], 2);
+    EXPECT_EQ(communicator.responses[1][offsetof(ResponseFormat, status)], FormatChunk::MAX_PAYLOAD_SIZE);
+
+    large.push_back(0x01);
+    const Result too_large = handler_t::execute(large, communicator);
+    ASSERT_FALSE(too_large);
+    EXPECT_EQ(too_large.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+}
+
+TEST(HandlerTrailingPayload, KeepsTheCopyOfVectorOnlyCommandsDuringExecution) {
+    const TestCommunicator communicator;
+    const std::vector<std::uint8_t> frame{FormatChunk::ID, 0x10, 0x20, 0x30};
+    ASSERT_TRUE(Handler<CommandChunkCopied>::execute(frame, communicator));
+    ASSERT_EQ(communicator.responses.size(), 1);
+    EXPECT_EQ(communicator.responses[0][offsetof(ResponseFormat, status)], 3);
+    EXPECT_EQ(ReceivedMessage<ResponseFormat>(communicator.responses[0]).content().result, 0x60);
+}
+
+/* ───────────────────────── Handler::validateBatch ───────────────────────── */
+
+TEST(HandlerValidateBatch, MarksExactlyTheFramesExecuteAccepts) {
+    using handler_t = Handler<CommandA, CommandB, CommandChunk>;
+    const TestCommunicator communicator;
+
+    std::vector<std::vector<std::uint8_t>> raw{
+        toBytes(FormatA{.id = FormatA::ID, .op = 0, .val = 0}),
+        toBytes(FormatB{.id = FormatB::ID, .code = 0, .x = 0}),
+        {FormatA::ID, 0x00},              // too short
+        {FormatC::ID, 0x00, 0x00, 0x00},  // not registered
+        {},                               // empty
+        {FormatChunk::ID},                // header only
+        {FormatChunk::ID, 0x01, 0x02},    // with payload
+        std::vector<std::uint8_t>(2 + FormatChunk::MAX_PAYLOAD_SIZE, FormatChunk::ID), // payload too large
+    };
+    // Enough frames for several vector blocks and mask words, plus a tail
+    while (raw.size() < 150) {
+        raw.push_back(raw[raw.size() % 8]);
+    }
+    const std::vector<serialized_message_view_t> frames(raw.begin(), raw.end());
+
+    std::vector<std::uint64_t> mask(validationMaskWords(frames.size()), ~std::uint64_t{0});
+    std::size_t expected_valid = 0;
+    const std::size_t valid = handler_t::validateBatch(frames, mask);
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const bool accepted = handler_t::execute(frames[i], communicator).ok();
+        EXPECT_EQ(isValidFrame(mask, i), accepted) << "frame " << i;
+        expected_valid += accepted ? 1 : 0;
+    }
+    EXPECT_EQ(valid, expected_valid);
+}
+
+TEST(HandlerValidateBatch, TableFollowsRegisteredFormats) {
+    const FrameSizeTable<>& table = TestHandlerABC::frameSizes();
+    EXPECT_EQ(table.min[FormatA::ID], sizeof(FormatA));
+    EXPECT_EQ(table.max[FormatA::ID], sizeof(FormatA));
+    EXPECT_GT(table.min[0x7F], table.max[0x7F]);
+    EXPECT_EQ(Handler<CommandChunk>::frameSizes().max[FormatChunk::ID], 1 + FormatChunk::MAX_PAYLOAD_SIZE);
+}
+
+/* ───────────────────────── Handler::executeBatch ───────────────────────── */
+
+static_assert(std::is_trivially_copyable_v<HANDLER_EXECUTE_STATUS>);
+
+TEST(HandlerExecuteBatch, MatchesExecuteFrameByFrame) {
+    resetCounters();
+    const std::vector<std::vector<std::uint8_t>> raw{
+        toBytes(FormatB{.id = FormatB::ID, .code = 0x02, .x = 0x0022}),
+        {},
+        toBytes(FormatA{.id = FormatA::ID, .op = 0x01, .val = 0x0011}),
+        {FormatA::ID, 0x00},
+        {0x7F, 0x00, 0x00, 0x00},
+        toBytes(FormatA{.id = FormatA::ID, .op = 0x03, .val = 0x0033}),
+    };
+    const std::vector<serialized_message_view_t> frames(raw.begin(), raw.end());
+
+    const TestCommunicator batch;
+    std::vector<HANDLER_EXECUTE_STATUS> out(frames.size());
+    EXPECT_EQ(TestHandlerABC::executeBatch(frames, batch, out), 3);
+
+    const TestCommunicator single;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const Result result = TestHandlerABC::execute(frames[i], single);
+        EXPECT_EQ(out[i], result ? HANDLER_EXECUTE_STATUS::SUCCESS : result.error().code) << "frame " << i;
+    }
+    EXPECT_EQ(out[1], HANDLER_EXECUTE_STATUS::ERROR_EMPTY_MESSAGE);
+    EXPECT_EQ(out[4], HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND);
+    EXPECT_EQ(batch.responses, single.responses); // same responses, in arrival order
+    EXPECT_EQ(constructed_a, 4);
+}
+
+TEST(HandlerExecuteBatch, StopsAtTheEndOfTheStatusSpan) {
+    resetCounters();
+    const std::vector<std::uint8_t> raw_a = toBytes(FormatA{.id = FormatA::ID, .op = 0x01, .val = 0x0001});
+    const std::vector<serialized_message_view_t> frames(3, serialized_message_view_t(raw_a));
+    const TestCommunicator communicator;
+
+    std::array<HANDLER_EXECUTE_STATUS, 2> out{};
+    EXPECT_EQ(Handler<CommandA>::executeBatch<HANDLER_DISPATCH_MODE::FOLD>(frames, communicator, out), 2);
+    EXPECT_EQ(constructed_a, 2);
+    EXPECT_EQ(communicator.responses.size(), 2);
+}
+
+/* ───────────────────────── Handler::execute (view commands) ───────────────────────── */
+
+struct FormatConfig
+{
+    static constexpr std::uint8_t ID = 0x08;
+    std::uint8_t id;
+    std::uint8_t slot;
+    std::array<std::uint8_t, 1022> values;
+};
+
+/** Responds with status = slot and result = values[slot], read in place from the frame. */
+class CommandConfig final : public ViewCommand<FormatConfig>
+{
+  public:
+    explicit CommandConfig(const serialized_message_view_t raw) : ViewCommand(raw) {}
+
+    void execute(const Communicator& communicator) const override {
+        ResponseFormat r{};
+        r.id = ResponseFormat::ID;
+        r.status = get<&FormatConfig::slot>();
+        r.result = frame()[offsetof(FormatConfig, values) + r.status];
+        communicator.respond(SentMessage(r).serialize());
+    }
+};
+
+TEST(HandlerViewCommand, DispatchesAlongsideCopyingCommands) {
+    static_assert(CommandLike<CommandConfig>);
+    std::vector<std::uint8_t> raw(sizeof(FormatConfig), 0x00);
+    raw[0] = FormatConfig::ID;
+    raw[1] = 10;
+    raw[offsetof(FormatConfig, values) + 10] = 0x5A;
+
+    const TestCommunicator communicator;
+    ASSERT_TRUE((Handler<CommandA, CommandConfig>::execute(raw, communicator)));
+    ASSERT_EQ(communicator.responses.size(), 1);
+    EXPECT_EQ(communicator.responses[0][offsetof(ResponseFormat, status)], 10);
+    EXPECT_EQ(communicator.responses[0][offsetof(ResponseFormat, result)], 0x5A);
+
+    raw.pop_back();
+    const Result truncated = Handler<CommandA, CommandConfig>::execute(raw, communicator);
+    ASSERT_FALSE(truncated);
+    EXPECT_EQ(truncated.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+}
+
+/* ───────────────────────── Handler::execute (field lists) ───────────────────────── */
+
+/* Naturally aligned in memory (12 bytes), 6 bytes on the wire. */
+template <std::uint8_t Id> struct FormatFields
+{
+    static constexpr std::uint8_t ID = Id;
+    static constexpr auto fields() { return std::tuple{&FormatFields::id, &FormatFields::value, &FormatFields::arg}; }
+    std::uint8_t id;
+    std::uint32_t value;
+    std::uint8_t arg;
+};
+static_assert(FieldListFormatT<FormatFields<0x0A>>);
+
+/** Responds with status = arg and result = the low half of value. */
+class CommandFields final : public Command<FormatFields<0x0A>>
+{
+  public:
+    explicit CommandFields(const serialized_message_view_t raw) : Command(raw) {}
+
+    void execute(const Communicator& communicator) const override {
+        communicator.respond(
+            SentMessage(ResponseFormat{
+                            .id = ResponseFormat::ID,
+                            .status = content().arg,
+                            .result = static_cast<std::uint16_t>(content().value),
+                        })
+                .serialize()
+        );
+    }
+};
+
+/** Same response as CommandFields, without virtual dispatch. */
+class StaticCommandFields final : public StaticCommand<StaticCommandFields, FormatFields<0x0B>>
+{
+  public:
+    explicit StaticCommandFields(const serialized_message_view_t raw) : StaticCommand(raw) {}
+
+    void run(const Communicator& communicator) const {
+        communicator.respond(
+            SentMessage(ResponseFormat{
+                            .id = ResponseFormat::ID,
+                            .status = content().arg,
+                            .result = static_cast<std::uint16_t>(content().value),
+                        })
+                .serialize()
+        );
+    }
+};
+
+TEST(HandlerFieldList, DispatchesCompactFrames) {
+    using handler_t = Handler<CommandFields, StaticCommandFields>;
+    EXPECT_EQ(handler_t::frameSizes().min[0x0A], 6U);
+    EXPECT_EQ(handler_t::frameSizes().max[0x0B], 6U);
+
+    const TestCommunicator communicator;
+    for (const std::uint8_t id : {0x0A, 0x0B}) {
+        const std::vector<std::uint8_t> raw =
+            SentMessage<FormatFields<0x0A>>({.id = 0x0A, .value = 0x00011234, .arg = 7}).serialize();
+        std::vector<std::uint8_t> frame = raw;
+        frame[0] = id;
+        ASSERT_EQ(frame.size(), 6U);
+        ASSERT_TRUE(handler_t::execute(frame, communicator));
+
+        frame.resize(sizeof(FormatFields<0x0A>)); // the in-memory size is not a valid frame size
+        const Result padded = handler_t::execute(frame, communicator);
+        ASSERT_FALSE(padded);
+        EXPECT_EQ(padded.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+    }
+    ASSERT_EQ(communicator.responses.size(), 2U);
+    for (const std::vector<std::uint8_t>& response : communicator.responses) {
+        const ResponseFormat decoded = ReceivedMessage<ResponseFormat>(response).content();
+        EXPECT_EQ(decoded.status, 7);
+        EXPECT_EQ(decoded.result, 0x1234);
+    }
+}
+
+/* ───────────────────────── Handler::execute (wide and enum IDs) ───────────────────────── */
+
+template <std::uint16_t Id> struct FormatWide
+{
+    static constexpr std::uint16_t ID = Id;
+    be_u16_t id; // network order on the wire
+    std::uint8_t arg;
+};
+static_assert(MessageFormatT<FormatWide<0x0102>>);
+
+/** Responds with status = arg and result = its own ID. */
+template <std::uint16_t Id> class CommandWide final : public Command<FormatWide<Id>>
+{
+  public:
+    explicit CommandWide(const serialized_message_view_t raw) : Command<FormatWide<Id>>(raw) {}
+
+    void execute(const Communicator& communicator) const override {
+        ResponseFormat r{};
+        r.id = ResponseFormat::ID;
+        r.status = this->content().arg;
+        r.result = Id;
+        communicator.respond(SentMessage(r).serialize());
+    }
+};
+
+enum class OPCODE : std::uint8_t
+{
+    PING = 0x21,
+};
+
+struct FormatPing
+{
+    static constexpr OPCODE ID = OPCODE::PING;
+    std::uint8_t id;
+};
+
+class CommandPing final : public Command<FormatPing>
+{
+  public:
+    explicit CommandPing(const serialized_message_view_t raw) : Command(raw) {}
+
+    void execute(const Communicator& communicator) const override { communicator.respond(std::vector<std::uint8_t>{}); }
+};
+
+using TestHandlerWide = Handler<CommandWide<0x0102>, CommandWide<0x0201>, CommandWide<0xBEEF>>;
+
+template <std::size_t... I>
+Handler<CommandWide<static_cast<std::uint16_t>(0x0100 * I + 0x07)>...> makeManyWideHandler(std::index_sequence<I...>);
+using TestHandlerManyWide = decltype(makeManyWideHandler(std::make_index_sequence<40>{}));
+
+static std::vector<std::uint8_t> wideFrame(const std::uint16_t id, const std::uint8_t arg) {
+    return {static_cast<std::uint8_t>(id >> 8U), static_cast<std::uint8_t>(id & 0xFFU), arg};
+}
+
+TEST(HandlerWideId, DispatchesBigEndianIdsInBothModes) {
+    for (const std::uint16_t id : std::array<std::uint16_t, 3>{0x0102, 0x0201, 0xBEEF}) {
+        const TestCommunicator fold_communicator;
+        const TestCommunicator table_communicator;
+        ASSERT_TRUE(TestHandlerWide::execute<HANDLER_DISPATCH_MODE::FOLD>(wideFrame(id, 3), fold_communicator));
+        ASSERT_TRUE(TestHandlerWide::execute<HANDLER_DISPATCH_MODE::JUMP_TABLE>(wideFrame(id, 3), table_communicator));
+
+        ResponseFormat expected{};
+        expected.id = ResponseFormat::ID;
+        expected.status = 3;
+        expected.result = id;
+        ASSERT_EQ(table_communicator.responses.size(), 1);
+        EXPECT_EQ(table_communicator.responses[0], SentMessage{expected}.serialize());
+        EXPECT_EQ(fold_communicator.responses, table_communicator.responses);
+    }
+}
+
+TEST(HandlerWideId, RejectsUnknownAndTruncatedIds) {
+    const TestCommunicator communicator;
+    const Result unknown = TestHandlerWide::execute(wideFrame(0x0202, 0), communicator);
+    ASSERT_FALSE(unknown);
+    EXPECT_EQ(unknown.error().code, HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND);
+    EXPECT_EQ(unknown.error().id, 0x0202);
+
+    const std::vector<std::uint8_t> one_byte{0x01};
+    const Result truncated = TestHandlerWide::execute(one_byte, communicator);
+    ASSERT_FALSE(truncated);
+    EXPECT_EQ(truncated.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+    EXPECT_EQ(truncated.error().id, 0);
+
+    const Result wrong_size = TestHandlerWide::execute(std::vector<std::uint8_t>{0x01, 0x02}, communicator);
+    ASSERT_FALSE(wrong_size);
+    EXPECT_EQ(wrong_size.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+    EXPECT_EQ(wrong_size.error().id, 0x0102);
+    EXPECT_TRUE(communicator.responses.empty());
+}
+
+TEST(HandlerWideId, KeepsTablesProportionalToTheCommandCount) {
+    static_assert(TestHandlerWide::ID_SIZE == 2);
+    static_assert(TestHandlerManyWide::SLOT_COUNT <= 2 * 64 + 1, "40 IDs spread over 0x0007..0x2707");
+
+    const TestCommunicator communicator;
+    for (std::uint16_t i = 0; i < 40; ++i) {
+        const std::uint16_t id = static_cast<std::uint16_t>(0x0100 * i + 0x07);
+        ASSERT_TRUE(TestHandlerManyWide::execute(wideFrame(id, 0), communicator)) << id;
+        const std::uint16_t neighbour = static_cast<std::uint16_t>(id + 1);
+        EXPECT_FALSE(TestHandlerManyWide::execute(wideFrame(neighbour, 0), communicator)) << neighbour;
+    }
+    EXPECT_EQ(communicator.responses.size(), 40);
+}
+
+TEST(HandlerWideId, BatchesValidateBySlot) {
+    std::vector<std::vector<std::uint8_t>> raw{
+        wideFrame(0xBEEF, 0), wideFrame(0x0102, 1), {0x01}, wideFrame(0x0202, 0), {}, wideFrame(0xBEEF, 2),
+    };
+    const std::vector<serialized_message_view_t> frames(raw.begin(), raw.end());
+
+    std::vector<std::uint64_t> mask(validationMaskWords(frames.size()));
+    EXPECT_EQ(TestHandlerWide::validateBatch(frames, mask), 3);
+    const std::vector<bool> expected_valid{true, true, false, false, false, true};
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        EXPECT_EQ(isValidFrame(mask, i), expected_valid[i]) << "frame " << i;
+    }
+}
+
+TEST(HandlerWideId, DispatchesEnumIds) {
+    const TestCommunicator communicator;
+    ASSERT_TRUE((Handler<CommandA, CommandPing>::execute(std::vector<std::uint8_t>{0x21}, communicator)));
+    EXPECT_EQ(communicator.responses.size(), 1);
+    EXPECT_EQ(command_helpers::cmdId<CommandPing>(), 0x21);
+}
+
+TEST(HandlerWideId, DetectsMixedEncodingsAndDuplicates) {
+    EXPECT_TRUE((command_helpers::SameIdEncoding<CommandA, CommandPing>::value));
+    EXPECT_FALSE((command_helpers::SameIdEncoding<CommandA, CommandWide<0x0102>>::value));
+    EXPECT_FALSE((command_helpers::UniqueIds<CommandWide<0x0102>, CommandWide<0x0201>, CommandWide<0x0102>>::value));
+}
+
+/* ───────────────────────── Structured errors ───────────────────────── */
+
+struct FormatThrow
+{
+    static constexpr std::uint8_t ID = 0x07;
+    std::uint8_t id;
+};
+
+class CommandThrow final : public Command<FormatThrow>
+{
+  public:
+    explicit CommandThrow(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& /*communicator*/) const override {
+        throw std::runtime_error("device did not answer in time, giving up after several retries on the bus");
+    }
+};
+
+TEST(HandlerExecuteError, CarriesStructuredFields) {
+    const TestCommunicator communicator;
+    const std::vector<std::uint8_t> wrong_size{FormatA::ID, 0x00, 0x00, 0x00, 0x00};
+    const Result result = TestHandlerABC::execute(wrong_size, communicator);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().id, FormatA::ID);
+    EXPECT_EQ(result.error().expected, sizeof(FormatA));
+    EXPECT_EQ(result.error().got, wrong_size.size());
+    EXPECT_EQ(result.error().describe(), "Invalid content size, expected 4, got 5");
+
+    const std::vector<std::uint8_t> unknown{0x7F, 0x00};
+    EXPECT_EQ(TestHandlerABC::execute(unknown, communicator).error().describe(), "Unknown command ID: 127");
+    EXPECT_EQ(TestHandlerABC::execute({}, communicator).error().describe(), "Empty message received");
+}
+
+TEST(HandlerExecuteError, KeepsTheExceptionText) {
+    const TestCommunicator communicator;
+    const std::vector<std::uint8_t> frame{FormatThrow::ID};
+    const Result result = Handler<CommandA, CommandThrow>::execute(frame, communicator);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, HANDLER_EXECUTE_STATUS::ERROR_EXCEPTION_DURING_EXECUTION);
+    EXPECT_EQ(
+        result.error().describe(),
+        "Exception during execution: device did not answer in time, giving up after several retries on the bus"
+    );
+
+    // The text outlives the command, and copies of the error share it
+    const HandlerExecuteError copy = result.error();
+    EXPECT_STREQ(copy.exceptionText(), result.error().exceptionText());
+
+    std::array<char, 12> small{};
+    EXPECT_EQ(result.error().describeInto(small), "Exception du");
+    EXPECT_EQ(TestHandlerABC::execute({}, communicator).error().exceptionText(), nullptr);
+}
+
+// Returned by every execute(): kept to a few words, the exception text stays out of line
+static_assert(sizeof(HandlerExecuteError) <= 5 * sizeof(void*));
+static_assert(sizeof(handler_result_t) <= 6 * sizeof(void*));
@@ -0,0 +1,69 @@
+#include "hex.h"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(HexDecode, DecodesBothCases) {
+    std::array<std::uint8_t, 8> buffer{};
+    const auto bytes = hexDecode("0aFf10bC", buffer);
+    ASSERT_TRUE(bytes);
+    EXPECT_EQ(
+        std::vector<std::uint8_t>(bytes.value().begin(), bytes.value().end()),
+        (std::vector<std::uint8_t>{0x0A, 0xFF, 0x10, 0xBC})
+    );
+    EXPECT_EQ(bytes.value().data(), buffer.data());
+
+    const auto empty = hexDecode("", buffer);
+    ASSERT_TRUE(empty);
+    EXPECT_TRUE(empty.value().empty());
+}
+
+TEST(HexDecode, RejectsMalformedText) {
+    std::array<std::uint8_t, 8> buffer{};
+    const auto odd = hexDecode("012", buffer);
+    ASSERT_FALSE(odd);
+    EXPECT_EQ(odd.error(), HEX_DECODE_STATUS::ERROR_ODD_LENGTH);
+
+    for (const std::string_view text : {"0g", "g0", "01 2", "0x01", "-1", "\xff" "0"}) {
+        const auto invalid = hexDecode(text, buffer);
+        ASSERT_FALSE(invalid) << text;
+        EXPECT_EQ(invalid.error(), HEX_DECODE_STATUS::ERROR_INVALID_DIGIT) << text;
+    }
+
+    const auto too_long = hexDecode("000102030405060708", buffer);
+    ASSERT_FALSE(too_long);
+    EXPECT_EQ(too_long.error(), HEX_DECODE_STATUS::ERROR_BUFFER_TOO_SMALL);
+}
+
+TEST(HexDecode, AcceptsExactlyTheHexDigits) {
+    for (int c = 0; c < 256; ++c) {
+        const std::string text{static_cast<char>(c), '0'};
+        std::array<std::uint8_t, 1> buffer{};
+        const bool digit = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        EXPECT_EQ(static_cast<bool>(hexDecode(text, buffer)), digit) << c;
+    }
+}
+
+TEST(HexEncode, RoundTripsEveryByte) {
+    std::array<std::uint8_t, 256> bytes{};
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::uint8_t>(i);
+    }
+    std::array<char, 512> text{};
+    const std::string_view encoded = hexEncode(bytes, text);
+    ASSERT_EQ(encoded.size(), 512U);
+    EXPECT_EQ(encoded.substr(0, 8), "00010203");
+    EXPECT_EQ(encoded.substr(504), "fcfdfeff");
+
+    std::array<std::uint8_t, 256> decoded{};
+    ASSERT_TRUE(hexDecode(encoded, decoded));
+    EXPECT_EQ(decoded, bytes);
+
+    std::array<char, 3> small{};
+    EXPECT_TRUE(hexEncode(std::array<std::uint8_t, 2>{0x01, 0x02}, small).empty());
+}
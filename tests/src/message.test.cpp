@@ -1,6 +1,8 @@
 #include "message.h"
+#include <array>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -73,9 +75,32 @@ enum class SmallEnum : std::uint8_t
 {
     V = 7
 };
-struct BadStaticIdEnum
+struct GoodStaticIdEnum
 {
-    static constexpr SmallEnum ID = SmallEnum::V; // enum, not integral type for UnsignedByte
+    static constexpr SmallEnum ID = SmallEnum::V; // enum over a 1-byte unsigned integral
+    std::uint8_t id;
+};
+
+struct GoodWideId
+{
+    static constexpr std::uint16_t ID = 0x0102;
+    be_u16_t id; // 16-bit ID in network order
+    std::uint8_t arg;
+};
+
+struct BadWideIdNarrowField
+{
+    static constexpr std::uint16_t ID = 0x0102;
+    std::uint8_t id; // narrower than the ID
+};
+
+enum class SignedEnum : std::int8_t
+{
+    V = 1
+};
+struct BadStaticIdSignedEnum
+{
+    static constexpr SignedEnum ID = SignedEnum::V; // the underlying type must be unsigned
     std::uint8_t id;
 };
 
@@ -94,7 +119,10 @@ TEST(MessageConcepts, MessageFormatT) {
     static_assert(!MessageFormatT<BadIdNotFirst>, "`id` must be first member");
     static_assert(!MessageFormatT<BadIdWrongType>, "`id` must be 1-byte unsigned");
     static_assert(!MessageFormatT<BadStaticIdWrongType>, "T::ID must be 1-byte unsigned integral constant");
-    static_assert(!MessageFormatT<BadStaticIdEnum>, "T::ID must satisfy UnsignedByte, not enum");
+    static_assert(MessageFormatT<GoodStaticIdEnum>, "T::ID may be an enum over an unsigned byte");
+    static_assert(MessageFormatT<GoodWideId>, "T::ID may be 16-bit, with a WireInt id");
+    static_assert(!MessageFormatT<BadWideIdNarrowField>, "`id` must be as wide as T::ID");
+    static_assert(!MessageFormatT<BadStaticIdSignedEnum>, "T::ID must be unsigned");
     SUCCEED();
 }
 
@@ -154,6 +182,27 @@ TEST(SentMessage, SerializeMatchesStructMemory) {
     EXPECT_EQ(msg.content().b, 0xCDEF);
 }
 
+TEST(SentMessage, SerializeIntoMatchesSerialize) {
+    GoodFormat payload{};
+    payload.id = GoodFormat::ID;
+    payload.a = 0x12;
+    payload.b = 0x3456;
+    const SentGoodMessage msg{payload};
+
+    std::array<std::uint8_t, sizeof(GoodFormat) + 4> buffer{};
+    const serialized_message_view_t written = msg.serializeInto(buffer);
+
+    EXPECT_EQ(written.data(), buffer.data()) << "Bytes must be written at the start of the caller's buffer";
+    ASSERT_EQ(written.size(), msg.serializedSize());
+    EXPECT_EQ(std::vector<std::uint8_t>(written.begin(), written.end()), msg.serialize());
+}
+
+TEST(SentMessage, SerializeIntoThrowsOnSmallBuffer) {
+    const SentGoodMessage msg{GoodFormat{.id = GoodFormat::ID, .a = 0, .b = 0}};
+    std::array<std::uint8_t, sizeof(GoodFormat) - 1> buffer{};
+    EXPECT_THROW(static_cast<void>(msg.serializeInto(buffer)), MessageLengthError);
+}
+
 TEST(ReceivedMessage, ConstructFromRawBytesRoundTrips) {
     // Arrange: create raw bytes representing a GoodFormat
     GoodFormat original{};
@@ -175,6 +224,26 @@ TEST(ReceivedMessage, ConstructFromRawBytesRoundTrips) {
     EXPECT_EQ(msg.serialize(), raw);
 }
 
+TEST(ReceivedMessage, ConstructFromViewIntoLargerBuffer) {
+    GoodFormat original{};
+    original.id = GoodFormat::ID;
+    original.a = 0x5A;
+    original.b = 0x1234;
+
+    // Place the frame after a one-byte prefix, as a transport ring buffer would
+    std::array<std::uint8_t, sizeof(GoodFormat) + 2> buffer{};
+    std::memcpy(buffer.data() + 1, &original, sizeof(GoodFormat));
+
+    const ReceivedGoodMessage msg{serialized_message_view_t(buffer).subspan(1, sizeof(GoodFormat))};
+    EXPECT_EQ(toBytes(msg.content()), toBytes(original));
+}
+
+TEST(ReceivedMessage, ThrowsOnWrongSizeView) {
+    const std::array<std::uint8_t, sizeof(GoodFormat) + 1> bad_big{GoodFormat::ID};
+    EXPECT_THROW(ReceivedGoodMessage{serialized_message_view_t(bad_big)}, MessageLengthError);
+    EXPECT_THROW(ReceivedGoodMessage{serialized_message_view_t()}, MessageLengthError);
+}
+
 TEST(ReceivedMessage, ThrowsOnWrongSize) {
     // Too small
     const std::vector<std::uint8_t> bad_small(sizeof(GoodFormat) - 1, 0);
@@ -196,6 +265,61 @@ TEST(ReceivedMessage, ThrowsOnWrongID) {
     EXPECT_THROW(ReceivedGoodMessage{raw}, MessageWrongIdError);
 }
 
+TEST(ReceivedMessage, ValidateReportsWithoutThrowing) {
+    GoodFormat original{};
+    original.id = GoodFormat::ID;
+    const std::vector<std::uint8_t> raw = toBytes(original);
+    EXPECT_TRUE(ReceivedGoodMessage::validate(raw));
+
+    const std::vector<std::uint8_t> bad_small(sizeof(GoodFormat) - 1, GoodFormat::ID);
+    const Result too_small = ReceivedGoodMessage::validate(bad_small);
+    ASSERT_FALSE(too_small);
+    EXPECT_EQ(too_small.error().code, MESSAGE_PARSE_STATUS::ERROR_LENGTH);
+    EXPECT_EQ(too_small.error().expected, sizeof(GoodFormat));
+    EXPECT_EQ(too_small.error().got, sizeof(GoodFormat) - 1);
+
+    const std::vector<std::uint8_t> bad_id(sizeof(GoodFormat), GoodFormat::ID + 1);
+    const Result wrong_id = ReceivedGoodMessage::validate(bad_id);
+    ASSERT_FALSE(wrong_id);
+    EXPECT_EQ(wrong_id.error().code, MESSAGE_PARSE_STATUS::ERROR_WRONG_ID);
+    EXPECT_EQ(wrong_id.error().expected, GoodFormat::ID);
+    EXPECT_EQ(wrong_id.error().got, GoodFormat::ID + 1);
+
+    EXPECT_FALSE(ReceivedGoodMessage::validate(serialized_message_view_t()));
+}
+
+TEST(ReceivedMessage, TryParseBuildsMessage) {
+    GoodFormat original{};
+    original.id = GoodFormat::ID;
+    original.a = 0x42;
+    original.b = 0x4242;
+    const std::vector<std::uint8_t> raw = toBytes(original);
+
+    const Result parsed = ReceivedGoodMessage::tryParse(raw);
+    ASSERT_TRUE(parsed);
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(parsed.value())>, ReceivedGoodMessage>);
+    EXPECT_EQ(toBytes(parsed.value().content()), raw);
+}
+
+TEST(ReceivedMessage, TryParseRejectsMalformedContent) {
+    const std::vector<std::uint8_t> bad_big(sizeof(GoodFormat) + 1, GoodFormat::ID);
+    const Result parsed = ReceivedGoodMessage::tryParse<ReceivedGoodMessage>(bad_big);
+    ASSERT_FALSE(parsed);
+    EXPECT_EQ(parsed.error().code, MESSAGE_PARSE_STATUS::ERROR_LENGTH);
+    EXPECT_EQ(parsed.error().describe(), "Invalid content size, expected 4, got 5");
+}
+
+TEST(ReceivedMessage, ExceptionsMatchParseErrors) {
+    const std::vector<std::uint8_t> bad_id(sizeof(GoodFormat), 0x00);
+    try {
+        const ReceivedGoodMessage msg{bad_id};
+        FAIL() << "Expected MessageWrongIdError";
+    }
+    catch (const MessageWrongIdError& e) {
+        EXPECT_EQ(std::string(e.what()), ReceivedGoodMessage::validate(bad_id).error().describe());
+    }
+}
+
 TEST(NonTrivialMessage, InPlaceCtorParsesLenAndKeepsId) {
     // We won't use toBytes() because it would memcpy the non-trivial destructor
     const std::vector<std::uint8_t> wire{NonTrivialFormat::ID, 0x34, 0x12};
@@ -233,3 +357,290 @@ TEST(MessagePolymorphism, BasePointersWork) {
     // The first byte should be the ID by contract
     EXPECT_EQ(bytes[0], GoodFormat::ID);
 }
+
+/* ―――――――――――――――― Trailing payload ―――――――――――――――― */
+
+struct ChunkFormat
+{
+    static constexpr std::uint8_t ID = 0x20;
+    static constexpr std::size_t MAX_PAYLOAD_SIZE = 16;
+    std::uint8_t id;      // must be first
+    std::uint16_t offset; // fixed header field
+} __attribute__((packed));
+static_assert(MessageFormatT<ChunkFormat>);
+static_assert(TrailingPayloadFormatT<ChunkFormat>);
+static_assert(!TrailingPayloadFormatT<GoodFormat>);
+
+using ReceivedChunkMessage = ReceivedMessage<ChunkFormat>;
+using SentChunkMessage = SentMessage<ChunkFormat>;
+
+TEST(TrailingPayload, FixedFormatsKeepTheirSize) {
+    // Same layout as a Message without payload support: vptr + content
+    struct Reference
+    {
+        virtual ~Reference() = default;
+        GoodFormat content;
+    };
+    static_assert(sizeof(ReceivedMessage<GoodFormat>) == sizeof(Reference));
+    SUCCEED();
+}
+
+TEST(TrailingPayload, PayloadIsViewIntoSourceBuffer) {
+    const std::vector<std::uint8_t> wire{ChunkFormat::ID, 0x34, 0x12, 0xAA, 0xBB, 0xCC};
+
+    const ReceivedChunkMessage msg{wire};
+    EXPECT_EQ(msg.content().offset, 0x1234);
+    ASSERT_EQ(msg.payload().size(), 3);
+    EXPECT_EQ(msg.payload().data(), wire.data() + sizeof(ChunkFormat)) << "Payload must not be copied";
+    EXPECT_EQ(msg.serializedSize(), wire.size());
+    EXPECT_EQ(msg.serialize(), wire);
+}
+
+TEST(TrailingPayload, AcceptsEmptyAndMaximumPayload) {
+    std::vector<std::uint8_t> wire{ChunkFormat::ID, 0x00, 0x00};
+    EXPECT_TRUE(ReceivedChunkMessage::validate(wire));
+    EXPECT_TRUE(ReceivedChunkMessage{wire}.payload().empty());
+
+    wire.resize(sizeof(ChunkFormat) + ChunkFormat::MAX_PAYLOAD_SIZE, 0x55);
+    EXPECT_TRUE(ReceivedChunkMessage::validate(wire));
+    EXPECT_EQ(ReceivedChunkMessage{wire}.payload().size(), ChunkFormat::MAX_PAYLOAD_SIZE);
+}
+
+TEST(TrailingPayload, RejectsTruncatedHeaderAndOversizedPayload) {
+    const std::vector<std::uint8_t> truncated{ChunkFormat::ID, 0x00};
+    const Result too_small = ReceivedChunkMessage::validate(truncated);
+    ASSERT_FALSE(too_small);
+    EXPECT_EQ(too_small.error().code, MESSAGE_PARSE_STATUS::ERROR_LENGTH);
+    EXPECT_EQ(too_small.error().expected, sizeof(ChunkFormat));
+    EXPECT_THROW(ReceivedChunkMessage{truncated}, MessageLengthError);
+
+    const std::vector<std::uint8_t> oversized(sizeof(ChunkFormat) + ChunkFormat::MAX_PAYLOAD_SIZE + 1, ChunkFormat::ID);
+    const Result too_big = ReceivedChunkMessage::validate(oversized);
+    ASSERT_FALSE(too_big);
+    EXPECT_EQ(too_big.error().expected, sizeof(ChunkFormat) + ChunkFormat::MAX_PAYLOAD_SIZE);
+    EXPECT_THROW(ReceivedChunkMessage{oversized}, MessageLengthError);
+}
+
+TEST(TrailingPayload, SentMessageSerializesHeaderThenPayload) {
+    const std::array<std::uint8_t, 4> payload{0x01, 0x02, 0x03, 0x04};
+    const SentChunkMessage msg{ChunkFormat{.id = ChunkFormat::ID, .offset = 0x0102}, payload};
+
+    const std::vector<std::uint8_t> expected{ChunkFormat::ID, 0x02, 0x01, 0x01, 0x02, 0x03, 0x04};
+    EXPECT_EQ(msg.serialize(), expected);
+
+    std::array<std::uint8_t, 16> buffer{};
+    const serialized_message_view_t written = msg.serializeInto(buffer);
+    EXPECT_EQ(std::vector<std::uint8_t>(written.begin(), written.end()), expected);
+
+    std::array<std::uint8_t, sizeof(ChunkFormat)> header_only{};
+    EXPECT_THROW(static_cast<void>(msg.serializeInto(header_only)), MessageLengthError);
+
+    const std::array<std::uint8_t, ChunkFormat::MAX_PAYLOAD_SIZE + 1> too_large{};
+    EXPECT_THROW((SentChunkMessage{ChunkFormat{.id = ChunkFormat::ID, .offset = 0}, too_large}), MessageLengthError);
+}
+
+/* ―――――――――――――――― In-place view ―――――――――――――――― */
+
+struct AlignedViewFormat
+{
+    static constexpr std::uint8_t ID = 0x51;
+    std::uint8_t id;
+    std::uint8_t flags;
+    std::uint16_t port;
+    std::uint32_t address;
+    std::array<std::uint8_t, 1024> table; // large part most commands never read
+};
+static_assert(alignof(AlignedViewFormat) == 4);
+
+struct WireViewFormat
+{
+    static constexpr std::uint8_t ID = 0x52;
+    std::uint8_t id;
+    be_u32_t address;
+    le_u16_t port;
+};
+static_assert(alignof(WireViewFormat) == 1);
+
+TEST(ReceivedMessageView, ReadsFieldsFromMisalignedSourceBuffer) {
+    AlignedViewFormat format{.id = AlignedViewFormat::ID, .flags = 0x03, .port = 8080, .address = 0x7F000001, .table{}};
+    format.table[1000] = 0xAB;
+    std::vector<std::uint8_t> buffer(1 + sizeof(format));
+    std::memcpy(buffer.data() + 1, &format, sizeof(format)); // odd offset, as after a transport header
+
+    const ReceivedMessageView<AlignedViewFormat> view(serialized_message_view_t(buffer).subspan(1));
+    EXPECT_EQ(view.get<&AlignedViewFormat::flags>(), 0x03);
+    EXPECT_EQ(view.get<&AlignedViewFormat::port>(), 8080);
+    EXPECT_EQ(view.get<&AlignedViewFormat::address>(), 0x7F000001U);
+    EXPECT_EQ(view.get<&AlignedViewFormat::table>()[1000], 0xAB);
+    EXPECT_EQ(view.frame().data(), buffer.data() + 1) << "The frame must not be copied";
+    EXPECT_EQ(view.load().address, format.address);
+}
+
+TEST(ReceivedMessageView, ReadsLaterChangesOfTheSourceBuffer) {
+    std::vector<std::uint8_t> wire{WireViewFormat::ID, 0x0A, 0x00, 0x00, 0x01, 0x50, 0x00};
+    const ReceivedMessageView<WireViewFormat> view(wire);
+    EXPECT_EQ(view.content().address, 0x0A000001U);
+    EXPECT_EQ(view.get<&WireViewFormat::port>(), 80);
+
+    wire[5] = 0x51; // the view reads in place
+    EXPECT_EQ(view.content().port, 81);
+}
+
+TEST(ReceivedMessageView, ValidatesLikeReceivedMessage) {
+    const std::vector<std::uint8_t> short_frame{WireViewFormat::ID, 0x00};
+    EXPECT_THROW(ReceivedMessageView<WireViewFormat>{short_frame}, MessageLengthError);
+    const std::vector<std::uint8_t> wrong_id(sizeof(WireViewFormat), 0x00);
+    EXPECT_THROW(ReceivedMessageView<WireViewFormat>{wrong_id}, MessageWrongIdError);
+
+    const Result parsed = ReceivedMessageView<WireViewFormat>::tryParse(short_frame);
+    ASSERT_FALSE(parsed);
+    EXPECT_EQ(parsed.error().code, MESSAGE_PARSE_STATUS::ERROR_LENGTH);
+
+    const std::vector<std::uint8_t> chunk{ChunkFormat::ID, 0x00, 0x00, 0xAA, 0xBB};
+    const ReceivedMessageView<ChunkFormat> view(chunk);
+    ASSERT_EQ(view.payload().size(), 2);
+    EXPECT_EQ(view.payload().data(), chunk.data() + sizeof(ChunkFormat));
+}
+
+/* ―――――――――――――――― Field lists ―――――――――――――――― */
+
+struct FieldsFormat
+{
+    static constexpr std::uint8_t ID = 0x60;
+    static constexpr std::size_t MAX_PAYLOAD_SIZE = 8;
+    static constexpr auto fields() {
+        return std::tuple{&FieldsFormat::id, &FieldsFormat::flags, &FieldsFormat::value, &FieldsFormat::port};
+    }
+    std::uint8_t id;
+    std::uint8_t flags;
+    std::uint32_t value; // 2 bytes of padding before it in memory, none on the wire
+    be_u16_t port;
+    std::uint16_t cached; // in-memory only, left out of the wire
+};
+static_assert(FieldListFormatT<FieldsFormat>);
+static_assert(!FieldListFormatT<GoodFormat>);
+static_assert(sizeof(FieldsFormat) == 12);
+static_assert(message_helpers::wireSize<FieldsFormat>() == 8);
+static_assert(message_helpers::minSize<FieldsFormat>() == 8);
+static_assert(message_helpers::maxSize<FieldsFormat>() == 16);
+static_assert(message_helpers::memberWireOffset<FieldsFormat, &FieldsFormat::value>() == 2);
+static_assert(message_helpers::memberWireOffset<FieldsFormat, &FieldsFormat::port>() == 6);
+static_assert(message_helpers::memberWireOffset<FieldsFormat, &FieldsFormat::cached>() == 8);
+
+struct BadFieldsIdNotFirst
+{
+    static constexpr std::uint8_t ID = 0x61;
+    static constexpr auto fields() { return std::tuple{&BadFieldsIdNotFirst::value, &BadFieldsIdNotFirst::id}; }
+    std::uint8_t id;
+    std::uint8_t value;
+};
+static_assert(MessageFormatT<BadFieldsIdNotFirst>);
+static_assert(!FieldListFormatT<BadFieldsIdNotFirst>);
+
+struct OtherFieldsFormat
+{
+    static constexpr std::uint8_t ID = 0x62;
+    std::uint8_t id;
+};
+
+struct BadFieldsOfAnotherFormat
+{
+    static constexpr std::uint8_t ID = 0x62;
+    static constexpr auto fields() { return std::tuple{&OtherFieldsFormat::id}; }
+    std::uint8_t id;
+};
+static_assert(!FieldListFormatT<BadFieldsOfAnotherFormat>);
+
+static constexpr std::array<std::uint8_t, 8> FIELDS_WIRE{0x60, 0x05, 0x44, 0x33, 0x22, 0x11, 0x1F, 0x90};
+
+TEST(FieldList, SerializesTheFieldsBackToBack) {
+    const SentMessage<FieldsFormat> msg(
+        FieldsFormat{.id = FieldsFormat::ID, .flags = 0x05, .value = 0x11223344, .port = 8080, .cached = 0xFFFF}
+    );
+    const std::vector<std::uint8_t> expected(FIELDS_WIRE.begin(), FIELDS_WIRE.end());
+    if constexpr (std::endian::native == std::endian::little) {
+        EXPECT_EQ(msg.serialize(), expected);
+    }
+    EXPECT_EQ(msg.serializedSize(), 8U);
+
+    std::array<std::uint8_t, 8> buffer{};
+    const serialized_message_view_t written = msg.serializeInto(buffer);
+    EXPECT_EQ(std::vector<std::uint8_t>(written.begin(), written.end()), msg.serialize());
+    std::array<std::uint8_t, 7> small{};
+    EXPECT_THROW(static_cast<void>(msg.serializeInto(small)), MessageLengthError);
+}
+
+TEST(FieldList, ReceivedMessageDecodesIntoTheAlignedStruct) {
+    if constexpr (std::endian::native != std::endian::little) {
+        GTEST_SKIP() << "FIELDS_WIRE holds little-endian host integers";
+    }
+    const ReceivedMessage<FieldsFormat> msg{FIELDS_WIRE};
+    EXPECT_EQ(msg.content().flags, 0x05);
+    EXPECT_EQ(msg.content().value, 0x11223344U);
+    EXPECT_EQ(msg.content().port, 8080);
+    EXPECT_EQ(msg.content().cached, 0) << "Members left out of the fields are value-initialized";
+    EXPECT_TRUE(msg.payload().empty());
+
+    const Result short_frame = ReceivedMessage<FieldsFormat>::validate(serialized_message_view_t(FIELDS_WIRE).first(7));
+    ASSERT_FALSE(short_frame);
+    EXPECT_EQ(short_frame.error().expected, 8U);
+}
+
+TEST(FieldList, PayloadFollowsTheWireFields) {
+    std::vector<std::uint8_t> wire(FIELDS_WIRE.begin(), FIELDS_WIRE.end());
+    wire.insert(wire.end(), {0xAA, 0xBB});
+
+    const ReceivedMessage<FieldsFormat> msg{wire};
+    ASSERT_EQ(msg.payload().size(), 2U);
+    EXPECT_EQ(msg.payload().data(), wire.data() + 8);
+    EXPECT_EQ(msg.serialize(), wire);
+
+    const SentMessage<FieldsFormat> sent(msg.content(), msg.payload());
+    EXPECT_EQ(sent.serialize(), wire);
+}
+
+TEST(FieldList, ViewReadsMembersAtTheirWireOffset) {
+    std::vector<std::uint8_t> buffer(1 + FIELDS_WIRE.size());
+    std::memcpy(buffer.data() + 1, FIELDS_WIRE.data(), FIELDS_WIRE.size()); // misaligned on purpose
+
+    const ReceivedMessageView<FieldsFormat> view(serialized_message_view_t(buffer).subspan(1));
+    EXPECT_EQ(view.get<&FieldsFormat::flags>(), 0x05);
+    EXPECT_EQ(view.get<&FieldsFormat::port>(), 8080);
+    const FieldsFormat loaded = view.load();
+    EXPECT_EQ(loaded.port, 8080);
+    EXPECT_EQ(loaded.flags, 0x05);
+    if constexpr (std::endian::native == std::endian::little) {
+        EXPECT_EQ(view.get<&FieldsFormat::value>(), 0x11223344U);
+        EXPECT_EQ(loaded.value, 0x11223344U);
+    }
+}
+
+struct PackedFieldsFormat
+{
+    static constexpr std::uint8_t ID = 0x63;
+    std::uint8_t id;
+    std::uint32_t value;
+    std::uint16_t port;
+} __attribute__((packed));
+
+struct ListedFieldsFormat
+{
+    static constexpr std::uint8_t ID = 0x63;
+    static constexpr auto fields() {
+        return std::tuple{&ListedFieldsFormat::id, &ListedFieldsFormat::value, &ListedFieldsFormat::port};
+    }
+    std::uint8_t id;
+    std::uint32_t value;
+    std::uint16_t port;
+};
+static_assert(sizeof(ListedFieldsFormat) > sizeof(PackedFieldsFormat));
+static_assert(message_helpers::wireSize<ListedFieldsFormat>() == sizeof(PackedFieldsFormat));
+
+TEST(FieldList, MatchesThePackedLayoutWhenEveryMemberIsListed) {
+    const auto packed =
+        SentMessage<PackedFieldsFormat>({.id = 0x63, .value = 0xDEADBEEF, .port = 0x1234}).serialize();
+    const auto listed =
+        SentMessage<ListedFieldsFormat>({.id = 0x63, .value = 0xDEADBEEF, .port = 0x1234}).serialize();
+    EXPECT_EQ(listed, packed);
+    EXPECT_EQ(ReceivedMessage<ListedFieldsFormat>(packed).content().value, 0xDEADBEEF);
+}
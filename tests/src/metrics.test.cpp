@@ -0,0 +1,185 @@
+#include "metrics.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "test_communicators.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+struct MeteredFormat
+{
+    static constexpr std::uint8_t ID = 0x31;
+    std::uint8_t id;
+    std::uint8_t fail; // non-zero makes the command throw
+};
+static_assert(MessageFormatT<MeteredFormat>);
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+class MeteredCommand final : public Command<MeteredFormat>
+{
+  public:
+    explicit MeteredCommand(const serialized_message_view_t content) : Command<MeteredFormat>(content) {}
+
+    void execute(const Communicator&) const override {
+        if (content().fail != 0) {
+            throw std::runtime_error("failure");
+        }
+    }
+};
+
+inline CommandMetrics test_metrics;
+
+using MeteredHandler = BasicHandler<MetricsInstrumentation<test_metrics>, MeteredCommand>;
+
+static_assert(std::is_same_v<Handler<MeteredCommand>, BasicHandler<NoInstrumentation, MeteredCommand>>);
+
+/* ―――――――――――――――― Fixture ―――――――――――――――― */
+
+class MetricsTest : public ::testing::Test
+{
+  protected:
+    DiscardingCommunicator communicator;
+
+    void SetUp() override { test_metrics.reset(); }
+
+    void executeFrame(const std::vector<std::uint8_t>& frame) const {
+        static_cast<void>(MeteredHandler::execute(frame, communicator));
+    }
+};
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(MetricsBucketsTest, BucketsAreLog2OfTheDuration) {
+    EXPECT_EQ(CommandMetrics::bucketOf(0), 0U);
+    EXPECT_EQ(CommandMetrics::bucketOf(1), 1U);
+    EXPECT_EQ(CommandMetrics::bucketOf(1000), 10U);
+    EXPECT_LT(999U, CommandMetrics::bucketBound(CommandMetrics::bucketOf(999)));
+    EXPECT_EQ(CommandMetrics::bucketOf(UINT64_MAX), METRICS_HISTOGRAM_BUCKETS - 1);
+}
+
+TEST_F(MetricsTest, CountsInvocationsAndErrorsByStatus) {
+    executeFrame({MeteredFormat::ID, 0});
+    executeFrame({MeteredFormat::ID, 0});
+    executeFrame({MeteredFormat::ID, 1});       // throws
+    executeFrame({MeteredFormat::ID, 0, 0xFF}); // wrong size
+    executeFrame({0x77});                       // unknown ID
+
+    const CommandSnapshot metered = test_metrics.snapshot(MeteredFormat::ID);
+    EXPECT_EQ(metered.invocations, 4U);
+    EXPECT_EQ(metered.errorCount(HANDLER_EXECUTE_STATUS::ERROR_EXCEPTION_DURING_EXECUTION), 1U);
+    EXPECT_EQ(metered.errorCount(HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR), 1U);
+
+    const CommandSnapshot unknown = test_metrics.unknownIds();
+    EXPECT_EQ(unknown.invocations, 1U);
+    EXPECT_EQ(unknown.errorCount(HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND), 1U);
+    EXPECT_EQ(test_metrics.snapshot(0x77).invocations, 0U);
+
+    std::uint64_t histogram_total = 0;
+    for (const std::uint64_t count : metered.histogram) {
+        histogram_total += count;
+    }
+    EXPECT_EQ(histogram_total, metered.invocations);
+}
+
+TEST_F(MetricsTest, EmptyFramesAreRecordedUnderIdZero) {
+    executeFrame({});
+    EXPECT_EQ(test_metrics.snapshot(0).errorCount(HANDLER_EXECUTE_STATUS::ERROR_EMPTY_MESSAGE), 1U);
+}
+
+TEST_F(MetricsTest, CountsEveryStatus) {
+    const handler_result_t unrouted(
+        UNEXPECT, HandlerExecuteError{.code = HANDLER_EXECUTE_STATUS::ERROR_ROUTE_NOT_FOUND}
+    );
+    const handler_result_t overloaded(UNEXPECT, HandlerExecuteError{.code = HANDLER_EXECUTE_STATUS::ERROR_OVERLOADED});
+    test_metrics.record(MeteredFormat::ID, unrouted, 10);
+    test_metrics.record(MeteredFormat::ID, overloaded, 10);
+    const CommandSnapshot metered = test_metrics.snapshot(MeteredFormat::ID);
+    EXPECT_EQ(metered.errorCount(HANDLER_EXECUTE_STATUS::ERROR_ROUTE_NOT_FOUND), 1U);
+    EXPECT_EQ(metered.errorCount(HANDLER_EXECUTE_STATUS::ERROR_OVERLOADED), 1U);
+    const std::string text = test_metrics.toPrometheus("dev");
+    EXPECT_NE(text.find("dev_command_errors_total{id=\"49\",status=\"6\"} 1\n"), std::string::npos);
+}
+
+TEST_F(MetricsTest, SnapshotListsOnlyExecutedIds) {
+    executeFrame({MeteredFormat::ID, 0});
+    executeFrame({0x05});
+
+    test_metrics.record(0x05, handler_result_t{}, 10);
+
+    const std::vector<CommandSnapshot> snapshots = test_metrics.snapshot();
+    ASSERT_EQ(snapshots.size(), 2U);
+    EXPECT_EQ(snapshots[0].id, 0x05);
+    EXPECT_EQ(snapshots[1].id, MeteredFormat::ID);
+
+    test_metrics.reset();
+    EXPECT_TRUE(test_metrics.snapshot().empty());
+    EXPECT_EQ(test_metrics.unknownIds().invocations, 0U);
+}
+
+TEST_F(MetricsTest, ConcurrentRecordsAreNotLost) {
+    constexpr int PER_THREAD = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([this] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                executeFrame({MeteredFormat::ID, 0});
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(test_metrics.snapshot(MeteredFormat::ID).invocations, 4U * PER_THREAD);
+}
+
+TEST_F(MetricsTest, ExportsPrometheusText) {
+    executeFrame({MeteredFormat::ID, 0});
+    executeFrame({MeteredFormat::ID, 1});
+
+    const std::string text = test_metrics.toPrometheus("dev");
+    EXPECT_NE(text.find("# TYPE dev_command_invocations_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("dev_command_invocations_total{id=\"49\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("dev_command_errors_total{id=\"49\",status=\"3\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE dev_command_duration_nanoseconds histogram\n"), std::string::npos);
+    EXPECT_NE(text.find("dev_command_duration_nanoseconds_bucket{id=\"49\",le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("dev_command_duration_nanoseconds_count{id=\"49\"} 2\n"), std::string::npos);
+}
+
+TEST_F(MetricsTest, UnknownWideIdsShareOneBucket) {
+    const handler_result_t unknown(UNEXPECT, HandlerExecuteError{.code = HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND});
+    for (command_id_t id = 0x2000; id < 0x2000 + 2 * CommandMetrics::CELLS; ++id) {
+        test_metrics.record(id, unknown, 10);
+    }
+    executeFrame({MeteredFormat::ID, 0});
+
+    EXPECT_EQ(test_metrics.snapshot(MeteredFormat::ID).invocations, 1U);
+    EXPECT_EQ(test_metrics.unknownIds().invocations, 2 * CommandMetrics::CELLS);
+    EXPECT_EQ(test_metrics.snapshot().size(), 1U);
+    EXPECT_EQ(test_metrics.droppedRecords(), 0U);
+
+    const std::string text = test_metrics.toPrometheus("dev");
+    EXPECT_NE(text.find("dev_command_invocations_total{id=\"unknown\"} 512\n"), std::string::npos);
+    EXPECT_NE(text.find("dev_command_errors_total{id=\"unknown\",status=\"1\"} 512\n"), std::string::npos);
+}
+
+TEST_F(MetricsTest, TracksWideIdsUpToTheCellCount) {
+    const handler_result_t ok{};
+    test_metrics.record(0x0131, ok, 10); // shares its low byte with MeteredFormat::ID
+    test_metrics.record(MeteredFormat::ID, ok, 10);
+    EXPECT_EQ(test_metrics.snapshot(0x0131).invocations, 1U);
+    EXPECT_EQ(test_metrics.snapshot(MeteredFormat::ID).invocations, 1U);
+
+    for (command_id_t id = 0x1000; id < 0x1000 + CommandMetrics::CELLS; ++id) {
+        test_metrics.record(id, ok, 10);
+    }
+    EXPECT_EQ(test_metrics.snapshot().size(), CommandMetrics::CELLS);
+    EXPECT_EQ(test_metrics.droppedRecords(), 2U);
+    EXPECT_EQ(test_metrics.snapshot(0x10FF).invocations, 0U);
+}
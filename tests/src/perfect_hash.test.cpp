@@ -0,0 +1,53 @@
+#include "perfect_hash.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <set>
+
+/* ―――――――――――――――― Compile-time checks ―――――――――――――――― */
+
+constexpr PerfectHash<3> SMALL_HASH(std::array<std::uint16_t, 3>{0x0101, 0x0102, 0x0201});
+static_assert(PerfectHash<3>::SLOTS == 8);
+static_assert(SMALL_HASH.find(0x0101) != SMALL_HASH.find(0x0102));
+static_assert(SMALL_HASH.find(0x0102) != SMALL_HASH.find(0x0201));
+static_assert(SMALL_HASH.find(0x0101) != SMALL_HASH.find(0x0201));
+static_assert(SMALL_HASH.find(0x0202) == PerfectHash<3>::SLOTS);
+
+constexpr PerfectHash<0> EMPTY_HASH(std::array<std::uint16_t, 0>{});
+static_assert(EMPTY_HASH.find(0) == PerfectHash<0>::SLOTS);
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+template <std::size_t N> consteval std::array<std::uint16_t, N> strideKeys(const std::uint16_t stride) {
+    std::array<std::uint16_t, N> keys{};
+    for (std::size_t i = 0; i < N; ++i) {
+        keys[i] = static_cast<std::uint16_t>(i * stride);
+    }
+    return keys;
+}
+
+TEST(PerfectHashTest, MapsEveryKeyToItsOwnSlot) {
+    static constexpr std::array<std::uint16_t, 200> KEYS = strideKeys<200>(0x0101);
+    static constexpr PerfectHash<200> HASH(KEYS);
+
+    std::set<std::size_t> slots;
+    for (const std::uint16_t key : KEYS) {
+        const std::size_t slot = HASH.find(key);
+        ASSERT_LT(slot, PerfectHash<200>::SLOTS) << key;
+        EXPECT_EQ(slot, HASH.slot(key));
+        slots.insert(slot);
+    }
+    EXPECT_EQ(slots.size(), KEYS.size());
+}
+
+TEST(PerfectHashTest, RejectsEveryOtherKey) {
+    static constexpr std::array<std::uint16_t, 64> KEYS = strideKeys<64>(0x0400);
+    static constexpr PerfectHash<64> HASH(KEYS);
+
+    std::size_t found = 0;
+    for (std::uint32_t key = 0; key <= 0xFFFFU; ++key) {
+        found += HASH.find(static_cast<std::uint16_t>(key)) != PerfectHash<64>::SLOTS ? 1 : 0;
+    }
+    EXPECT_EQ(found, KEYS.size());
+}
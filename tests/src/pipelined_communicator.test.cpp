@@ -0,0 +1,234 @@
+#include "pipelined_communicator.h"
+#include "communication.h"
+#include "test_communicators.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* ―――――――――――――――― Transports ―――――――――――――――― */
+
+/**
+ * @brief Sink recording every frame sent downstream
+ */
+class RecordingSink final : public FrameSink
+{
+    mutable std::mutex _mutex;
+    std::vector<std::vector<std::uint8_t>> _frames;
+
+  public:
+    void send(const std::span<const std::uint8_t> frame) override {
+        const std::scoped_lock lock(_mutex);
+        _frames.emplace_back(frame.begin(), frame.end());
+    }
+
+    std::vector<std::vector<std::uint8_t>> frames() const {
+        const std::scoped_lock lock(_mutex);
+        return _frames;
+    }
+};
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+using pipelined_t = PipelinedCommunicator<8>;
+
+/**
+ * @brief Device side: builds the frame answering token
+ */
+static std::vector<std::uint8_t>
+reply(const std::uint16_t token, const PIPELINE_FRAME_KIND kind, const std::vector<std::uint8_t>& body) {
+    std::vector<std::uint8_t> buffer(PIPELINE_HEADER_SIZE + body.size());
+    const serialized_message_view_t frame = encodeEnvelope({.token = token, .kind = kind, .body = body}, buffer);
+    return {frame.begin(), frame.end()};
+}
+
+static std::vector<std::uint8_t> completeFrame(const std::uint16_t token, const Communicator::REQUEST_STATUS status) {
+    return reply(token, PIPELINE_FRAME_KIND::COMPLETE, {static_cast<std::uint8_t>(status)});
+}
+
+/**
+ * @brief Collects the responses of one request
+ */
+struct Collector
+{
+    std::vector<std::vector<std::uint8_t>>* responses;
+
+    void operator()(const std::span<const std::uint8_t> response) const {
+        responses->emplace_back(response.begin(), response.end());
+    }
+};
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(PipelineEnvelope, RoundTrips) {
+    const std::vector<std::uint8_t> body{0x10, 0x20};
+    const std::vector<std::uint8_t> frame = reply(0xBEEF, PIPELINE_FRAME_KIND::RESPONSE, body);
+    EXPECT_EQ(frame, (std::vector<std::uint8_t>{0xEF, 0xBE, 0x01, 0x10, 0x20}));
+
+    const std::optional<PipelineEnvelope> envelope = decodeEnvelope(frame);
+    ASSERT_TRUE(envelope.has_value());
+    EXPECT_EQ(envelope->token, 0xBEEF);
+    EXPECT_EQ(envelope->kind, PIPELINE_FRAME_KIND::RESPONSE);
+    EXPECT_EQ(std::vector<std::uint8_t>(envelope->body.begin(), envelope->body.end()), body);
+    EXPECT_FALSE(decodeEnvelope(serialized_message_view_t(frame).first(2)).has_value());
+}
+
+TEST(PipelinedCommunicator, RoutesOutOfOrderResponsesToTheirRequest) {
+    RecordingSink sink;
+    const DiscardingCommunicator upstream;
+    const pipelined_t communicator(sink, upstream);
+
+    constexpr std::size_t REQUESTS = 5;
+    std::array<std::vector<std::vector<std::uint8_t>>, REQUESTS> responses;
+    std::vector<std::unique_ptr<RequestCompletion>> requests;
+    for (std::size_t i = 0; i < REQUESTS; ++i) {
+        const std::array<std::uint8_t, 2> message{0x42, static_cast<std::uint8_t>(i)};
+        requests.push_back(std::make_unique<AsyncRequest<Collector>>(communicator, message, Collector{&responses[i]}));
+    }
+    EXPECT_EQ(communicator.inFlight(), REQUESTS);
+
+    // The device answers last request first, interleaving responses of different requests
+    const std::vector<std::vector<std::uint8_t>> sent = sink.frames();
+    ASSERT_EQ(sent.size(), REQUESTS);
+    for (std::size_t i = REQUESTS; i-- > 0;) {
+        const std::optional<PipelineEnvelope> request = decodeEnvelope(sent[i]);
+        ASSERT_TRUE(request.has_value());
+        EXPECT_EQ(request->kind, PIPELINE_FRAME_KIND::REQUEST);
+        const std::vector<std::uint8_t> body(request->body.begin(), request->body.end());
+        EXPECT_TRUE(communicator.onDownstreamFrame(reply(request->token, PIPELINE_FRAME_KIND::RESPONSE, body)));
+    }
+    for (std::size_t i = 0; i < REQUESTS; ++i) {
+        const std::uint16_t token = decodeEnvelope(sent[i])->token;
+        EXPECT_TRUE(communicator.onDownstreamFrame(reply(token, PIPELINE_FRAME_KIND::RESPONSE, {0xFF})));
+        EXPECT_TRUE(communicator.onDownstreamFrame(completeFrame(token, Communicator::REQUEST_STATUS::SUCCESS)));
+    }
+
+    EXPECT_EQ(communicator.inFlight(), 0);
+    for (std::size_t i = 0; i < REQUESTS; ++i) {
+        ASSERT_TRUE(requests[i]->done());
+        EXPECT_EQ(requests[i]->status(), Communicator::REQUEST_STATUS::SUCCESS);
+        const std::vector<std::vector<std::uint8_t>> expected{{0x42, static_cast<std::uint8_t>(i)}, {0xFF}};
+        EXPECT_EQ(responses[i], expected);
+    }
+}
+
+TEST(PipelinedCommunicator, CompletesWithBusyWhenTheTableIsFull) {
+    RecordingSink sink;
+    const DiscardingCommunicator upstream;
+    const PipelinedCommunicator<2> communicator(sink, upstream);
+    std::vector<std::vector<std::uint8_t>> responses;
+    const std::array<std::uint8_t, 1> message{0x01};
+
+    AsyncRequest<Collector> first(communicator, message, Collector{&responses});
+    AsyncRequest<Collector> second(communicator, message, Collector{&responses});
+    const AsyncRequest<Collector> third(communicator, message, Collector{&responses});
+    EXPECT_TRUE(third.done());
+    EXPECT_EQ(third.status(), Communicator::REQUEST_STATUS::ERROR_BUSY);
+    EXPECT_EQ(sink.frames().size(), 2);
+
+    communicator.cancelAll();
+    EXPECT_EQ(first.status(), Communicator::REQUEST_STATUS::ERROR_COMMUNICATION);
+    EXPECT_EQ(second.status(), Communicator::REQUEST_STATUS::ERROR_COMMUNICATION);
+    EXPECT_EQ(communicator.inFlight(), 0);
+}
+
+TEST(PipelinedCommunicator, IgnoresStaleAndUnknownTokens) {
+    RecordingSink sink;
+    const DiscardingCommunicator upstream;
+    const PipelinedCommunicator<1> communicator(sink, upstream);
+    std::vector<std::vector<std::uint8_t>> responses;
+    const std::array<std::uint8_t, 1> message{0x01};
+
+    std::uint16_t stale_token = 0;
+    {
+        const AsyncRequest<Collector> request(communicator, message, Collector{&responses});
+        stale_token = decodeEnvelope(sink.frames().back())->token;
+        EXPECT_TRUE(communicator.onDownstreamFrame(completeFrame(stale_token, Communicator::REQUEST_STATUS::SUCCESS)));
+    }
+
+    const AsyncRequest<Collector> request(communicator, message, Collector{&responses});
+    const std::uint16_t token = decodeEnvelope(sink.frames().back())->token;
+    EXPECT_NE(token, stale_token) << "a reused slot gets a new generation";
+    EXPECT_FALSE(communicator.onDownstreamFrame(reply(stale_token, PIPELINE_FRAME_KIND::RESPONSE, {0x01})));
+    EXPECT_FALSE(communicator.onDownstreamFrame(std::vector<std::uint8_t>{0x00}));
+    EXPECT_TRUE(responses.empty());
+    EXPECT_TRUE(communicator.onDownstreamFrame(completeFrame(token, Communicator::REQUEST_STATUS::ERROR_TIMEOUT)));
+    EXPECT_EQ(request.status(), Communicator::REQUEST_STATUS::ERROR_TIMEOUT);
+}
+
+TEST(PipelinedCommunicator, BlockingRequestWaitsForTheReader) {
+    RecordingSink sink;
+    const DiscardingCommunicator upstream;
+    const pipelined_t communicator(sink, upstream);
+
+    std::thread device([&] {
+        while (sink.frames().empty()) {
+            std::this_thread::yield();
+        }
+        const std::uint16_t token = decodeEnvelope(sink.frames().front())->token;
+        communicator.onDownstreamFrame(reply(token, PIPELINE_FRAME_KIND::RESPONSE, {0x07}));
+        communicator.onDownstreamFrame(completeFrame(token, Communicator::REQUEST_STATUS::SUCCESS));
+    });
+
+    const Communicator& base = communicator; // the collecting overload is hidden by the overrides
+    std::vector<std::vector<std::uint8_t>> responses;
+    EXPECT_EQ(base.request({0x01}, responses), Communicator::REQUEST_STATUS::SUCCESS);
+    device.join();
+    EXPECT_EQ(responses, (std::vector<std::vector<std::uint8_t>>{{0x07}}));
+
+    communicator.respond(std::vector<std::uint8_t>{0x01});
+    EXPECT_EQ(upstream.responses(), 1);
+}
+
+TEST(PipelinedCommunicator, ExpiresRequestsWithoutComplete) {
+    RecordingSink sink;
+    const DiscardingCommunicator upstream;
+    const PipelinedCommunicator<2> communicator(sink, upstream, std::chrono::milliseconds(20));
+
+    const Communicator& base = communicator; // the collecting overload is hidden by the overrides
+    std::vector<std::vector<std::uint8_t>> responses;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(base.request({0x01}, responses), Communicator::REQUEST_STATUS::ERROR_TIMEOUT);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_EQ(communicator.inFlight(), 0);
+
+    // The late answer of the expired request is ignored
+    const std::uint16_t token = decodeEnvelope(sink.frames().back())->token;
+    EXPECT_FALSE(communicator.onDownstreamFrame(reply(token, PIPELINE_FRAME_KIND::RESPONSE, {0x01})));
+    EXPECT_FALSE(communicator.onDownstreamFrame(completeFrame(token, Communicator::REQUEST_STATUS::SUCCESS)));
+    EXPECT_TRUE(responses.empty());
+
+    // Awaitable requests expire too, instead of blocking their destructor
+    {
+        const std::array<std::uint8_t, 1> message{0x02};
+        const AsyncRequest<Collector> first(communicator, message, Collector{&responses});
+        const AsyncRequest<Collector> second(communicator, message, Collector{&responses});
+        EXPECT_EQ(
+            syncWait([](const PipelinedCommunicator<2>& self) -> Task<Communicator::REQUEST_STATUS> {
+                co_return co_await self.asyncRequest(std::array<std::uint8_t, 1>{0x03}, [](auto) {});
+            }(communicator)),
+            Communicator::REQUEST_STATUS::ERROR_BUSY
+        );
+    }
+    EXPECT_EQ(communicator.inFlight(), 0);
+}
+
+TEST(PipelinedCommunicator, RejectsCompleteFramesWithUnknownStatus) {
+    RecordingSink sink;
+    const DiscardingCommunicator upstream;
+    const pipelined_t communicator(sink, upstream);
+    std::vector<std::vector<std::uint8_t>> responses;
+    const std::array<std::uint8_t, 1> message{0x01};
+
+    const AsyncRequest<Collector> request(communicator, message, Collector{&responses});
+    const std::uint16_t token = decodeEnvelope(sink.frames().back())->token;
+    EXPECT_TRUE(communicator.onDownstreamFrame(reply(token, PIPELINE_FRAME_KIND::COMPLETE, {0x7F})));
+    ASSERT_TRUE(request.done());
+    EXPECT_EQ(request.status(), Communicator::REQUEST_STATUS::ERROR_COMMUNICATION);
+    EXPECT_EQ(communicator.inFlight(), 0);
+}
@@ -0,0 +1,259 @@
+#include "response_cache.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "test_communicators.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+struct CachedReadFormat
+{
+    static constexpr std::uint8_t ID = 0x61;
+    std::uint8_t id;
+    std::uint8_t count; // number of responses
+    std::uint16_t arg;
+};
+static_assert(MessageFormatT<CachedReadFormat>);
+
+struct CachedWriteFormat
+{
+    static constexpr std::uint8_t ID = 0x62;
+    std::uint8_t id;
+    std::uint8_t reserved;
+    std::uint16_t arg;
+};
+static_assert(MessageFormatT<CachedWriteFormat>);
+
+struct CachedResponse
+{
+    static constexpr std::uint8_t ID = 0xE1;
+    std::uint8_t id;
+    std::uint8_t index;
+    std::uint16_t value;
+};
+static_assert(MessageFormatT<CachedResponse>);
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+static std::atomic<std::size_t> read_executions{0};
+static std::atomic<std::size_t> write_executions{0};
+
+/**
+ * @brief Pure read: answers count responses computed from arg
+ */
+class CachedReadCommand final : public Command<CachedReadFormat>
+{
+  public:
+    static constexpr bool IDEMPOTENT = true;
+
+    explicit CachedReadCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        read_executions.fetch_add(1, std::memory_order_relaxed);
+        std::array<std::uint8_t, sizeof(CachedResponse)> buffer{};
+        for (std::uint8_t index = 0; index < content().count; ++index) {
+            const auto value = static_cast<std::uint16_t>(content().arg * 2U);
+            communicator.respondView(
+                SentMessage<CachedResponse>({.id = CachedResponse::ID, .index = index, .value = value})
+                    .serializeInto(buffer)
+            );
+        }
+    }
+};
+
+/**
+ * @brief Not marked idempotent, always executed
+ */
+class CachedWriteCommand final : public Command<CachedWriteFormat>
+{
+  public:
+    explicit CachedWriteCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        write_executions.fetch_add(1, std::memory_order_relaxed);
+        std::array<std::uint8_t, sizeof(CachedResponse)> buffer{};
+        communicator.respondView(
+            SentMessage<CachedResponse>({.id = CachedResponse::ID, .index = 0, .value = content().arg})
+                .serializeInto(buffer)
+        );
+    }
+};
+
+using CachedBaseHandler = Handler<CachedReadCommand, CachedWriteCommand>;
+
+static_assert(IdempotentCommandT<CachedReadCommand>);
+static_assert(!IdempotentCommandT<CachedWriteCommand>);
+
+/* ―――――――――――――――― Caches ―――――――――――――――― */
+
+static ResponseCache<64, 16, 32, 4> default_cache;
+static ResponseCache<64, 16, 32, 4> expiring_cache({.ttl = std::chrono::milliseconds(20)});
+static ResponseCache<4, 16, 32, 1> tiny_cache({.ttl = std::chrono::seconds(0)});
+static ResponseCache<1024, 16, 32, 16> shared_cache;
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+static serialized_message_t readFrame(const std::uint16_t arg, const std::uint8_t count = 1) {
+    return SentMessage<CachedReadFormat>({.id = CachedReadFormat::ID, .count = count, .arg = arg}).serialize();
+}
+
+static serialized_message_t writeFrame(const std::uint16_t arg) {
+    return SentMessage<CachedWriteFormat>({.id = CachedWriteFormat::ID, .reserved = 0, .arg = arg}).serialize();
+}
+
+/**
+ * @brief Resets the command counters before each test
+ */
+class ResponseCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override {
+        read_executions = 0;
+        write_executions = 0;
+    }
+};
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(HandlerIdempotent, ReportsTheTraitOfTheFrameCommand) {
+    EXPECT_TRUE(CachedBaseHandler::idempotent(readFrame(1)));
+    EXPECT_FALSE(CachedBaseHandler::idempotent(writeFrame(1)));
+    EXPECT_FALSE(CachedBaseHandler::idempotent(std::vector<std::uint8_t>{0x7F}));
+    EXPECT_FALSE(CachedBaseHandler::idempotent(std::vector<std::uint8_t>{}));
+}
+
+TEST_F(ResponseCacheTest, ReplaysHitsWithoutExecuting) {
+    using handler_t = MemoizingHandler<CachedBaseHandler, default_cache>;
+    const RecordingCommunicator<CachedResponse> communicator;
+    EXPECT_TRUE(handler_t::execute(readFrame(21, 3), communicator));
+    EXPECT_TRUE(handler_t::execute(readFrame(21, 3), communicator));
+    EXPECT_TRUE(handler_t::execute(readFrame(22, 3), communicator));
+
+    EXPECT_EQ(read_executions, 2U);
+    ASSERT_EQ(communicator.responses.size(), 9U);
+    for (std::size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(communicator.responses[i].index, i % 3);
+        EXPECT_EQ(communicator.responses[i].value, 42);
+    }
+    EXPECT_EQ(communicator.responses[6].value, 44);
+    const ResponseCacheStats stats = default_cache.stats();
+    EXPECT_EQ(stats.hits, 1U);
+    EXPECT_EQ(stats.misses, 2U);
+    EXPECT_EQ(stats.stores, 2U);
+    default_cache.clear();
+}
+
+TEST_F(ResponseCacheTest, AlwaysExecutesOtherCommands) {
+    using handler_t = MemoizingHandler<CachedBaseHandler, default_cache>;
+    const RecordingCommunicator<CachedResponse> communicator;
+    EXPECT_TRUE(handler_t::execute(writeFrame(1), communicator));
+    EXPECT_TRUE(handler_t::execute(writeFrame(1), communicator));
+
+    EXPECT_EQ(write_executions, 2U);
+    EXPECT_EQ(communicator.responses.size(), 2U);
+    default_cache.clear();
+}
+
+TEST_F(ResponseCacheTest, DoesNotCacheFailures) {
+    using handler_t = MemoizingHandler<CachedBaseHandler, default_cache>;
+    const RecordingCommunicator<CachedResponse> communicator;
+    serialized_message_t truncated = readFrame(1);
+    truncated.pop_back();
+    const ResponseCacheStats before = default_cache.stats();
+    for (int i = 0; i < 2; ++i) {
+        const auto result = handler_t::execute(truncated, communicator);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+    }
+    EXPECT_EQ(default_cache.stats().stores, before.stores);
+}
+
+TEST_F(ResponseCacheTest, DoesNotCacheResponsesLargerThanAnEntry) {
+    using handler_t = MemoizingHandler<CachedBaseHandler, default_cache>;
+    const RecordingCommunicator<CachedResponse> communicator;
+    // Six responses of 4 bytes, each with its 2-byte length, exceed the 32 bytes of an entry
+    EXPECT_TRUE(handler_t::execute(readFrame(5, 6), communicator));
+    EXPECT_TRUE(handler_t::execute(readFrame(5, 6), communicator));
+
+    EXPECT_EQ(read_executions, 2U);
+    EXPECT_EQ(communicator.responses.size(), 12U);
+    EXPECT_GE(default_cache.stats().uncacheable, 2U);
+    default_cache.clear();
+}
+
+TEST_F(ResponseCacheTest, ExpiresEntriesAfterTheirTtl) {
+    using handler_t = MemoizingHandler<CachedBaseHandler, expiring_cache>;
+    const RecordingCommunicator<CachedResponse> communicator;
+    EXPECT_TRUE(handler_t::execute(readFrame(9), communicator));
+    EXPECT_TRUE(handler_t::execute(readFrame(9), communicator));
+    EXPECT_EQ(read_executions, 1U);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_TRUE(handler_t::execute(readFrame(9), communicator));
+    EXPECT_EQ(read_executions, 2U);
+}
+
+TEST_F(ResponseCacheTest, InvalidatesEntries) {
+    using handler_t = MemoizingHandler<CachedBaseHandler, default_cache>;
+    const RecordingCommunicator<CachedResponse> communicator;
+    for (std::uint16_t arg = 0; arg < 3; ++arg) {
+        EXPECT_TRUE(handler_t::execute(readFrame(arg), communicator));
+    }
+    default_cache.invalidate(readFrame(0));
+    EXPECT_EQ(default_cache.invalidateIf([](const serialized_message_view_t frame) { return frame[2] == 1; }), 1U);
+    for (std::uint16_t arg = 0; arg < 3; ++arg) {
+        EXPECT_TRUE(handler_t::execute(readFrame(arg), communicator));
+    }
+    EXPECT_EQ(read_executions, 5U); // only arg 2 was still cached
+
+    default_cache.clear();
+    EXPECT_TRUE(handler_t::execute(readFrame(2), communicator));
+    EXPECT_EQ(read_executions, 6U);
+    default_cache.clear();
+}
+
+TEST_F(ResponseCacheTest, EvictsTheOldestEntryOfAFullWindow) {
+    using handler_t = MemoizingHandler<CachedBaseHandler, tiny_cache>;
+    const RecordingCommunicator<CachedResponse> communicator;
+    for (std::uint16_t arg = 0; arg < 5; ++arg) {
+        EXPECT_TRUE(handler_t::execute(readFrame(arg), communicator));
+    }
+    EXPECT_EQ(tiny_cache.stats().evictions, 1U);
+
+    EXPECT_TRUE(handler_t::execute(readFrame(4), communicator));
+    EXPECT_EQ(read_executions, 5U);
+    EXPECT_TRUE(handler_t::execute(readFrame(0), communicator)); // evicted first, as the oldest
+    EXPECT_EQ(read_executions, 6U);
+}
+
+TEST_F(ResponseCacheTest, ServesConcurrentThreads) {
+    using handler_t = MemoizingHandler<CachedBaseHandler, shared_cache>;
+    const RecordingCommunicator<CachedResponse> communicator;
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([&communicator] {
+            for (int round = 0; round < 1000; ++round) {
+                EXPECT_TRUE(handler_t::execute(readFrame(static_cast<std::uint16_t>(round % 50)), communicator));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(communicator.responses.size(), 4000U);
+    EXPECT_LE(read_executions, 200U); // each frame executed at most once per thread racing on its first miss
+    for (const CachedResponse& response : communicator.responses) {
+        EXPECT_EQ(response.value % 2, 0);
+    }
+    const ResponseCacheStats stats = shared_cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 4000U);
+}
@@ -0,0 +1,152 @@
+#include "result.h"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+struct SmallError
+{
+    std::uint8_t code;
+};
+
+struct LargeError
+{
+    std::array<std::uint8_t, 64> bytes;
+};
+
+/* Value whose copies, and moves unless NothrowMove, throw while failing is set */
+template <bool NothrowMove> struct FragileValue
+{
+    static inline bool failing = false;
+    int v;
+
+    explicit FragileValue(const int value) : v(value) {}
+    FragileValue(const FragileValue& other) : v(other.v) { fail(); }
+    FragileValue(FragileValue&& other) noexcept(NothrowMove) : v(other.v) {
+        if constexpr (!NothrowMove) {
+            fail();
+        }
+    }
+    FragileValue& operator=(const FragileValue&) = default;
+    FragileValue& operator=(FragileValue&&) = default;
+    ~FragileValue() = default;
+
+    static void fail() {
+        if (failing) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+};
+
+using int_result_t = Result<int, SmallError>;
+using void_result_t = Result<void, LargeError>;
+using owning_result_t = Result<std::unique_ptr<int>, std::string>;
+
+/* ―――――――――――――――― Layout ―――――――――――――――― */
+
+static_assert(sizeof(int_result_t) <= 2 * sizeof(int), "One discriminant next to the largest alternative");
+static_assert(sizeof(void_result_t) <= sizeof(LargeError) + alignof(LargeError));
+static_assert(std::is_trivially_copyable_v<int_result_t>);
+static_assert(std::is_trivially_copyable_v<void_result_t>);
+static_assert(!std::is_copy_constructible_v<owning_result_t>);
+static_assert(std::is_nothrow_move_constructible_v<owning_result_t>);
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(Result, HoldsValueOrError) {
+    const int_result_t value(EXPECT, 7);
+    ASSERT_TRUE(value);
+    EXPECT_EQ(value.value(), 7);
+
+    const int_result_t error(UNEXPECT, SmallError{.code = 3});
+    ASSERT_FALSE(error);
+    EXPECT_EQ(error.error().code, 3);
+
+    const void_result_t success;
+    EXPECT_TRUE(success.ok());
+}
+
+TEST(Result, MovesNonCopyableValues) {
+    owning_result_t result(EXPECT, std::make_unique<int>(5));
+    owning_result_t moved = std::move(result);
+    ASSERT_TRUE(moved);
+    EXPECT_EQ(*moved.value(), 5);
+
+    const std::unique_ptr<int> extracted = std::move(moved).value();
+    EXPECT_EQ(*extracted, 5);
+}
+
+TEST(Result, AssignsAcrossAlternatives) {
+    Result<std::string, std::string> result(EXPECT, "value");
+    result = Result<std::string, std::string>(UNEXPECT, "error");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), "error");
+
+    const Result<std::string, std::string> value(EXPECT, "again");
+    result = value;
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value(), "again");
+
+    void_result_t status(UNEXPECT, LargeError{});
+    status = void_result_t();
+    EXPECT_TRUE(status);
+}
+
+template <typename Value> void expectKeepsErrorWhenAssignmentThrows() {
+    using result_t = Result<Value, std::string>;
+    result_t result(UNEXPECT, "error");
+    const result_t value(EXPECT, Value(1));
+
+    Value::failing = true;
+    EXPECT_THROW(result = value, std::runtime_error);
+    Value::failing = false;
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), "error");
+
+    result = value;
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value().v, 1);
+}
+
+TEST(Result, KeepsTheOldAlternativeWhenAssignmentThrows) {
+    expectKeepsErrorWhenAssignmentThrows<FragileValue<true>>();  // constructed aside, then moved in
+    expectKeepsErrorWhenAssignmentThrows<FragileValue<false>>(); // the error is saved and restored
+}
+
+TEST(Result, AndThenChainsOrShortCircuits) {
+    const auto half = [](const int v) {
+        return v % 2 == 0 ? int_result_t(EXPECT, v / 2) : int_result_t(UNEXPECT, SmallError{.code = 1});
+    };
+    EXPECT_EQ(int_result_t(EXPECT, 8).and_then(half).and_then(half).value(), 2);
+    EXPECT_EQ(int_result_t(EXPECT, 6).and_then(half).and_then(half).error().code, 1);
+    EXPECT_EQ(int_result_t(UNEXPECT, SmallError{.code = 9}).and_then(half).error().code, 9);
+
+    bool called = false;
+    const Result<void, SmallError> done = Result<void, SmallError>().and_then([&] {
+        called = true;
+        return Result<void, SmallError>(UNEXPECT, SmallError{.code = 4});
+    });
+    EXPECT_TRUE(called);
+    EXPECT_EQ(done.error().code, 4);
+}
+
+TEST(Result, TransformMapsValueAndError) {
+    const Result<std::string, SmallError> text =
+        int_result_t(EXPECT, 42).transform([](const int v) { return std::to_string(v); });
+    EXPECT_EQ(text.value(), "42");
+
+    const Result<int, std::string> described = int_result_t(UNEXPECT, SmallError{.code = 2}).transform_error(
+        [](const SmallError e) { return "code " + std::to_string(e.code); }
+    );
+    EXPECT_EQ(described.error(), "code 2");
+
+    int seen = 0;
+    const Result<void, SmallError> consumed = int_result_t(EXPECT, 3).transform([&](const int v) { seen = v; });
+    EXPECT_TRUE(consumed);
+    EXPECT_EQ(seen, 3);
+}
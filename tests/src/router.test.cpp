@@ -0,0 +1,183 @@
+#include "router.h"
+#include "command.h"
+#include "concurrent_listener.h"
+#include "handler.h"
+#include "message.h"
+#include "test_communicators.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+struct RoutedFormat
+{
+    static constexpr std::uint8_t ID = 0x51; // shared by the command of every device
+    std::uint8_t id;
+    std::uint8_t reserved;
+    std::uint16_t value;
+};
+static_assert(MessageFormatT<RoutedFormat>);
+
+struct RoutedResponse
+{
+    static constexpr std::uint8_t ID = 0xD1;
+    std::uint8_t id;
+    std::uint8_t device;
+    std::uint16_t value;
+};
+static_assert(MessageFormatT<RoutedResponse>);
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+template <std::uint8_t Device> class RoutedCommand final : public Command<RoutedFormat>
+{
+  public:
+    explicit RoutedCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::array<std::uint8_t, sizeof(RoutedResponse)> buffer{};
+        communicator.respondView(
+            SentMessage<RoutedResponse>({.id = RoutedResponse::ID, .device = Device, .value = content().value})
+                .serializeInto(buffer)
+        );
+    }
+};
+
+using MotorHandler = Handler<RoutedCommand<1>>;
+using SensorHandler = Handler<RoutedCommand<2>>;
+using DeviceRouter = Router<Route<0x10, MotorHandler>, Route<0x20, SensorHandler>>;
+using GatewayRouter = Router<Route<0x01, DeviceRouter>, Route<0x02, Handler<RoutedCommand<3>>>>;
+
+static_assert(RoutableHandlerT<MotorHandler>);
+static_assert(RoutableHandlerT<DeviceRouter>);
+static_assert(DeviceRouter::SHARD_COUNT == 2);
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+/**
+ * @brief Source delivering pre-built frames, then closing
+ */
+class RoutedFrameSource final : public FrameSource
+{
+    std::vector<std::vector<std::uint8_t>> _frames;
+    std::size_t _next = 0;
+
+  public:
+    explicit RoutedFrameSource(std::vector<std::vector<std::uint8_t>> frames) : _frames(std::move(frames)) {}
+
+    bool receive(const frame_callback_t on_frame) override {
+        if (_next < _frames.size()) {
+            on_frame(_frames[_next++]);
+        }
+        return _next < _frames.size();
+    }
+};
+
+/**
+ * @brief Builds a routed frame: the addresses, then a RoutedFormat command
+ */
+static std::vector<std::uint8_t> routedFrame(const std::vector<std::uint8_t>& addresses, const std::uint16_t value) {
+    std::vector<std::uint8_t> frame = addresses;
+    const serialized_message_t command =
+        SentMessage<RoutedFormat>({.id = RoutedFormat::ID, .reserved = 0, .value = value}).serialize();
+    frame.insert(frame.end(), command.begin(), command.end());
+    return frame;
+}
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(Router, DispatchesOnTheAddressByte) {
+    const RecordingCommunicator<RoutedResponse> communicator;
+    EXPECT_TRUE(DeviceRouter::execute(routedFrame({0x10}, 7), communicator));
+    EXPECT_TRUE(DeviceRouter::execute(routedFrame({0x20}, 8), communicator));
+
+    ASSERT_EQ(communicator.responses.size(), 2U);
+    EXPECT_EQ(communicator.responses[0].device, 1);
+    EXPECT_EQ(communicator.responses[0].value, 7);
+    EXPECT_EQ(communicator.responses[1].device, 2);
+    EXPECT_EQ(communicator.responses[1].value, 8);
+}
+
+TEST(Router, RejectsUnknownAddresses) {
+    const RecordingCommunicator<RoutedResponse> communicator;
+    const auto result = DeviceRouter::execute(routedFrame({0x30}, 1), communicator);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, HANDLER_EXECUTE_STATUS::ERROR_ROUTE_NOT_FOUND);
+    EXPECT_EQ(result.error().describe(), "Unknown route: 48");
+    EXPECT_TRUE(communicator.responses.empty());
+}
+
+TEST(Router, RejectsEmptyFramesAndMissingCommands) {
+    const RecordingCommunicator<RoutedResponse> communicator;
+    const auto empty = DeviceRouter::execute(std::vector<std::uint8_t>{}, communicator);
+    ASSERT_FALSE(empty);
+    EXPECT_EQ(empty.error().code, HANDLER_EXECUTE_STATUS::ERROR_EMPTY_MESSAGE);
+
+    const auto address_only = DeviceRouter::execute(std::vector<std::uint8_t>{0x10}, communicator);
+    ASSERT_FALSE(address_only);
+    EXPECT_EQ(address_only.error().code, HANDLER_EXECUTE_STATUS::ERROR_EMPTY_MESSAGE);
+}
+
+TEST(Router, PassesHandlerErrorsThrough) {
+    const RecordingCommunicator<RoutedResponse> communicator;
+    std::vector<std::uint8_t> truncated = routedFrame({0x10}, 1);
+    truncated.pop_back();
+    const auto length = DeviceRouter::execute(truncated, communicator);
+    ASSERT_FALSE(length);
+    EXPECT_EQ(length.error().code, HANDLER_EXECUTE_STATUS::ERROR_MESSAGE_LENGTH_ERROR);
+
+    const auto unknown = DeviceRouter::execute(std::vector<std::uint8_t>{0x20, 0x7F}, communicator);
+    ASSERT_FALSE(unknown);
+    EXPECT_EQ(unknown.error().code, HANDLER_EXECUTE_STATUS::ERROR_ID_NOT_FOUND);
+    EXPECT_EQ(unknown.error().id, 0x7F);
+}
+
+TEST(Router, NestsRouters) {
+    const RecordingCommunicator<RoutedResponse> communicator;
+    EXPECT_TRUE(GatewayRouter::execute(routedFrame({0x01, 0x20}, 5), communicator));
+    EXPECT_TRUE(GatewayRouter::execute<HANDLER_DISPATCH_MODE::FOLD>(routedFrame({0x02}, 6), communicator));
+    EXPECT_FALSE(GatewayRouter::execute(routedFrame({0x01, 0x02}, 7), communicator));
+
+    ASSERT_EQ(communicator.responses.size(), 2U);
+    EXPECT_EQ(communicator.responses[0].device, 2);
+    EXPECT_EQ(communicator.responses[1].device, 3);
+}
+
+TEST(Router, MapsFramesToShards) {
+    EXPECT_EQ(DeviceRouter::shardOf(routedFrame({0x10}, 0)), 0U);
+    EXPECT_EQ(DeviceRouter::shardOf(routedFrame({0x20}, 0)), 1U);
+    EXPECT_EQ(DeviceRouter::shardOf(routedFrame({0x30}, 0)), DeviceRouter::SHARD_COUNT);
+    EXPECT_EQ(DeviceRouter::shardOf(std::vector<std::uint8_t>{}), DeviceRouter::SHARD_COUNT);
+}
+
+TEST(Router, GivesEachShardItsOwnListenerWorker) {
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (std::uint16_t value = 0; value < 500; ++value) {
+        frames.push_back(routedFrame({0x10}, value));
+        frames.push_back(routedFrame({0x20}, value));
+    }
+    RoutedFrameSource source(std::move(frames));
+    const RecordingCommunicator<RoutedResponse> communicator;
+    ConcurrentListener<DeviceRouter, 16, 8> listener(
+        source, communicator, {.workers = DeviceRouter::SHARD_COUNT, .affinity = WORKER_AFFINITY::SHARD}
+    );
+    listener.start();
+
+    EXPECT_EQ(listener.stats().executed, 1000U);
+    std::map<std::uint8_t, std::set<std::thread::id>> threads = communicator.threadsBy(&RoutedResponse::device);
+    ASSERT_EQ(threads.size(), 2U);
+    EXPECT_EQ(threads[1].size(), 1U);
+    EXPECT_EQ(threads[2].size(), 1U);
+    EXPECT_NE(*threads[1].begin(), *threads[2].begin());
+    std::map<std::uint8_t, std::uint16_t> next_value;
+    for (const RoutedResponse& response : communicator.responses) {
+        EXPECT_EQ(response.value, next_value[response.device]++) << "device " << int(response.device);
+    }
+}
@@ -0,0 +1,294 @@
+#include "shm_transport.h"
+#include "command.h"
+#include "handler.h"
+#include "message.h"
+#include "test_communicators.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+struct ShmEchoFormat
+{
+    static constexpr std::uint8_t ID = 0x41;
+    std::uint8_t id;
+    std::uint8_t count; // number of responses
+    std::uint16_t value;
+};
+static_assert(MessageFormatT<ShmEchoFormat>);
+
+struct ShmEchoResponse
+{
+    static constexpr std::uint8_t ID = 0xC1;
+    std::uint8_t id;
+    std::uint8_t index;
+    std::uint16_t value;
+};
+static_assert(MessageFormatT<ShmEchoResponse>);
+
+struct ShmSleepFormat
+{
+    static constexpr std::uint8_t ID = 0x42;
+    std::uint8_t id;
+    std::uint8_t reserved;
+    std::uint16_t milliseconds;
+};
+static_assert(MessageFormatT<ShmSleepFormat>);
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+class ShmEchoCommand final : public Command<ShmEchoFormat>
+{
+  public:
+    explicit ShmEchoCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::array<std::uint8_t, sizeof(ShmEchoResponse)> buffer{};
+        for (std::uint8_t index = 0; index < content().count; ++index) {
+            communicator.respondView(
+                SentMessage<ShmEchoResponse>({.id = ShmEchoResponse::ID, .index = index, .value = content().value})
+                    .serializeInto(buffer)
+            );
+        }
+    }
+};
+
+class ShmSleepCommand final : public Command<ShmSleepFormat>
+{
+  public:
+    explicit ShmSleepCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(content().milliseconds));
+        std::array<std::uint8_t, sizeof(ShmEchoResponse)> buffer{};
+        communicator.respondView(
+            SentMessage<ShmEchoResponse>({.id = ShmEchoResponse::ID, .index = 0, .value = content().milliseconds})
+                .serializeInto(buffer)
+        );
+    }
+};
+
+using ShmHandler = Handler<ShmEchoCommand, ShmSleepCommand>;
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+static std::string segmentName(const char* test) {
+    return "/libcmd-test-" + std::to_string(::getpid()) + "-" + test;
+}
+
+static serialized_message_t echoRequest(const std::uint8_t count, const std::uint16_t value) {
+    return SentMessage<ShmEchoFormat>({.id = ShmEchoFormat::ID, .count = count, .value = value}).serialize();
+}
+
+/**
+ * @brief Sends a request through the client and keeps the values of its responses
+ */
+static Communicator::REQUEST_STATUS
+collect(const Communicator& client, const serialized_message_view_t request, std::vector<std::uint16_t>& values) {
+    return client.requestView(request, [&values](const std::span<const std::uint8_t> response) {
+        values.push_back(ReceivedMessage<ShmEchoResponse>(response).content().value);
+    });
+}
+
+/**
+ * @brief Segment served by a ShmListener on its own thread
+ */
+struct ShmServer
+{
+    ShmSegment<> segment;
+    ShmListener<ShmHandler> listener{segment.channel()};
+    std::thread loop{[this] { listener.start(); }};
+
+    explicit ShmServer(const char* test) : segment(ShmSegment<>::create(segmentName(test))) {}
+    ShmServer(const ShmServer&) = delete;
+    ShmServer& operator=(const ShmServer&) = delete;
+    ~ShmServer() {
+        listener.stop();
+        loop.join();
+    }
+};
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(ShmTransport, RoundTripsThroughAnOpenedSegment) {
+    const ShmServer server("round-trip");
+    const ShmSegment<> segment = ShmSegment<>::open(segmentName("round-trip"));
+    const DiscardingCommunicator upstream;
+    const ShmClient client(segment.channel(), upstream);
+
+    for (std::uint16_t value = 0; value < 1000; ++value) {
+        std::vector<std::uint16_t> values;
+        ASSERT_EQ(collect(client, echoRequest(1, value), values), Communicator::REQUEST_STATUS::SUCCESS);
+        ASSERT_EQ(values, std::vector<std::uint16_t>{value});
+    }
+}
+
+TEST(ShmTransport, DeliversEveryResponseOfARequest) {
+    const ShmServer server("responses");
+    const DiscardingCommunicator upstream;
+    const ShmClient client(server.segment.channel(), upstream);
+
+    std::vector<std::uint16_t> values;
+    EXPECT_EQ(collect(client, echoRequest(200, 7), values), Communicator::REQUEST_STATUS::SUCCESS);
+    EXPECT_EQ(values, std::vector<std::uint16_t>(200, 7));
+}
+
+TEST(ShmTransport, ReportsHandlerErrors) {
+    const ShmServer server("errors");
+    const DiscardingCommunicator upstream;
+    const ShmClient client(server.segment.channel(), upstream);
+
+    const std::array<std::uint8_t, 4> unknown{0x7F, 0, 0, 0};
+    std::vector<std::uint16_t> values;
+    EXPECT_EQ(collect(client, unknown, values), Communicator::REQUEST_STATUS::ERROR_UNKNOWN);
+    EXPECT_TRUE(values.empty());
+}
+
+TEST(ShmTransport, RejectsRequestsLargerThanTheRing) {
+    const ShmServer server("oversized");
+    const DiscardingCommunicator upstream;
+    const ShmClient client(server.segment.channel(), upstream);
+
+    const std::vector<std::uint8_t> oversized(ShmChannel<>::MAX_FRAME + 1, ShmEchoFormat::ID);
+    std::vector<std::uint16_t> values;
+    EXPECT_EQ(collect(client, oversized, values), Communicator::REQUEST_STATUS::ERROR_COMMUNICATION);
+}
+
+TEST(ShmTransport, TimesOutThenSkipsTheLateResponses) {
+    const ShmServer server("timeout");
+    const DiscardingCommunicator upstream;
+    const ShmClient client(server.segment.channel(), upstream, std::chrono::milliseconds(20));
+
+    const serialized_message_t slow =
+        SentMessage<ShmSleepFormat>({.id = ShmSleepFormat::ID, .reserved = 0, .milliseconds = 200}).serialize();
+    std::vector<std::uint16_t> values;
+    EXPECT_EQ(collect(client, slow, values), Communicator::REQUEST_STATUS::ERROR_TIMEOUT);
+    EXPECT_TRUE(values.empty());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    EXPECT_EQ(collect(client, echoRequest(1, 3), values), Communicator::REQUEST_STATUS::SUCCESS);
+    EXPECT_EQ(values, std::vector<std::uint16_t>{3});
+}
+
+TEST(ShmTransport, ForwardsRespondUpstream) {
+    const ShmServer server("upstream");
+    const DiscardingCommunicator upstream;
+    const ShmClient client(server.segment.channel(), upstream);
+
+    client.respond(echoRequest(1, 1));
+    EXPECT_EQ(upstream.responses(), 1U);
+}
+
+TEST(ShmTransport, StopsAnIdleListener) {
+    auto segment = ShmSegment<>::create(segmentName("stop"));
+    ShmListener<ShmHandler> listener(segment.channel());
+    std::thread loop([&listener] { listener.start(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // let it fall asleep on the futex
+    listener.stop();
+    loop.join();
+}
+
+TEST(ShmTransport, OpenRejectsMissingAndMismatchedSegments) {
+    EXPECT_THROW(ShmSegment<>::open(segmentName("missing")), std::system_error);
+    const auto small = ShmSegment<ShmChannel<4096>>::create(segmentName("small"));
+    EXPECT_THROW(ShmSegment<>::open(segmentName("small")), std::system_error);
+    EXPECT_THROW(ShmSegment<ShmChannel<4096>>::create(segmentName("small")), std::system_error);
+}
+
+TEST(ShmTransport, RingWrapsRecordsAroundTheEnd) {
+    auto ring = std::make_unique<shm_helpers::FrameRing<256>>();
+    std::vector<std::uint8_t> body;
+    for (std::uint16_t round = 0; round < 500; ++round) {
+        body.assign(round % (shm_helpers::FrameRing<256>::MAX_BODY + 1), static_cast<std::uint8_t>(round));
+        ASSERT_TRUE(ring->tryPush(shm_helpers::RECORD_KIND::RESPONSE, round, body));
+        ASSERT_TRUE(ring->tryPop([&](const shm_helpers::RecordHeader& header, const serialized_message_view_t got) {
+            EXPECT_EQ(header.kind, shm_helpers::RECORD_KIND::RESPONSE);
+            EXPECT_EQ(header.sequence, round);
+            EXPECT_TRUE(std::ranges::equal(got, body));
+        }));
+        ASSERT_FALSE(ring->readable());
+    }
+}
+
+TEST(ShmTransport, RingRefusesRecordsUntilSpaceIsFreed) {
+    auto ring = std::make_unique<shm_helpers::FrameRing<256>>();
+    const std::vector<std::uint8_t> body(56, 1);
+    std::size_t pushed = 0;
+    while (ring->tryPush(shm_helpers::RECORD_KIND::REQUEST, 0, body)) {
+        ++pushed;
+    }
+    EXPECT_EQ(pushed, 4U);
+    EXPECT_TRUE(ring->tryPop([](const shm_helpers::RecordHeader&, serialized_message_view_t) {}));
+    EXPECT_TRUE(ring->tryPush(shm_helpers::RECORD_KIND::REQUEST, 0, body));
+}
+
+TEST(ShmTransport, RingDiscardsCorruptRecords) {
+    using ring_t = shm_helpers::FrameRing<256>;
+    auto ring = std::make_unique<ring_t>();
+    const std::vector<std::uint8_t> body(8, 1);
+    const auto corrupt = [&ring](const std::uint64_t position, const shm_helpers::RecordHeader& header) {
+        ring->writeHeader(position, header);
+        return ring->tryPop([](const shm_helpers::RecordHeader&, serialized_message_view_t) {
+            ADD_FAILURE() << "corrupt record handed to the consumer";
+        });
+    };
+
+    ASSERT_TRUE(ring->tryPush(shm_helpers::RECORD_KIND::RESPONSE, 1, body));
+    constexpr auto too_large = static_cast<std::uint32_t>(ring_t::MAX_BODY + 1);
+    constexpr auto response = shm_helpers::RECORD_KIND::RESPONSE;
+    EXPECT_FALSE(corrupt(ring->head.load(), {.size = too_large, .sequence = 1, .kind = response}));
+    EXPECT_FALSE(ring->readable());
+
+    ASSERT_TRUE(ring->tryPush(shm_helpers::RECORD_KIND::RESPONSE, 2, body));
+    EXPECT_FALSE(corrupt(ring->head.load(), {.size = 64, .sequence = 2, .kind = response}));
+    EXPECT_FALSE(ring->readable());
+
+    ASSERT_TRUE(ring->tryPush(shm_helpers::RECORD_KIND::RESPONSE, 3, body));
+    EXPECT_FALSE(corrupt(ring->head.load(), {.size = 0, .sequence = 0, .kind = shm_helpers::RECORD_KIND::WRAP}));
+    EXPECT_FALSE(ring->readable());
+
+    // Still usable afterwards
+    ASSERT_TRUE(ring->tryPush(shm_helpers::RECORD_KIND::RESPONSE, 4, body));
+    EXPECT_TRUE(ring->tryPop([&body](const shm_helpers::RecordHeader& header, const serialized_message_view_t got) {
+        EXPECT_EQ(header.sequence, 4);
+        EXPECT_TRUE(std::ranges::equal(got, body));
+    }));
+}
+
+TEST(ShmTransport, ServesAClientInAnotherProcess) {
+    const ShmServer server("fork");
+    const std::string name = segmentName("fork"); // before fork(): the name holds the pid of this process
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // Only the forking thread exists here: no gtest assertions, the exit code is the verdict
+        const ShmSegment<> segment = ShmSegment<>::open(name);
+        const DiscardingCommunicator upstream;
+        const ShmClient client(segment.channel(), upstream);
+        for (std::uint16_t value = 0; value < 10000; ++value) {
+            std::vector<std::uint16_t> values;
+            if (collect(client, echoRequest(2, value), values) != Communicator::REQUEST_STATUS::SUCCESS
+                || values != std::vector<std::uint16_t>{value, value}) {
+                ::_exit(1);
+            }
+        }
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
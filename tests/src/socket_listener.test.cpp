@@ -0,0 +1,341 @@
+#include "socket_listener.h"
+#include "command.h"
+#include "framer.h"
+#include "handler.h"
+#include "message.h"
+#include "uring_listener.h"
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+struct SocketEchoFormat
+{
+    static constexpr std::uint8_t ID = 0x31;
+    std::uint8_t id;
+    std::uint8_t zero; // keeps a 0x00 in every frame, exercising COBS
+    std::uint16_t sequence;
+};
+static_assert(MessageFormatT<SocketEchoFormat>);
+
+struct SocketEchoResponse
+{
+    static constexpr std::uint8_t ID = 0xB1;
+    std::uint8_t id;
+    std::uint8_t zero;
+    std::uint16_t sequence;
+};
+static_assert(MessageFormatT<SocketEchoResponse>);
+
+/* ―――――――――――――――― Commands ―――――――――――――――― */
+
+class SocketEchoCommand final : public Command<SocketEchoFormat>
+{
+  public:
+    explicit SocketEchoCommand(const serialized_message_view_t content) : Command(content) {}
+
+    void execute(const Communicator& communicator) const override {
+        std::array<std::uint8_t, sizeof(SocketEchoResponse)> buffer{};
+        communicator.respondView(
+            SentMessage<SocketEchoResponse>({.id = SocketEchoResponse::ID, .zero = 0, .sequence = content().sequence})
+                .serializeInto(buffer)
+        );
+    }
+};
+
+using SocketEchoHandler = Handler<SocketEchoCommand>;
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+static serialized_message_t echoFrame(const std::uint16_t sequence) {
+    return SentMessage<SocketEchoFormat>({.id = SocketEchoFormat::ID, .zero = 0, .sequence = sequence}).serialize();
+}
+
+/**
+ * @brief Listening TCP socket on a free loopback port
+ */
+struct LoopbackServer
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    std::uint16_t port = 0;
+
+    LoopbackServer() {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        EXPECT_EQ(::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+        EXPECT_EQ(::listen(fd, 1024), 0);
+        EXPECT_EQ(::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length), 0);
+        port = ntohs(address.sin_port);
+    }
+    LoopbackServer(const LoopbackServer&) = delete;
+    LoopbackServer& operator=(const LoopbackServer&) = delete;
+    ~LoopbackServer() { ::close(fd); }
+};
+
+/**
+ * @brief Blocking client connection exchanging COBS frames
+ */
+class Client
+{
+    int _fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    CobsFramer<64> _framer;
+    std::vector<std::vector<std::uint8_t>> _frames;
+
+  public:
+    explicit Client(const std::uint16_t port) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        EXPECT_EQ(::connect(_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+        const timeval timeout{.tv_sec = 5, .tv_usec = 0};
+        ::setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+    ~Client() { ::close(_fd); }
+
+    /** @brief Sends the echo frames of sequence numbers [first, first + count) in one write */
+    void sendEchoes(const std::uint16_t first, const std::uint16_t count) const {
+        std::vector<std::uint8_t> stream;
+        for (std::uint16_t sequence = first; sequence < first + count; ++sequence) {
+            const serialized_message_t frame = echoFrame(sequence);
+            std::array<std::uint8_t, cobsEncodedSize(sizeof(SocketEchoFormat))> encoded{};
+            const serialized_message_view_t bytes = cobsEncode(frame, encoded);
+            stream.insert(stream.end(), bytes.begin(), bytes.end());
+        }
+        sendRaw(stream);
+    }
+
+    void sendRaw(const std::vector<std::uint8_t>& bytes) const {
+        for (std::size_t sent = 0; sent < bytes.size();) {
+            const ssize_t written = ::send(_fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            ASSERT_GT(written, 0);
+            sent += static_cast<std::size_t>(written);
+        }
+    }
+
+    /** @brief recv() retried on EINTR, which io_uring task work can cause on other threads */
+    ssize_t receive(const std::span<std::uint8_t> chunk) const {
+        ssize_t got = 0;
+        do {
+            got = ::recv(_fd, chunk.data(), chunk.size(), 0);
+        } while (got < 0 && errno == EINTR);
+        return got;
+    }
+
+    void shutdownWrite() const { ::shutdown(_fd, SHUT_WR); }
+
+    /**
+     * @brief Reads until count frames arrived or the connection closed
+     * @return std::vector<std::uint16_t> The sequence numbers of the responses received
+     */
+    std::vector<std::uint16_t> receiveEchoes(const std::size_t count) {
+        std::array<std::uint8_t, 4096> chunk{};
+        while (_frames.size() < count) {
+            const ssize_t got = receive(chunk);
+            if (got <= 0) {
+                break;
+            }
+            const auto on_frame = [this](const serialized_message_view_t frame) {
+                _frames.emplace_back(frame.begin(), frame.end());
+            };
+            _framer.feed(serialized_message_view_t(chunk.data(), static_cast<std::size_t>(got)), on_frame);
+        }
+        std::vector<std::uint16_t> sequences;
+        for (const std::vector<std::uint8_t>& frame : _frames) {
+            sequences.push_back(ReceivedMessage<SocketEchoResponse>(frame).content().sequence);
+        }
+        _frames.clear();
+        return sequences;
+    }
+
+    /** @brief Whether the server closed the connection (reads 0 bytes) */
+    [[nodiscard]] bool closedByServer() const {
+        std::array<std::uint8_t, 16> chunk{};
+        return receive(chunk) == 0;
+    }
+};
+
+static std::vector<std::uint16_t> sequenceRange(const std::uint16_t first, const std::uint16_t count) {
+    std::vector<std::uint16_t> sequences(count);
+    for (std::uint16_t i = 0; i < count; ++i) {
+        sequences[i] = static_cast<std::uint16_t>(first + i);
+    }
+    return sequences;
+}
+
+/**
+ * @brief Waits until a condition holds, up to a few seconds
+ */
+static bool eventually(const std::function<bool()>& condition) {
+    for (int attempt = 0; attempt < 500; ++attempt) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return condition();
+}
+
+/* ―――――――――――――――― Fixture ―――――――――――――――― */
+
+template <typename ListenerT> class SocketListenerTest : public ::testing::Test
+{
+  protected:
+    LoopbackServer server;
+    std::unique_ptr<SocketListener> listener;
+    std::thread loop;
+
+    void SetUp() override {
+#ifdef LIBCMD_HAS_IO_URING
+        if constexpr (std::is_same_v<ListenerT, UringListener<SocketEchoHandler>>) {
+            if (!ListenerT::supported()) {
+                GTEST_SKIP() << "io_uring is not available";
+            }
+        }
+#endif
+    }
+
+    void run(const SocketListenerConfig config = {}) {
+        listener = std::make_unique<ListenerT>(server.fd, config);
+        loop = std::thread([this] { listener->start(); });
+    }
+
+    void TearDown() override {
+        if (loop.joinable()) {
+            listener->stop();
+            loop.join();
+        }
+    }
+};
+
+#ifdef LIBCMD_HAS_IO_URING
+using socket_listeners_t = ::testing::Types<EpollListener<SocketEchoHandler>, UringListener<SocketEchoHandler>>;
+#else
+using socket_listeners_t = ::testing::Types<EpollListener<SocketEchoHandler>>;
+#endif
+TYPED_TEST_SUITE(SocketListenerTest, socket_listeners_t);
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TYPED_TEST(SocketListenerTest, AnswersEveryFrameInOrder) {
+    this->run();
+    Client client(this->server.port);
+    client.sendEchoes(0, 500);
+    EXPECT_EQ(client.receiveEchoes(500), sequenceRange(0, 500));
+    client.sendEchoes(500, 1);
+    EXPECT_EQ(client.receiveEchoes(1), sequenceRange(500, 1));
+
+    const SocketListenerStats stats = this->listener->stats();
+    EXPECT_EQ(stats.accepted, 1);
+    EXPECT_EQ(stats.received, 501);
+    EXPECT_EQ(stats.executed, 501);
+}
+
+TYPED_TEST(SocketListenerTest, WritesABacklogLargerThanTheSocketBuffers) {
+    this->run();
+    Client client(this->server.port);
+    client.sendEchoes(0, 60000); // about 400 KB each way, read only once everything is sent
+    EXPECT_EQ(client.receiveEchoes(60000), sequenceRange(0, 60000));
+}
+
+TYPED_TEST(SocketListenerTest, ServesManyConnectionsFromOneThread) {
+    this->run();
+    std::vector<std::unique_ptr<Client>> clients;
+    for (std::size_t i = 0; i < 300; ++i) {
+        clients.push_back(std::make_unique<Client>(this->server.port));
+    }
+    for (std::size_t i = 0; i < clients.size(); ++i) {
+        clients[i]->sendEchoes(static_cast<std::uint16_t>(i * 4), 4);
+    }
+    for (std::size_t i = 0; i < clients.size(); ++i) {
+        EXPECT_EQ(clients[i]->receiveEchoes(4), sequenceRange(static_cast<std::uint16_t>(i * 4), 4));
+    }
+    EXPECT_EQ(this->listener->stats().accepted, clients.size());
+    EXPECT_EQ(this->listener->stats().executed, clients.size() * 4);
+}
+
+TYPED_TEST(SocketListenerTest, AnswersAHalfClosedClientThenClosesIt) {
+    this->run();
+    Client client(this->server.port);
+    client.sendEchoes(7, 3);
+    client.shutdownWrite();
+    EXPECT_EQ(client.receiveEchoes(3), sequenceRange(7, 3));
+    EXPECT_TRUE(client.closedByServer());
+    EXPECT_TRUE(eventually([this] { return this->listener->stats().closed == 1; }));
+}
+
+TYPED_TEST(SocketListenerTest, ReassemblesFramesSplitAcrossWrites) {
+    this->run();
+    Client client(this->server.port);
+    const serialized_message_t frame = echoFrame(42);
+    std::array<std::uint8_t, cobsEncodedSize(sizeof(SocketEchoFormat))> encoded{};
+    for (const std::uint8_t byte : cobsEncode(frame, encoded)) {
+        client.sendRaw({byte});
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(client.receiveEchoes(1), sequenceRange(42, 1));
+}
+
+TYPED_TEST(SocketListenerTest, CountsFramesTheHandlerRejects) {
+    this->run();
+    Client client(this->server.port);
+    client.sendRaw({0x02, 0x7F, 0x00}); // unknown ID
+    client.sendEchoes(1, 1);
+    EXPECT_EQ(client.receiveEchoes(1), sequenceRange(1, 1));
+    EXPECT_EQ(this->listener->stats().failed, 1);
+    EXPECT_EQ(this->listener->stats().executed, 1);
+}
+
+TYPED_TEST(SocketListenerTest, RejectsConnectionsBeyondTheLimit) {
+    this->run({.max_connections = 1});
+    Client first(this->server.port);
+    first.sendEchoes(0, 1);
+    EXPECT_EQ(first.receiveEchoes(1), sequenceRange(0, 1)); // accepted before the second connects
+    const Client second(this->server.port);
+    EXPECT_TRUE(second.closedByServer());
+    EXPECT_TRUE(eventually([this] { return this->listener->stats().rejected == 1; }));
+}
+
+TYPED_TEST(SocketListenerTest, StopClosesEveryConnection) {
+    this->run();
+    Client client(this->server.port);
+    client.sendEchoes(0, 1);
+    EXPECT_EQ(client.receiveEchoes(1), sequenceRange(0, 1));
+    this->listener->stop();
+    this->loop.join();
+    EXPECT_TRUE(client.closedByServer());
+    EXPECT_EQ(this->listener->stats().closed, 1);
+}
+
+TEST(MakeSocketListener, ServesClients) {
+    const LoopbackServer server;
+    const std::unique_ptr<SocketListener> listener = makeSocketListener<SocketEchoHandler>(server.fd);
+    std::thread loop([&listener] { listener->start(); });
+    {
+        Client client(server.port);
+        client.sendEchoes(3, 2);
+        EXPECT_EQ(client.receiveEchoes(2), sequenceRange(3, 2));
+    }
+    listener->stop();
+    loop.join();
+}
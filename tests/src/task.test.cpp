@@ -0,0 +1,155 @@
+#include "task.h"
+#include "communication.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/* ―――――――――――――――― Coroutines ―――――――――――――――― */
+
+static Task<int> answer() { co_return 42; }
+
+static Task<int> twiceAnswer() { co_return 2 * co_await answer(); }
+
+static Task<> throwing() {
+    throw std::runtime_error("boom");
+    co_return;
+}
+
+static Task<std::size_t> countTo(const std::size_t count) {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        total += static_cast<std::size_t>(co_await answer() == 42); // completes synchronously every time
+    }
+    co_return total;
+}
+
+/* ―――――――――――――――― Communicators ―――――――――――――――― */
+
+/**
+ * @brief Blocking communicator answering each request with the request bytes, twice
+ */
+class EchoCommunicator final : public Communicator
+{
+  public:
+    void respond(const std::vector<std::uint8_t>&) const override {}
+
+    REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& message, std::function<void(std::vector<std::uint8_t>)> callback
+    ) const override {
+        callback(message);
+        callback(message);
+        return REQUEST_STATUS::SUCCESS;
+    }
+};
+
+/**
+ * @brief Asynchronous communicator answering from another thread once a whole batch of requests is in flight
+ */
+class DeferredCommunicator final : public Communicator
+{
+    const std::size_t _batch;
+    mutable std::mutex _mutex;
+    mutable std::vector<std::pair<std::vector<std::uint8_t>, RequestCompletion*>> _pending;
+    mutable std::vector<std::thread> _threads;
+
+  public:
+    mutable std::size_t max_in_flight = 0;
+
+    explicit DeferredCommunicator(const std::size_t batch) : _batch(batch) {}
+
+    ~DeferredCommunicator() override {
+        for (std::thread& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    void respond(const std::vector<std::uint8_t>&) const override {}
+
+    REQUEST_STATUS request(const std::vector<std::uint8_t>&, std::function<void(std::vector<std::uint8_t>)>)
+        const override {
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+
+    void startRequest(const std::span<const std::uint8_t> message, RequestCompletion& completion) const override {
+        const std::scoped_lock lock(_mutex);
+        _pending.emplace_back(std::vector<std::uint8_t>(message.begin(), message.end()), &completion);
+        max_in_flight = std::max(max_in_flight, _pending.size());
+        if (_pending.size() == _batch) {
+            _threads.emplace_back([pending = std::move(_pending)] {
+                for (const auto& [request, request_completion] : pending) {
+                    std::vector<std::uint8_t> response = request;
+                    response.push_back(0xAA);
+                    request_completion->deliver(response);
+                    request_completion->complete(REQUEST_STATUS::SUCCESS);
+                }
+            });
+            _pending.clear();
+        }
+    }
+};
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(Task, ProducesValuesThroughNestedAwaits) { EXPECT_EQ(syncWait(twiceAnswer()), 84); }
+
+TEST(Task, PropagatesExceptions) { EXPECT_THROW(syncWait(throwing()), std::runtime_error); }
+
+TEST(Task, RunsLongChainsOfSynchronousAwaits) { EXPECT_EQ(syncWait(countTo(10'000)), 10'000); }
+
+TEST(Task, IsLazy) {
+    bool started = false;
+    auto task = [&]() -> Task<> {
+        started = true;
+        co_return;
+    }();
+    EXPECT_FALSE(started);
+    syncWait(std::move(task));
+    EXPECT_TRUE(started);
+}
+
+TEST(AsyncRequest, DefaultStartRequestCompletesSynchronously) {
+    const EchoCommunicator communicator;
+    const std::vector<std::uint8_t> message{0x01, 0x02};
+    std::vector<std::vector<std::uint8_t>> responses;
+    const auto status = syncWait([&]() -> Task<Communicator::REQUEST_STATUS> {
+        co_return co_await communicator.asyncRequest(message, [&](const std::span<const std::uint8_t> response) {
+            responses.emplace_back(response.begin(), response.end());
+        });
+    }());
+    EXPECT_EQ(status, Communicator::REQUEST_STATUS::SUCCESS);
+    EXPECT_EQ(responses, (std::vector<std::vector<std::uint8_t>>{message, message}));
+}
+
+TEST(AsyncRequest, FanOutKeepsEveryRequestInFlight) {
+    constexpr std::size_t DEVICES = 8;
+    const DeferredCommunicator communicator(DEVICES);
+    std::array<std::vector<std::uint8_t>, DEVICES> responses;
+
+    const auto fan_out = [&]() -> Task<std::size_t> {
+        std::vector<std::unique_ptr<RequestCompletion>> requests;
+        for (std::size_t device = 0; device < DEVICES; ++device) {
+            const std::array<std::uint8_t, 1> message{static_cast<std::uint8_t>(device)};
+            auto on_response = [&responses, device](const std::span<const std::uint8_t> response) {
+                responses[device].assign(response.begin(), response.end());
+            };
+            using request_t = AsyncRequest<decltype(on_response)>;
+            requests.push_back(std::make_unique<request_t>(communicator, message, on_response));
+        }
+        std::size_t succeeded = 0;
+        for (const std::unique_ptr<RequestCompletion>& request : requests) {
+            succeeded += static_cast<std::size_t>(co_await *request == Communicator::REQUEST_STATUS::SUCCESS);
+        }
+        co_return succeeded;
+    };
+
+    EXPECT_EQ(syncWait(fan_out()), DEVICES);
+    EXPECT_EQ(communicator.max_in_flight, DEVICES);
+    for (std::size_t device = 0; device < DEVICES; ++device) {
+        EXPECT_EQ(responses[device], (std::vector<std::uint8_t>{static_cast<std::uint8_t>(device), 0xAA}));
+    }
+}
@@ -0,0 +1,73 @@
+#include "validation.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+/**
+ * @brief Size table accepting 1..4 bytes for even IDs, exactly 3 bytes for ID 0x11 and nothing else
+ */
+static FrameSizeTable<> makeTable() {
+    FrameSizeTable<> table{};
+    table.min.fill(std::numeric_limits<std::uint32_t>::max());
+    for (std::size_t id = 0; id < 256; id += 2) {
+        table.min[id] = 1;
+        table.max[id] = 4;
+    }
+    table.min[0x11] = 3;
+    table.max[0x11] = 3;
+    return table;
+}
+
+/**
+ * @brief Frames of pseudo-random IDs and sizes, valid and invalid alike, including empty ones
+ */
+static std::vector<std::vector<std::uint8_t>> makeFrames(const std::size_t count) {
+    std::vector<std::vector<std::uint8_t>> frames(count);
+    std::uint32_t state = 0x2468ACE1U; // xorshift, deterministic across runs
+    for (std::vector<std::uint8_t>& frame : frames) {
+        state ^= state << 13U;
+        state ^= state >> 17U;
+        state ^= state << 5U;
+        frame.assign(state % 6, static_cast<std::uint8_t>(state >> 8U));
+        if (state % 5 == 0 && !frame.empty()) {
+            frame.front() = 0x11;
+        }
+    }
+    return frames;
+}
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(ValidateFrames, ScalarKernelChecksIdAndSize) {
+    const FrameSizeTable<> table = makeTable();
+    const std::vector<std::vector<std::uint8_t>> raw{{}, {0x02}, {0x02, 0, 0, 0, 0}, {0x03}, {0x11, 0}, {0x11, 0, 0}};
+    const std::vector<serialized_message_view_t> frames(raw.begin(), raw.end());
+
+    std::vector<std::uint64_t> mask(validationMaskWords(frames.size()), ~std::uint64_t{0});
+    EXPECT_EQ(validateFrames(frames, table, mask, VALIDATION_KERNEL::SCALAR), 2);
+    EXPECT_EQ(mask[0], 0b100010U);
+}
+
+TEST(ValidateFrames, VectorKernelMatchesTheScalarReference) {
+    const FrameSizeTable<> table = makeTable();
+    const std::vector<std::vector<std::uint8_t>> raw = makeFrames(200);
+
+    // Empty, shorter than a vector block, whole blocks, and tails across mask words
+    for (const std::size_t count : std::array<std::size_t, 10>{0, 1, 7, 8, 9, 63, 64, 65, 128, 200}) {
+        const std::vector<serialized_message_view_t> frames(raw.begin(), std::next(raw.begin(), count));
+        std::vector<std::uint64_t> scalar(validationMaskWords(count));
+        const std::size_t valid = validateFrames(frames, table, scalar, VALIDATION_KERNEL::SCALAR);
+
+        for (const VALIDATION_KERNEL kernel : {VALIDATION_KERNEL::AVX2, VALIDATION_KERNEL::AUTO}) {
+            std::vector<std::uint64_t> mask(validationMaskWords(count), ~std::uint64_t{0});
+            EXPECT_EQ(validateFrames(frames, table, mask, kernel), valid) << count << " frames";
+            EXPECT_EQ(mask, scalar) << count << " frames";
+        }
+    }
+}
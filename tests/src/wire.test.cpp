@@ -0,0 +1,70 @@
+#include "wire.h"
+#include "message.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <type_traits>
+#include <vector>
+
+/* ―――――――――――――――― Formats ―――――――――――――――― */
+
+struct WireFormat
+{
+    static constexpr std::uint8_t ID = 0x41;
+    std::uint8_t id;
+    std::uint8_t status;
+    le_u32_t little; // at offset 2, no padding before it
+    be_u16_t big;
+    le_i16_t signed_little;
+};
+static_assert(MessageFormatT<WireFormat>);
+static_assert(std::is_trivially_copyable_v<WireFormat>);
+static_assert(sizeof(WireFormat) == 10);
+static_assert(offsetof(WireFormat, little) == 2);
+
+static_assert(alignof(le_u64_t) == 1);
+static_assert(sizeof(be_u64_t) == 8);
+static_assert(le_u32_t(0x01020304U).value() == 0x01020304U); // usable in constant expressions
+static_assert(be_u16_t(0x0102U).bytes() == std::array<std::uint8_t, 2>{0x01, 0x02});
+static_assert(le_u16_t(0x0102U).bytes() == std::array<std::uint8_t, 2>{0x02, 0x01});
+
+/* ―――――――――――――――― Tests ―――――――――――――――― */
+
+TEST(WireIntTest, StoresBytesInTheWireOrder) {
+    const le_u32_t little = 0xA1B2C3D4U;
+    const be_u32_t big = 0xA1B2C3D4U;
+    EXPECT_EQ(little.bytes(), (std::array<std::uint8_t, 4>{0xD4, 0xC3, 0xB2, 0xA1}));
+    EXPECT_EQ(big.bytes(), (std::array<std::uint8_t, 4>{0xA1, 0xB2, 0xC3, 0xD4}));
+    EXPECT_EQ(little, 0xA1B2C3D4U);
+    EXPECT_EQ(big, 0xA1B2C3D4U);
+}
+
+TEST(WireIntTest, RoundTripsSignedValues) {
+    be_i32_t field;
+    field = -2;
+    EXPECT_EQ(field.value(), -2);
+    EXPECT_EQ(field.bytes(), (std::array<std::uint8_t, 4>{0xFF, 0xFF, 0xFF, 0xFE}));
+}
+
+TEST(WireIntTest, ParsesMisalignedFrames) {
+    // The frame starts at an odd offset, as it does after a one-byte transport header
+    std::array<std::uint8_t, 1 + sizeof(WireFormat)> buffer{
+        0x00, WireFormat::ID, 0x07, 0x04, 0x03, 0x02, 0x01, 0x12, 0x34, 0xFE, 0xFF
+    };
+    const ReceivedMessage<WireFormat> message(serialized_message_view_t(buffer).subspan(1));
+    EXPECT_EQ(message.content().status, 0x07);
+    EXPECT_EQ(message.content().little, 0x01020304U);
+    EXPECT_EQ(message.content().big, 0x1234U);
+    EXPECT_EQ(message.content().signed_little, -2);
+}
+
+TEST(WireIntTest, SerializesInTheWireOrder) {
+    const SentMessage<WireFormat> message(
+        {.id = WireFormat::ID, .status = 0x00, .little = 0x01020304U, .big = 0x1234U, .signed_little = -2}
+    );
+    EXPECT_EQ(
+        message.serialize(),
+        (std::vector<std::uint8_t>{WireFormat::ID, 0x00, 0x04, 0x03, 0x02, 0x01, 0x12, 0x34, 0xFE, 0xFF})
+    );
+}
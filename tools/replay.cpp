@@ -0,0 +1,225 @@
+#include "capture.h"
+#include "communication.h"
+#include "example_commands.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/* ―――――――――――――――― Types ―――――――――――――――― */
+
+/** @brief Time before a frame is due when a timed replay stops sleeping and spins, as sleeps overshoot */
+static constexpr std::chrono::microseconds SPIN_WINDOW{200};
+
+/**
+ * @brief Command line options
+ */
+struct ReplayOptions
+{
+    std::string path;        ///< Capture file
+    bool timing = false;     ///< Replay at the original timing instead of as fast as possible
+    std::size_t threads = 1; ///< Threads executing the frames
+    std::size_t repeat = 1;  ///< Passes over the capture
+};
+
+/**
+ * @brief What one replay thread measured
+ */
+struct ReplayThreadResult
+{
+    std::vector<std::uint64_t> latencies_ns; ///< Latency of each executed frame
+    std::size_t errors = 0;                  ///< Frames the handler failed
+};
+
+/* ―――――――――――――――― Communicator ―――――――――――――――― */
+
+/**
+ * @brief Communicator discarding the responses, so that only the handler is measured
+ */
+class DiscardingCommunicator final : public Communicator
+{
+  public:
+    void respond(const std::vector<std::uint8_t>& /*response*/) const override {}
+    void respondView(const std::span<const std::uint8_t> /*response*/) const override {}
+
+    [[nodiscard]] REQUEST_STATUS request(
+        const std::vector<std::uint8_t>& /*message*/,
+        std::function<void(std::vector<std::uint8_t>)> /*handle_response_callback*/
+    ) const override {
+        return REQUEST_STATUS::ERROR_UNKNOWN;
+    }
+};
+
+/* ―――――――――――――――― Helpers ―――――――――――――――― */
+
+static void usage(const char* program) {
+    std::cerr << "Usage: " << program << " <capture file> [--timing] [--threads <n>] [--repeat <n>]\n"
+              << "  --timing       replay at the original timing instead of as fast as possible\n"
+              << "  --threads <n>  execute with n threads, frame i going to thread i % n (default 1)\n"
+              << "  --repeat <n>   replay the capture n times over (default 1)\n";
+}
+
+static bool parseCount(const std::string_view text, std::size_t& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size() && value > 0;
+}
+
+static bool parseOptions(const int argc, char** argv, ReplayOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--timing") {
+            options.timing = true;
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            if (!parseCount(argv[++i], options.threads)) {
+                return false;
+            }
+        }
+        else if (arg == "--repeat" && i + 1 < argc) {
+            if (!parseCount(argv[++i], options.repeat)) {
+                return false;
+            }
+        }
+        else if (options.path.empty() && !arg.starts_with("--")) {
+            options.path = arg;
+        }
+        else {
+            return false;
+        }
+    }
+    return !options.path.empty();
+}
+
+/**
+ * @brief Executes the records of one thread, measuring the latency of each
+ *
+ * At the original timing, a frame is due at its capture time after start, and its latency runs from
+ * then rather than from when the thread got to it: a handler falling behind shows as growing latency
+ * instead of silently stretching the replay.
+ *
+ * @param records The records of the capture
+ * @param options The options
+ * @param index Index of the thread, which executes records index, index + threads, ...
+ * @param start Time the replay started
+ * @param span Time between the starts of two passes at the original timing
+ * @param result Where to store the measurements
+ */
+static void replayThread(
+    const std::vector<CaptureRecord>& records,
+    const ReplayOptions& options,
+    const std::size_t index,
+    const std::chrono::steady_clock::time_point start,
+    const std::chrono::nanoseconds span,
+    ReplayThreadResult& result
+) {
+    const DiscardingCommunicator communicator;
+    result.latencies_ns.reserve((records.size() / options.threads + 1) * options.repeat);
+    for (std::size_t pass = 0; pass < options.repeat; ++pass) {
+        for (std::size_t i = index; i < records.size(); i += options.threads) {
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            if (options.timing) {
+                const auto due = start + span * static_cast<std::int64_t>(pass) + records[i].at;
+                std::this_thread::sleep_until(due - SPIN_WINDOW);
+                while (std::chrono::steady_clock::now() < due) {
+                    std::this_thread::yield();
+                }
+                begin = due;
+            }
+            const auto status = Handler123::execute(records[i].frame, communicator);
+            const auto end = std::chrono::steady_clock::now();
+            result.errors += status ? 0 : 1;
+            result.latencies_ns.push_back(
+                static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count())
+            );
+        }
+    }
+}
+
+/**
+ * @brief Latency at a percentile of sorted latencies
+ * @param sorted The latencies, in increasing order
+ * @param percentile The percentile, in ]0, 100]
+ * @return std::uint64_t The smallest latency that percentile of the frames did not exceed
+ */
+static std::uint64_t percentileOf(const std::vector<std::uint64_t>& sorted, const double percentile) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto rank = static_cast<std::size_t>(percentile / 100.0 * static_cast<double>(sorted.size()) + 0.999999);
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+/* ―――――――――――――――― Main ―――――――――――――――― */
+
+int main(const int argc, char** argv) {
+    ReplayOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    try {
+        const CaptureReader capture(options.path);
+        const std::vector<CaptureRecord> records(capture.begin(), capture.end());
+        if (records.empty()) {
+            std::cerr << "Error: " << options.path << " holds no frame." << std::endl;
+            return 1;
+        }
+        if (capture.truncatedBytes() != 0) {
+            std::cerr << "Warning: ignoring a torn last record of " << capture.truncatedBytes() << " bytes."
+                      << std::endl;
+        }
+        const std::chrono::nanoseconds span = records.back().at + std::chrono::nanoseconds(1);
+
+        std::vector<ReplayThreadResult> results(options.threads);
+        std::vector<std::thread> threads;
+        std::latch ready(static_cast<std::ptrdiff_t>(options.threads) + 1);
+        std::chrono::steady_clock::time_point start;
+        for (std::size_t index = 0; index < options.threads; ++index) {
+            threads.emplace_back([&, index] {
+                ready.arrive_and_wait();
+                replayThread(records, options, index, start, span, results[index]);
+            });
+        }
+        start = std::chrono::steady_clock::now();
+        ready.arrive_and_wait();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::vector<std::uint64_t> latencies;
+        std::size_t errors = 0;
+        for (ReplayThreadResult& result : results) {
+            latencies.insert(latencies.end(), result.latencies_ns.begin(), result.latencies_ns.end());
+            errors += result.errors;
+        }
+        std::ranges::sort(latencies);
+
+        std::cout << "Replayed " << latencies.size() << " frames (" << errors << " failed) with " << options.threads
+                  << " thread(s), " << (options.timing ? "at the original timing" : "as fast as possible") << '\n'
+                  << std::fixed << std::setprecision(3) << "  elapsed:    " << elapsed.count() << " s\n"
+                  << std::setprecision(0)
+                  << "  throughput: " << static_cast<double>(latencies.size()) / elapsed.count() << " frames/s\n"
+                  << "  latency ns: p50 " << percentileOf(latencies, 50) << ", p90 " << percentileOf(latencies, 90)
+                  << ", p99 " << percentileOf(latencies, 99) << ", p99.9 " << percentileOf(latencies, 99.9)
+                  << ", max " << latencies.back() << std::endl;
+    }
+    catch (const std::system_error& e) {
+        std::cerr << "Error: " << options.path << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}